@@ -4,13 +4,25 @@
 # FUSE_FOUND - system has fuse
 # FUSE_INCLUDE_DIRS - the fuse include directories
 # FUSE_LIBRARIES - fuse libraries directories
+# FUSE3_FOUND - the fuse found is libfuse3
 
 if(FUSE_INCLUDE_DIRS AND FUSE_LIBRARIES)
 set(FUSE_FIND_QUIETLY TRUE)
 endif(FUSE_INCLUDE_DIRS AND FUSE_LIBRARIES)
 
-find_path(FUSE_INCLUDE_DIR fuse/fuse_lowlevel.h)
-find_library(FUSE_LIBRARY fuse)
+# Prefer libfuse3 and fall back to the FUSE 2 API
+find_path(FUSE3_INCLUDE_DIR fuse3/fuse_lowlevel.h)
+find_library(FUSE3_LIBRARY fuse3)
+
+if(FUSE3_INCLUDE_DIR AND FUSE3_LIBRARY)
+  set(FUSE3_FOUND TRUE)
+  set(FUSE_INCLUDE_DIR ${FUSE3_INCLUDE_DIR})
+  set(FUSE_LIBRARY ${FUSE3_LIBRARY})
+else()
+  set(FUSE3_FOUND FALSE)
+  find_path(FUSE_INCLUDE_DIR fuse/fuse_lowlevel.h)
+  find_library(FUSE_LIBRARY fuse)
+endif()
 
 set(FUSE_INCLUDE_DIRS ${FUSE_INCLUDE_DIR})
 set(FUSE_LIBRARIES ${FUSE_LIBRARY})
@@ -20,4 +32,4 @@ set(FUSE_LIBRARIES ${FUSE_LIBRARY})
 include(FindPackageHandleStandardArgs)
 find_package_handle_standard_args(fuse DEFAULT_MSG FUSE_INCLUDE_DIR FUSE_LIBRARY)
 
-mark_as_advanced(FUSE_INCLUDE_DIR FUSE_LIBRARY)
+mark_as_advanced(FUSE_INCLUDE_DIR FUSE_LIBRARY FUSE3_INCLUDE_DIR FUSE3_LIBRARY)
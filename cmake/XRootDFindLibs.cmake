@@ -76,16 +76,7 @@ if( ENABLE_PYTHON OR PYPI_BUILD )
 endif()
 
 if( ENABLE_XRDOSSARC )
-  if( FORCE_ENABLED )
-    find_package( libzip REQUIRED )
-  else()
-    find_package( libzip )
-  endif()
-  if( LIBZIP_FOUND )
-    set( BUILD_XRDOSSARC TRUE )
-  else()
-    set( BUILD_XRDOSSARC FALSE )
-  endif()
+  set( BUILD_XRDOSSARC TRUE )
 endif()
 
 if( ENABLE_TESTS )
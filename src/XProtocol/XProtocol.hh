@@ -656,6 +656,7 @@ enum XQueryType {
    kXR_Qvisa  = 8,
    kXR_QFinfo = 9,
    kXR_QFSinfo=10,
+   kXR_QFread =11,
    kXR_Qopaque=16,
    kXR_Qopaquf=32,
    kXR_Qopaqug=64
@@ -1121,6 +1122,22 @@ struct ServerResponseBody_pgWrCSE {
 // kXR_int64 bof[(dlen-8)/8];       // List of offsets of pages in error
 };
 
+/******************************************************************************/
+/*                     k X R _ q u e r y   R e s p o n s e                    */
+/******************************************************************************/
+
+// The response to kXR_QFread whose arguments are "<maxbytes>\n<path>[\n...]".
+// For each path, in request order, the following is returned followed by dlen
+// bytes of file data or, if errnum is not zero, the error text. The results
+// may be spread over several kXR_oksofar responses.
+//
+struct ServerResponseBody_QFread {
+   kXR_int32 errnum;                // 0 or the XErrorCode for this path
+   kXR_int32 dlen;                  // Number of bytes that follow
+   kXR_int64 fsize;                 // Size of the file (-1 upon error)
+// kXR_char  data[dlen];
+};
+
 /******************************************************************************/
 /*                 k X R _ p r o t o c o l   R e s p o n s e                  */
 /******************************************************************************/
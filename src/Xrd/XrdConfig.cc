@@ -2440,6 +2440,9 @@ int XrdConfig::xtcpmon(XrdSysError *eDest, XrdOucStream &Config)
              <opts>   options:
                       [no]detail       do [not] print TLS library msgs
                       hsto <sec>       handshake timeout (default 10).
+                      [no]ktls         do [not] use kernel TLS offload when
+                                       the kernel supports it. This allows
+                                       sendfile over TLS (default noktls).
 
    Output: 0 upon success or 1 upon failure.
 */
@@ -2469,6 +2472,8 @@ int XrdConfig::xtls(XrdSysError *eDest, XrdOucStream &Config)
 
 do {     if (!strcmp(val,   "detail")) SSLmsgs = true;
     else if (!strcmp(val, "nodetail")) SSLmsgs = false;
+    else if (!strcmp(val,   "ktls"))   tlsOpts |=  XrdTlsContext::ktlsOn;
+    else if (!strcmp(val, "noktls"))   tlsOpts &= ~XrdTlsContext::ktlsOn;
     else if (!strcmp(val, "hsto" ))
             {if (!(val = Config.GetWord()))
                 {eDest->Emsg("Config", "tls hsto value not specified");
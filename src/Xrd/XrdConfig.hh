@@ -43,9 +43,11 @@ class XrdOucStream;
 class XrdInet;
 class XrdConfigProt;
 class XrdMonitor;
+class XrdConfigTests;
 
 class XrdConfig
 {
+friend class ::XrdConfigTests;
 public:
 
 int         Configure(int argc, char **argv);
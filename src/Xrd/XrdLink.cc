@@ -493,6 +493,15 @@ bool XrdLink::setTLS(bool enable, XrdTlsContext *ctx)
    return linkXQ.setTLS(enable, ctx);
 }
   
+/******************************************************************************/
+/*                                 s f T L S                                  */
+/******************************************************************************/
+
+bool XrdLink::sfTLS()
+{
+   return (isTLS ? linkXQ.sfTLS() : false);
+}
+
 /******************************************************************************/
 /*                              S h u t d o w n                               */
 /******************************************************************************/
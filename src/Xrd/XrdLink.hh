@@ -562,6 +562,16 @@ bool            hasBridge() const {return isBridged;}
 
 bool            hasTLS() const {return isTLS;}
 
+//-----------------------------------------------------------------------------
+//! Determine if sendfile can be used efficiently on this TLS link. This is
+//! the case when kernel TLS is encrypting the data sent on the link.
+//!
+//! @return true    file data is sent without copying it into user space.
+//! @return false   link is not using TLS or file data is sent via a copy.
+//-----------------------------------------------------------------------------
+
+bool            sfTLS();
+
 //-----------------------------------------------------------------------------
 //! Return TLS protocol version being used.
 //!
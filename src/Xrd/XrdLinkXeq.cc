@@ -1394,31 +1394,45 @@ int XrdLinkXeq::TLS_Send(const struct iovec *iov, int iocnt, int bytes)
 int XrdLinkXeq::TLS_Send(const sfVec *sfP, int sfN)
 {
    XrdSysMutexHelper lck(wrMutex);
-   int bytes, buffsz, fileFD, retc;
+   XrdTls::RC tlsrc;
+   int bytes, buffsz, fileFD, retc, byteswritten;
    off_t offset;
    ssize_t totamt = 0;
    char myBuff[65536];
+   bool useSF = tlsIO.CanSendFile();
 
-// Convert the sendfile to a regular send. The conversion is not particularly
-// fast and caller are advised to avoid using sendfile on TLS connections.
+// If kernel TLS is active we can send file segments directly. Otherwise, we
+// must convert the sendfile to a regular send. The conversion is not
+// particularly fast and callers are advised to use sendfile on TLS
+// connections only when sfTLS() is true.
 //
    isIdle = 0;
    for (int i = 0; i < sfN; sfP++, i++)
        {if (!(bytes = sfP->sendsz)) continue;
-        totamt += bytes;
         if (sfP->fdnum < 0)
            {if (!TLS_Write(sfP->buffer, bytes)) return -1;
+            totamt += bytes;
             continue;
            }
         offset = sfP->offset;
         fileFD = sfP->fdnum;
-        buffsz = (bytes < (int)sizeof(myBuff) ? bytes : sizeof(myBuff));
-        do {do {retc = pread(fileFD, myBuff, buffsz, offset);}
+        if (useSF)
+           {do {tlsrc = tlsIO.SendFile(fileFD, offset, bytes, byteswritten);
+                if (tlsrc != XrdTls::TLS_AOK)
+                   return TLS_Error("sendfile to", tlsrc);
+                if (!byteswritten) break;
+                offset += byteswritten; bytes -= byteswritten;
+                totamt += byteswritten;
+               } while(bytes > 0);
+            continue;
+           }
+        do {buffsz = (bytes < (int)sizeof(myBuff) ? bytes : sizeof(myBuff));
+            do {retc = pread(fileFD, myBuff, buffsz, offset);}
                        while(retc < 0 && errno == EINTR);
             if (retc < 0) return SFError(errno);
             if (!retc) break;
-            if (!TLS_Write(myBuff, buffsz)) return -1;
-            offset += buffsz; bytes -= buffsz; totamt += retc;
+            if (!TLS_Write(myBuff, retc)) return -1;
+            offset += retc; bytes -= retc; totamt += retc;
            } while(bytes > 0);
        }
 
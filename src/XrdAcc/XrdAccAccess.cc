@@ -96,6 +96,10 @@ XrdAccAccess::XrdAccAccess(XrdSysError *erp)
 // Get the audit option that we should use
 //
    Auditor = XrdAccAuditObject(erp);
+
+// Start with empty tables until the configuration supplies real ones
+//
+   Atab = new XrdAccAccess_Tables;
 }
 
 /******************************************************************************/
@@ -112,6 +116,7 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
    XrdAccCapability *cp;
    XrdAccEntity     *aeP;
    XrdAccEntityInfo  eInfo;
+   XrdAccAccess_Tables *tabP;
    int plen = strlen(path);
    long phash = XrdOucHashVal2(path, plen);
    bool isuser;
@@ -137,23 +142,24 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
        isuser = false;
       }
 
-// Get a shared context for these potentially long running routines
+// Pin the current tables. They cannot change underneath us and a refresh
+// need not wait for us to finish.
 //
-   Access_Context.Lock(xs_Shared);
+   tabP = PinTabs();
 
 // Setup the host entry in the eInfo structure (it may need to be resolved)
 //
-   eInfo.host = (hostRefX ? Resolve(Entity) : "?");
+   eInfo.host = (tabP->hostRefX ? Resolve(Entity) : "?");
 
 // Run through the exclusive list first as only one rule will apply
 //
-   if (Atab.SXList)
-      {XrdAccAccess_ID *xlP = Atab.SXList;
+   if (tabP->SXList)
+      {XrdAccAccess_ID *xlP = tabP->SXList;
        do {int aSeq = 0;
            while(aeP->Next(aSeq, eInfo))
                 {if (xlP->Applies(eInfo))
                     {xlP->caps->Privs(caps, path, plen, phash);
-                     Access_Context.UnLock(xs_Shared);
+                     UnPinTabs(tabP);
                      return Access2(caps, Entity, path, oper);
                     }
                 }
@@ -163,42 +169,42 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
 
 // Check if we really need to resolve the host name
 //
-//???   if (Atab.D_List || Atab.H_Hash || Atab.N_Hash) host = Resolve(Entity);
-   if (!hostRefX && hostRefY) eInfo.host = Resolve(Entity);
+//???   if (tabP->D_List || tabP->H_Hash || tabP->N_Hash) host = Resolve(Entity);
+   if (!tabP->hostRefX && tabP->hostRefY) eInfo.host = Resolve(Entity);
 
 // Establish default privileges
 //
-   if (Atab.Z_List) Atab.Z_List->Privs(caps, path, plen, phash);
+   if (tabP->Z_List) tabP->Z_List->Privs(caps, path, plen, phash);
 
 // Next add in the host domain privileges
 //
-   if (Atab.D_List && (cp = Atab.D_List->Find(eInfo.host)))
+   if (tabP->D_List && (cp = tabP->D_List->Find(eInfo.host)))
       cp->Privs(caps, path, plen, phash);
 
 // Next add in the host-specific privileges
 //
-   if (Atab.H_Hash && (cp = Atab.H_Hash->Find(eInfo.host)))
+   if (tabP->H_Hash && (cp = tabP->H_Hash->Find(eInfo.host)))
       cp->Privs(caps, path, plen, phash);
 
 // Now add in the netgroup privileges
 //
-   if (Atab.N_Hash && *eInfo.host != '?' &&
+   if (tabP->N_Hash && *eInfo.host != '?' &&
        (glp = XrdAccConfiguration.GroupMaster.NetGroups(eInfo.name,eInfo.host)))
       {char *gname;
        while((gname = (char *)glp->Next()))
-            if ((cp = Atab.N_Hash->Find((const char *)gname)))
+            if ((cp = tabP->N_Hash->Find((const char *)gname)))
                cp->Privs(caps, path, plen, phash);
        delete glp;
       }
 
 // Check for user fungible privileges
 //
-   if (isuser && Atab.X_List)
-      Atab.X_List->Privs(caps, path, plen, phash, eInfo.name);
+   if (isuser && tabP->X_List)
+      tabP->X_List->Privs(caps, path, plen, phash, eInfo.name);
 
 // Add in specific user privileges
 //
-   if (isuser && Atab.U_Hash && (cp = Atab.U_Hash->Find(eInfo.name)))
+   if (isuser && tabP->U_Hash && (cp = tabP->U_Hash->Find(eInfo.name)))
       cp->Privs(caps, path, plen, phash);
 
 // The following privileges are based on multiple attributes. Orgs and roles
@@ -211,28 +217,28 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
         {
          // Add in the group privileges.
          //
-         if (Atab.G_Hash && eInfo.grup && (cp = Atab.G_Hash->Find(eInfo.grup)))
+         if (tabP->G_Hash && eInfo.grup && (cp = tabP->G_Hash->Find(eInfo.grup)))
             cp->Privs(caps, path, plen, phash);
 
          // Add in the org-specific privileges
          //
-         if (Atab.O_Hash && eInfo.vorg && eInfo.vorg != vorgPrev)
+         if (tabP->O_Hash && eInfo.vorg && eInfo.vorg != vorgPrev)
             {vorgPrev = eInfo.vorg;
-             if ((cp = Atab.O_Hash->Find(eInfo.vorg)))
+             if ((cp = tabP->O_Hash->Find(eInfo.vorg)))
                 cp->Privs(caps, path, plen, phash);
             }
 
          // Add in the role-specific privileges
          //
-         if (Atab.R_Hash && eInfo.role && eInfo.role != rolePrev)
+         if (tabP->R_Hash && eInfo.role && eInfo.role != rolePrev)
             {rolePrev = eInfo.role;
-             if ((cp = Atab.R_Hash->Find(eInfo.role)))
+             if ((cp = tabP->R_Hash->Find(eInfo.role)))
                 cp->Privs(caps, path, plen, phash);
             }
 
          // Finally run through the inclusive list and apply all relevant rules
          //
-         XrdAccAccess_ID *ylP = Atab.SYList;
+         XrdAccAccess_ID *ylP = tabP->SYList;
          while (ylP)
                {if (ylP->Applies(eInfo))
                    ylP->caps->Privs(caps, path, plen, phash);
@@ -242,7 +248,7 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
 
 // We are now done with looking at changeable data
 //
-   Access_Context.UnLock(xs_Shared);
+   UnPinTabs(tabP);
 
 // Return the privileges as needed
 //
@@ -332,6 +338,24 @@ int XrdAccAccess::Audit(const int              accok,
    return accok;
 }
 
+/******************************************************************************/
+/*                               P i n T a b s                                */
+/******************************************************************************/
+
+XrdAccAccess_Tables *XrdAccAccess::PinTabs()
+{
+   XrdAccAccess_Tables *tabP;
+
+// Take a reference to the current tables. The lock only covers fetching the
+// pointer so that it cannot be replaced and released before we count it.
+//
+   Access_Context.Lock();
+   tabP = Atab;
+   tabP->tRefs++;
+   Access_Context.UnLock();
+   return tabP;
+}
+
 /******************************************************************************/
 /*                               R e s o l v e                                */
 /******************************************************************************/
@@ -350,39 +374,34 @@ const char *XrdAccAccess::Resolve(const XrdSecEntity *Entity)
 /*                              S w a p T a b s                               */
 /******************************************************************************/
 
-#define XrdAccSWAP(x) oldtab.x = Atab.x;   Atab.x  =  newtab.x; \
-                      newtab.x = oldtab.x; oldtab.x = 0;
+#define XrdAccSWAP(x) tabP->x = newtab.x; newtab.x = 0;
 
 void XrdAccAccess::SwapTabs(struct XrdAccAccess_Tables &newtab)
 {
-   struct XrdAccAccess_Tables oldtab;
-   bool hRefX = false, hRefY = false;
+   XrdAccAccess_Tables *tabP = new XrdAccAccess_Tables, *oldP;
 
 // Determine if we need to resolve the host name early
 //
    XrdAccAccess_ID *xlP = newtab.SXList;
    while(xlP)
-        {if (xlP->host) {hRefX = true; break;}
+        {if (xlP->host) {tabP->hostRefX = true; break;}
          xlP = xlP->next;
         }
 
 // Determine if we need to resolve the hostname at all.
 //
-   if (!hRefX)
-      {if (newtab.D_List || newtab.H_Hash || newtab.N_Hash) hRefY = true;
+   if (!tabP->hostRefX)
+      {if (newtab.D_List || newtab.H_Hash || newtab.N_Hash)
+          tabP->hostRefY = true;
           else {XrdAccAccess_ID *ylP = newtab.SYList;
                 while (ylP)
-                      {if (ylP->host) {hRefY = true; break;}
+                      {if (ylP->host) {tabP->hostRefY = true; break;}
                        ylP = ylP->next;
                       }
                }
       }
 
-// Get an exclusive context to change the table pointers
-//
-   Access_Context.Lock(xs_Exclusive);
-
-// Save the old pointer while replacing it with the new pointer
+// Take over the new tables, the caller's copy is left empty
 //
    XrdAccSWAP(D_List);
    XrdAccSWAP(E_List);
@@ -398,16 +417,22 @@ void XrdAccAccess::SwapTabs(struct XrdAccAccess_Tables &newtab)
    XrdAccSWAP(Z_List);
    XrdAccSWAP(SXList);
    XrdAccSWAP(SYList);
-   hostRefX = hRefX;
-   hostRefY = hRefY;
+
+// Replace the table pointer. New searches use the new tables from here on.
+//
+   Access_Context.Lock();
+   oldP = Atab;
+   Atab = tabP;
+   Access_Context.UnLock();
 
 // When we set new access tables, we should purge the group cache
 //
    XrdAccConfiguration.GroupMaster.PurgeCache();
 
-// We can now let loose new table searchers
+// Drop our reference to the old tables. They are deleted now or when the
+// last search using them completes.
 //
-   Access_Context.UnLock(xs_Exclusive);
+   UnPinTabs(oldP);
 }
 
 /******************************************************************************/
@@ -441,6 +466,17 @@ int XrdAccAccess::Test(const XrdAccPrivs priv,const Access_Operation oper)
    return (int)(need[oper] & priv) == need[oper];
 }
 
+/******************************************************************************/
+/*                             U n P i n T a b s                              */
+/******************************************************************************/
+
+void XrdAccAccess::UnPinTabs(XrdAccAccess_Tables *tabP)
+{
+// Whoever drops the last reference to replaced tables deletes them
+//
+   if (tabP->tRefs.fetch_sub(1) == 1) delete tabP;
+}
+
 /******************************************************************************/
 /*              X r d A c c A c c e s s _ I D : : A p p l i e s               */
 /******************************************************************************/
@@ -30,12 +30,14 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
+
 #include "XrdAcc/XrdAccAudit.hh"
 #include "XrdAcc/XrdAccAuthorize.hh"
 #include "XrdAcc/XrdAccCapability.hh"
 #include "XrdSec/XrdSecEntity.hh"
 #include "XrdOuc/XrdOucHash.hh"
-#include "XrdSys/XrdSysXSLock.hh"
+#include "XrdSys/XrdSysPthread.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 
 /******************************************************************************/
@@ -97,6 +99,9 @@ struct XrdAccAccess_Tables
                   XrdAccCapability  *Z_List;  // Default  capbailities
                   XrdAccAccess_ID   *SXList;  // 's' exclusive list
                   XrdAccAccess_ID   *SYList;  // 's' inclusive list
+                  std::atomic<int>   tRefs;   // References while in use
+                  bool               hostRefX;// Resolve host for 'x' rules
+                  bool               hostRefY;// Resolve host for other rules
 
         XrdAccAccess_Tables() {G_Hash = 0; H_Hash = 0; N_Hash = 0;
                                O_Hash = 0; R_Hash = 0;
@@ -104,6 +109,7 @@ struct XrdAccAccess_Tables
                                D_List = 0; E_List = 0;
                                X_List = 0; Z_List = 0;
                                SXList = 0; SYList = 0;
+                               tRefs = 1; hostRefX = hostRefY = false;
                               }
        ~XrdAccAccess_Tables() {if (G_Hash) delete G_Hash;
                                if (H_Hash) delete H_Hash;
@@ -145,7 +151,9 @@ static
 const char       *Resolve(const XrdSecEntity *Entity);
 
 // SwapTabs() is used by the configuration object to establish new access
-// control tables. It may be called whenever the tables change.
+// control tables. It may be called whenever the tables change. The new tables
+// replace the old ones in one step; searches already under way finish using
+// the old tables which are deleted once the last such search is done.
 //
 void              SwapTabs(struct XrdAccAccess_Tables &newtab);
 
@@ -157,16 +165,17 @@ void              SwapTabs(struct XrdAccAccess_Tables &newtab);
 
 private:
 
+XrdAccAccess_Tables *PinTabs();
+void                 UnPinTabs(XrdAccAccess_Tables *tabP);
+
 XrdAccPrivs Access2(      XrdAccPrivCaps  &caps,
                     const XrdSecEntity    *Entity,
                     const char            *path,
                     const Access_Operation oper);
 
-struct XrdAccAccess_Tables Atab;
-bool   hostRefX; // True if we need to resolve hostname for exclusive rules
-bool   hostRefY; // True if we need to resolve hostname for any other rules
+struct XrdAccAccess_Tables *Atab;
 
-XrdSysXSLock Access_Context;
+XrdSysMutex  Access_Context;
 
 XrdAccAudit *Auditor;
 };
@@ -0,0 +1,200 @@
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d A c c C a p I n d e x . c c                      */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstring>
+
+#include "XrdAcc/XrdAccCapIndex.hh"
+#include "XrdAcc/XrdAccCapability.hh"
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdAccCapIndex::XrdAccCapIndex() : root(new capNode("", 0)) {}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdAccCapIndex::~XrdAccCapIndex() {delete root;}
+
+/******************************************************************************/
+/*                                   A d d                                    */
+/******************************************************************************/
+
+void XrdAccCapIndex::Add(const char *path, int plen, const XrdAccPrivCaps &privs)
+{
+   capNode *nP = root, *kP;
+   int kx, n, pos = 0;
+
+// Walk down the trie splitting any edge that only partially matches the path
+//
+   while(pos < plen)
+        {if (!(kP = Child(nP, path[pos], kx)))
+            {kP = new capNode(path+pos, plen-pos);
+             nP->kids.insert(nP->kids.begin()+kx, kP);
+             nP = kP;
+             break;
+            }
+         n = 1;
+         while(n < (int)kP->label.size() && pos+n < plen
+         &&    kP->label[n] == path[pos+n]) n++;
+         if (n < (int)kP->label.size()) Split(kP, n);
+         nP = kP; pos += n;
+        }
+
+// Only the first rule for any given path can ever apply, ignore the rest
+//
+   if (nP->rule >= 0) return;
+   nP->rule = (int)ruleTab.size();
+   ruleTab.push_back(privs);
+}
+
+/******************************************************************************/
+/*                               C o m p i l e                                */
+/******************************************************************************/
+
+XrdAccCapIndex *XrdAccCapIndex::Compile(XrdAccCapability *capList)
+{
+   XrdAccCapIndex *ixP = new XrdAccCapIndex;
+
+// Add all the rules in the list in order, then see if this was worth it
+//
+   ixP->AddList(capList);
+   if (ixP->Rules() < minRules) {delete ixP; return 0;}
+   ixP->Ready();
+   return ixP;
+}
+
+/******************************************************************************/
+/*                                  F i n d                                   */
+/******************************************************************************/
+
+bool XrdAccCapIndex::Find(XrdAccPrivCaps &pathpriv,
+                          const char *path, int plen) const
+{
+   const capNode *nP = root, *kP;
+   int kx, n, pos = 0;
+
+// Descend as far as the path allows. Each node already knows which rule
+// applies to it so the deepest node reached has the answer.
+//
+   while(pos < plen && (kP = Child(nP, path[pos], kx)))
+        {n = (int)kP->label.size();
+         if (plen - pos < n || memcmp(kP->label.data(), path+pos, n)) break;
+         nP = kP; pos += n;
+        }
+
+// Merge in the privileges, if any
+//
+   if (nP->best < 0) return false;
+   pathpriv.pprivs = (XrdAccPrivs)(pathpriv.pprivs | ruleTab[nP->best].pprivs);
+   pathpriv.nprivs = (XrdAccPrivs)(pathpriv.nprivs | ruleTab[nP->best].nprivs);
+   return true;
+}
+
+/******************************************************************************/
+/*                                 R e a d y                                  */
+/******************************************************************************/
+
+void XrdAccCapIndex::Ready() {SetBest(root, -1);}
+
+/******************************************************************************/
+/*                     P r i v a t e   F u n c t i o n s                      */
+/******************************************************************************/
+/******************************************************************************/
+/*                               A d d L i s t                                */
+/******************************************************************************/
+
+void XrdAccCapIndex::AddList(XrdAccCapability *capList)
+{
+   XrdAccCapability *cP = capList;
+
+// Templates are expanded in place as they are searched in place
+//
+   while(cP)
+        {if (cP->ctmp) AddList(cP->ctmp);
+            else Add(cP->path, cP->plen, cP->priv);
+         cP = cP->next;
+        }
+}
+
+/******************************************************************************/
+/*                                 C h i l d                                  */
+/******************************************************************************/
+
+XrdAccCapIndex::capNode *XrdAccCapIndex::Child(const capNode *nP, char c,
+                                               int &kx) const
+{
+   int lo = 0, hi = (int)nP->kids.size() - 1, mid;
+
+// Children are ordered by their first character so do a binary search
+//
+   while(lo <= hi)
+        {mid = (lo + hi) / 2;
+         if (nP->kids[mid]->label[0] == c) {kx = mid; return nP->kids[mid];}
+         if ((unsigned char)nP->kids[mid]->label[0] < (unsigned char)c)
+            lo = mid + 1;
+            else hi = mid - 1;
+        }
+   kx = lo;
+   return 0;
+}
+
+/******************************************************************************/
+/*                               S e t B e s t                                */
+/******************************************************************************/
+
+void XrdAccCapIndex::SetBest(capNode *nP, int best)
+{
+// The earliest rule along the way to this node is the one that applies
+//
+   if (nP->rule >= 0 && (best < 0 || nP->rule < best)) best = nP->rule;
+   nP->best = best;
+   for (auto kP : nP->kids) SetBest(kP, best);
+}
+
+/******************************************************************************/
+/*                                 S p l i t                                  */
+/******************************************************************************/
+
+void XrdAccCapIndex::Split(capNode *nP, int at)
+{
+   capNode *tP = new capNode(nP->label.data()+at, nP->label.size()-at);
+
+// The tail inherits everything below this node which then becomes its parent.
+// The first character is unchanged so the node's position is still valid.
+//
+   tP->kids.swap(nP->kids);
+   tP->rule = nP->rule;
+   nP->label.resize(at);
+   nP->kids.push_back(tP);
+   nP->rule = -1;
+}
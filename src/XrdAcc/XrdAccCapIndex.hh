@@ -0,0 +1,106 @@
+#ifndef __ACC_CAPINDEX__
+#define __ACC_CAPINDEX__
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d A c c C a p I n d e x . h h                      */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include "XrdAcc/XrdAccPrivs.hh"
+
+/******************************************************************************/
+/*                        X r d A c c C a p I n d e x                         */
+/******************************************************************************/
+
+// The capability index is a compiled form of a capability list. It is a radix
+// trie keyed by the path prefix of each rule where each node records the
+// earliest rule that applies to any path reaching it. Since rules are plain
+// character prefixes, a lookup is a single walk down the trie and costs time
+// proportional to the length of the path no matter how many rules there are.
+// The index is immutable once built and may be searched by any number of
+// threads. Substitution (i.e. @=) matching is not indexed.
+//
+class XrdAccCapability;
+
+class XrdAccCapIndex
+{
+public:
+
+// Add() records a rule. Rules must be added in the order they appear in the
+// capability list as the first matching rule is the one that applies.
+//
+void          Add(const char *path, int plen, const XrdAccPrivCaps &privs);
+
+// Compile() builds the index for the passed capability list, including any
+// templates it references. Nothing is returned when the list is too short for
+// an index to be worthwhile.
+//
+static
+XrdAccCapIndex *Compile(XrdAccCapability *capList);
+
+// Find() locates the rule that applies to path. If one is found, its
+// privileges are or'd into the passed XrdAccPrivCaps struct and true is
+// returned. Otherwise, false is returned and XrdAccPrivCaps is unchanged.
+//
+bool          Find(XrdAccPrivCaps &pathpriv, const char *path, int plen) const;
+
+// Ready() must be called once all of the rules have been added.
+//
+void          Ready();
+
+int           Rules() const {return (int)ruleTab.size();}
+
+              XrdAccCapIndex();
+             ~XrdAccCapIndex();
+
+static const int minRules = 8;  // Shorter lists are searched linearly
+
+private:
+
+struct capNode
+      {std::string           label;  // Characters on the edge to this node
+       std::vector<capNode*> kids;   // Ordered by the first label character
+       int                   rule;   // Rule ending here or -1
+       int                   best;   // Earliest rule applying here or -1
+
+       capNode(const char *lbl, int llen) : label(lbl, llen),
+                                            rule(-1), best(-1) {}
+      ~capNode() {for (auto kP : kids) delete kP;}
+      };
+
+void      AddList(XrdAccCapability *capList);
+capNode  *Child(const capNode *nP, char c, int &kx) const;
+void      Split(capNode *nP, int at);
+void      SetBest(capNode *nP, int best);
+
+capNode                    *root;
+std::vector<XrdAccPrivCaps> ruleTab;
+};
+#endif
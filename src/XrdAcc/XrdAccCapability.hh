@@ -36,15 +36,23 @@
 
 #include "XrdAcc/XrdAccPrivs.hh"
 
+class XrdAccCapIndex;
+
 /******************************************************************************/
 /*                      X r d A c c C a p a b i l i t y                       */
 /******************************************************************************/
   
 class XrdAccCapability
 {
+friend class XrdAccCapIndex;
 public:
 void                Add(XrdAccCapability *newcap) {next = newcap;}
 
+// Compile() builds a search index for the list headed by this capability when
+// the list is long enough to benefit. The list must not change afterwards.
+//
+void                Compile();
+
 XrdAccCapability   *Next() {return next;}
 
 // Privs() searches the associated capability for a prefix matching path. If one
@@ -79,7 +87,7 @@ int                 Subcomp(const char *pathname, const int pathlen,
                   XrdAccCapability(char *pathval, XrdAccPrivCaps &privval);
 
                   XrdAccCapability(XrdAccCapability *taddr)
-                        {next = 0; ctmp = taddr;
+                        {next = 0; ctmp = taddr; cidx = 0;
                          pkey = 0; path = 0; plen = 0; pins = 0; prem = 0;
                         }
 
@@ -87,6 +95,7 @@ int                 Subcomp(const char *pathname, const int pathlen,
 private:
 XrdAccCapability *next;      // -> Next capability
 XrdAccCapability *ctmp;      // -> Capability template
+XrdAccCapIndex   *cidx;      // -> Compiled index of the list (head only)
 
 /*----------- The below fields are valid when template is zero -----------*/
 
@@ -768,6 +768,12 @@ int XrdAccConfig::ConfigDBrec(XrdSysError &Eroute,
        return -1;
       }
 
+   // Compile long lists so that searching them does not depend on their
+   // length. Templates are expanded wherever they are used and the fungible
+   // list is always searched with a substitution, so neither is compiled.
+   //
+   if (!anyuser && rectype != Template_ID) mycap.Next()->Compile();
+
    // Insert the capability into the appropriate table/list
    //
         if (sp) sp->caps = mycap.Next();
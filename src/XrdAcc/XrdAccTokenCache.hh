@@ -0,0 +1,159 @@
+#ifndef __ACC_TOKENCACHE_HH__
+#define __ACC_TOKENCACHE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d A c c T o k e n C a c h e . h h                    */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                      X r d A c c T o k e n C a c h e                       */
+/******************************************************************************/
+
+// This class caches whatever an authorization plugin derives from a token so
+// that the costly work (e.g. signature verification) is done only once while
+// the result remains valid. Items are keyed by a string (the token itself or a
+// token combined with a request) and carry an absolute expiry time in the
+// caller's own clock. The cache is split into independently locked shards so
+// concurrent requests rarely contend. Each shard is bounded; when one fills,
+// expired items are dropped and then those closest to expiring are evicted.
+// Items are handed out as shared pointers so they remain valid after removal.
+//
+template<class T>
+class XrdAccTokenCache
+{
+public:
+
+// Add() inserts or replaces the item associated with key. Items that have
+// already expired are not added.
+//
+void               Add(const std::string &key, const std::shared_ptr<T> &item,
+                       uint64_t expiry, uint64_t now)
+                      {if (expiry <= now) return;
+                       cacheShard &sh = Shard(key);
+                       XrdSysMutexHelper mHelp(sh.mtx);
+                       if (sh.map.size() >= maxPerShard
+                       &&  sh.map.find(key) == sh.map.end()) Trim(sh, now);
+                       sh.map[key] = {item, expiry};
+                      }
+
+// Find() returns the item associated with key or nil if there is none or the
+// item has expired.
+//
+std::shared_ptr<T> Find(const std::string &key, uint64_t now)
+                       {cacheShard &sh = Shard(key);
+                        XrdSysMutexHelper mHelp(sh.mtx);
+                        auto it = sh.map.find(key);
+                        if (it == sh.map.end()) return nullptr;
+                        if (it->second.expiry > now) return it->second.item;
+                        sh.map.erase(it);
+                        return nullptr;
+                       }
+
+// Purge() removes all expired items and returns the number removed.
+//
+int                Purge(uint64_t now)
+                        {int num = 0;
+                         for (int i = 0; i < numShards; i++)
+                             {XrdSysMutexHelper mHelp(shards[i].mtx);
+                              num += Expire(shards[i], now);
+                             }
+                         return num;
+                        }
+
+// Size() returns the number of items in the cache, including expired ones
+// that have not yet been removed.
+//
+size_t             Size()
+                       {size_t num = 0;
+                        for (int i = 0; i < numShards; i++)
+                            {XrdSysMutexHelper mHelp(shards[i].mtx);
+                             num += shards[i].map.size();
+                            }
+                        return num;
+                       }
+
+                   XrdAccTokenCache(int maxItems=16384, int nShards=16)
+                       : numShards(nShards > 0 ? nShards : 1)
+                       {shards = new cacheShard[numShards];
+                        maxPerShard = std::max(maxItems / numShards, 1);
+                       }
+
+                  ~XrdAccTokenCache() {delete [] shards;}
+
+private:
+
+struct cacheEnt
+      {std::shared_ptr<T> item;
+       uint64_t           expiry;
+      };
+
+struct cacheShard
+      {XrdSysMutex                               mtx;
+       std::unordered_map<std::string, cacheEnt> map;
+      };
+
+int         Expire(cacheShard &sh, uint64_t now)
+                  {int num = 0;
+                   for (auto it = sh.map.begin(); it != sh.map.end(); )
+                       {if (it->second.expiry > now) ++it;
+                           else {it = sh.map.erase(it); num++;}
+                       }
+                   return num;
+                  }
+
+cacheShard &Shard(const std::string &key)
+                 {return shards[std::hash<std::string>()(key) % numShards];}
+
+// Trim() makes room in a full shard. When nothing has expired, the quarter of
+// the items that would expire soonest are evicted so that trimming is rare.
+//
+void        Trim(cacheShard &sh, uint64_t now)
+                {if (Expire(sh, now) || sh.map.size() < maxPerShard) return;
+                 std::vector<uint64_t> eVec;
+                 eVec.reserve(sh.map.size());
+                 for (auto &ent : sh.map) eVec.push_back(ent.second.expiry);
+                 size_t n = std::max(eVec.size() / 4, size_t(1)) - 1;
+                 std::nth_element(eVec.begin(), eVec.begin() + n, eVec.end());
+                 Expire(sh, eVec[n]);
+                }
+
+cacheShard *shards;
+int         numShards;
+size_t      maxPerShard;
+};
+#endif
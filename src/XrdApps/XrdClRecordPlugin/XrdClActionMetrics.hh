@@ -37,9 +37,145 @@
 #include <vector>
 #include <numeric>
 #include <regex>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <sstream>
 
 namespace XrdCl
 {
+//------------------------------------------------------------------------------
+//! Latency histogram with log-linear buckets in microseconds: values below 64
+//! are exact, above that every power of two is split into 32 buckets, which
+//! keeps the relative error of a percentile under about 3%
+//------------------------------------------------------------------------------
+struct LatencyHistogram
+{
+  LatencyHistogram()
+  : count(0)
+  , sum(0)
+  , min(std::numeric_limits<uint64_t>::max())
+  , max(0)
+  {
+  }
+
+  //--------------------------------------------------------------------------
+  //! Record a latency given in seconds
+  //--------------------------------------------------------------------------
+  void add(double seconds)
+  {
+    uint64_t usec = seconds > 0 ? (uint64_t)(seconds * 1000000.0) : 0;
+    size_t   idx  = index(usec);
+    if (idx >= buckets.size())
+      buckets.resize(idx + 1, 0);
+    buckets[idx]++;
+    count++;
+    sum += usec;
+    if (usec < min)
+      min = usec;
+    if (usec > max)
+      max = usec;
+  }
+
+  void add(const LatencyHistogram& other)
+  {
+    if (other.buckets.size() > buckets.size())
+      buckets.resize(other.buckets.size(), 0);
+    for (size_t i = 0; i < other.buckets.size(); ++i)
+      buckets[i] += other.buckets[i];
+    count += other.count;
+    sum += other.sum;
+    if (other.min < min)
+      min = other.min;
+    if (other.max > max)
+      max = other.max;
+  }
+
+  //--------------------------------------------------------------------------
+  //! @return : the latency in microseconds below which the given percentage
+  //!           of the samples fall
+  //--------------------------------------------------------------------------
+  uint64_t percentile(double pct) const
+  {
+    if (!count)
+      return 0;
+    uint64_t rank = (uint64_t)std::ceil(pct / 100.0 * count);
+    if (rank < 1)
+      rank = 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i)
+    {
+      seen += buckets[i];
+      if (seen >= rank)
+        return std::min(upper(i), max);
+    }
+    return max;
+  }
+
+  std::string Dump(const std::string& name, bool json) const
+  {
+    static const double pcts[] = { 50, 90, 99, 99.9 };
+    std::stringstream   ss;
+    if (!json)
+    {
+      ss << "# " << std::setw(12) << name << " : n=" << count
+         << " min=" << min << " avg=" << (count ? sum / count : 0);
+      for (auto p : pcts)
+        ss << " p" << p << "=" << percentile(p);
+      ss << " max=" << max << " [us]" << std::endl;
+      return ss.str();
+    }
+
+    ss << "    \"" << name << "\": {" << std::endl;
+    ss << "      \"n\": " << count << "," << std::endl;
+    ss << "      \"min::us\": " << min << "," << std::endl;
+    ss << "      \"avg::us\": " << (count ? sum / count : 0) << "," << std::endl;
+    for (auto p : pcts)
+      ss << "      \"p" << p << "::us\": " << percentile(p) << "," << std::endl;
+    ss << "      \"max::us\": " << max << "," << std::endl;
+    ss << "      \"histogram\": [";
+    bool first = true;
+    for (size_t i = 0; i < buckets.size(); ++i)
+    {
+      if (!buckets[i])
+        continue;
+      ss << (first ? " " : ", ") << "[" << upper(i) << ", " << buckets[i] << "]";
+      first = false;
+    }
+    ss << " ]" << std::endl;
+    ss << "    }";
+    return ss.str();
+  }
+
+  uint64_t count;  //< number of samples
+  uint64_t sum;    //< sum of all samples in microseconds
+  uint64_t min;    //< smallest sample in microseconds
+  uint64_t max;    //< largest sample in microseconds
+
+  private:
+  static const int subbits = 5;  //< 32 buckets per power of two
+  static const int exact   = 64; //< values below are counted exactly
+
+  static size_t index(uint64_t usec)
+  {
+    if (usec < exact)
+      return usec;
+    int e = 63 - __builtin_clzll(usec);
+    return exact + (e - 6) * (1 << subbits) + ((usec >> (e - subbits)) & ((1 << subbits) - 1));
+  }
+
+  static uint64_t upper(size_t idx)
+  {
+    if (idx < (size_t)exact)
+      return idx;
+    int    e   = (idx - exact) / (1 << subbits) + 6;
+    size_t sub = (idx - exact) % (1 << subbits);
+    return (((1 << subbits) + sub + 1) << (e - subbits)) - 1;
+  }
+
+  std::vector<uint64_t> buckets;  //< sample count per bucket
+};
+
 //------------------------------------------------------------------------------
 //! Metrics struct storing all timing and IO information of an action
 //------------------------------------------------------------------------------
@@ -192,6 +328,10 @@ struct ActionMetrics
     // function called from callbacks requires a guard
     std::unique_lock<std::mutex> guard(mtx);
     delays[action + "::" + field] += value;
+    if (field == "tmeas")
+    {
+      latency[action].add(value);
+    }
   }
 
   void addIos(const std::string& action, const std::string& field, double value)
@@ -215,6 +355,10 @@ struct ActionMetrics
     {
       delays[k.first] += k.second;
     }
+    for (auto& k : other.latency)
+    {
+      latency[k.first].add(k.second);
+    }
     errors += other.errors;
 
     auto w1 = other.ios.find("Write::b");
@@ -335,6 +479,7 @@ struct ActionMetrics
 
   std::map<std::string, uint64_t> ios;
   std::map<std::string, double>   delays;
+  std::map<std::string, LatencyHistogram> latency;  //< completion times per operation
   std::mutex                      mtx;  // only required for async callbacks
 };
 }
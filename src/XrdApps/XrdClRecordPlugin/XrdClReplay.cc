@@ -899,7 +899,9 @@ using action_list = std::multimap<double, ActionExecutor>;
 
 //------------------------------------------------------------------------------
 //! Parse input file
-//! @param path : path to the input csv file
+//! @param path    : path to the input csv file
+//! @param clients : number of virtual clients, each one replays the whole
+//!                  file with its own file objects
 //------------------------------------------------------------------------------
 std::unordered_map<File*, action_list> ParseInput(const std::string&                      path,
                                                   double&                                 t0,
@@ -907,19 +909,15 @@ std::unordered_map<File*, action_list> ParseInput(const std::string&
                                                   std::unordered_map<File*, std::string>& filenames,
                                                   std::unordered_map<File*, double>& synchronicity,
                                                   std::unordered_map<File*, size_t>& responseerrors,
-                                                  const std::vector<std::string>&    option_regex)
+                                                  const std::vector<std::string>&    option_regex,
+                                                  int                                clients)
 {
   std::unordered_map<File*, action_list> result;
   std::unique_ptr<std::ifstream>        fin( path.empty() ? nullptr : new std::ifstream( path, std::ifstream::in ) );
   std::istream                          &input = path.empty() ? std::cin : *fin;
   std::string                            line;
-  std::unordered_map<uint64_t, File*>    files;
-  std::unordered_map<uint64_t, double>   last_stop;
-  std::unordered_map<uint64_t, double>   overlaps;
-  std::unordered_map<uint64_t, double>   overlaps_cnt;
+  std::vector<std::vector<std::string>>  rows;
 
-  t0 = 10e99;
-  t1 = 0;
   while (input.good())
   {
     std::getline(input, line);
@@ -932,81 +930,106 @@ std::unordered_map<File*, action_list> ParseInput(const std::string&
     {
       throw std::invalid_argument("Invalid input file format.");
     }
+    rows.emplace_back(std::move(tokens));
+  }
+
+  std::vector<std::pair<std::regex, std::string>> replacements;
+  for (auto& v : option_regex)
+  {
+    std::vector<std::string> tokens;
+    Utils::splitString(tokens, v, ":=");
+    if (tokens.size() != 2)
+    {
+      std::cerr
+        << "Error: invalid regex for argument replacement - must be format like <oldstring>:=<newstring>"
+        << std::endl;
+      exit(EINVAL);
+    }
+    replacements.emplace_back(std::regex(tokens[0]), tokens[1]);
+  }
+
+  t0 = 10e99;
+  t1 = 0;
+  for (int client = 0; client < clients; ++client)
+  {
+    //--------------------------------------------------------------------------
+    // Every virtual client gets its own set of files and may have its paths
+    // rewritten using the {client} placeholder
+    //--------------------------------------------------------------------------
+    std::vector<std::pair<std::regex, std::string>> rewrite(replacements);
+    for (auto& r : rewrite)
+    {
+      size_t pos;
+      while ((pos = r.second.find("{client}")) != std::string::npos)
+        r.second.replace(pos, 8, std::to_string(client));
+    }
 
-    uint64_t    id     = std::stoull(tokens[0]);  // file object ID
-    std::string action = tokens[1];               // action name (e.g. Open)
-    double      start  = std::stod(tokens[2]);    // start time
-    std::string args   = tokens[3];               // operation arguments
-    double      stop   = std::stod(tokens[4]);    // stop time
-    std::string status = tokens[5];               // operation status
-    std::string resp   = tokens[6];               // server response
+    std::unordered_map<uint64_t, File*>    files;
+    std::unordered_map<uint64_t, double>   last_stop;
+    std::unordered_map<uint64_t, double>   overlaps;
+    std::unordered_map<uint64_t, double>   overlaps_cnt;
 
-    if (option_regex.size())
+    for (auto& tokens : rows)
     {
-      for (auto& v : option_regex)
+      uint64_t    id     = std::stoull(tokens[0]);  // file object ID
+      std::string action = tokens[1];               // action name (e.g. Open)
+      double      start  = std::stod(tokens[2]);    // start time
+      std::string args   = tokens[3];               // operation arguments
+      double      stop   = std::stod(tokens[4]);    // stop time
+      std::string status = tokens[5];               // operation status
+      std::string resp   = tokens[6];               // server response
+
+      for (auto& r : rewrite)
       {
-        std::vector<std::string> tokens;
-        Utils::splitString(tokens, v, ":=");
-        std::regex src(tokens[0]);
-        if (tokens.size() != 2)
-        {
-          std::cerr
-            << "Error: invalid regex for argument replacement - must be format like <oldstring>:=<newstring>"
-            << std::endl;
-          exit(EINVAL);
-        }
-        else
+        // write the results to an output iterator
+        args = std::regex_replace(args, r.first, r.second);
+      }
+
+      if (start < t0)
+        t0 = start;
+      if (stop > t1)
+        t1 = stop;
+
+      if (!files.count(id))
+      {
+        files[id] = new File(false);
+        files[id]->SetProperty("BundledClose", "true");
+        filenames[files[id]] = args;
+        filenames[files[id]].erase(args.find(";"));
+        overlaps[id]     = 0;
+        overlaps_cnt[id] = 0;
+        last_stop[id]    = stop;
+      }
+      else
+      {
+        overlaps_cnt[id]++;
+        if (start > last_stop[id])
         {
-          // write the results to an output iterator
-          args = std::regex_replace(args, src, tokens[1]);
+          overlaps[id]++;
         }
+        last_stop[id] = stop;
       }
-    }
 
-    if (start < t0)
-      t0 = start;
-    if (stop > t1)
-      t1 = stop;
+      last_stop[id]           = stop;
+      double nominal_duration = stop - start;
 
-    if (!files.count(id))
-    {
-      files[id] = new File(false);
-      files[id]->SetProperty("BundledClose", "true");
-      filenames[files[id]] = args;
-      filenames[files[id]].erase(args.find(";"));
-      overlaps[id]     = 0;
-      overlaps_cnt[id] = 0;
-      last_stop[id]    = stop;
-    }
-    else
-    {
-      overlaps_cnt[id]++;
-      if (start > last_stop[id])
+      if (status != "[SUCCESS]")
+      {
+        responseerrors[files[id]]++;
+      }
+      else
       {
-        overlaps[id]++;
+        result[files[id]].emplace(
+          start, ActionExecutor(*files[id], action, args, status, resp, nominal_duration));
       }
-      last_stop[id] = stop;
     }
 
-    last_stop[id]           = stop;
-    double nominal_duration = stop - start;
-
-    if (status != "[SUCCESS]")
-    {
-      responseerrors[files[id]]++;
-    }
-    else
+    for (auto& it : overlaps)
     {
-      result[files[id]].emplace(
-        start, ActionExecutor(*files[id], action, args, status, resp, nominal_duration));
+      // compute the synchronicity of requests
+      synchronicity[files[it.first]] = 100.0 * (it.second / overlaps_cnt[it.first]);
     }
   }
-
-  for (auto& it : overlaps)
-  {
-    // compute the synchronicity of requests
-    synchronicity[files[it.first]] = 100.0 * (it.second / overlaps_cnt[it.first]);
-  }
   return result;
 }
 
@@ -1015,12 +1038,18 @@ std::unordered_map<File*, action_list> ParseInput(const std::string&
 //! @param file    : the file object
 //! @param actions : list of actions to be executed
 //! @param t0      : offset to add to each start time to determine when to ru an action
+//! @param tsample : recorded start time of the whole sample, the schedule is
+//!                  compressed or stretched by the speed factor relative to it
+//! @param closed  : closed loop, i.e. wait for each action to complete and
+//!                  only keep the recorded think time before the next one
 //! @return        : thread that will executed the list of actions
 //------------------------------------------------------------------------------
 std::thread ExecuteActions(std::unique_ptr<File> file,
                            action_list&&         actions,
                            double                t0,
+                           double                tsample,
                            double                speed,
+                           bool                  closed,
                            ActionMetrics&        metric,
                            bool                  simulate)
 {
@@ -1028,33 +1057,56 @@ std::thread ExecuteActions(std::unique_ptr<File> file,
     [file{ std::move(file) },
      actions{ std::move(actions) },
      t0,
+     tsample,
      &metric,
      simulate,
-     &speed]() mutable
+     closed,
+     speed]() mutable
     {
       XrdSysSemaphore endsem(0);
       XrdSysSemaphore closesem(0);
       auto            ending  = std::make_shared<barrier_t>(endsem);
       auto            closing = std::make_shared<barrier_t>(closesem);
+      double          laststop = 0;
 
       for (auto& p : actions)
       {
         auto& action = p.second;
 
-        auto tdelay = t0 ? ((p.first + t0) - XrdCl::Action::timeNow()) : 0;
-        if (tdelay > 0)
+        if (closed && laststop)
         {
-          tdelay /= speed;
-          metric.delays[action.Name() + "::tloss"] += tdelay;
-	  std::this_thread::sleep_for(std::chrono::milliseconds((int) (tdelay * 1000)));
+          // keep the think time between the end of the previous action and
+          // the start of this one
+          double tthink = (p.first - laststop) / speed;
+          if (tthink > 0 && t0)
+            std::this_thread::sleep_for(std::chrono::milliseconds((int) (tthink * 1000)));
         }
         else
         {
-          metric.delays[action.Name() + "::tgain"] += tdelay;
+          auto tdelay = t0 ? ((tsample + t0 + (p.first - tsample) / speed) - XrdCl::Action::timeNow()) : 0;
+          if (tdelay > 0)
+          {
+            metric.delays[action.Name() + "::tloss"] += tdelay;
+            std::this_thread::sleep_for(std::chrono::milliseconds((int) (tdelay * 1000)));
+          }
+          else
+          {
+            metric.delays[action.Name() + "::tgain"] += tdelay;
+          }
         }
+        laststop = p.first + action.NominalDuration();
 
         mytimer_t timer;
-        action.Execute(ending, closing, metric, simulate);
+        if (closed)
+        {
+          XrdSysSemaphore stepsem(0);
+          auto            step = std::make_shared<barrier_t>(stepsem);
+          action.Execute(step, closing, metric, simulate);
+          step.reset();
+          stepsem.Wait();
+        }
+        else
+          action.Execute(ending, closing, metric, simulate);
         metric.addDelays(action.Name(), "tnomi", action.NominalDuration());
         metric.addDelays(action.Name(), "texec", timer.elapsed());
       }
@@ -1123,7 +1175,8 @@ int main(int argc, char** argv)
                                      filenames,
                                      synchronicity,
                                      responseerrors,
-                                     opt.regex());  // parse the input file
+                                     opt.regex(),
+                                     opt.clients());  // parse the input file
     std::vector<std::thread>                               threads;
     std::unordered_map<XrdCl::File*, XrdCl::ActionMetrics> metrics;
     threads.reserve(actions.size());
@@ -1164,7 +1217,9 @@ int main(int argc, char** argv)
       threads.emplace_back(ExecuteActions(std::unique_ptr<XrdCl::File>(action.first),
                                           std::move(action.second),
                                           toffset,
+                                          t0,
                                           opt.speed(),
+                                          opt.closedloop(),
                                           metrics[action.first],
                                           opt.print()));
     }
@@ -1208,6 +1263,9 @@ int main(int argc, char** argv)
           std::cout << "    \"player::runtime\": " << tbench << "," << std::endl;
         }
         std::cout << "    \"player::speed\": " << opt.speed() << "," << std::endl;
+        std::cout << "    \"player::clients\": " << opt.clients() << "," << std::endl;
+        std::cout << "    \"player::pacing\": \"" << (opt.closedloop() ? "closed" : "open")
+                  << "\"," << std::endl;
         std::cout << "    \"sampled::runtime\": " << t1 - t0 << "," << std::endl;
         std::cout << "    \"volume::totalread\": " << summetric.getBytesRead() << "," << std::endl;
         std::cout << "    \"volume::totalwrite\": " << summetric.getBytesWritten() << ","
@@ -1241,19 +1299,35 @@ int main(int argc, char** argv)
           std::cout << "    \"performancemark\": " << (100.0 * (t1 - t0) / tbench) << ","
                     << std::endl;
           std::cout << "    \"gain::read\":"
-                    << (100.0 * summetric.delays["Read::tnomi"] / summetric.delays["Read::tmeas"])
+                    << (summetric.delays["Read::tmeas"] ?
+                        100.0 * summetric.delays["Read::tnomi"] / summetric.delays["Read::tmeas"] : 0)
                     << "," << std::endl;
           std::cout << "    \"gain::write\":"
-                    << (100.0 * summetric.delays["Write::tnomi"] / summetric.delays["Write::tmeas"])
-                    << std::endl;
+                    << (summetric.delays["Write::tmeas"] ?
+                        100.0 * summetric.delays["Write::tnomi"] / summetric.delays["Write::tmeas"] : 0)
+                    << "," << std::endl;
         }
         std::cout << "    \"synchronicity::read\":"
                   << summetric.aggregated_synchronicity.ReadSynchronicity() << "," << std::endl;
         std::cout << "    \"synchronicity::write\":"
                   << summetric.aggregated_synchronicity.WriteSynchronicity() << "," << std::endl;
         std::cout << "    \"response::error:\":" << summetric.ios["All::e"] << std::endl;
-        std::cout << "  }" << std::endl;
-        std::cout << "}" << std::endl;
+        std::cout << "  }";
+        if (!opt.print())
+        {
+          // completion time percentiles and histograms per operation
+          std::cout << "," << std::endl << "  \"latency\": {" << std::endl;
+          bool first = true;
+          for (auto& l : summetric.latency)
+          {
+            std::string key = l.first;
+            std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+            std::cout << (first ? "" : ",\n") << l.second.Dump(key, true);
+            first = false;
+          }
+          std::cout << std::endl << "  }";
+        }
+        std::cout << std::endl << "}" << std::endl;
       }
     }
     else
@@ -1271,6 +1345,12 @@ int main(int argc, char** argv)
       std::cout << "# Sampled Runtime  : " << std::fixed << t1 - t0 << " s" << std::endl;
       std::cout << "# Playback Speed   : " << std::fixed << std::setprecision(2) << opt.speed()
                 << std::endl;
+      if (opt.clients() > 1 || opt.closedloop())
+      {
+        std::cout << "# Clients          : " << opt.clients() << std::endl;
+        std::cout << "# Pacing           : " << (opt.closedloop() ? "closed" : "open")
+                  << " loop" << std::endl;
+      }
       std::cout << "# IO Volume (R)    : " << std::fixed
                 << XrdCl::ActionMetrics::humanreadable(summetric.getBytesRead())
                 << " [ std:" << XrdCl::ActionMetrics::humanreadable(summetric.ios["Read::b"])
@@ -1326,6 +1406,15 @@ int main(int argc, char** argv)
       {
         std::cout << "# ---------------------------------------------" << std::endl;
         std::cout << "# Response Errors  : " << std::fixed << summetric.ios["All::e"] << std::endl;
+        std::cout << "# ---------------------------------------------" << std::endl;
+        std::cout << "# Latency" << std::endl;
+        std::cout << "# ---------------------------------------------" << std::endl;
+        for (auto& l : summetric.latency)
+        {
+          std::string key = l.first;
+          std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+          std::cout << l.second.Dump(key, false);
+        }
         std::cout << "# =============================================" << std::endl;
         if (summetric.ios["All::e"])
         {
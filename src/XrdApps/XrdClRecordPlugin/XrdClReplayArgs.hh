@@ -45,6 +45,8 @@ class ReplayArgs
   , option_suppress_error(false)
   , option_verify(false)
   , option_speed(1.0)
+  , option_clients(1)
+  , option_closedloop(false)
   {
     while (1)
     {
@@ -55,9 +57,10 @@ class ReplayArgs
             { "long", no_argument, 0, 'l' },        { "json", no_argument, 0, 'j' },
             { "summary", no_argument, 0, 's' },     { "replace", required_argument, 0, 'r' },
             { "suppress", no_argument, 0, 'f' },    { "verify", no_argument, 0, 'v' },
-            { "speed", required_argument, 0, 'x' }, { 0, 0, 0, 0 } };
+            { "speed", required_argument, 0, 'x' }, { "clients", required_argument, 0, 'n' },
+            { "pacing", required_argument, 0, 'P' }, { 0, 0, 0, 0 } };
 
-      int c = getopt_long(argc, argv, "vjpctshlfr:x:", long_options, &option_index);
+      int c = getopt_long(argc, argv, "vjpctshlfr:x:n:P:", long_options, &option_index);
       if (c == -1)
         break;
 
@@ -106,6 +109,23 @@ class ReplayArgs
           }
           break;
 
+        case 'n':
+          option_clients = std::strtol(optarg, 0, 10);
+          if (option_clients <= 0)
+          {
+            usage();
+          }
+          break;
+
+        case 'P':
+          if (std::string(optarg) == "closed")
+            option_closedloop = true;
+          else if (std::string(optarg) == "open")
+            option_closedloop = false;
+          else
+            usage();
+          break;
+
         case 'r':
           option_regex.push_back(optarg);
           break;
@@ -144,7 +164,7 @@ class ReplayArgs
   void usage()
   {
     std::cerr
-      << "usage: xrdreplay [-p|--print] [-c|--create-data] [t|--truncate-data] [-l|--long] [-s|--summary] [-h|--help] [-r|--replace <arg>:=<newarg>] [-f|--suppress] [-v|--verify] [-x|--speed <value] p<recordfilename>]\n"
+      << "usage: xrdreplay [-p|--print] [-c|--create-data] [t|--truncate-data] [-l|--long] [-s|--summary] [-h|--help] [-r|--replace <arg>:=<newarg>] [-f|--suppress] [-v|--verify] [-x|--speed <value] [-n|--clients <n>] [-P|--pacing open|closed] p<recordfilename>]\n"
       << std::endl;
     std::cerr << "                -h | --help             : show this help" << std::endl;
     std::cerr
@@ -168,12 +188,24 @@ class ReplayArgs
     std::cerr
       << "                -x | --speed <x>        : change playback speed by factor <x> [ <x> > 0.0 ]"
       << std::endl;
+    std::cerr
+      << "                -n | --clients <n>      : replay the record file with <n> concurrent virtual clients"
+      << std::endl;
+    std::cerr
+      << "                -P | --pacing <mode>    : open  - submit each IO at its recorded time (default)"
+      << std::endl;
+    std::cerr
+      << "                                          closed - submit each IO once the previous one of the same file completed"
+      << std::endl;
     std::cerr
       << "                -r | --replace <a>:=<b> : replace in the argument list the string <a> with <b> "
       << std::endl;
     std::cerr
       << "                                          - option is usable several times e.g. to change storage prefixes or filenames"
       << std::endl;
+    std::cerr
+      << "                                          - {client} in <b> is replaced by the index of the virtual client"
+      << std::endl;
     std::cerr << std::endl;
     std::cerr
       << "             [recordfilename]          : if a file is given, it will be used as record input otherwise STDIN is used to read records!"
@@ -194,6 +226,8 @@ class ReplayArgs
   bool                      suppress_error() { return option_suppress_error; }
   bool                      verify() { return option_verify; }
   double                    speed() { return option_speed; }
+  int                       clients() { return option_clients; }
+  bool                      closedloop() { return option_closedloop; }
   std::vector<std::string>& regex() { return option_regex; }
   std::string&              path() { return _path; }
 
@@ -207,6 +241,8 @@ class ReplayArgs
   bool                     option_suppress_error;
   bool                     option_verify;
   double                   option_speed;
+  int                      option_clients;
+  bool                     option_closedloop;
   std::vector<std::string> option_regex;
   std::string              _path;
 };
@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+#include <sys/types.h> 
+#include "XrdCephBufferAlgReadAhead.hh"
+
+#include "../XrdCephPosix.hh"
+#include <algorithm>
+#include <iostream>
+
+
+using namespace XrdCephBuffer;
+
+
+XrdCephBufferAlgReadAhead::XrdCephBufferAlgReadAhead(std::unique_ptr<IXrdCephBufferData> buffer, 
+                                                     std::unique_ptr<ICephIOAdapter> cephio, int fd,
+                                                     bool useStriperlessReads, size_t minWindow):
+XrdCephBufferAlgSimple(std::move(buffer), std::move(cephio), fd, useStriperlessReads),
+m_minWindow(minWindow), m_window(minWindow) {
+    // the window can never be larger than the buffer itself
+    m_minWindow = std::max<size_t>(1, std::min(m_minWindow, m_bufferdata->capacity()));
+    m_window = m_minWindow;
+}
+
+XrdCephBufferAlgReadAhead::~XrdCephBufferAlgReadAhead() {
+    BUFLOG("XrdCephBufferAlgReadAhead::Destructor, fd=" << m_fd 
+            << ", fills="  << m_stats_fills 
+            << ", sequential_fills=" << m_stats_seqfills
+            << ", last_window=" << m_window);
+}
+
+
+size_t XrdCephBufferAlgReadAhead::nextWindow(off_t fillOffset) {
+    ++m_stats_fills;
+    if (m_bufferLength > 0 && fillOffset == (off_t)(m_bufferStartingOffset + m_bufferLength)) {
+        // carrying on from where the last fill ended; read further ahead
+        ++m_stats_seqfills;
+        m_window = std::min(m_window * 2, m_bufferdata->capacity());
+    } else {
+        m_window = m_minWindow;
+    }
+    return m_window;
+}
+
+
+ssize_t XrdCephBufferAlgReadAhead::read(volatile void *buf,   off_t offset, size_t blen)  {
+    const std::lock_guard<std::recursive_mutex> lock(m_data_mutex);
+
+    if (blen == 0) return 0;
+
+    /**
+     * Reads larger than the buffer bypass it, as in the simple algorithm.
+     * This also means a random access pattern, so reset the window.
+     */
+    if (blen >= m_bufferdata->capacity()) {
+        m_window = m_minWindow;
+        return XrdCephBufferAlgSimple::read(buf, offset, blen);
+    }
+
+    ssize_t rc(-1);
+    size_t bytesRemaining = blen; // track how many bytes still need to be read
+    off_t offsetDelta = 0;
+    size_t bytesRead = 0;
+
+    while (bytesRemaining > 0) { 
+        const off_t pos = offset + offsetDelta;
+        bool loadCache = (m_bufferLength == 0) 
+                         || (pos < m_bufferStartingOffset) 
+                         || (pos >= (off_t) (m_bufferStartingOffset + m_bufferLength));
+
+        if (loadCache) {
+            // a fill must at least cover what is left of this request
+            size_t fillLength = std::max(nextWindow(pos), bytesRemaining);
+            fillLength = std::min(fillLength, m_bufferdata->capacity());
+
+            m_bufferdata->invalidate();
+            m_bufferLength = 0;
+            rc = m_cephio->read(pos, fillLength);
+            if (rc < 0) {
+                BUFLOG("XrdCephBufferAlgReadAhead: LoadCache Error: " << rc);
+                return rc;
+            }
+            m_stats_bytes_fromceph += rc;
+            m_bufferStartingOffset = pos;
+            m_bufferLength = rc;
+            if (rc == 0) {
+                // end of file
+                break;
+            }
+        }
+
+        off_t bufPosition = pos - m_bufferStartingOffset; 
+        rc =  m_bufferdata->readBuffer( (void*) &(((char*)buf)[offsetDelta]) , bufPosition , bytesRemaining);
+        if (rc < 0 ) {
+            BUFLOG("XrdCephBufferAlgReadAhead: Reading from Cache Failed: " << rc << "  " << offset << " " 
+                    << offsetDelta << "  " << m_bufferStartingOffset << " " 
+                    << bufPosition << " " 
+                    << bytesRemaining );
+            return rc;
+        }
+        if (rc == 0) {
+            break;
+        }
+        m_stats_bytes_toclient += rc;
+        offsetDelta    += rc; 
+        bytesRemaining -= rc;
+        bytesRead      += rc;
+    } // while bytesremaing
+
+    return bytesRead;
+}
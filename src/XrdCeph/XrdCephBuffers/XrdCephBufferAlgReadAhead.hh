@@ -0,0 +1,43 @@
+#ifndef __XRD_CEPH_BUFFER_ALG_READAHEAD_HH__
+#define __XRD_CEPH_BUFFER_ALG_READAHEAD_HH__
+//------------------------------------------------------------------------------
+// Buffer algorithm with a readahead window adapting to the access pattern
+//------------------------------------------------------------------------------
+
+#include <sys/types.h> 
+
+#include "XrdCephBufferAlgSimple.hh"
+
+
+namespace XrdCephBuffer {
+
+/** Variant of the simple buffering algorithm for reads, where the amount of data fetched
+ * on a buffer miss is not always the full buffer capacity.
+ * The fill starts with a small window; each time a refill directly continues the data
+ * previously held (i.e. the client is reading sequentially) the window is doubled, up to
+ * the capacity of the buffer. A refill anywhere else (random access) resets the window
+ * to its minimum, so that sparse readers do not pay for large fills that will be discarded.
+ * Writes are handled exactly as in XrdCephBufferAlgSimple.
+ */
+
+class XrdCephBufferAlgReadAhead : public XrdCephBufferAlgSimple {
+    public:
+        XrdCephBufferAlgReadAhead(std::unique_ptr<IXrdCephBufferData> buffer, std::unique_ptr<ICephIOAdapter> cephio, int fd,
+                                  bool useStriperlessReads = true, size_t minWindow = 1024*1024 ); 
+        virtual ~XrdCephBufferAlgReadAhead();
+
+        virtual ssize_t read (volatile void *buff, off_t offset, size_t blen) override;
+
+    protected:
+        size_t nextWindow(off_t fillOffset); //!< choose the size of the next fill, starting at fillOffset
+
+        size_t m_minWindow;  //!< smallest fill size
+        size_t m_window;     //!< current fill size
+
+        long m_stats_fills{0};      //! number of buffer fills
+        long m_stats_seqfills{0};   //! number of those that continued a sequential stream
+};  
+
+}
+
+#endif 
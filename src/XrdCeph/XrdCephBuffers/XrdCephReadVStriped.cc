@@ -0,0 +1,68 @@
+
+#include "XrdCephReadVStriped.hh"
+#include "BufferUtils.hh"
+
+using namespace XrdCephBuffer;
+
+
+XrdCephReadVStriped::XrdCephReadVStriped(size_t objectSize, size_t maxGap) :
+m_objectSize(objectSize > 0 ? objectSize : 4*1024*1024), m_maxGap(maxGap) {
+
+}
+
+XrdCephReadVStriped::~XrdCephReadVStriped() {
+
+    size_t totalBytes = m_usedBytes + m_wastedBytes;
+    float goodFrac_pct = totalBytes > 0 ? (100.*m_usedBytes)/totalBytes : 0;
+    BUFLOG("XrdCephReadVStriped: Summary: "
+            << " Used: " <<  m_usedBytes << " Wasted: " << m_wastedBytes << " goodFrac: "
+            << goodFrac_pct << " chunks_in: " << m_nInput << " reads_out: " << m_nOutput
+            );
+}
+
+std::vector<ExtentHolder> XrdCephReadVStriped::convert(const ExtentHolder &extentsHolderInput)
+{
+    std::vector<ExtentHolder> outputs;
+
+    const ExtentContainer &extentsIn = extentsHolderInput.extents();
+    if (extentsIn.empty()) return outputs;
+
+    size_t usedBytes(0);
+    size_t wastedBytes(0);
+
+    ExtentHolder tmp;
+    off_t objStart = 0; // first byte of the object the current holder lives in
+    for (ExtentContainer::const_iterator it = extentsIn.begin(); it != extentsIn.end(); ++it) {
+        bool merge = !tmp.empty();
+        if (merge) {
+            // only go forwards; an out of order or overlapping chunk starts a new read
+            if (it->begin() < tmp.end()) merge = false;
+            else if ((size_t)(it->begin() - tmp.end()) > m_maxGap) merge = false;
+            // never let a read cross into the next object
+            else if (it->end() > objStart + (off_t)m_objectSize) merge = false;
+        }
+        if (!merge) {
+            if (!tmp.empty()) {
+                usedBytes += tmp.bytesContained();
+                wastedBytes += tmp.bytesMissing();
+                outputs.push_back(tmp);
+                tmp = ExtentHolder();
+            }
+            objStart = it->begin() - (it->begin() % m_objectSize);
+        }
+        tmp.push_back(*it);
+    }
+    usedBytes += tmp.bytesContained();
+    wastedBytes += tmp.bytesMissing();
+    outputs.push_back(tmp);
+
+    m_usedBytes += usedBytes;
+    m_wastedBytes += wastedBytes;
+    m_nInput += extentsIn.size();
+    m_nOutput += outputs.size();
+    BUFLOG("XrdCephReadVStriped: In size: " << extentsHolderInput.size() << " "
+            << outputs.size() << " "
+            << " useful bytes: " << usedBytes << " wasted bytes:" << wastedBytes);
+
+    return outputs;
+} // convert
@@ -0,0 +1,48 @@
+#ifndef __IXRD_CEPH_READV_STRIPED_HH__
+#define __IXRD_CEPH_READV_STRIPED_HH__
+//------------------------------------------------------------------------------
+// ReadV adapter that is aware of the rados striper object layout
+//------------------------------------------------------------------------------
+
+#include <sys/types.h>
+#include <vector>
+
+#include "BufferUtils.hh"
+#include "IXrdCephReadVAdapter.hh"
+
+namespace XrdCephBuffer
+{
+
+    /**
+     * @brief Combine requests into single reads per underlying ceph object.
+     * Consecutive chunks are merged while they stay inside the same stripe object and the hole
+     * between them is no larger than the maximum gap; a merged read never crosses an object boundary,
+     * so that each output holder maps onto exactly one rados read operation.
+     * The order of the input extents is preserved, as the caller unravels the results in order.
+     * The resulting holders are intended to be submitted together (see XrdCephOssReadVFile::ReadV)
+     * so that the reads on the different objects run in parallel.
+     */
+
+
+    class XrdCephReadVStriped : virtual public IXrdCephReadVAdapter {
+    public:
+        explicit XrdCephReadVStriped(size_t objectSize = 4*1024*1024, size_t maxGap = 512*1024);
+        virtual ~XrdCephReadVStriped();
+
+    virtual std::vector<ExtentHolder> convert(const ExtentHolder &extentsHolderInput) override;
+
+    protected:
+        size_t m_objectSize; //!< size of each rados object of the striped file
+        size_t m_maxGap;     //!< largest hole between two chunks that is still read through
+
+    private:
+        size_t m_usedBytes = 0;
+        size_t m_wastedBytes = 0;
+        size_t m_nInput = 0;
+        size_t m_nOutput = 0;
+
+    };
+
+}
+
+#endif
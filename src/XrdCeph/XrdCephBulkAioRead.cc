@@ -1,18 +1,20 @@
 #include "XrdCephBulkAioRead.hh"
 
 
-bulkAioRead::bulkAioRead(librados::IoCtx* ct, logfunc_pointer logwrapper, CephFileRef* fileref) {
+bulkAioRead::bulkAioRead(librados::IoCtx* ct, logfunc_pointer logwrapper, CephFileRef* fileref, size_t max_inflight) {
   /**
    * Constructor.
    *
    * @param ct                Rados IoContext object
    * @param logfunc_pointer   Pointer to the function that will be used for logging
    * @param fileref           Ceph file reference
+   * @param max_inflight      Maximum number of object reads submitted at once (0 -- no limit)
    *
    */
   context = ct;
   file_ref = fileref;
   log_func = logwrapper;
+  max_in_flight = max_inflight;
 }
 
 bulkAioRead::~bulkAioRead() {
@@ -61,18 +63,53 @@ int bulkAioRead::addRequest(size_t obj_idx, char* out_buf, size_t size, off64_t
   return 0;
 }
 
+int bulkAioRead::wait_for_one(std::map<size_t, CephOpData>::iterator &op_it) {
+  /**
+   * Wait for the completion of a single submitted object read. Private method.
+   *
+   * @param op_it  iterator to the operation to wait for
+   *
+   * @return  zero on success, negative error code on failure
+   *
+   */
+  op_it->second.cmpl.wait_for_complete();
+  int rval = op_it->second.cmpl.get_return_value();
+  /*
+   * Optimization is possible here: cancel all remaining read operations after the failure.
+   * One way to do so is the following: add context as an argument to the `use` method of CmplPtr.
+   * Then inside the class this pointer can be saved and used by the destructor to call
+   * `aio_cancel` (and probably `wait_for_complete`) before releasing the completion.
+   * Though one need to clarify whether it is necessary to cal `wait_for_complete` after
+   * `aio_cancel` (i.e. may the status variable/bufferlist still be written to or not).
+   */
+  if (rval < 0) {
+    log_func((char*)"Read of the object %ld for file %s failed", op_it->first, file_ref->name.c_str());
+    return rval;
+  }
+  return 0;
+}
+
 int bulkAioRead::submit_and_wait_for_complete() {
   /**
    * Submit previously prepared read requests and wait for their completion
    *
    * To prepare read requests use `read` or `addRequest` methods.
    *
+   * Requests are sent for all objects concurrently. If a depth limit was given to the
+   * constructor, no more than that many object reads are outstanding at any time: once
+   * the limit is reached, the oldest read is waited for before the next one is submitted.
+   * This keeps a very large readv from flooding the OSDs while still overlapping the
+   * latency of the individual objects.
+   *
    * @return  zero on success, negative error code on failure
    *
    */
 
-  for (auto &op_data: operations) {
-    size_t obj_idx = op_data.first;
+  std::deque<std::map<size_t, CephOpData>::iterator> in_flight;
+  int rc;
+
+  for (auto op_it = operations.begin(); op_it != operations.end(); ++op_it) {
+    size_t obj_idx = op_it->first;
     //16 bytes for object hex number, 1 for dot and 1 for null-terminator
     char object_suffix[18];
     int sp_bytes_written;
@@ -89,23 +126,22 @@ int bulkAioRead::submit_and_wait_for_complete() {
       log_func((char*)"Can not create object string for file %s)", file_ref->name.c_str());
       return -ENOMEM;
     }
-    context->aio_operate(obj_name, op_data.second.cmpl.use(), &op_data.second.ceph_read_op, 0);
+
+    if (max_in_flight > 0 && in_flight.size() >= max_in_flight) {
+      rc = wait_for_one(in_flight.front());
+      if (rc < 0) {
+        return rc;
+      }
+      in_flight.pop_front();
+    }
+    context->aio_operate(obj_name, op_it->second.cmpl.use(), &op_it->second.ceph_read_op, 0);
+    in_flight.push_back(op_it);
   }
 
-  for (auto &op_data: operations) {
-    op_data.second.cmpl.wait_for_complete();
-    int rval = op_data.second.cmpl.get_return_value();
-    /*
-     * Optimization is possible here: cancel all remaining read operations after the failure.
-     * One way to do so is the following: add context as an argument to the `use` method of CmplPtr.
-     * Then inside the class this pointer can be saved and used by the destructor to call
-     * `aio_cancel` (and probably `wait_for_complete`) before releasing the completion.
-     * Though one need to clarify whether it is necessary to cal `wait_for_complete` after
-     * `aio_cancel` (i.e. may the status variable/bufferlist still be written to or not).
-     */
-    if (rval < 0) {
-      log_func((char*)"Read of the object %ld for file %s failed", op_data.first, file_ref->name.c_str());
-      return rval;
+  for (auto &op_it: in_flight) {
+    rc = wait_for_one(op_it);
+    if (rc < 0) {
+      return rc;
     }
   }
   return 0;
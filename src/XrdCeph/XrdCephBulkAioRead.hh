@@ -2,6 +2,7 @@
 #include <map>
 #include <list>
 #include <tuple>
+#include <deque>
 #include <rados/librados.hpp>
 
 #include "XrdCephPosix.hh"
@@ -25,7 +26,7 @@ class bulkAioRead {
    * (i.e. something like `bulkAioRead rop = bulkAioRead(...);` will not work, use `bulkAioRead rop(...);` instead).
    */ 
   public:
-  bulkAioRead(librados::IoCtx* ct, logfunc_pointer ptr, CephFileRef* fileref);
+  bulkAioRead(librados::IoCtx* ct, logfunc_pointer ptr, CephFileRef* fileref, size_t max_inflight = 0);
   ~bulkAioRead();
 
   void clear();
@@ -82,6 +83,7 @@ class bulkAioRead {
   
 
   int addRequest(size_t obj_idx, char *out_buf, size_t size, off64_t offset);
+  int wait_for_one(std::map<size_t, CephOpData>::iterator &op_it);
   librados::IoCtx* context;
   std::list<ReadOpData> buffers;
 
@@ -90,4 +92,6 @@ class bulkAioRead {
 
   logfunc_pointer log_func; 
   CephFileRef* file_ref;
+  //Maximum number of object reads in flight at the same time, 0 means no limit
+  size_t max_in_flight;
 };
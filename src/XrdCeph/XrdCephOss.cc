@@ -164,6 +164,7 @@ XrdCephOss::~XrdCephOss() {
 // declared and used in XrdCephPosix.cc
 extern unsigned int g_maxCephPoolIdx;
 extern unsigned int g_cephAioWaitThresh;
+extern unsigned int g_cephAioMaxInFlight;
 
 int XrdCephOss::Configure(const char *configfn, XrdSysError &Eroute) {
    int NoGo = 0;
@@ -259,6 +260,22 @@ int XrdCephOss::Configure(const char *configfn, XrdSysError &Eroute) {
            return 1; 
          }
        }
+
+       if (!strncmp(var, "ceph.aiomaxinflight", 20)) {
+         var = Config.GetWord();
+         if (var) {
+           char* endptr;
+           unsigned long value = strtoul(var, &endptr, 10);
+           if ((var != endptr) && (value < INT_MAX)) {
+             g_cephAioMaxInFlight = value;
+           } else {
+             Eroute.Emsg("Config", "Invalid value for ceph.aiomaxinflight:", var);
+           }
+         } else {
+           Eroute.Emsg("Config", "Missing value for ceph.aiomaxinflight in config file");
+           return 1;
+         }
+       }
      
         if (!strncmp(var, "ceph.usebuffer", 14)) { // allowable values: 0, 1
          var = Config.GetWord();
@@ -354,6 +371,19 @@ int XrdCephOss::Configure(const char *configfn, XrdSysError &Eroute) {
            return 1;
          }
        }
+       if (!strncmp(var, "ceph.bufferalgname", 18)) {
+         var = Config.GetWord();
+         if (var) {
+           if (strcmp(var, "simple") && strcmp(var, "readahead")) {
+             Eroute.Emsg("Config", "Invalid value for ceph.bufferalgname (must be simple or readahead):", var);
+             return 1;
+           }
+           m_configBufferAlgName = var;
+         } else {
+           Eroute.Emsg("Config", "Missing value for ceph.bufferalgname in config file", configfn);
+           return 1;
+         }
+       }
 
        if (!strcmp(var, "ceph.reportingpools")) {
          var = Config.GetWord();
@@ -672,7 +702,8 @@ XrdOssDF* XrdCephOss::newFile(const char *tident) {
 
   if (m_configBufferEnable) {
     xrdCephOssDF = new XrdCephOssBufferedFile(this,xrdCephOssDF, m_configBufferSize, 
-                                              m_configBufferIOmode, m_configMaxSimulBufferCount);
+                                              m_configBufferIOmode, m_configMaxSimulBufferCount,
+                                              m_configBufferAlgName);
   }
 
 
@@ -83,6 +83,7 @@ public:
     bool m_configBufferEnable=false; //! config option for buffering
     size_t m_configBufferSize=16*1024*1024L;  //! Buffer size
     std::string m_configBufferIOmode = "aio";
+    std::string m_configBufferAlgName = "simple"; //! buffer algorithm: simple|readahead
     bool m_configReadVEnable=false; //! enable readV decorator
     std::string m_configReadVAlgName="passthrough"; // readV algorithm type
     size_t m_configMaxSimulBufferCount=10;  //! max number of buffers in a single Oss instance (.e.g simul. reads)
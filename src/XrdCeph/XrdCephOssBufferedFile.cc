@@ -42,6 +42,7 @@
 
 #include "XrdCeph/XrdCephOssBufferedFile.hh"
 #include "XrdCeph/XrdCephBuffers/XrdCephBufferAlgSimple.hh"
+#include "XrdCeph/XrdCephBuffers/XrdCephBufferAlgReadAhead.hh"
 #include "XrdCeph/XrdCephBuffers/XrdCephBufferDataSimple.hh"
 #include "XrdCeph/XrdCephBuffers/CephIOAdapterRaw.hh"
 #include "XrdCeph/XrdCephBuffers/CephIOAdapterAIORaw.hh"
@@ -57,12 +58,14 @@ extern XrdOucTrace XrdCephTrace;
 
 XrdCephOssBufferedFile::XrdCephOssBufferedFile(XrdCephOss *cephoss,XrdCephOssFile *cephossDF, 
                                                 size_t buffersize,const std::string& bufferIOmode,
-                                                size_t maxNumberSimulBuffers):
+                                                size_t maxNumberSimulBuffers,
+                                                const std::string& bufferAlgName):
                   XrdCephOssFile(cephoss), m_cephoss(cephoss), m_xrdOssDF(cephossDF), 
                   m_maxCountReadBuffers(maxNumberSimulBuffers),
                   m_maxBufferRetrySleepTime_ms(1000), 
                   m_bufsize(buffersize),
-                  m_bufferIOmode(bufferIOmode)     
+                  m_bufferIOmode(bufferIOmode),
+                  m_bufferAlgName(bufferAlgName)
 {
 
 }
@@ -336,7 +339,11 @@ std::unique_ptr<XrdCephBuffer::IXrdCephBufferAlg> XrdCephOssBufferedFile::create
       }
 
       LOGCEPH( "XrdCephOssBufferedFile::Open: fd: " << m_fd <<  " Buffer created: " << cephbuffer->capacity() );
-      bufferAlg = std::unique_ptr<IXrdCephBufferAlg>(new XrdCephBufferAlgSimple(std::move(cephbuffer),std::move(cephio),m_fd) );
+      if (m_bufferAlgName == "readahead") {
+          bufferAlg = std::unique_ptr<IXrdCephBufferAlg>(new XrdCephBufferAlgReadAhead(std::move(cephbuffer),std::move(cephio),m_fd) );
+      } else {
+          bufferAlg = std::unique_ptr<IXrdCephBufferAlg>(new XrdCephBufferAlgSimple(std::move(cephbuffer),std::move(cephio),m_fd) );
+      }
     } catch (const std::bad_alloc &e) {
       BUFLOG("XrdCephOssBufferedFile: Bad memory allocation in buffer: " << e.what() );
     }
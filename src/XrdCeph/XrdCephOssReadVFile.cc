@@ -40,6 +40,7 @@
 #include "XrdCeph/XrdCephOssReadVFile.hh"
 #include "XrdCeph/XrdCephBuffers/XrdCephReadVBasic.hh"
 #include "XrdCeph/XrdCephBuffers/XrdCephReadVNoOp.hh"
+#include "XrdCeph/XrdCephBuffers/XrdCephReadVStriped.hh"
 
 using namespace XrdCephBuffer;
 
@@ -55,6 +56,8 @@ XrdCephOssFile(cephoss), m_cephoss(cephoss), m_xrdOssDF(cephossDF),m_algname(alg
       m_readVAdapter =  std::unique_ptr<XrdCephBuffer::IXrdCephReadVAdapter>(new XrdCephBuffer::XrdCephReadVNoOp());
   } else if (m_algname == "basic") { 
       m_readVAdapter =  std::unique_ptr<XrdCephBuffer::IXrdCephReadVAdapter>(new XrdCephBuffer::XrdCephReadVBasic());
+  } else if (m_algname == "striped") {
+      m_readVAdapter =  std::unique_ptr<XrdCephBuffer::IXrdCephReadVAdapter>(new XrdCephBuffer::XrdCephReadVStriped());
   } else {
     XrdCephEroute.Say("XrdCephOssReadVFile::ERROR Invalid ReadV algorithm passed; defaulting to passthrough");
     m_algname = "passthrough";
@@ -118,6 +121,12 @@ ssize_t XrdCephOssReadVFile::ReadV(XrdOucIOVec *readV, int rnum) {
   std::vector<ExtentHolder> mappedExtents = m_readVAdapter->convert(extents);
 
 
+  // The striped algorithm produces one holder per ceph object; hand all of them to the
+  // underlying readV in one go so that the per-object reads are issued in parallel.
+  if (m_algname == "striped") {
+    return ReadVMerged(readV, mappedExtents);
+  }
+
   // counter is the iterator to the original readV elements, and is incremented for each chunk that's returned
   int nbytes = 0, curCount = 0, counter(0);
   size_t totalBytesRead(0), totalBytesUseful(0);
@@ -178,6 +187,65 @@ ssize_t XrdCephOssReadVFile::ReadV(XrdOucIOVec *readV, int rnum) {
 
 }
 
+ssize_t XrdCephOssReadVFile::ReadVMerged(XrdOucIOVec *readV, const std::vector<ExtentHolder>& mappedExtents) {
+  // one contiguous buffer holding every merged range, back to back
+  size_t buffersize{0};
+  for (std::vector<ExtentHolder>::const_iterator ehit = mappedExtents.cbegin(); ehit!= mappedExtents.cend(); ++ehit ) {
+    buffersize += ehit->len();
+  }
+
+  std::vector<char> buffer;
+  std::vector<XrdOucIOVec> mergedV;
+  try {
+    buffer.resize(buffersize);
+    mergedV.resize(mappedExtents.size());
+  } catch (const std::bad_alloc &e) {
+    LOGCEPH("XrdCephOssReadVFile::ReadVMerged: Bad memory allocation: " << e.what());
+    return -ENOMEM;
+  }
+
+  size_t bufpos{0};
+  for (size_t i = 0; i < mappedExtents.size(); ++i) {
+    mergedV[i].offset = mappedExtents[i].begin();
+    mergedV[i].size   = mappedExtents[i].len();
+    mergedV[i].info   = 0;
+    mergedV[i].data   = buffer.data() + bufpos;
+    bufpos += mappedExtents[i].len();
+  }
+
+  ssize_t curCount{0};
+  long timed_read_ns{0};
+  {Timer_ns ts(timed_read_ns);
+    curCount = m_xrdOssDF->ReadV(mergedV.data(), (int)mergedV.size());
+  } // timer scope
+  ++m_timer_count;
+  auto l = m_timer_longest.load();
+  m_timer_longest.store(std::max(l,timed_read_ns)); // doesn't quite prevent race conditions
+  m_timer_read_ns.fetch_add(timed_read_ns);
+  if (curCount > 0) m_timer_size.fetch_add(curCount);
+
+  if (curCount != (ssize_t)buffersize) {
+    return (curCount < 0 ? curCount : -ESPIPE);
+  }
+
+  // now read out into the original readV requests, in the order they were given
+  ssize_t nbytes{0};
+  int counter{0};
+  for (size_t i = 0; i < mappedExtents.size(); ++i) {
+    const off_t off  = mappedExtents[i].begin();
+    const char* data = mergedV[i].data;
+    const ExtentContainer& innerExtents = mappedExtents[i].extents();
+    for (ExtentContainer::const_iterator it = innerExtents.cbegin(); it != innerExtents.cend(); ++it) {
+      std::copy(data + (it->begin() - off), data + (it->end() - off), readV[counter].data);
+      nbytes += it->len();
+      ++counter;
+    }
+  }
+  LOGCEPH( "readV (merged) returning " << nbytes << " bytes: " << "Read:  " << buffersize
+           << " in " << mergedV.size() << " object reads");
+  return nbytes;
+}
+
 ssize_t XrdCephOssReadVFile::Read(off_t offset, size_t blen) {
   return m_xrdOssDF->Read(offset,blen);
 }
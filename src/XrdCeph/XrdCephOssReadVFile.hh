@@ -34,6 +34,7 @@
 #include "XrdCeph/XrdCephBuffers/IXrdCephReadVAdapter.hh"
 
 #include <memory>
+#include <vector>
 
 
 //------------------------------------------------------------------------------
@@ -74,6 +75,9 @@ public:
   virtual int Ftruncate(unsigned long long);
 
 protected:
+  //! issue all merged ranges as a single readV on the wrapped file and unpack them into readV
+  ssize_t ReadVMerged(XrdOucIOVec *readV, const std::vector<XrdCephBuffer::ExtentHolder>& mappedExtents);
+
   XrdCephOss *m_cephoss  = nullptr;
   XrdCephOssFile * m_xrdOssDF = nullptr; // holder of the XrdCephOssFile instance
   bool m_extraLogging = true; // use verbose logging
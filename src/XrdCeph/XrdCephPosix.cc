@@ -89,6 +89,10 @@ unsigned int g_cephPoolIdx = 0;
 ///If aio read operation takes longer than this value, a warning
 ///will be issued 
 unsigned int g_cephAioWaitThresh = 15;
+///Maximum number of object reads a single striperless readv keeps
+///in flight; 0 means no limit. May be overwritten in the
+///configuration file (See XrdCephOss::configure)
+unsigned int g_cephAioMaxInFlight = 16;
 /// size of the Striper/IoCtx pool, defaults to 1
 /// may be overwritten in the configuration file
 /// (See XrdCephOss::configure)
@@ -967,7 +971,7 @@ ssize_t ceph_nonstriper_readv(int fd, XrdOucIOVec *readV, int n) {
 
     try {
       //Constructor can throw bad alloc
-      bulkAioRead readOp(ioctx, logwrapper, fr);
+      bulkAioRead readOp(ioctx, logwrapper, fr, g_cephAioMaxInFlight);
 
       for (int i = 0; i < n; i++) {
         rc = readOp.read(readV[i].data, readV[i].size, readV[i].offset);
@@ -1070,7 +1074,7 @@ ssize_t ceph_posix_nonstriper_pread(int fd, void *buf, size_t count, off64_t off
 
     try {
       //Constructor can throw bad alloc
-      bulkAioRead readOp(ioctx, logwrapper, fr);
+      bulkAioRead readOp(ioctx, logwrapper, fr, g_cephAioMaxInFlight);
       rc = readOp.read(buf, count, offset);
       if (rc < 0) {
         logwrapper( (char*)"Can not declare read request\n");
@@ -87,8 +87,10 @@ namespace XrdCl
   const int DefaultPreserveLocateTried     = 1;
   const int DefaultNotAuthorizedRetryLimit = 3;
   const int DefaultPreserveXAttrs          = 0;
+  const int DefaultDirListPageSize         = 10000;
   const int DefaultNoTlsOK                 = 0;
   const int DefaultTlsNoData               = 0;
+  const int DefaultTlsSessionReuse         = 1;
   const int DefaultTlsMetalink             = 0;
   const int DefaultZipMtlnCksum            = 0;
   const int DefaultIPNoShuffle             = 0;
@@ -155,8 +157,10 @@ namespace XrdCl
       { to_lower( "PreserveLocateTried" ),     DefaultPreserveLocateTried },
       { to_lower( "NotAuthorizedRetryLimit" ), DefaultNotAuthorizedRetryLimit },
       { to_lower( "PreserveXAttrs" ),          DefaultPreserveXAttrs },
+      { to_lower( "DirListPageSize" ),         DefaultDirListPageSize },
       { to_lower( "NoTlsOK" ),                 DefaultNoTlsOK },
       { to_lower( "TlsNoData" ),               DefaultTlsNoData },
+      { to_lower( "TlsSessionReuse" ),         DefaultTlsSessionReuse },
       { to_lower( "TlsMetalink" ),             DefaultTlsMetalink },
       { to_lower( "ZipMtlnCksum" ),            DefaultZipMtlnCksum },
       { to_lower( "IPNoShuffle" ),             DefaultIPNoShuffle },
@@ -296,8 +296,10 @@ namespace XrdCl
     REGISTER_VAR_INT( varsInt, "PreserveLocateTried",     DefaultPreserveLocateTried     );
     REGISTER_VAR_INT( varsInt, "NotAuthorizedRetryLimit", DefaultNotAuthorizedRetryLimit );
     REGISTER_VAR_INT( varsInt, "PreserveXAttrs",          DefaultPreserveXAttrs          );
+    REGISTER_VAR_INT( varsInt, "DirListPageSize",         DefaultDirListPageSize         );
     REGISTER_VAR_INT( varsInt, "NoTlsOK",                 DefaultNoTlsOK                 );
     REGISTER_VAR_INT( varsInt, "TlsNoData",               DefaultTlsNoData               );
+    REGISTER_VAR_INT( varsInt, "TlsSessionReuse",         DefaultTlsSessionReuse         );
     REGISTER_VAR_INT( varsInt, "TlsMetalink",             DefaultTlsMetalink             );
     REGISTER_VAR_INT( varsInt, "ZipMtlnCksum",            DefaultZipMtlnCksum            );
     REGISTER_VAR_INT( varsInt, "IPNoShuffle",             DefaultIPNoShuffle             );
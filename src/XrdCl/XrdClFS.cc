@@ -380,7 +380,8 @@ XRootDStatus DoLS( FileSystem                      *fs,
   bool        human    = false;
   uint64_t base        = 1024;
   std::string path;
-  DirListFlags::Flags flags = DirListFlags::Locate | DirListFlags::Merge;
+  DirListFlags::Flags flags = DirListFlags::Locate | DirListFlags::Merge |
+                              DirListFlags::Paged;
 
   if( argc > 6 )
   {
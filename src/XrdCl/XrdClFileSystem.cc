@@ -36,6 +36,7 @@
 #include "XrdCl/XrdClPlugInManager.hh"
 #include "XrdCl/XrdClLocalFileTask.hh"
 #include "XrdCl/XrdClZipListHandler.hh"
+#include "XrdOuc/XrdOucUtils.hh"
 #include "XrdSys/XrdSysE2T.hh"
 #include "XrdSys/XrdSysPthread.hh"
 
@@ -254,6 +255,57 @@ namespace
       ResponseHandler   *pUserHandler;
   };
 
+  //----------------------------------------------------------------------------
+  // Turn the response to a kXR_QFread query into a ReadFilesInfo object
+  //----------------------------------------------------------------------------
+  class ReadFilesHandler: public XrdCl::ResponseHandler
+  {
+    public:
+      //------------------------------------------------------------------------
+      // Constructor
+      //------------------------------------------------------------------------
+      ReadFilesHandler( XrdCl::ResponseHandler         *handler,
+                        const std::vector<std::string> &paths ):
+        pHandler( handler ),
+        pPaths( paths ) {}
+
+      //------------------------------------------------------------------------
+      // Handle the response
+      //------------------------------------------------------------------------
+      virtual void HandleResponse( XrdCl::XRootDStatus *status,
+                                   XrdCl::AnyObject    *response )
+      {
+        using namespace XrdCl;
+
+        if( status->IsOK() )
+        {
+          Buffer *buff = 0;
+          if( response ) response->Get( buff );
+          ReadFilesInfo *info = new ReadFilesInfo();
+          if( !buff || !info->ParseServerResponse( pPaths, buff->GetBuffer(),
+                                                   buff->GetSize() ) )
+          {
+            Log *log = DefaultEnv::GetLog();
+            log->Error( FileSystemMsg, "[%p@ReadFiles] Got invalid response "
+                        "from the server", (void*)this );
+            delete info;
+            *status = XRootDStatus( stError, errInvalidResponse );
+            delete response;
+            response = 0;
+          }
+          else
+            response->Set( info );
+        }
+
+        pHandler->HandleResponse( status, response );
+        delete this;
+      }
+
+    private:
+      XrdCl::ResponseHandler   *pHandler;
+      std::vector<std::string>  pPaths;
+  };
+
   //----------------------------------------------------------------------------
   // Deep locate handler
   //----------------------------------------------------------------------------
@@ -870,6 +922,144 @@ namespace
       std::set<ListEntry*, less>  uniquesofar;
       XrdCl::ResponseHandler     *pHandler;
   };
+
+  //----------------------------------------------------------------------------
+  // Handle results for a paged dirlist request: every page is requested after
+  // the last entry of the previous one and the pages are glued together. The
+  // listing is complete once the server marks the end of it. A server that
+  // does not know about pages returns the whole listing each time, which we
+  // recognize and stop.
+  //----------------------------------------------------------------------------
+  class PagedDirListHandler: public XrdCl::ResponseHandler
+  {
+    public:
+
+      PagedDirListHandler( const XrdCl::URL          &url,
+                           const std::string         &path,
+                           XrdCl::DirListFlags::Flags flags,
+                           uint32_t                   pageSize,
+                           XrdCl::ResponseHandler    *handler,
+                           time_t                     timeout ) :
+        pPath( path ), pFlags( flags ), pPageSize( pageSize ),
+        pExpires( timeout ? ::time( 0 ) + timeout : 0 ),
+        pHandler( handler ), pDirList( new XrdCl::DirectoryList() ),
+        pFs( new XrdCl::FileSystem( url ) )
+      {
+        pDirList->SetParentName( path );
+      }
+
+      ~PagedDirListHandler()
+      {
+        delete pDirList;
+        delete pFs;
+      }
+
+      XrdCl::XRootDStatus NextPage()
+      {
+        using namespace XrdCl;
+
+        time_t timeout = 0;
+        if( pExpires )
+        {
+          timeout = pExpires - ::time( 0 );
+          if( timeout <= 0 )
+            return XRootDStatus( stError, errOperationExpired );
+        }
+
+        bool hasCgi = pPath.find( '?' ) != std::string::npos;
+        std::string path = pPath + GetCgiDelimiter( hasCgi ) + "xrd.dlpage=" +
+                           std::to_string( pPageSize );
+        if( !pLast.empty() )
+          path += "&xrd.dlafter=" + XrdOucUtils::UrlEncode( pLast );
+        return pFs->DirList( path, pFlags, this, timeout );
+      }
+
+      virtual void HandleResponse( XrdCl::XRootDStatus *status,
+                                   XrdCl::AnyObject    *response )
+      {
+        using namespace XrdCl;
+
+        DirectoryList *page = 0;
+        if( status->IsOK() && response )
+          response->Get( page );
+        if( !page )
+        {
+          if( status->IsOK() )
+            *status = XRootDStatus( stError, errInternal );
+          delete response;
+          pHandler->HandleResponse( status, 0 );
+          delete this;
+          return;
+        }
+
+        //----------------------------------------------------------------------
+        // The server ends the last page of the listing with a "/" entry, which
+        // arrives here with an empty name as leading slashes are stripped. A
+        // server that does not page returns the whole listing each time, which
+        // shows as a page not starting after the last name we have or as a
+        // page larger than asked for.
+        //----------------------------------------------------------------------
+        uint32_t size = page->GetSize();
+        bool done = ( size && page->At( size - 1 )->GetName().empty() );
+        if( done )
+          --size;
+
+        if( size && !pLast.empty() && ( page->At( 0 )->GetName() == pFirst ||
+                                        page->At( 0 )->GetName() <= pLast ) )
+          done = true;
+        else
+        {
+          for( uint32_t i = 0; i < size; ++i )
+          {
+            pDirList->Add( page->At( i ) );
+            *( page->Begin() + i ) = 0;
+          }
+          if( size )
+          {
+            if( pFirst.empty() )
+              pFirst = pDirList->At( 0 )->GetName();
+            pLast = pDirList->At( pDirList->GetSize() - 1 )->GetName();
+          }
+          else
+            done = true;
+          if( size > pPageSize )
+            done = true;
+        }
+        delete response;
+
+        if( !done )
+        {
+          XRootDStatus st = NextPage();
+          if( st.IsOK() )
+          {
+            delete status;
+            return;
+          }
+          *status = st;
+          pHandler->HandleResponse( status, 0 );
+          delete this;
+          return;
+        }
+
+        AnyObject *resp = new AnyObject();
+        resp->Set( pDirList );
+        pDirList = 0;
+        pHandler->HandleResponse( status, resp );
+        delete this;
+      }
+
+    private:
+
+      std::string                 pPath;
+      XrdCl::DirListFlags::Flags  pFlags;
+      uint32_t                    pPageSize;
+      time_t                      pExpires;
+      XrdCl::ResponseHandler     *pHandler;
+      XrdCl::DirectoryList       *pDirList;
+      XrdCl::FileSystem          *pFs;
+      std::string                 pFirst;
+      std::string                 pLast;
+  };
 }
 
 namespace XrdCl
@@ -1291,6 +1481,54 @@ namespace XrdCl
     return MessageUtils::WaitForResponse( &handler, response );
   }
 
+  //----------------------------------------------------------------------------
+  // Read many files with a single request - async
+  //----------------------------------------------------------------------------
+  XRootDStatus FileSystem::ReadFiles( const std::vector<std::string> &paths,
+                                      uint32_t                        maxSize,
+                                      ResponseHandler                *handler,
+                                      time_t                          timeout )
+  {
+    if( paths.empty() )
+      return XRootDStatus( stError, errInvalidArgs );
+
+    std::string arg = std::to_string( maxSize );
+    //--------------------------------------------------------------------------
+    // The server skips empty lines, so an empty path would leave the response
+    // with fewer entries than requested
+    //--------------------------------------------------------------------------
+    for( auto &path : paths )
+    {
+      std::string fPath = FilterXrdClCgi( path );
+      if( fPath.empty() || fPath[0] == '?' ||
+          fPath.find( '\n' ) != std::string::npos )
+        return XRootDStatus( stError, errInvalidArgs );
+      arg += '\n';
+      arg += fPath;
+    }
+
+    Buffer buff;
+    buff.FromString( arg );
+    return Query( QueryCode::FRead, buff,
+                  new ReadFilesHandler( handler, paths ), timeout );
+  }
+
+  //----------------------------------------------------------------------------
+  // Read many files with a single request - sync
+  //----------------------------------------------------------------------------
+  XRootDStatus FileSystem::ReadFiles( const std::vector<std::string>  &paths,
+                                      uint32_t                         maxSize,
+                                      ReadFilesInfo                  *&response,
+                                      time_t                           timeout )
+  {
+    SyncResponseHandler handler;
+    Status st = ReadFiles( paths, maxSize, &handler, timeout );
+    if( !st.IsOK() )
+      return st;
+
+    return MessageUtils::WaitForResponse( &handler, response );
+  }
+
   //----------------------------------------------------------------------------
   // Truncate a file - async
   //----------------------------------------------------------------------------
@@ -1688,6 +1926,35 @@ namespace XrdCl
       return st;
     }
 
+    if( flags & DirListFlags::Recursive )
+      handler = new RecursiveDirListHandler( *pImpl->fsdata->pUrl, url.GetPath(), flags, handler, timeout );
+
+    if( flags & DirListFlags::Merge )
+      handler = new MergeDirListHandler( flags & DirListFlags::Chunked, handler );
+
+    //--------------------------------------------------------------------------
+    // Ask for the listing a page at a time, unless it is delivered in chunks
+    // anyway
+    //--------------------------------------------------------------------------
+    int pageSize = DefaultDirListPageSize;
+    DefaultEnv::GetEnv()->GetInt( "DirListPageSize", pageSize );
+    if( ( flags & DirListFlags::Paged ) && !( flags & DirListFlags::Chunked ) &&
+        pageSize > 0 )
+    {
+      DirListFlags::Flags pgFlags = flags & ~( DirListFlags::Paged |
+                                               DirListFlags::Recursive |
+                                               DirListFlags::Merge );
+      if( flags & DirListFlags::Recursive )
+        pgFlags |= DirListFlags::Stat;
+      PagedDirListHandler *pgHandler =
+          new PagedDirListHandler( *pImpl->fsdata->pUrl, fPath, pgFlags,
+                                   pageSize, handler, timeout );
+      XRootDStatus st = pgHandler->NextPage();
+      if( !st.IsOK() )
+        delete pgHandler;
+      return st;
+    }
+
     Message           *msg;
     ClientDirlistRequest *req;
     MessageUtils::CreateRequest( msg, req, fPath.length() );
@@ -1701,12 +1968,6 @@ namespace XrdCl
     if( ( flags & DirListFlags::Cksm ) )
       req->options[0] = kXR_dstat | kXR_dcksm;
 
-    if( flags & DirListFlags::Recursive )
-      handler = new RecursiveDirListHandler( *pImpl->fsdata->pUrl, url.GetPath(), flags, handler, timeout );
-
-    if( flags & DirListFlags::Merge )
-      handler = new MergeDirListHandler( flags & DirListFlags::Chunked, handler );
-
     msg->Append( fPath.c_str(), fPath.length(), 24 );
     MessageSendParams params; params.timeout = timeout;
     if( flags & DirListFlags::Chunked )
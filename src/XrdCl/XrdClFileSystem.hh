@@ -64,7 +64,8 @@ namespace XrdCl
       Visa           = kXR_Qvisa,      //!< Query file visa attributes
       XAttr          = kXR_Qxattr,     //!< Query file extended attributes
       FInfo          = kXR_QFinfo,     //!< Query op-dependant file information on FD
-      FSInfo         = kXR_QFSinfo     //!< Query op-dependant file information on FS path
+      FSInfo         = kXR_QFSinfo,    //!< Query op-dependant file information on FS path
+      FRead          = kXR_QFread      //!< Read files in bulk (see FileSystem::ReadFiles)
     };
   };
 
@@ -168,7 +169,9 @@ namespace XrdCl
       Merge     = 8,  //!< Merge duplicates
       Chunked   = 16, //!< Serve chunked results for better performance
       Zip       = 32, //!< List content of ZIP files
-      Cksm      = 64  //!< Get checksum for every entry
+      Cksm      = 64, //!< Get checksum for every entry
+      Paged     = 128 //!< Fetch the listing a page at a time, in sorted order
+                      //!< (ignored for chunked listings)
     };
   };
   XRDOUC_ENUM_OPERATORS( DirListFlags::Flags )
@@ -358,6 +361,45 @@ namespace XrdCl
                           time_t            timeout = 0 )
                           XRD_WARN_UNUSED_RESULT;
 
+      //------------------------------------------------------------------------
+      //! Read many (small) files with a single request - async
+      //!
+      //! The server opens, reads and closes all the files in parallel. The
+      //! status of each file is reported separately, files the server could
+      //! not serve right away (e.g. because they need to be staged) fail
+      //! with kXR_Cancelled and should be read individually.
+      //!
+      //! @param paths   paths of the files to be read
+      //! @param maxSize maximum number of bytes to be read from each file
+      //! @param handler handler to be notified when the response arrives,
+      //!                the response parameter will hold a ReadFilesInfo
+      //!                object if the procedure is successful
+      //! @param timeout timeout value, if 0 the environment default will
+      //!                be used
+      //! @return        status of the operation
+      //------------------------------------------------------------------------
+      XRootDStatus ReadFiles( const std::vector<std::string> &paths,
+                              uint32_t                        maxSize,
+                              ResponseHandler                *handler,
+                              time_t                          timeout = 0 )
+                              XRD_WARN_UNUSED_RESULT;
+
+      //------------------------------------------------------------------------
+      //! Read many (small) files with a single request - sync
+      //!
+      //! @param paths    paths of the files to be read
+      //! @param maxSize  maximum number of bytes to be read from each file
+      //! @param response the response (to be deleted by the user)
+      //! @param timeout  timeout value, if 0 the environment default will
+      //!                 be used
+      //! @return         status of the operation
+      //------------------------------------------------------------------------
+      XRootDStatus ReadFiles( const std::vector<std::string>  &paths,
+                              uint32_t                         maxSize,
+                              ReadFilesInfo                  *&response,
+                              time_t                           timeout = 0 )
+                              XRD_WARN_UNUSED_RESULT;
+
       //------------------------------------------------------------------------
       //! Truncate a file - async
       //!
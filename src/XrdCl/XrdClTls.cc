@@ -25,6 +25,7 @@
 
 #include "XrdTls/XrdTls.hh"
 #include "XrdTls/XrdTlsContext.hh"
+#include "XrdNet/XrdNetAddrInfo.hh"
 #include "XrdOuc/XrdOucUtils.hh"
 
 #include <mutex>
@@ -135,6 +136,15 @@ namespace XrdCl
       return false;
     }
 
+    //--------------------------------------------------------------------------
+    // Keep negotiated sessions so that new connections to the same endpoint
+    // can skip the full hand-shake.
+    //--------------------------------------------------------------------------
+    int tlsReuse = DefaultTlsSessionReuse;
+    env->GetInt("TlsSessionReuse", tlsReuse);
+    if (tlsReuse)
+      tlsContext->SessionCache(XrdTlsContext::scClnt);
+
     return true;
   }
 
@@ -165,6 +175,20 @@ namespace XrdCl
     const char *verhost = 0;
     if( thehost != "localhost" && thehost != "127.0.0.1" && thehost != "[::1]" )
       verhost = thehost.c_str();
+
+    //--------------------------------------------------------------------------
+    // Offer a previously saved session for this endpoint and credentials to
+    // the server. This is ignored once the hand-shake is under way.
+    //--------------------------------------------------------------------------
+    if( pTls->NeedHandShake() )
+    {
+      std::string sessKey = thehost + ':' +
+                            std::to_string( netInfo ? netInfo->Port() : 0 );
+      const std::string &cert = tlsContext->GetParams()->cert;
+      if( !cert.empty() ) sessKey += '#' + cert;
+      pTls->SetSessionKey( sessKey.c_str() );
+    }
+
     XrdTls::RC error = pTls->Connect( verhost, &errmsg );
     XRootDStatus status = ToStatus( error );
     if( !status.IsOK() )
@@ -209,6 +233,12 @@ namespace XrdCl
         if( !st.IsOK() ) return st;
       }
     }
+    else if( pTls->isResumed() )
+    {
+      XrdCl::Log *log = XrdCl::DefaultEnv::GetLog();
+      log->Debug( XrdCl::TlsMsg, "Resumed TLS session with %s.",
+                  thehost.c_str() );
+    }
 
     return status;
   }
@@ -21,7 +21,10 @@
 #include "XrdCl/XrdClDefaultEnv.hh"
 #include "XrdCl/XrdClConstants.hh"
 #include "XrdCl/XrdClUtils.hh"
+#include "XrdSys/XrdSysPlatform.hh"
 #include <cstdlib>
+#include <cstring>
+#include <arpa/inet.h>
 
 namespace XrdCl
 {
@@ -754,6 +757,38 @@ namespace XrdCl
     return pImpl->retries[i];
   }
 
+  //----------------------------------------------------------------------------
+  // Parse the server response to a kXR_QFread query
+  //----------------------------------------------------------------------------
+  bool ReadFilesInfo::ParseServerResponse( const std::vector<std::string> &paths,
+                                           const char                     *data,
+                                           uint32_t                        len )
+  {
+    pFiles.clear();
+    pFiles.reserve( paths.size() );
+    for( auto &path : paths )
+    {
+      ServerResponseBody_QFread rsp;
+      if( len < sizeof( rsp ) ) return false;
+      memcpy( &rsp, data, sizeof( rsp ) );
+      data += sizeof( rsp ); len -= sizeof( rsp );
+
+      uint32_t dlen = ntohl( rsp.dlen );
+      if( len < dlen ) return false;
+      std::string buff( data, dlen );
+      data += dlen; len -= dlen;
+
+      int32_t errnum = ntohl( rsp.errnum );
+      if( errnum )
+        pFiles.emplace_back( path, XRootDStatus( stError, errErrorResponse,
+                                                 errnum, buff ) );
+      else
+        pFiles.emplace_back( path, XRootDStatus(), ntohll( rsp.fsize ),
+                             std::move( buff ) );
+    }
+    return len == 0;
+  }
+
   //------------------------------------------------------------------------
   // Factory function for generating handler objects from lambdas
   //------------------------------------------------------------------------
@@ -1160,6 +1160,161 @@ namespace XrdCl
       uint32_t  pSize;
   };
 
+  //----------------------------------------------------------------------------
+  //! Contents of files read in bulk
+  //----------------------------------------------------------------------------
+  class ReadFilesInfo
+  {
+    public:
+      //------------------------------------------------------------------------
+      //! Contents of a single file
+      //------------------------------------------------------------------------
+      class FileData
+      {
+        public:
+          //--------------------------------------------------------------------
+          //! Constructor
+          //--------------------------------------------------------------------
+          FileData( const std::string  &path,
+                    const XRootDStatus &status,
+                    uint64_t            size = 0,
+                    std::string        &&data = std::string() ):
+            pPath( path ),
+            pStatus( status ),
+            pSize( size ),
+            pData( std::move( data ) ) {}
+
+          //--------------------------------------------------------------------
+          //! Get the path
+          //--------------------------------------------------------------------
+          const std::string &GetPath() const
+          {
+            return pPath;
+          }
+
+          //--------------------------------------------------------------------
+          //! Get the status of reading this file
+          //--------------------------------------------------------------------
+          const XRootDStatus &GetStatus() const
+          {
+            return pStatus;
+          }
+
+          //--------------------------------------------------------------------
+          //! Get the size of the whole file, the data may be shorter if the
+          //! file is bigger than what was asked for
+          //--------------------------------------------------------------------
+          uint64_t GetSize() const
+          {
+            return pSize;
+          }
+
+          //--------------------------------------------------------------------
+          //! Get the data
+          //--------------------------------------------------------------------
+          const std::string &GetData() const
+          {
+            return pData;
+          }
+
+        private:
+          std::string  pPath;
+          XRootDStatus pStatus;
+          uint64_t     pSize;
+          std::string  pData;
+      };
+
+      //------------------------------------------------------------------------
+      //! List of files
+      //------------------------------------------------------------------------
+      typedef std::vector<FileData>        FileList;
+
+      //------------------------------------------------------------------------
+      //! Iterator over files
+      //------------------------------------------------------------------------
+      typedef FileList::iterator           Iterator;
+
+      //------------------------------------------------------------------------
+      //! Iterator over files
+      //------------------------------------------------------------------------
+      typedef FileList::const_iterator     ConstIterator;
+
+      //------------------------------------------------------------------------
+      //! Destructor
+      //------------------------------------------------------------------------
+      virtual ~ReadFilesInfo() {}
+
+      //------------------------------------------------------------------------
+      //! Get number of files
+      //------------------------------------------------------------------------
+      uint32_t GetSize() const
+      {
+        return pFiles.size();
+      }
+
+      //------------------------------------------------------------------------
+      //! Get the file at given index
+      //------------------------------------------------------------------------
+      FileData &At( uint32_t index )
+      {
+        return pFiles[index];
+      }
+
+      //------------------------------------------------------------------------
+      //! Get the file at given index
+      //------------------------------------------------------------------------
+      const FileData &At( uint32_t index ) const
+      {
+        return pFiles[index];
+      }
+
+      //------------------------------------------------------------------------
+      //! Get the begin iterator
+      //------------------------------------------------------------------------
+      Iterator Begin()
+      {
+        return pFiles.begin();
+      }
+
+      //------------------------------------------------------------------------
+      //! Get the begin iterator
+      //------------------------------------------------------------------------
+      ConstIterator Begin() const
+      {
+        return pFiles.begin();
+      }
+
+      //------------------------------------------------------------------------
+      //! Get the end iterator
+      //------------------------------------------------------------------------
+      Iterator End()
+      {
+        return pFiles.end();
+      }
+
+      //------------------------------------------------------------------------
+      //! Get the end iterator
+      //------------------------------------------------------------------------
+      ConstIterator End() const
+      {
+        return pFiles.end();
+      }
+
+      //------------------------------------------------------------------------
+      //! Parse the server response to a kXR_QFread query
+      //!
+      //! @param paths : the paths in the order they were requested
+      //! @param data  : the response
+      //! @param len   : the length of the response
+      //------------------------------------------------------------------------
+      bool ParseServerResponse( const std::vector<std::string> &paths,
+                                const char                     *data,
+                                uint32_t                        len );
+
+    private:
+      FileList pFiles;
+  };
+
   //----------------------------------------------------------------------------
   // List of URLs
   //----------------------------------------------------------------------------
@@ -33,10 +33,328 @@
 
 #include <sys/stat.h>
 
+#include <deque>
+#include <functional>
+#include <mutex>
+
 namespace XrdCl
 {
   using namespace XrdZip;
 
+  //---------------------------------------------------------------------------
+  // A cursor inflating a compressed file sequentially, it serves the queued
+  // read requests in order and fetches the compressed data as needed
+  //---------------------------------------------------------------------------
+  struct ZipCursor : public std::enable_shared_from_this<ZipCursor>
+  {
+    typedef std::function<void( const XRootDStatus&, uint32_t )> callback_t;
+
+    struct Request
+    {
+      uint64_t    offset;
+      uint32_t    length;
+      char       *buffer;
+      callback_t  done;
+    };
+
+    static const uint32_t minRdSize = 256 * 1024;
+    static const uint32_t maxRdSize = 8 * 1024 * 1024;
+
+    ZipCursor( const std::shared_ptr<ZipStream> &stream );
+
+    void Run();
+    void Fetch( const std::shared_ptr<ZipStream> &strm );
+    void Fail( const std::shared_ptr<ZipStream> &strm, const XRootDStatus &st );
+
+    std::weak_ptr<ZipStream>  stream;   //< weak as the stream owns its cursors
+    ZipInflater               inflater;
+    std::deque<Request>       queue;    //< guarded by the stream mutex
+    bool                      busy;     //< guarded by the stream mutex
+    uint64_t                  tail;     //< end offset of the last queued request
+    uint32_t                  filled;   //< bytes filled in the front request
+    uint32_t                  rdsize;   //< size of the next remote read
+    time_t                    timeout;
+  };
+
+  //---------------------------------------------------------------------------
+  // The inflated data stream of a compressed file in the archive, reads are
+  // assigned to the cursor that can serve them with the least inflating. At
+  // most maxCursors cursors exist, once they are all busy further reads are
+  // queued with one of them.
+  //---------------------------------------------------------------------------
+  struct ZipStream : public std::enable_shared_from_this<ZipStream>
+  {
+    static const size_t maxCursors = 8;
+
+    ZipStream( File &archive, const char *data, uint64_t fileoff, uint64_t csize ) :
+      archive( archive ), data( data ), fileoff( fileoff ), csize( csize ),
+      index( std::make_shared<ZipSeekIndex>() )
+    {
+    }
+
+    void Read( uint64_t offset, uint32_t length, char *buffer, time_t timeout,
+               ZipCursor::callback_t done );
+
+    void Submit( uint64_t offset, uint32_t length, char *buffer, time_t timeout,
+                 ZipCursor::callback_t done );
+
+    File                                    &archive;
+    const char                              *data;    //< the whole archive if at hand
+    uint64_t                                 fileoff; //< offset of the compressed data
+    uint64_t                                 csize;   //< size of the compressed data
+    std::shared_ptr<ZipSeekIndex>            index;
+    std::mutex                               mtx;
+    std::vector<std::shared_ptr<ZipCursor>>  cursors;
+  };
+
+  ZipCursor::ZipCursor( const std::shared_ptr<ZipStream> &stream ) :
+                                              stream( stream ),
+                                              inflater( stream->index ),
+                                              busy( false ), tail( 0 ),
+                                              filled( 0 ), rdsize( minRdSize ),
+                                              timeout( 0 )
+  {
+  }
+
+  //---------------------------------------------------------------------------
+  // Serve the queued requests until we run out of them or of input
+  //---------------------------------------------------------------------------
+  void ZipCursor::Run()
+  {
+    // a completion callback may close the archive and drop the stream, keep
+    // it alive for as long as we use it
+    std::shared_ptr<ZipStream> strm = stream.lock();
+    if( !strm )
+      return Fail( strm, XRootDStatus( stError, errInvalidOp, 0,
+                                       "The archive has been closed." ) );
+
+    while( true )
+    {
+      Request *req;
+      {
+        std::unique_lock<std::mutex> lck( strm->mtx );
+        if( queue.empty() )
+        {
+          busy = false;
+          return;
+        }
+        req = &queue.front();
+      }
+
+      // we may only move forward, otherwise start over from a checkpoint;
+      // a new request far ahead also starts from the nearest checkpoint
+      // rather than inflating everything in between
+      uint64_t want = req->offset + filled;
+      uint64_t upos = inflater.UncompressedOffset();
+      if( want < upos || ( !filled && want > upos ) )
+      {
+        ZipSeekIndex::Point pt;
+        bool found = strm->index->Find( want, pt );
+        if( want < upos || ( found && pt.uoff > upos ) )
+        {
+          XRootDStatus st = inflater.Reset( found ? &pt : nullptr );
+          if( !st.IsOK() ) return Fail( strm, st );
+        }
+      }
+
+      XRootDStatus st = inflater.Inflate( req->offset, req->length, req->buffer, filled );
+      if( st.IsOK() && st.code == suContinue )
+      {
+        uint64_t cpos = inflater.CompressedOffset();
+        if( cpos >= strm->csize )
+          return Fail( strm, XRootDStatus( stError, errDataError, 0,
+                                           "Compressed data ended prematurely." ) );
+        if( !strm->data ) return Fetch( strm );
+        // we have the whole archive, there's no need to wait for anything
+        const char *begin = strm->data + strm->fileoff + cpos;
+        inflater.Input( ZipCache::buffer_t( begin, strm->data + strm->fileoff + strm->csize ) );
+        continue;
+      }
+      if( !st.IsOK() ) return Fail( strm, st );
+
+      Request done;
+      {
+        std::unique_lock<std::mutex> lck( strm->mtx );
+        done = std::move( queue.front() );
+        queue.pop_front();
+      }
+      uint32_t n = filled;
+      filled = 0;
+      done.done( st, n );
+    }
+  }
+
+  //---------------------------------------------------------------------------
+  // Read the next chunk of compressed data, the chunk size grows as long as
+  // the cursor keeps streaming
+  //---------------------------------------------------------------------------
+  void ZipCursor::Fetch( const std::shared_ptr<ZipStream> &strm )
+  {
+    uint64_t cpos = inflater.CompressedOffset();
+    uint32_t size = std::min<uint64_t>( rdsize, strm->csize - cpos );
+    rdsize = std::min( rdsize * 2, maxRdSize );
+
+    auto rdbuff = std::make_shared<ZipCache::buffer_t>( size );
+    auto self   = shared_from_this();
+    // the stream is kept alive while reading
+    Pipeline p = XrdCl::Read( strm->archive, strm->fileoff + cpos, size, rdbuff->data() ) >>
+                   [self, strm, rdbuff]( XRootDStatus &st, ChunkInfo &chunk )
+                   {
+                     if( !st.IsOK() ) return self->Fail( strm, st );
+                     if( chunk.length == 0 )
+                       return self->Fail( strm, XRootDStatus( stError, errDataError, 0,
+                                                              "Compressed data ended prematurely." ) );
+                     rdbuff->resize( chunk.length );
+                     self->inflater.Input( std::move( *rdbuff ) );
+                     self->Run();
+                   };
+    Async( std::move( p ), timeout );
+  }
+
+  //---------------------------------------------------------------------------
+  // Fail all the queued requests and retire the cursor, without a stream
+  // nobody else can get at the queue anymore
+  //---------------------------------------------------------------------------
+  void ZipCursor::Fail( const std::shared_ptr<ZipStream> &strm, const XRootDStatus &st )
+  {
+    std::deque<Request> failed;
+    auto self = shared_from_this();
+    if( !strm ) failed.swap( queue );
+    else
+    {
+      std::unique_lock<std::mutex> lck( strm->mtx );
+      failed.swap( queue );
+      busy = false;
+      auto itr = std::find( strm->cursors.begin(), strm->cursors.end(), self );
+      if( itr != strm->cursors.end() ) strm->cursors.erase( itr );
+    }
+    filled = 0;
+    for( auto &req : failed )
+      req.done( st, 0 );
+  }
+
+  //---------------------------------------------------------------------------
+  // Read from the inflated stream, requests spanning checkpoints are split
+  // so the segments can be inflated in parallel
+  //---------------------------------------------------------------------------
+  void ZipStream::Read( uint64_t offset, uint32_t length, char *buffer, time_t timeout,
+                        ZipCursor::callback_t done )
+  {
+    std::vector<uint64_t> cuts = index->Inside( offset, offset + length );
+    if( cuts.empty() ) return Submit( offset, length, buffer, timeout, std::move( done ) );
+
+    struct Gather
+    {
+      std::mutex            mtx;
+      size_t                left;
+      XRootDStatus          status;
+      uint32_t              filled;
+      ZipCursor::callback_t done;
+    };
+    auto gather    = std::make_shared<Gather>();
+    gather->left   = cuts.size() + 1;
+    gather->filled = 0;
+    gather->done   = std::move( done );
+    auto segdone = [gather]( const XRootDStatus &st, uint32_t filled )
+                   {
+                     std::unique_lock<std::mutex> lck( gather->mtx );
+                     if( !st.IsOK() && gather->status.IsOK() ) gather->status = st;
+                     gather->filled += filled;
+                     if( --gather->left ) return;
+                     lck.unlock();
+                     gather->done( gather->status, gather->status.IsOK() ? gather->filled : 0 );
+                   };
+
+    cuts.push_back( offset + length );
+    uint64_t begin = offset;
+    for( uint64_t end : cuts )
+    {
+      Submit( begin, end - begin, buffer + ( begin - offset ), timeout, segdone );
+      begin = end;
+    }
+  }
+
+  //---------------------------------------------------------------------------
+  // Queue a read with the best positioned cursor
+  //---------------------------------------------------------------------------
+  void ZipStream::Submit( uint64_t offset, uint32_t length, char *buffer, time_t timeout,
+                          ZipCursor::callback_t done )
+  {
+    std::unique_lock<std::mutex> lck( mtx );
+    std::shared_ptr<ZipCursor> cur;
+
+    // a cursor that will end up exactly where we want to start
+    for( auto &c : cursors )
+      if( c->tail == offset )
+      {
+        cur = c;
+        break;
+      }
+
+    // otherwise an idle cursor behind us, unless a checkpoint is closer
+    if( !cur )
+    {
+      ZipSeekIndex::Point pt;
+      bool found = index->Find( offset, pt );
+      for( auto &c : cursors )
+      {
+        if( c->busy ) continue;
+        uint64_t upos = c->inflater.UncompressedOffset();
+        if( upos > offset || ( found && pt.uoff > upos ) ) continue;
+        if( !cur || upos > cur->inflater.UncompressedOffset() ) cur = c;
+      }
+
+      // make room for a new cursor by retiring an idle one, if they are all
+      // busy queue the read with the one ending closest before us or else
+      // with the one with the fewest queued reads
+      if( !cur && cursors.size() >= maxCursors )
+      {
+        auto itr = std::find_if( cursors.begin(), cursors.end(),
+                                 []( const std::shared_ptr<ZipCursor> &c ){ return !c->busy; } );
+        if( itr != cursors.end() ) cursors.erase( itr );
+        else
+        {
+          for( auto &c : cursors )
+            if( c->tail <= offset && ( !cur || c->tail > cur->tail ) ) cur = c;
+          if( !cur )
+            cur = *std::min_element( cursors.begin(), cursors.end(),
+                                     []( const std::shared_ptr<ZipCursor> &a,
+                                         const std::shared_ptr<ZipCursor> &b )
+                                     { return a->queue.size() < b->queue.size(); } );
+        }
+      }
+
+      if( !cur )
+      {
+        XRootDStatus st;
+        try
+        {
+          cur = std::make_shared<ZipCursor>( shared_from_this() );
+          st  = cur->inflater.Reset( found ? &pt : nullptr );
+        }
+        catch( const ZipError &ex )
+        {
+          st = ex.status;
+        }
+        if( !st.IsOK() )
+        {
+          lck.unlock();
+          return done( st, 0 );
+        }
+        cursors.push_back( cur );
+      }
+    }
+
+    cur->queue.push_back( ZipCursor::Request{ offset, length, buffer, std::move( done ) } );
+    cur->tail    = offset + length;
+    cur->timeout = timeout;
+    bool start   = !cur->busy;
+    cur->busy    = true;
+    lck.unlock();
+
+    if( start ) cur->Run();
+  }
+
   //---------------------------------------------------------------------------
   // Read data from a given file
   //---------------------------------------------------------------------------
@@ -90,79 +408,38 @@ namespace XrdCl
                            0 : uncompressedSize - relativeOffset;
     if( size > sizeTillEnd ) size = sizeTillEnd;
 
-    // if it is a compressed file use ZIP cache to read from the file
+    // if it is a compressed file use the inflated data stream
     if( cdfh->compressionMethod == Z_DEFLATED )
     {
       log->Dump( ZipMsg, "[%p] Reading compressed data.", (void*)&me );
-      // check if respective ZIP cache exists
-      bool empty = me.zipcache.find( fn ) == me.zipcache.end();
-      // if the entry does not exist, it will be created using
-      // default constructor
-      ZipCache &cache = me.zipcache[fn];
 
-      if( relativeOffset > uncompressedSize )
+      if( size == 0 )
       {
-        // we are reading past the end of file,
+        // we are reading at or past the end of file,
         // we can serve the request right away!
-        RSP *r = new RSP( relativeOffset, 0, usrbuff );
-        AnyObject *rsp = new AnyObject();
-        rsp->Set( r );
-        usrHandler->HandleResponse( new XRootDStatus(), rsp );
+        if( usrHandler )
+          ZipArchive::Schedule( usrHandler, ZipArchive::make_status(),
+                                new RSP( relativeOffset, 0, usrbuff ) );
         return XRootDStatus();
       }
 
-      uint32_t sizereq = size;
-      if( relativeOffset + size > uncompressedSize )
-        sizereq = uncompressedSize - relativeOffset;
-      cache.QueueReq( relativeOffset, sizereq, usrbuff, usrHandler );
-
-      // if we have the whole ZIP archive we can populate the cache
-      // straight away
-      if( empty && me.buffer)
-      {
-        auto begin = me.buffer.get() + fileoff;
-        auto end   = begin + filesize ;
-        buffer_t buff( begin, end );
-        cache.QueueRsp( XRootDStatus(), 0, std::move( buff ) );
-        return XRootDStatus();
-      }
-
-      // if we don't have the data we need to issue a remote read
-      if( !me.buffer )
-      {
-        if( relativeOffset > filesize ) return XRootDStatus(); // there's nothing to do,
-                                                                           // we already have all the data locally
-        uint32_t rdsize = size;
-        // check if this is the last read (we reached the end of
-        // file from user perspective)
-        if( relativeOffset + size >= uncompressedSize )
-        {
-          // if yes, make sure we readout all the compressed data
-          // Note: In a patological case the compressed size may
-          //       be greater than the uncompressed size
-          rdsize = filesize > relativeOffset ?
-                   filesize - relativeOffset :
-                   0;
-        }
-        // make sure we are not reading past the end of
-        // compressed data
-        if( relativeOffset + size > filesize )
-          rdsize = filesize - relativeOffset;
-
-
-        // now read the data ...
-        auto rdbuff = std::make_shared<ZipCache::buffer_t>( rdsize );
-        Pipeline p = XrdCl::RdWithRsp<RSP>( me.archive, offset, rdbuff->size(), rdbuff->data() ) >>
-                       [relativeOffset, rdbuff, &cache, &me]( XRootDStatus &st, RSP &rsp )
-                       {
-                         Log *log = DefaultEnv::GetLog();
-                         log->Dump( ZipMsg, "[%p] Read %u bytes of remote data at offset %llu.",
-                                            (void*)&me, rsp.GetLength(), (unsigned long long) rsp.GetOffset() );
-                         cache.QueueRsp( st, relativeOffset, std::move( *rdbuff ) );
-                       };
-        Async( std::move( p ), timeout );
-      }
-
+      // if the stream does not exist yet create it, if we have the
+      // whole ZIP archive it will be inflated straight from our buffer
+      std::shared_ptr<ZipStream> &stream = me.zipcache[fn];
+      if( !stream )
+        stream = std::make_shared<ZipStream>( me.archive, me.buffer.get(),
+                                              fileoff, filesize );
+
+      stream->Read( relativeOffset, size, reinterpret_cast<char*>( usrbuff ), timeout,
+                    [=, &me]( const XRootDStatus &st, uint32_t filled )
+                    {
+                      log->Dump( ZipMsg, "[%p] Inflated %u bytes at offset %llu.",
+                                 (void*)&me, filled, (unsigned long long) relativeOffset );
+                      if( !usrHandler ) return;
+                      RSP *rsp = st.IsOK() ? new RSP( relativeOffset, filled, usrbuff ) : nullptr;
+                      usrHandler->HandleResponse( ZipArchive::make_status( st ),
+                                                  ZipArchive::PkgRsp( rsp ) );
+                    } );
       return XRootDStatus();
     }
 
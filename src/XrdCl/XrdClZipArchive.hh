@@ -50,6 +50,8 @@ namespace XrdCl
 {
   using namespace XrdZip;
 
+  struct ZipStream;
+
   //---------------------------------------------------------------------------
   // ZipArchive provides following functionalities:
   // - parsing of existing ZIP archive
@@ -532,6 +534,7 @@ namespace XrdCl
         cdvec.clear();
         cdmap.clear();
         zip64eocd.reset();
+        zipcache.clear();
         openstage = None;
       }
 
@@ -573,9 +576,9 @@ namespace XrdCl
       };
 
       //-----------------------------------------------------------------------
-      //! Type that maps file name to its cache
+      //! Type that maps file name to its inflated data stream
       //-----------------------------------------------------------------------
-      typedef std::unordered_map<std::string, ZipCache> zipcache_t;
+      typedef std::unordered_map<std::string, std::shared_ptr<ZipStream>> zipcache_t;
       typedef std::unordered_map<std::string, NewFile>  new_files_t;
 
       File                        archive;   //> File object for handling the ZIP archive
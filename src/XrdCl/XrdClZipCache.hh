@@ -33,6 +33,9 @@
 #include <mutex>
 #include <queue>
 #include <tuple>
+#include <memory>
+#include <algorithm>
+#include <cstring>
 
 namespace XrdCl
 {
@@ -96,6 +99,27 @@ namespace XrdCl
         inflateEnd( &strm );
       }
 
+      //-----------------------------------------------------------------------
+      //! Translate a zlib return code into XRootDStatus
+      //-----------------------------------------------------------------------
+      static XrdCl::XRootDStatus ToXRootDStatus( int rc, const std::string &func )
+      {
+        std::string msg = "[zlib] " + func + " : ";
+
+        switch( rc )
+        {
+          case Z_STREAM_END    :
+          case Z_OK            : return XrdCl::XRootDStatus();
+          case Z_BUF_ERROR     : return XrdCl::XRootDStatus( XrdCl::stOK,    XrdCl::suContinue );
+          case Z_MEM_ERROR     : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errInternal,    Z_MEM_ERROR,     msg + "not enough memory." );
+          case Z_VERSION_ERROR : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errInternal,    Z_VERSION_ERROR, msg + "version mismatch." );
+          case Z_STREAM_ERROR  : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errInvalidArgs, Z_STREAM_ERROR,  msg + "invalid argument." );
+          case Z_NEED_DICT     : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errDataError,   Z_NEED_DICT,     msg + "need dict.");
+          case Z_DATA_ERROR    : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errDataError,   Z_DATA_ERROR,    msg + "corrupted data." );
+          default              : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errUnknown );
+        }
+      }
+
       inline void QueueReq( uint64_t offset, uint32_t length, void *buffer, ResponseHandler *handler )
       {
         std::unique_lock<std::mutex> lck( mtx );
@@ -199,30 +223,255 @@ namespace XrdCl
         handler->HandleResponse( new XRootDStatus( st ), PkgRsp( chunk ) );
       }
 
-      XrdCl::XRootDStatus ToXRootDStatus( int rc, const std::string &func )
+      z_stream  strm;      // the zlib stream we will use for reading
+
+      std::mutex              mtx;
+      uint64_t                inabsoff; //< the absolute offset in the input file (compressed), ensures the user is actually streaming the data
+      std::queue<read_args_t> rdreqs;   //< pending read requests  (we only allow read requests to be submitted in order)
+      resp_queue_t            rdrsps;   //< pending read responses (due to multiple-streams the read response may come out of order)
+  };
+
+
+  //---------------------------------------------------------------------------
+  //! Checkpoints of a deflated file that allow inflation to be restarted
+  //! midway (see zlib's examples/zran.c), collected while the file is being
+  //! inflated front to back
+  //---------------------------------------------------------------------------
+  class ZipSeekIndex
+  {
+    public:
+
+      //-----------------------------------------------------------------------
+      //! Window size needed to restart inflation and checkpoint spacing
+      //-----------------------------------------------------------------------
+      static const uint32_t winSize = 32768;
+      static const uint64_t span    = 4 * 1024 * 1024;
+
+      struct Point
       {
-        std::string msg = "[zlib] " + func + " : ";
+        uint64_t                        uoff;   //< offset in uncompressed data
+        uint64_t                        coff;   //< offset in compressed data
+        int                             bits;   //< bits of the preceding byte still to consume
+        uint8_t                         prime;  //< the preceding byte
+        std::shared_ptr<const ZipCache::buffer_t> window; //< preceding uncompressed data
+      };
 
-        switch( rc )
+      //-----------------------------------------------------------------------
+      //! Add a checkpoint, it is ignored unless it is at least a span past
+      //! the last one
+      //-----------------------------------------------------------------------
+      inline void Add( Point &&pt )
+      {
+        std::unique_lock<std::mutex> lck( mtx );
+        if( !points.empty() && pt.uoff < points.back().uoff + span ) return;
+        points.emplace_back( std::move( pt ) );
+      }
+
+      //-----------------------------------------------------------------------
+      //! Find the last checkpoint at or before given offset
+      //!
+      //! @return : true if found, false otherwise
+      //-----------------------------------------------------------------------
+      inline bool Find( uint64_t offset, Point &pt ) const
+      {
+        std::unique_lock<std::mutex> lck( mtx );
+        auto itr = std::upper_bound( points.begin(), points.end(), offset,
+                                     []( uint64_t off, const Point &p ){ return off < p.uoff; } );
+        if( itr == points.begin() ) return false;
+        pt = *( --itr );
+        return true;
+      }
+
+      //-----------------------------------------------------------------------
+      //! Get the offsets of the checkpoints inside of ( begin, end )
+      //-----------------------------------------------------------------------
+      inline std::vector<uint64_t> Inside( uint64_t begin, uint64_t end ) const
+      {
+        std::unique_lock<std::mutex> lck( mtx );
+        std::vector<uint64_t> offs;
+        for( auto &p : points )
+          if( p.uoff > begin && p.uoff < end ) offs.push_back( p.uoff );
+        return offs;
+      }
+
+      inline size_t Size() const
+      {
+        std::unique_lock<std::mutex> lck( mtx );
+        return points.size();
+      }
+
+    private:
+
+      mutable std::mutex mtx;
+      std::vector<Point> points;
+  };
+
+  //---------------------------------------------------------------------------
+  //! Utility class for inflating a deflated file from an arbitrary offset
+  //! using (and populating) a ZipSeekIndex. The compressed data are provided
+  //! by the caller in consecutive chunks starting at CompressedOffset().
+  //---------------------------------------------------------------------------
+  class ZipInflater
+  {
+    public:
+
+      ZipInflater( std::shared_ptr<ZipSeekIndex> index ) :
+        index( std::move( index ) ), window( ZipSeekIndex::winSize ),
+        wpos( 0 ), wfill( 0 ), upos( 0 ), cpos( 0 ),
+        nextpt( ZipSeekIndex::span ), last( 0 ), eos( false )
+      {
+        memset( &strm, 0, sizeof( strm ) );
+        int rc = inflateInit2( &strm, -MAX_WBITS );
+        XrdCl::XRootDStatus st = ZipCache::ToXRootDStatus( rc, "inflateInit2" );
+        if( !st.IsOK() ) throw ZipError( st );
+      }
+
+      ~ZipInflater()
+      {
+        inflateEnd( &strm );
+      }
+
+      //-----------------------------------------------------------------------
+      //! Restart inflation at given checkpoint or, if none, at the beginning
+      //-----------------------------------------------------------------------
+      XRootDStatus Reset( const ZipSeekIndex::Point *pt )
+      {
+        inflateReset( &strm );
+        strm.avail_in = 0;
+        input.clear();
+        eos = false;
+        if( !pt )
         {
-          case Z_STREAM_END    :
-          case Z_OK            : return XrdCl::XRootDStatus();
-          case Z_BUF_ERROR     : return XrdCl::XRootDStatus( XrdCl::stOK,    XrdCl::suContinue );
-          case Z_MEM_ERROR     : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errInternal,    Z_MEM_ERROR,     msg + "not enough memory." );
-          case Z_VERSION_ERROR : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errInternal,    Z_VERSION_ERROR, msg + "version mismatch." );
-          case Z_STREAM_ERROR  : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errInvalidArgs, Z_STREAM_ERROR,  msg + "invalid argument." );
-          case Z_NEED_DICT     : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errDataError,   Z_NEED_DICT,     msg + "need dict.");
-          case Z_DATA_ERROR    : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errDataError,   Z_DATA_ERROR,    msg + "corrupted data." );
-          default              : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errUnknown );
+          wpos = wfill = 0;
+          upos = cpos = 0;
+          nextpt = ZipSeekIndex::span;
+          return XRootDStatus();
         }
+
+        int rc = Z_OK;
+        if( pt->bits )
+          rc = inflatePrime( &strm, pt->bits, pt->prime >> ( 8 - pt->bits ) );
+        if( rc == Z_OK )
+          rc = inflateSetDictionary( &strm, (const Bytef*)pt->window->data(),
+                                     pt->window->size() );
+        if( rc != Z_OK ) return ZipCache::ToXRootDStatus( rc, "inflateSetDictionary" );
+        std::copy( pt->window->begin(), pt->window->end(), window.begin() );
+        wpos = wfill = pt->window->size();
+        upos   = pt->uoff;
+        cpos   = pt->coff;
+        nextpt = pt->uoff + ZipSeekIndex::span;
+        return XRootDStatus();
       }
 
-      z_stream  strm;      // the zlib stream we will use for reading
+      //-----------------------------------------------------------------------
+      //! Provide the compressed data starting at CompressedOffset()
+      //-----------------------------------------------------------------------
+      void Input( ZipCache::buffer_t &&buffer )
+      {
+        if( !input.empty() ) last = input.back();
+        input = std::move( buffer );
+        strm.next_in  = (Bytef*)input.data();
+        strm.avail_in = input.size();
+        cpos += input.size();
+      }
 
-      std::mutex              mtx;
-      uint64_t                inabsoff; //< the absolute offset in the input file (compressed), ensures the user is actually streaming the data
-      std::queue<read_args_t> rdreqs;   //< pending read requests  (we only allow read requests to be submitted in order)
-      resp_queue_t            rdrsps;   //< pending read responses (due to multiple-streams the read response may come out of order)
+      //-----------------------------------------------------------------------
+      //! Inflate the uncompressed data in [offset, offset + length) into
+      //! buffer, offset must not be before UncompressedOffset()
+      //!
+      //! @param filled : number of bytes in buffer, on input what has been
+      //!                 filled in a preceding call
+      //! @return       : stOK if done (filled may be short at the end of
+      //!                 data), suContinue if more input is needed, or an
+      //!                 error
+      //-----------------------------------------------------------------------
+      XRootDStatus Inflate( uint64_t offset, uint32_t length, char *buffer, uint32_t &filled )
+      {
+        while( filled < length && !eos )
+        {
+          if( !strm.avail_in ) return XRootDStatus( stOK, suContinue );
+
+          if( wpos == ZipSeekIndex::winSize ) wpos = 0;
+          uint32_t wlen  = ZipSeekIndex::winSize - wpos;
+          strm.next_out  = (Bytef*)window.data() + wpos;
+          strm.avail_out = wlen;
+
+          // stop at the end of each deflate block so checkpoints can be taken
+          int rc = inflate( &strm, Z_BLOCK );
+          if( rc == Z_BUF_ERROR ) rc = Z_DATA_ERROR;
+          XRootDStatus st = ZipCache::ToXRootDStatus( rc, "inflate" );
+          if( !st.IsOK() ) return st;
+          if( rc == Z_STREAM_END ) eos = true;
+
+          // hand out whatever part of the output falls within the request
+          uint32_t n = wlen - strm.avail_out;
+          uint64_t want = offset + filled;
+          if( upos + n > want )
+          {
+            uint32_t skip = want - upos;
+            uint32_t cnt  = std::min<uint64_t>( n - skip, length - filled );
+            memcpy( buffer + filled, window.data() + wpos + skip, cnt );
+            filled += cnt;
+          }
+          wpos  += n;
+          upos  += n;
+          wfill  = std::min<uint32_t>( wfill + n, ZipSeekIndex::winSize );
+
+          if( ( strm.data_type & 128 ) && !( strm.data_type & 64 ) && upos >= nextpt )
+            Checkpoint();
+        }
+        return XRootDStatus();
+      }
+
+      //-----------------------------------------------------------------------
+      //! @return : offset of the next compressed byte to be provided
+      //-----------------------------------------------------------------------
+      inline uint64_t CompressedOffset() const
+      {
+        return cpos;
+      }
+
+      //-----------------------------------------------------------------------
+      //! @return : offset of the next uncompressed byte to be produced
+      //-----------------------------------------------------------------------
+      inline uint64_t UncompressedOffset() const
+      {
+        return upos;
+      }
+
+    private:
+
+      void Checkpoint()
+      {
+        ZipSeekIndex::Point pt;
+        pt.uoff  = upos;
+        pt.coff  = cpos - strm.avail_in;
+        pt.bits  = strm.data_type & 7;
+        pt.prime = strm.next_in > (Bytef*)input.data() ? strm.next_in[-1] : last;
+        auto win = std::make_shared<ZipCache::buffer_t>( wfill );
+        if( wfill < ZipSeekIndex::winSize )
+          std::copy( window.begin(), window.begin() + wfill, win->begin() );
+        else
+        {
+          auto end = std::copy( window.begin() + wpos, window.end(), win->begin() );
+          std::copy( window.begin(), window.begin() + wpos, end );
+        }
+        pt.window = std::move( win );
+        index->Add( std::move( pt ) );
+        nextpt = upos + ZipSeekIndex::span;
+      }
+
+      std::shared_ptr<ZipSeekIndex> index;  //< checkpoints of the file
+      z_stream                      strm;   //< the zlib stream
+      ZipCache::buffer_t            window; //< circular buffer with the latest output
+      ZipCache::buffer_t            input;  //< compressed data being consumed
+      uint32_t                      wpos;   //< next write position in the window
+      uint32_t                      wfill;  //< valid bytes in the window
+      uint64_t                      upos;   //< uncompressed offset of the next output byte
+      uint64_t                      cpos;   //< compressed offset of the next input byte to be provided
+      uint64_t                      nextpt; //< take the next checkpoint past this offset
+      uint8_t                       last;   //< last byte of the previous input
+      bool                          eos;    //< end of the deflate stream reached
   };
 
 }
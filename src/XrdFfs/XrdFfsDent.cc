@@ -27,8 +27,22 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <string>
+#include <unordered_map>
+
 #include "XrdFfs/XrdFfsDent.hh"
 
+namespace
+{
+struct XrdFfsDentStat {
+    struct stat st;
+    time_t expire;
+    bool negative;
+};
+
+std::unordered_map<std::string, struct XrdFfsDentStat> XrdFfsDentStats;
+}
+
 #ifdef __cplusplus
   extern "C" {
 #endif
@@ -265,6 +279,108 @@ void XrdFfsDent_cache_destroy()
         XrdFfsDent_dentcache_free(&XrdFfsDentCaches[i]);
 }
 
+/*
+   Attribute cache: stat() results, including negative ones, keyed on the
+   path seen by FUSE. Entries are added by getattr() and by directory listings
+   that carry stat information, they expire after "ttl" (or "negttl" for
+   negative ones) seconds and are dropped when the path, or an entry in the
+   directory, is modified through this instance. A zero ttl disables it.
+ */
+
+#define XrdFfsDent_MAXSTATS 1000000
+static time_t XrdFfsDentStat_ttl = 0, XrdFfsDentStat_negttl = 0;
+pthread_mutex_t XrdFfsDentStats_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void XrdFfsDent_stat_init(int ttl, int negttl)
+{
+    XrdFfsDentStat_ttl = (ttl > 0 ? ttl : 0);
+    XrdFfsDentStat_negttl = (negttl > 0 && ttl > 0 ? negttl : 0);
+}
+
+int XrdFfsDent_stat_enabled()
+{
+    return (XrdFfsDentStat_ttl != 0);
+}
+
+/*
+   _stat_search() returns 1 and fills *stbuf if the path is known to exist,
+   -1 if it is known not to exist and 0 if nothing (valid) is cached.
+ */
+int XrdFfsDent_stat_search(const char *path, struct stat *stbuf)
+{
+    int rval = 0;
+
+    if (XrdFfsDentStat_ttl == 0) return 0;
+
+    pthread_mutex_lock(&XrdFfsDentStats_mutex);
+    auto it = XrdFfsDentStats.find(path);
+    if (it != XrdFfsDentStats.end())
+    {
+        if (it->second.expire <= time(NULL))
+            XrdFfsDentStats.erase(it);
+        else if (it->second.negative)
+            rval = -1;
+        else
+        {
+            memcpy(stbuf, &it->second.st, sizeof(struct stat));
+            rval = 1;
+        }
+    }
+    pthread_mutex_unlock(&XrdFfsDentStats_mutex);
+    return rval;
+}
+
+static void XrdFfsDent_stat_add(const char *path, const struct stat *stbuf, time_t life)
+{
+    time_t now = time(NULL);
+
+    pthread_mutex_lock(&XrdFfsDentStats_mutex);
+    if (XrdFfsDentStats.size() >= XrdFfsDent_MAXSTATS)
+    {
+        for (auto it = XrdFfsDentStats.begin(); it != XrdFfsDentStats.end(); )
+            if (it->second.expire <= now) it = XrdFfsDentStats.erase(it);
+            else ++it;
+        if (XrdFfsDentStats.size() >= XrdFfsDent_MAXSTATS)
+            XrdFfsDentStats.clear();
+    }
+    struct XrdFfsDentStat &ent = XrdFfsDentStats[path];
+    if (stbuf != NULL)
+        memcpy(&ent.st, stbuf, sizeof(struct stat));
+    ent.negative = (stbuf == NULL);
+    ent.expire = now + life;
+    pthread_mutex_unlock(&XrdFfsDentStats_mutex);
+}
+
+void XrdFfsDent_stat_fill(const char *path, const struct stat *stbuf)
+{
+    if (XrdFfsDentStat_ttl != 0)
+        XrdFfsDent_stat_add(path, stbuf, XrdFfsDentStat_ttl);
+}
+
+void XrdFfsDent_stat_fillneg(const char *path)
+{
+    if (XrdFfsDentStat_negttl != 0)
+        XrdFfsDent_stat_add(path, NULL, XrdFfsDentStat_negttl);
+}
+
+/*
+   _stat_invalidate() drops the path and its parent directory, whose mtime
+   and link count change along with it.
+ */
+void XrdFfsDent_stat_invalidate(const char *path)
+{
+    if (XrdFfsDentStat_ttl == 0) return;
+
+    std::string p(path), d;
+    std::string::size_type i = p.rfind('/');
+    if (i != std::string::npos) d = p.substr(0, (i ? i : 1));
+
+    pthread_mutex_lock(&XrdFfsDentStats_mutex);
+    XrdFfsDentStats.erase(p);
+    if (!d.empty()) XrdFfsDentStats.erase(d);
+    pthread_mutex_unlock(&XrdFfsDentStats_mutex);
+}
+
 /*
 #include <cstdio>
 
@@ -31,6 +31,7 @@
 #include <cstdlib>
 #include <ctime>
 #include <pthread.h>
+#include <sys/stat.h>
 
 #ifdef __cplusplus
   extern "C" {
@@ -51,6 +52,13 @@ void XrdFfsDent_cache_destroy();
 int  XrdFfsDent_cache_fill(char *dname, char ***dnarray, int nents);
 int  XrdFfsDent_cache_search(char *dname, char *dentname);
 
+void XrdFfsDent_stat_init(int ttl, int negttl);
+int  XrdFfsDent_stat_enabled();
+int  XrdFfsDent_stat_search(const char *path, struct stat *stbuf);
+void XrdFfsDent_stat_fill(const char *path, const struct stat *stbuf);
+void XrdFfsDent_stat_fillneg(const char *path);
+void XrdFfsDent_stat_invalidate(const char *path);
+
 #ifdef __cplusplus
   }
 #endif
@@ -46,8 +46,14 @@
 #include <unistd.h>
 #include <cstdlib>
 #include <syslog.h>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
 #include "XrdFfs/XrdFfsPosix.hh"
+#include "XrdPosix/XrdPosixMap.hh"
 #include "XrdPosix/XrdPosixXrootd.hh"
+#include "XrdOuc/XrdOucECMsg.hh"
 #include "XrdFfs/XrdFfsMisc.hh"
 #include "XrdFfs/XrdFfsDent.hh"
 #include "XrdFfs/XrdFfsQueue.hh"
@@ -63,19 +69,24 @@
 
 #define MAXROOTURLLEN 1024 // this is also defined in other files
 
-int XrdFfsPosix_stat(const char *path, struct stat *buf)
+static void XrdFfsPosix_fixmode(struct stat *buf)
 {
-    int rc; 
-    errno = 0;
-    rc = XrdPosixXrootd::Stat(path, buf);
-    if (rc == 0 && S_ISBLK(buf->st_mode)) /* If 'buf' come from HPSS, xrootd will return it as a block device! */
-    {                                     /* So we re-mark it to a regular file */
+    if (S_ISBLK(buf->st_mode))        /* If 'buf' come from HPSS, xrootd will return it as a block device! */
+    {                                 /* So we re-mark it to a regular file */
         buf->st_mode &= 0007777;
         if ( buf->st_mode & S_IXUSR )
             buf->st_mode |= S_IFDIR;   /* a directory */
         else
             buf->st_mode |= S_IFREG;   /* a file */
     }
+}
+
+int XrdFfsPosix_stat(const char *path, struct stat *buf)
+{
+    int rc; 
+    errno = 0;
+    rc = XrdPosixXrootd::Stat(path, buf);
+    if (rc == 0) XrdFfsPosix_fixmode(buf);
     return rc;
 }
 
@@ -428,9 +439,11 @@ int XrdFfsPosix_truncateall(const char *rdrurl, const char *path, off_t size, ui
 
 struct XrdFfsPosixX_readdirall_args {
     char *url;
+    const char *path;
     int *res;
     int *err;
     struct XrdFfsDentnames **dents;
+    std::vector<std::pair<std::string, struct stat> > *stats;
 };
  
 /*
@@ -448,6 +461,42 @@ void* XrdFfsPosix_x_readdirall(void* x)
     DIR *dp;
     struct dirent *de;
 
+/*
+   When the attribute cache is on, list the directory with a single
+   dirlist-with-stat (kXR_dstat) request and return the attributes of
+   every entry, so that the getattr() calls of an "ls -l" need no further
+   round trips to the data servers. The caller merges the attributes
+   returned by all data servers.
+ */
+    if (args->path != NULL && args->path[0] == '/')
+    {
+        struct stat stbuf;
+        XrdOucECMsg ecMsg("[xrootdfs]");
+        XrdCl::URL url(args->url);
+        XrdCl::FileSystem fs(url);
+        XrdCl::DirectoryList *dl = 0;
+        XrdCl::XRootDStatus st = fs.DirList(url.GetPathWithParams(), XrdCl::DirListFlags::Stat, dl);
+        std::unique_ptr<XrdCl::DirectoryList> dlp(dl);
+
+        if (! st.IsOK())
+        {
+            *(args->res) = XrdPosixMap::Result(st, ecMsg, true);
+            *(args->err) = errno;
+            return NULL;
+        }
+        *(args->res) = 0;
+        for (auto it = dl->Begin(); it != dl->End(); ++it)
+        {
+            XrdFfsDent_names_add(args->dents, (char*)(*it)->GetName().c_str());
+            if (XrdPosixMap::Entry2Buf(**it, stbuf, ecMsg) == 0)
+            {
+                XrdFfsPosix_fixmode(&stbuf);
+                args->stats->emplace_back((*it)->GetName(), stbuf);
+            }
+        }
+        return NULL;
+    }
+
 /*
    Xrootd's Opendir will not return NULL even under some error. For instance,
    when it is supposed to return ENOENT or ENOTDIR, it actually returns 
@@ -480,6 +529,7 @@ int XrdFfsPosix_readdirall(const char *rdrurl, const char *path, char*** direnta
     int res_i[XrdFfs_MAX_NUM_NODES];
     int errno_i[XrdFfs_MAX_NUM_NODES];
     struct XrdFfsDentnames *dir_i[XrdFfs_MAX_NUM_NODES] = {0};
+    std::vector<std::pair<std::string, struct stat> > stats_i[XrdFfs_MAX_NUM_NODES];
     struct XrdFfsPosixX_readdirall_args args[XrdFfs_MAX_NUM_NODES];
     struct XrdFfsQueueTasks *jobs[XrdFfs_MAX_NUM_NODES];
 
@@ -510,9 +560,11 @@ int XrdFfsPosix_readdirall(const char *rdrurl, const char *path, char*** direnta
         strncat(newurls[i], path,  MAXROOTURLLEN - strlen(newurls[i]) -1);
         XrdFfsMisc_xrd_secsss_editurl(newurls[i], user_uid, 0);
         args[i].url = newurls[i];
+        args[i].path = (XrdFfsDent_stat_enabled() ? path : NULL);
         args[i].err = &errno_i[i];
         args[i].res = &res_i[i];
         args[i].dents = &dir_i[i];
+        args[i].stats = &stats_i[i];
 #ifdef NOUSE_QUEUE
         XrdFfsPosix_x_readdirall((void*) &args[i]);
     }   
@@ -535,6 +587,23 @@ int XrdFfsPosix_readdirall(const char *rdrurl, const char *path, char*** direnta
             break;
         }
 
+/*
+   Merge the attributes returned by the data servers the way statall() does:
+   the first data server, in URL order, holding an entry with a valid mtime
+   wins. This does not depend on the order in which the listings completed.
+ */
+    if (args[0].path != NULL && path[0] == '/')
+    {
+        std::map<std::string, struct stat> merged;
+        std::string dir(path);
+        if (dir.back() != '/') dir += '/';
+        for (i = 0; i < nurls; i++)
+            for (auto &entry : stats_i[i])
+                if (entry.second.st_mtime > 0) merged.insert(entry);
+        for (auto &entry : merged)
+            XrdFfsDent_stat_fill((dir + entry.first).c_str(), &entry.second);
+    }
+
     for (i = 0; i < nurls; i++)
         free(newurls[i]);
     for (i = 1; i < nurls; i++)
@@ -0,0 +1,278 @@
+/******************************************************************************/
+/*                                                                            */
+/*                       X r d F f s R a h e a d . c c                        */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+/*
+   Once a file opened read-only is read sequentially, the next few blocks
+   are requested with XrdPosix asynchronous reads. Several XrdCl reads are
+   then in flight while FUSE consumes the current block, instead of one
+   synchronous round trip per FUSE read request.
+
+   Data is always returned in full (a short count only happens at the end
+   of file) because, without direct_io, FUSE takes a short read as EOF.
+*/
+
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <pthread.h>
+
+#include "XrdFfs/XrdFfsRahead.hh"
+#include "XrdFfs/XrdFfsPosix.hh"
+#include "XrdPosix/XrdPosixCallBack.hh"
+#include "XrdPosix/XrdPosixXrootd.hh"
+
+#define XRDFFS_RAHEAD_MAXBLKS 64
+
+struct XrdFfsRaheadFile;
+
+class XrdFfsRaheadBlk : public XrdPosixCallBackIO
+{
+public:
+    void Complete(ssize_t Result);
+
+    struct XrdFfsRaheadFile *file;
+    char   *buf;
+    off_t   offset;
+    ssize_t len;      // -1 if the block holds no valid data
+    bool    pending;
+
+    XrdFfsRaheadBlk() : file(0), buf(0), offset(0), len(-1), pending(false) {}
+   ~XrdFfsRaheadBlk() {free(buf);}
+};
+
+struct XrdFfsRaheadFile {
+    pthread_mutex_t mlock;
+    pthread_cond_t cond;
+    off_t nextoff;    // where a sequential reader would read next
+    off_t eofoff;     // end of file once a short block was seen, else -1
+    XrdFfsRaheadBlk *blks;
+};
+
+static struct XrdFfsRaheadFile **XrdFfsRaheadFiles = NULL;
+static int XrdFfsRahead_baseFD, XrdFfsRaheadNFILES, XrdFfsRaheadNblks = 0;
+static size_t XrdFfsRaheadBlksz;
+
+void XrdFfsRaheadBlk::Complete(ssize_t Result)
+{
+    pthread_mutex_lock(&file->mlock);
+    len = Result;
+    pending = false;
+    if (Result >= 0 && (size_t)Result < XrdFfsRaheadBlksz)
+    {
+        off_t eof = offset + Result;
+        if (file->eofoff < 0 || eof < file->eofoff) file->eofoff = eof;
+    }
+    pthread_cond_broadcast(&file->cond);
+    pthread_mutex_unlock(&file->mlock);
+}
+
+#ifdef __cplusplus
+  extern "C" {
+#endif
+
+void XrdFfsRahead_init(int basefd, int maxfd, int nblks, size_t blksz)
+{
+    XrdFfsRahead_baseFD = basefd;
+    XrdFfsRaheadNFILES = maxfd;
+    XrdFfsRaheadNblks = (nblks > XRDFFS_RAHEAD_MAXBLKS ? XRDFFS_RAHEAD_MAXBLKS : nblks);
+    XrdFfsRaheadBlksz = blksz;
+    if (nblks <= 0 || blksz == 0)
+    {
+        XrdFfsRaheadNblks = 0;
+        return;
+    }
+    XrdFfsRaheadFiles = (struct XrdFfsRaheadFile**)calloc(maxfd, sizeof(struct XrdFfsRaheadFile*));
+    if (XrdFfsRaheadFiles == NULL) XrdFfsRaheadNblks = 0;
+}
+
+int XrdFfsRahead_create(int fd)
+/* Create the read-ahead state for a given file descriptor. Read-ahead is
+ * silently skipped when it is disabled or memory is short.
+ *
+ * fd:      file descriptor
+ *
+ * returns: 1 - read-ahead is enabled for the file
+ *          0 - plain reads must be used
+ */
+{
+    struct XrdFfsRaheadFile *fp;
+    int i;
+
+    XrdFfsRahead_destroy(fd);
+    fd -= XrdFfsRahead_baseFD;
+    if (XrdFfsRaheadNblks == 0 || fd < 0 || fd >= XrdFfsRaheadNFILES)
+        return 0;
+
+    fp = new struct XrdFfsRaheadFile;
+    fp->nextoff = 0;
+    fp->eofoff = -1;
+    fp->blks = new XrdFfsRaheadBlk[XrdFfsRaheadNblks];
+    for (i = 0; i < XrdFfsRaheadNblks; i++)
+    {
+        fp->blks[i].file = fp;
+        if ((fp->blks[i].buf = (char*)malloc(XrdFfsRaheadBlksz)) == NULL)
+        {
+            delete [] fp->blks;
+            delete fp;
+            return 0;
+        }
+    }
+    pthread_mutex_init(&fp->mlock, NULL);
+    pthread_cond_init(&fp->cond, NULL);
+    XrdFfsRaheadFiles[fd] = fp;
+    return 1;
+}
+
+void XrdFfsRahead_destroy(int fd)
+{
+    struct XrdFfsRaheadFile *fp;
+    int i;
+
+    fd -= XrdFfsRahead_baseFD;
+    if (XrdFfsRaheadFiles == NULL || fd < 0 || fd >= XrdFfsRaheadNFILES
+        || (fp = XrdFfsRaheadFiles[fd]) == NULL)
+        return;
+    XrdFfsRaheadFiles[fd] = NULL;
+
+/* outstanding reads still refer to the buffers, let them finish first */
+    pthread_mutex_lock(&fp->mlock);
+    for (i = 0; i < XrdFfsRaheadNblks; i++)
+        while (fp->blks[i].pending) pthread_cond_wait(&fp->cond, &fp->mlock);
+    pthread_mutex_unlock(&fp->mlock);
+
+    pthread_cond_destroy(&fp->cond);
+    pthread_mutex_destroy(&fp->mlock);
+    delete [] fp->blks;
+    delete fp;
+}
+
+static XrdFfsRaheadBlk *XrdFfsRahead_find(struct XrdFfsRaheadFile *fp, off_t offset)
+{
+    off_t boff = (offset / XrdFfsRaheadBlksz) * XrdFfsRaheadBlksz;
+    int i;
+
+    for (i = 0; i < XrdFfsRaheadNblks; i++)
+        if ((fp->blks[i].pending || fp->blks[i].len >= 0) && fp->blks[i].offset == boff)
+            return &fp->blks[i];
+    return NULL;
+}
+
+ssize_t XrdFfsRahead_pread(int fd, char *buf, size_t len, off_t offset)
+{
+    struct XrdFfsRaheadFile *fp;
+    XrdFfsRaheadBlk *blk, *issue[XRDFFS_RAHEAD_MAXBLKS];
+    int i, nissue = 0;
+    size_t done = 0, n;
+    off_t cur, boff, winbeg, winend;
+    ssize_t rc;
+    bool sequential, ateof = false;
+
+    if (XrdFfsRaheadFiles == NULL || fd - XrdFfsRahead_baseFD < 0
+        || fd - XrdFfsRahead_baseFD >= XrdFfsRaheadNFILES
+        || (fp = XrdFfsRaheadFiles[fd - XrdFfsRahead_baseFD]) == NULL)
+        return XrdFfsPosix_pread(fd, buf, len, offset);
+
+    pthread_mutex_lock(&fp->mlock);
+    sequential = (offset == fp->nextoff);
+    fp->nextoff = offset + len;
+
+/* copy what the read-ahead blocks hold, waiting for those still in flight */
+    while (done < len)
+    {
+        cur = offset + done;
+        if ((blk = XrdFfsRahead_find(fp, cur)) == NULL)
+            break;
+        if (blk->pending)
+        {
+            pthread_cond_wait(&fp->cond, &fp->mlock);
+            continue;
+        }
+        if (cur >= blk->offset + blk->len)
+        {
+            ateof = ((size_t)blk->len < XrdFfsRaheadBlksz);
+            break;
+        }
+        n = blk->offset + blk->len - cur;
+        if (n > len - done) n = len - done;
+        memcpy(buf + done, blk->buf + (cur - blk->offset), n);
+        done += n;
+    }
+
+/*
+   For a sequential reader, make sure the blocks following the current
+   position are being fetched. Blocks outside of that window are recycled.
+   The reads are started after the lock is dropped as an immediate error
+   calls back on this thread.
+*/
+    if (sequential)
+    {
+        winbeg = (offset / XrdFfsRaheadBlksz) * XrdFfsRaheadBlksz;
+        boff = ((offset + len) / XrdFfsRaheadBlksz) * XrdFfsRaheadBlksz;
+        winend = boff + XrdFfsRaheadNblks * XrdFfsRaheadBlksz;
+        for (i = 0; i < XrdFfsRaheadNblks; i++, boff += XrdFfsRaheadBlksz)
+        {
+            if (fp->eofoff >= 0 && boff >= fp->eofoff) break;
+            if (XrdFfsRahead_find(fp, boff) != NULL) continue;
+            for (int j = 0; j < XrdFfsRaheadNblks; j++)
+            {
+                blk = &fp->blks[j];
+                if (blk->pending) continue;
+                if (blk->len >= 0 && blk->offset >= winbeg && blk->offset < winend)
+                    continue;
+                blk->offset = boff;
+                blk->len = -1;
+                blk->pending = true;
+                issue[nissue++] = blk;
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock(&fp->mlock);
+
+    for (i = 0; i < nissue; i++)
+        XrdPosixXrootd::Pread(fd, issue[i]->buf, XrdFfsRaheadBlksz, issue[i]->offset, issue[i]);
+
+/* anything not covered by read-ahead is read directly */
+    if (done < len && !ateof)
+    {
+        rc = XrdFfsPosix_pread(fd, buf + done, len - done, offset + done);
+        if (rc < 0)
+            return (done ? (ssize_t)done : -1);
+        done += rc;
+    }
+    return (ssize_t)done;
+}
+
+#ifdef __cplusplus
+  }
+#endif
@@ -27,7 +27,11 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#ifdef HAVE_FUSE3
+#define FUSE_USE_VERSION 35
+#else
 #define FUSE_USE_VERSION 26
+#endif
 
 #include <cstdio>
 #include <cstdlib>
@@ -41,8 +45,13 @@
 #endif
 #endif
 
+#ifdef HAVE_FUSE3
+#include <fuse3/fuse.h>
+#include <fuse3/fuse_opt.h>
+#else
 #include <fuse.h>
 #include <fuse/fuse_opt.h>
+#endif
 #include <cctype>
 #include <cstring>
 #include <fcntl.h>
@@ -63,12 +72,25 @@
 #include "XrdFfs/XrdFfsMisc.hh"
 #include "XrdFfs/XrdFfsWcache.hh"
 #include "XrdFfs/XrdFfsQueue.hh"
-//#include "XrdFfs/XrdFfsDent.hh"
+#include "XrdFfs/XrdFfsRahead.hh"
+#include "XrdFfs/XrdFfsDent.hh"
 #include "XrdFfs/XrdFfsFsinfo.hh"
 #include "XrdPosix/XrdPosixXrootd.hh"
 
 #define MAXROOTURLLEN 1024 // this is also defined in other files
 
+/*
+   With FUSE 3 big writes are always on and the kernel negotiates the number
+   of pages per request from max_write, so much larger requests are used.
+*/
+#ifdef HAVE_FUSE3
+#define XROOTDFS_MAXWRITE "1048576"
+#define XrdFfsFill(filler, buf, name) filler(buf, name, NULL, 0, (enum fuse_fill_dir_flags)0)
+#else
+#define XROOTDFS_MAXWRITE "131072"
+#define XrdFfsFill(filler, buf, name) filler(buf, name, NULL, 0)
+#endif
+
 struct XROOTDFS {
     char *rdr;
     char *cns;
@@ -79,18 +101,51 @@ struct XROOTDFS {
     bool ofsfwd;
     int  nworkers;
     int  maxfd;
+    int  rablocks;
+    int  rablksz;
+    int  writeback;
+    int  statttl;
+    int  negttl;
 };
 
 int cwdfd; // File descript of the initial working dir
 
 struct XROOTDFS xrootdfs;
-static struct fuse_opt xrootdfs_opts[14];
+static struct fuse_opt xrootdfs_opts[19];
 
 enum { OPT_KEY_HELP, OPT_KEY_SECSSS, };
 
 bool usingEC = false;
 
+#ifdef HAVE_FUSE3
+static void xrootdfs_setconn(struct fuse_conn_info *conn, struct fuse_config *cfg)
+{
+/* large requests, spliced to and from the fuse device where the kernel can */
+    conn->max_write = atoi(XROOTDFS_MAXWRITE);
+    conn->max_readahead = conn->max_write;
+    if (conn->capable & FUSE_CAP_ASYNC_READ) conn->want |= FUSE_CAP_ASYNC_READ;
+    if (conn->capable & FUSE_CAP_SPLICE_READ) conn->want |= FUSE_CAP_SPLICE_READ;
+    if (conn->capable & FUSE_CAP_SPLICE_WRITE) conn->want |= FUSE_CAP_SPLICE_WRITE;
+    if (conn->capable & FUSE_CAP_SPLICE_MOVE) conn->want |= FUSE_CAP_SPLICE_MOVE;
+
+/* let the kernel gather small writes, which makes the write cache redundant */
+    if (xrootdfs.writeback && (conn->capable & FUSE_CAP_WRITEBACK_CACHE))
+        conn->want |= FUSE_CAP_WRITEBACK_CACHE;
+    else
+        xrootdfs.writeback = 0;
+
+/*
+   Keep cached pages across open() as long as the file's mtime and size
+   (as returned by getattr) do not change.
+*/
+    cfg->kernel_cache = 0;
+    cfg->auto_cache = 1;
+}
+
+static void* xrootdfs_init(struct fuse_conn_info *conn, struct fuse_config *cfg)
+#else
 static void* xrootdfs_init(struct fuse_conn_info *conn)
+#endif
 {
     struct passwd pw, *pwp;
     char *pwbuf;
@@ -131,6 +186,13 @@ static void* xrootdfs_init(struct fuse_conn_info *conn)
     XrdPosixXrootd *abc = new XrdPosixXrootd(-xrootdfs.maxfd);
     XrdFfsMisc_xrd_init(xrootdfs.rdr,xrootdfs.urlcachelife,0);
     XrdFfsWcache_init(abc->fdOrigin(), xrootdfs.maxfd);
+    XrdFfsDent_stat_init(xrootdfs.statttl, xrootdfs.negttl);
+    if (! usingEC)
+        XrdFfsRahead_init(abc->fdOrigin(), xrootdfs.maxfd, xrootdfs.rablocks, xrootdfs.rablksz);
+
+#ifdef HAVE_FUSE3
+    xrootdfs_setconn(conn, cfg);
+#endif
 
     char *next, *savptr;
     next = strtok_r(strdup(xrootdfs.rdr), "//", &savptr);
@@ -163,7 +225,12 @@ static void* xrootdfs_init(struct fuse_conn_info *conn)
     return NULL;
 }
 
+#ifdef HAVE_FUSE3
+static int xrootdfs_getattr(const char *path, struct stat *stbuf,
+                            struct fuse_file_info *fi)
+#else
 static int xrootdfs_getattr(const char *path, struct stat *stbuf)
+#endif
 {
 //  int res, fd;
     int res;
@@ -193,15 +260,28 @@ static int xrootdfs_getattr(const char *path, struct stat *stbuf)
     res = XrdFfsPosix_stat(rootpath, stbuf);
 */
 
-    if (xrootdfs.cns != NULL && xrootdfs.fastls != NULL)
+/* try the attribute cache first, it also remembers paths that don't exist */
+    res = XrdFfsDent_stat_search(path, stbuf);
+    if (res < 0)
+        return -ENOENT;
+    else if (res > 0)
+        res = 0;
+    else if (xrootdfs.cns != NULL && xrootdfs.fastls != NULL)
     {
         strncat(rootpath,xrootdfs.cns, MAXROOTURLLEN - strlen(rootpath) -1);
         strncat(rootpath,path, MAXROOTURLLEN - strlen(rootpath) -1);
         XrdFfsMisc_xrd_secsss_editurl(rootpath, fuse_get_context()->uid, 0);
         res = XrdFfsPosix_stat(rootpath, stbuf);
+        if (res == 0) XrdFfsDent_stat_fill(path, stbuf);
     }
     else
+    {
         res = XrdFfsPosix_statall(xrootdfs.rdr, path, stbuf, fuse_get_context()->uid);
+        if (res == 0)
+            XrdFfsDent_stat_fill(path, stbuf);
+        else if (errno == ENOENT && xrootdfs.cns == NULL)
+            XrdFfsDent_stat_fillneg(path);
+    }
 
 //    seteuid(getuid());
 //    setegid(getgid());
@@ -305,8 +385,14 @@ static int xrootdfs_readlink(const char *path, char *buf, size_t size)
     return 0;
 }
 
+#ifdef HAVE_FUSE3
+static int xrootdfs_readdir(const char *path, void *buf, fuse_fill_dir_t filler,
+                       off_t offset, struct fuse_file_info *fi,
+                       enum fuse_readdir_flags flags)
+#else
 static int xrootdfs_readdir(const char *path, void *buf, fuse_fill_dir_t filler,
                        off_t offset, struct fuse_file_info *fi)
+#endif
 {
     DIR *dp;
     struct dirent *de;
@@ -340,7 +426,7 @@ static int xrootdfs_readdir(const char *path, void *buf, fuse_fill_dir_t filler,
             st.st_ino = de->d_ino;
             st.st_mode = de->d_type << 12;
  */
-            if (filler(buf, de->d_name, NULL, 0))
+            if (XrdFfsFill(filler, buf, de->d_name))
                 break;
         }
         XrdFfsPosix_closedir(dp);
@@ -354,7 +440,7 @@ static int xrootdfs_readdir(const char *path, void *buf, fuse_fill_dir_t filler,
          n = XrdFfsPosix_readdirall(xrootdfs.rdr, path, &dnarray, fuse_get_context()->uid);
 
          for (i = 0; i < n; i++)
-             if (filler(buf, dnarray[i], NULL, 0)) break;
+             if (XrdFfsFill(filler, buf, dnarray[i])) break;
 
 /* 
   this loop should not be merged with the above loop because all members of 
@@ -416,6 +502,7 @@ static int xrootdfs_mknod(const char *path, mode_t mode, dev_t rdev)
     int res, fd;
     if (!S_ISREG(mode))
         return -EPERM;
+    XrdFfsDent_stat_invalidate(path);
 /* 
    Around May 2008, the O_EXCL was added to the _open(). No reason was given. It is removed again 
    due to the following reason (the situation that redirector thinks a file exist while it doesn't):
@@ -452,12 +539,14 @@ static int xrootdfs_create(const char *path, mode_t mode, struct fuse_file_info
  */
 {
     int res, fd = -1;
+    int acc = (xrootdfs.writeback ? O_RDWR : O_WRONLY);  // see xrootdfs_open()
     if (!S_ISREG(mode))
         return -EPERM;
+    XrdFfsDent_stat_invalidate(path);
     if (usingEC)
-        res = xrootdfs_do_create(path, xrootdfs.rdr, O_CREAT | O_WRONLY | O_EXCL, true, &fd);
+        res = xrootdfs_do_create(path, xrootdfs.rdr, O_CREAT | acc | O_EXCL, true, &fd);
     else
-        res = xrootdfs_do_create(path, xrootdfs.rdr, O_CREAT | O_WRONLY, true, &fd);
+        res = xrootdfs_do_create(path, xrootdfs.rdr, O_CREAT | acc, true, &fd);
     if (res < 0) return res;
     fi->fh = fd;
     XrdFfsWcache_create(fd, fi->flags);    // Unlike mknod and like open, prepare wcache.
@@ -482,6 +571,7 @@ static int xrootdfs_mkdir(const char *path, mode_t mode)
  */
     rootpath[0]='\0';
 
+    XrdFfsDent_stat_invalidate(path);
     if (xrootdfs.cns != NULL)
         strncat(rootpath,xrootdfs.cns, MAXROOTURLLEN - strlen(rootpath) -1);
     else
@@ -517,6 +607,7 @@ static int xrootdfs_unlink(const char *path)
     strncat(rootpath,path, MAXROOTURLLEN - strlen(rootpath) -1);
 
     XrdFfsMisc_xrd_secsss_register(fuse_get_context()->uid, fuse_get_context()->gid, 0);
+    XrdFfsDent_stat_invalidate(path);
     if (xrootdfs.ofsfwd == true)
     {
         XrdFfsMisc_xrd_secsss_editurl(rootpath, fuse_get_context()->uid, 0);
@@ -553,6 +644,7 @@ static int xrootdfs_rmdir(const char *path)
     strncat(rootpath,path, MAXROOTURLLEN - strlen(rootpath) -1);
 
     XrdFfsMisc_xrd_secsss_register(fuse_get_context()->uid, fuse_get_context()->gid, 0);
+    XrdFfsDent_stat_invalidate(path);
     if (xrootdfs.ofsfwd == true)
     { 
         XrdFfsMisc_xrd_secsss_editurl(rootpath, fuse_get_context()->uid, 0);
@@ -602,12 +694,25 @@ static int xrootdfs_symlink(const char *from, const char *to)
     return -EIO;
 }
 
+#ifdef HAVE_FUSE3
+static int xrootdfs_rename(const char *from, const char *to, unsigned int flags)
+#else
 static int xrootdfs_rename(const char *from, const char *to)
+#endif
 {
     int res;
     char from_path[MAXROOTURLLEN], to_path[MAXROOTURLLEN];
     struct stat stbuf;
 
+#ifdef HAVE_FUSE3
+/* RENAME_NOREPLACE and RENAME_EXCHANGE can not be done atomically */
+    if (flags)
+        return -EINVAL;
+#endif
+
+    XrdFfsDent_stat_invalidate(from);
+    XrdFfsDent_stat_invalidate(to);
+
     from_path[0]='\0';
     strncat(from_path, xrootdfs.rdr, MAXROOTURLLEN - strlen(from_path) -1);
     strncat(from_path, from, MAXROOTURLLEN - strlen(from_path) -1);
@@ -671,7 +776,11 @@ static int xrootdfs_link(const char *from, const char *to)
     return -EMLINK;
 }
 
+#ifdef HAVE_FUSE3
+static int xrootdfs_chmod(const char *path, mode_t mode, struct fuse_file_info *fi)
+#else
 static int xrootdfs_chmod(const char *path, mode_t mode)
+#endif
 {
 /*
     int res;
@@ -683,7 +792,12 @@ static int xrootdfs_chmod(const char *path, mode_t mode)
     return 0;
 }
 
+#ifdef HAVE_FUSE3
+static int xrootdfs_chown(const char *path, uid_t uid, gid_t gid,
+                          struct fuse_file_info *fi)
+#else
 static int xrootdfs_chown(const char *path, uid_t uid, gid_t gid)
+#endif
 {
 /*
     int res;
@@ -703,6 +817,7 @@ static int xrootdfs_ftruncate(const char *path, off_t size,
 //  char rootpath[1024];
                                                                                                                                            
     fd = (int) fi->fh;
+    XrdFfsDent_stat_invalidate(path);
     XrdFfsWcache_flush(fd);
     res = XrdFfsPosix_ftruncate(fd, size);
     if (res == -1)
@@ -726,16 +841,28 @@ static int xrootdfs_ftruncate(const char *path, off_t size,
     return 0;
 }
 
+#ifdef HAVE_FUSE3
+static int xrootdfs_truncate(const char *path, off_t size,
+                             struct fuse_file_info *fi)
+#else
 static int xrootdfs_truncate(const char *path, off_t size)
+#endif
 {
     int res;
     char rootpath[MAXROOTURLLEN];
 
+#ifdef HAVE_FUSE3
+/* FUSE 3 has no ftruncate(), an open file is passed along instead */
+    if (fi != NULL)
+        return xrootdfs_ftruncate(path, size, fi);
+#endif
+
     rootpath[0]='\0';
     strncat(rootpath,xrootdfs.rdr, MAXROOTURLLEN - strlen(rootpath) -1);
     strncat(rootpath,path, MAXROOTURLLEN - strlen(rootpath) -1);
 
     XrdFfsMisc_xrd_secsss_register(fuse_get_context()->uid, fuse_get_context()->gid, 0);
+    XrdFfsDent_stat_invalidate(path);
     if (xrootdfs.ofsfwd == true)
     {
         XrdFfsMisc_xrd_secsss_editurl(rootpath, fuse_get_context()->uid, 0);
@@ -761,7 +888,12 @@ static int xrootdfs_truncate(const char *path, off_t size)
     return 0;
 }
 
+#ifdef HAVE_FUSE3
+static int xrootdfs_utimens(const char *path, const struct timespec ts[2],
+                            struct fuse_file_info *fi)
+#else
 static int xrootdfs_utimens(const char *path, const struct timespec ts[2])
+#endif
 {
 /*
     int res;
@@ -792,6 +924,17 @@ static int xrootdfs_open(const char *path, struct fuse_file_info *fi)
     strncat(rootpath,xrootdfs.rdr, MAXROOTURLLEN - strlen(rootpath) -1);
     strncat(rootpath,path, MAXROOTURLLEN - strlen(rootpath) -1);
 
+/*
+   With writeback caching the kernel may read a file opened write-only to
+   fill partial pages, and it takes care of O_APPEND itself.
+*/
+    if (xrootdfs.writeback)
+    {
+        if ((fi->flags & O_ACCMODE) == O_WRONLY)
+            fi->flags = (fi->flags & ~O_ACCMODE) | O_RDWR;
+        fi->flags &= ~O_APPEND;
+    }
+
     XrdFfsMisc_xrd_secsss_register(fuse_get_context()->uid, fuse_get_context()->gid, &lid);
     XrdFfsMisc_xrd_secsss_editurl(rootpath, fuse_get_context()->uid, &lid);
     fd = XrdFfsPosix_open(rootpath, fi->flags, S_IRUSR|S_IWUSR|S_IRGRP|S_IROTH);
@@ -799,6 +942,8 @@ static int xrootdfs_open(const char *path, struct fuse_file_info *fi)
         return -errno;
 
     fi->fh = fd;
+    if ((fi->flags & O_ACCMODE) == O_RDONLY && ! usingEC)
+        XrdFfsRahead_create(fd);
     // be careful, 0 means error for this function
     if (XrdFfsWcache_create(fi->fh, fi->flags))
         return 0;
@@ -833,6 +978,8 @@ static int xrootdfs_read(const char *path, char *buf, size_t size, off_t offset,
         else
             res = XrdFfsPosix_pread(fd, buf, size, offset);
     }
+    else if ((fi->flags & O_ACCMODE) == O_RDONLY)
+        res = XrdFfsRahead_pread(fd, buf, size, offset);
     else
         res = XrdFfsPosix_pread(fd, buf, size, offset);
 
@@ -857,6 +1004,8 @@ static int xrootdfs_write(const char *path, const char *buf, size_t size,
     res = XrdFfsWcache_pwrite(fd, (char *)buf, size, offset);
     if (res == -1)
         res = -errno;
+    else
+        XrdFfsDent_stat_invalidate(path);
 
     return res;
 }
@@ -940,7 +1089,10 @@ static int xrootdfs_release(const char *path, struct fuse_file_info *fi)
     fd = (int) fi->fh;
     XrdFfsWcache_flush(fd);
     XrdFfsWcache_destroy(fd);
+    XrdFfsRahead_destroy(fd);
     XrdFfsPosix_close(fd);
+    if ((fi->flags & O_ACCMODE) != O_RDONLY)
+        XrdFfsDent_stat_invalidate(path);
     fi->fh = 0;
 /* 
    Return at here because the current version of Cluster Name Space daemon 
@@ -1268,7 +1420,7 @@ static void xrootdfs_usage(const char *progname)
 "    -h -help --help          print help\n"
 "\n"
 "Default options:\n"
-"    fsname=xrootdfs,allow_other,max_write=131072,attr_timeout=10,entry_timeout=10,negative_timeout=5\n"
+"    fsname=xrootdfs,allow_other,max_write=" XROOTDFS_MAXWRITE ",attr_timeout=10,entry_timeout=10,negative_timeout=5\n"
 "  In case of an Erasure Encoding storage, entry_timeout=0\n"
 "\n"
 "[Required]\n"
@@ -1283,6 +1435,13 @@ static void xrootdfs_usage(const char *progname)
 "    -o maxfd=N               number of virtual file descriptors for posix requests, default 8192 (min 2048)\n"
 "    -o nworkers=N            number of workers to handle parallel requests to data servers, default 4\n"
 "    -o fastls=RDR            set to RDR when CNS is presented will cause stat() to go to redirector\n"
+"    -o readahead=N           number of blocks read ahead of a sequential reader, default 4 (0 disables)\n"
+"    -o rablksz=N             size in bytes of a read-ahead block, default 1048576\n"
+"    -o statttl=N             seconds to cache file attributes and directory listings, default 10 (0 disables)\n"
+"    -o negttl=N              seconds to remember that a path does not exist, default 5\n"
+#ifdef HAVE_FUSE3
+"    -o writeback             let the kernel cache writes (writeback caching)\n"
+#endif
 "\n", progname);
 }
 
@@ -1302,7 +1461,11 @@ static int xrootdfs_opt_proc(void* data, const char* arg, int key, struct fuse_a
         return 0;
       case OPT_KEY_HELP:
         xrootdfs_usage(outargs->argv[0]);
+#ifdef HAVE_FUSE3
+        fuse_opt_add_arg(outargs, "-h");
+#else
         fuse_opt_add_arg(outargs, "-ho");
+#endif
         fuse_main(outargs->argc, outargs->argv, &xrootdfs_oper, NULL);
         exit(1);
       default:
@@ -1328,7 +1491,9 @@ int main(int argc, char *argv[])
     xrootdfs_oper.link		= xrootdfs_link;
     xrootdfs_oper.chmod		= xrootdfs_chmod;
     xrootdfs_oper.chown		= xrootdfs_chown;
+#ifndef HAVE_FUSE3
     xrootdfs_oper.ftruncate	= xrootdfs_ftruncate;
+#endif
     xrootdfs_oper.truncate	= xrootdfs_truncate;
     xrootdfs_oper.utimens	= xrootdfs_utimens;
     xrootdfs_oper.open		= xrootdfs_open;
@@ -1353,16 +1518,16 @@ int main(int argc, char *argv[])
     if (getenv("XROOTDFS_NO_ALLOW_OTHER") != NULL && ! strcmp(getenv("XROOTDFS_NO_ALLOW_OTHER"),"1") )
      {
         if (! usingEC)
-            cmdline_opts[2] = strdup("fsname=xrootdfs,max_write=131072,attr_timeout=10,entry_timeout=10,negative_timeout=5");
+            cmdline_opts[2] = strdup("fsname=xrootdfs,max_write=" XROOTDFS_MAXWRITE ",attr_timeout=10,entry_timeout=10,negative_timeout=5");
         else
-            cmdline_opts[2] = strdup("fsname=xrootdfs,max_write=131072,attr_timeout=10,entry_timeout=0,negative_timeout=5");
+            cmdline_opts[2] = strdup("fsname=xrootdfs,max_write=" XROOTDFS_MAXWRITE ",attr_timeout=10,entry_timeout=0,negative_timeout=5");
     }
     else
     {
         if (! usingEC)
-            cmdline_opts[2] = strdup("fsname=xrootdfs,allow_other,max_write=131072,attr_timeout=10,entry_timeout=10,negative_timeout=5");
+            cmdline_opts[2] = strdup("fsname=xrootdfs,allow_other,max_write=" XROOTDFS_MAXWRITE ",attr_timeout=10,entry_timeout=10,negative_timeout=5");
         else
-            cmdline_opts[2] = strdup("fsname=xrootdfs,allow_other,max_write=131072,attr_timeout=10,entry_timeout=0,negative_timeout=5");
+            cmdline_opts[2] = strdup("fsname=xrootdfs,allow_other,max_write=" XROOTDFS_MAXWRITE ",attr_timeout=10,entry_timeout=0,negative_timeout=5");
     }
 
     for (int i = 1; i < argc; i++)
@@ -1430,7 +1595,30 @@ int main(int argc, char *argv[])
     xrootdfs_opts[12].offset = offsetof(struct XROOTDFS, maxfd);
     xrootdfs_opts[12].value = 0;
 
-    xrootdfs_opts[13].templ = NULL;
+/* sequential read-ahead */
+    xrootdfs_opts[13].templ = "readahead=%d";
+    xrootdfs_opts[13].offset = offsetof(struct XROOTDFS, rablocks);
+    xrootdfs_opts[13].value = 0;
+
+    xrootdfs_opts[14].templ = "rablksz=%d";
+    xrootdfs_opts[14].offset = offsetof(struct XROOTDFS, rablksz);
+    xrootdfs_opts[14].value = 0;
+
+/* kernel writeback caching (FUSE 3 only) */
+    xrootdfs_opts[15].templ = "writeback";
+    xrootdfs_opts[15].offset = offsetof(struct XROOTDFS, writeback);
+    xrootdfs_opts[15].value = 1;
+
+/* attribute cache */
+    xrootdfs_opts[16].templ = "statttl=%d";
+    xrootdfs_opts[16].offset = offsetof(struct XROOTDFS, statttl);
+    xrootdfs_opts[16].value = 0;
+
+    xrootdfs_opts[17].templ = "negttl=%d";
+    xrootdfs_opts[17].offset = offsetof(struct XROOTDFS, negttl);
+    xrootdfs_opts[17].value = 0;
+
+    xrootdfs_opts[18].templ = NULL;
 
 /* initialize struct xrootdfs */
 //    memset(&xrootdfs, 0, sizeof(xrootdfs));
@@ -1443,6 +1631,11 @@ int main(int argc, char *argv[])
     xrootdfs.urlcachelife = strdup("3650d"); /* 10 years */
     xrootdfs.nworkers = 4;
     xrootdfs.maxfd = 8192;
+    xrootdfs.rablocks = 4;
+    xrootdfs.rablksz = 1048576;
+    xrootdfs.writeback = 0;
+    xrootdfs.statttl = 10;
+    xrootdfs.negttl = (usingEC ? 0 : 5);
 
 /* Get options from environment variables first */
     xrootdfs.rdr = getenv("XROOTDFS_RDRURL");
@@ -1453,6 +1646,11 @@ int main(int argc, char *argv[])
     if (getenv("XROOTDFS_OFSFWD") != NULL && ! strcmp(getenv("XROOTDFS_OFSFWD"),"1")) xrootdfs.ofsfwd = true;
     if (getenv("XROOTDFS_NWORKERS") != NULL) sscanf(getenv("XROOTDFS_NWORKERS"), "%d", &xrootdfs.nworkers);
     if (getenv("XROOTDFS_MAXFD") != NULL) sscanf(getenv("XROOTDFS_MAXFD"), "%d", &xrootdfs.maxfd);
+    if (getenv("XROOTDFS_READAHEAD") != NULL) sscanf(getenv("XROOTDFS_READAHEAD"), "%d", &xrootdfs.rablocks);
+    if (getenv("XROOTDFS_RABLKSZ") != NULL) sscanf(getenv("XROOTDFS_RABLKSZ"), "%d", &xrootdfs.rablksz);
+    if (getenv("XROOTDFS_STATTTL") != NULL) sscanf(getenv("XROOTDFS_STATTTL"), "%d", &xrootdfs.statttl);
+    if (getenv("XROOTDFS_NEGTTL") != NULL) sscanf(getenv("XROOTDFS_NEGTTL"), "%d", &xrootdfs.negttl);
+    if (getenv("XROOTDFS_WRITEBACK") != NULL && ! strcmp(getenv("XROOTDFS_WRITEBACK"),"1")) xrootdfs.writeback = 1;
 
 /* Parse XrootdFS options, will overwrite those defined in environment variables */
     fuse_opt_parse(&args, &xrootdfs, xrootdfs_opts, xrootdfs_opt_proc);
@@ -1486,6 +1684,10 @@ int main(int argc, char *argv[])
     }
 
     if (xrootdfs.maxfd < 2048) xrootdfs.maxfd = 2048;
+#ifndef HAVE_FUSE3
+    xrootdfs.writeback = 0;
+#endif
+    if (xrootdfs.rablksz < 65536) xrootdfs.rablksz = 65536;
 
     signal(SIGUSR1,xrootdfs_sigusr1_handler);
 
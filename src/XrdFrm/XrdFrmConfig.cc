@@ -152,6 +152,11 @@ XrdFrmConfig::XrdFrmConfig(SubSys ss, const char *vopts, const char *uinfo)
    xfrMax   = 2;
    xfrMaxIn = 0;
    xfrMaxOt = 0;
+   xfrBatch = 8;
+   xfrAgeMax= 30*60;
+   xfrSmall = 0;
+   memset(xfrQMax,  0, sizeof(xfrQMax));
+   memset(xfrQRate, 0, sizeof(xfrQRate));
    FailHold = 3*60*60;
    IdleHold = 10*60;
    WaitMigr = 60*60;
@@ -178,6 +183,8 @@ XrdFrmConfig::XrdFrmConfig(SubSys ss, const char *vopts, const char *uinfo)
    pProg    = 0;
    Fix      = 0;
    dirHold  = 40*60*60;
+   scanThreads = 1;
+   scanIndex   = 0;
    runOld   = 0;
    runNew   = 1;
    nonXA    = 0;
@@ -1067,6 +1074,7 @@ int XrdFrmConfig::ConfigXeq(char *var, int mbok)
        if (!strcmp(var, "ofs.xattrlib"  )) PARSEPI(theAtrLib);
        if (!strcmp(var, "policy"        )) return xpol();
        if (!strcmp(var, "polprog"       )) return xpolprog();
+       if (!strcmp(var, "scan"          )) return xscan();
        if (!strcmp(var, "oss.space"     )) return xspace(1);
        if (!strcmp(var, "waittime"      )) return xitm("purge wait",WaitPurge);
        if (!strcmp(var, "frm.all.monitor"))return xmon();
@@ -1957,6 +1965,63 @@ int XrdFrmConfig::xqchk()
    return 0;
 }
 
+/******************************************************************************/
+/*                                 x s c a n                                  */
+/******************************************************************************/
+
+/* Function: xscan
+
+   Purpose:  To parse the directive: scan [threads <n>] [index <path> | off]
+
+             threads   number of threads that read directories ahead of the
+                       purge name space scan. The default is 1 (no readahead).
+             index     file that records a per-directory summary between scans.
+                       Directories that have not changed since the last scan
+                       and whose files cannot become purgeable before the next
+                       one are then not read. Specify off to disable (default).
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdFrmConfig::xscan()
+{
+    const char *wantParm = 0;
+    char *val;
+    int   ival;
+
+    while((val = cFile->GetWord()))        // threads | index
+         {     if (!strcmp("threads", val))
+                  {wantParm = "scan threads";
+                   if ((val = cFile->GetWord()))     // thread count
+                      {if (XrdOuca2x::a2i(Say,wantParm,val,&ival,1,64))
+                          return 1;
+                       scanThreads = ival; wantParm=0;
+                      }
+                  }
+          else if (!strcmp("index", val))
+                  {wantParm = "scan index";
+                   if ((val = cFile->GetWord()))     // index path or off
+                      {if (scanIndex) free(scanIndex);
+                       if (!strcmp("off", val)) scanIndex = 0;
+                          else {if (*val != '/')
+                                   {Say.Emsg("Config", "scan index path is "
+                                             "not absolute -", val);
+                                    return 1;
+                                   }
+                                scanIndex = strdup(val);
+                               }
+                       wantParm = 0;
+                      }
+                  }
+          else {Say.Emsg("Config", "invalid scan option -", val); return 1;}
+         };
+
+    if (!val && wantParm)
+       {Say.Emsg("Config", wantParm, "value not specified"); return 1;}
+
+    return 0;
+}
+
 /******************************************************************************/
 /*                                  x s i t                                   */
 /******************************************************************************/
@@ -2100,10 +2165,23 @@ void XrdFrmConfig::xspaceBuild(char *grp, char *fn, int isxa)
 /* Function: xxfr
 
    Purpose:  To parse the directive: xfr [deny <sec>] [fdir <path>] [keep <sec>]
+                                         [agemax <sec>] [batch <num>]
+                                         [qmax <qname> <num>]
+                                         [qrate <qname> <bw>] [small <sz>]
 
              deny      number of seconds that a fail file rejects a request
              fdir      base directory where fail files are kept
              keep      number of seconds to keep queued requests (ignored)
+             agemax    number of seconds a request may wait before it is
+                       selected ahead of any batching or interleaving.
+             batch     maximum number of consecutive requests selected from
+                       the same batch (same volume hint or same directory).
+                       Zero disables batching. The default is 8.
+             qmax      maximum number of simultaneous transfers for the queue
+                       named <qname> (stage, migr, copyin, or copyout).
+             qrate     maximum bytes per second started for <qname>.
+             small     files smaller than <sz> are considered small; small
+                       and large transfers are then selected alternately.
 
    Output: 0 upon success or !0 upon failure.
 */
@@ -2111,9 +2189,11 @@ void XrdFrmConfig::xspaceBuild(char *grp, char *fn, int isxa)
 int XrdFrmConfig::xxfr()
 {
     static const int maxfdln = 256;
+    static const char *qNames[] = {"stage", "migr", "copyin", "copyout"};
     const char *wantParm = 0;
     char *val;
-    int       htime = 3*60*60;
+    long long llval;
+    int       htime = 3*60*60, qNum, ival;
 
     while((val = cFile->GetWord()))        // deny | keep
          {     if (!strcmp("deny", val))
@@ -2143,6 +2223,49 @@ int XrdFrmConfig::xxfr()
                        wantParm=0;
                       }
                   }
+          else if (!strcmp("agemax", val))
+                  {wantParm = "xfr agemax";
+                   if ((val = cFile->GetWord()))     // age time
+                      {if (XrdOuca2x::a2tm(Say,wantParm,val,&htime,0)) return 1;
+                       xfrAgeMax = htime; wantParm=0;
+                      }
+                  }
+          else if (!strcmp("batch", val))
+                  {wantParm = "xfr batch";
+                   if ((val = cFile->GetWord()))     // batch count
+                      {if (XrdOuca2x::a2i(Say,wantParm,val,&ival,0)) return 1;
+                       xfrBatch = ival; wantParm=0;
+                      }
+                  }
+          else if (!strcmp("qmax", val) || !strcmp("qrate", val))
+                  {bool isMax = (*(val+1) == 'm');
+                   wantParm = (isMax ? "xfr qmax" : "xfr qrate");
+                   if (!(val = cFile->GetWord())) break;
+                   for (qNum = 0; qNum < 4; qNum++)
+                       if (!strcmp(qNames[qNum], val)) break;
+                   if (qNum >= 4)
+                      {Say.Emsg("Config", wantParm, "queue name is invalid -", val);
+                       return 1;
+                      }
+                   if ((val = cFile->GetWord()))     // limit
+                      {if (isMax)
+                          {if (XrdOuca2x::a2i(Say,wantParm,val,&ival,0)) return 1;
+                           xfrQMax[qNum] = ival;
+                          } else {
+                           if (XrdOuca2x::a2sz(Say,wantParm,val,&llval,0))
+                              return 1;
+                           xfrQRate[qNum] = llval;
+                          }
+                       wantParm=0;
+                      }
+                  }
+          else if (!strcmp("small", val))
+                  {wantParm = "xfr small";
+                   if ((val = cFile->GetWord()))     // size
+                      {if (XrdOuca2x::a2sz(Say,wantParm,val,&llval,0)) return 1;
+                       xfrSmall = llval; wantParm=0;
+                      }
+                  }
           else break;
          };
 
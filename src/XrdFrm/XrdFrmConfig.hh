@@ -99,6 +99,11 @@ int                 isAgent;
 int                 xfrMax;
 int                 xfrMaxIn;
 int                 xfrMaxOt;
+int                 xfrBatch;    // Max consecutive transfers from one batch
+int                 xfrAgeMax;   // Wait after which a request goes first
+long long           xfrSmall;    // Size below which a transfer is small
+int                 xfrQMax[4];  // Per-queue maximum active transfers
+long long           xfrQRate[4]; // Per-queue bytes/second (0 -> unlimited)
 int                 FailHold;
 int                 IdleHold;
 int                 WaitQChk;
@@ -145,6 +150,8 @@ struct Policy
 Policy           dfltPolicy;
 
 int              dirHold;
+int              scanThreads; // Purge namespace scan prefetch threads
+char            *scanIndex;   // Purge namespace scan index file (0 -> none)
 int              pVecNum;     // Number of policy variables
 static const int pVecMax=8;
 char             pVec[pVecMax];
@@ -208,6 +215,7 @@ int          xmon();
 int          xpol();
 int          xpolprog();
 int          xqchk();
+int          xscan();
 int          xsit();
 int          xspace(int isPrg=0, int isXA=1);
 void         xspaceBuild(char *grp, char *fn, int isxa);
@@ -118,6 +118,11 @@ public:
 
 XrdFrmFileset *Get(int &rc, int noBase=0);
 
+// Must be called before the first Get(), see XrdOucNSWalk for details.
+//
+void           setScan(int nThreads, XrdOucNSIndex *ixP=0, time_t cutOff=0)
+                      {nsObj.setThreads(nThreads); nsObj.setIndex(ixP, cutOff);}
+
 static const int Recursive = 0x0001;   // List filesets recursively
 static const int CompressD = 0x0002;   // Use shared directory object (not MT)
 static const int NoAutoDel = 0x0004;   // Do not automatically delete objects
@@ -319,6 +319,12 @@ void XrdFrmPurge::Display()
       else sprintf(buff, "%d", Config.dirHold);
    Say.Say("=====> ", "Directory hold: ", buff);
 
+// Display how the name space will be scanned
+//
+   sprintf(buff, "%d", Config.scanThreads);
+   Say.Say("=====> ", "Scan threads: ", buff, "; index: ",
+           (Config.scanIndex ? Config.scanIndex : "off"));
+
 // Run through all of the policies, displaying each one
 //
    spP = First;
@@ -708,13 +714,16 @@ void XrdFrmPurge::Scan()
    static time_t lastHP = time(0), nextDP = 0, nowT = time(0);
    static XrdFrmPurgeDir purgeDir;
    static XrdOucNSWalk::CallBack *cbP;
+   static XrdOucNSIndex *ixP = 0;
 
    XrdFrmConfig::VPInfo *vP = Config.pathList;
+   XrdFrmPurge   *psP;
    XrdFrmFileset *sP;
    XrdFrmFiles   *fP;
    const char *Extra;
    char buff[128];
-   int needLF, ec = 0, Bad = 0, aFiles = 0, bFiles = 0;
+   time_t cutOff = 0;
+   int needLF, minHold = -1, ec = 0, Bad = 0, aFiles = 0, bFiles = 0;
 
 // Purge that bad file table evey 24 hours to keep complaints down
 //
@@ -729,6 +738,18 @@ void XrdFrmPurge::Scan()
             Extra = "and empty directory";
            }
 
+// If we are keeping a scan index, load it the first time through. A directory
+// that did not change may be skipped as long as none of its files can be
+// purged before the next scan (i.e. all are within the smallest hold time).
+//
+   if (Config.scanIndex)
+      {if (!ixP) {ixP = new XrdOucNSIndex(&Say); ixP->Load(Config.scanIndex);}
+       for (psP = First; psP; psP = psP->Next)
+           if (psP->Enabled && (minHold < 0 || psP->Hold < minHold))
+              minHold = psP->Hold;
+       cutOff = time(0) + Config.WaitPurge - (minHold > 0 ? minHold : 0);
+      }
+
 // Indicate scan started
 //
    VMSG("Scan", "Name space", Extra, "scan started. . .");
@@ -736,6 +757,7 @@ void XrdFrmPurge::Scan()
 // Process each directory
 //
    do {fP = new XrdFrmFiles(vP->Name, Opts, vP->Dir, cbP);
+       fP->setScan(Config.scanThreads, ixP, cutOff);
        needLF = vP->Val;
        while((sP = fP->Get(ec,1)))
             {aFiles++;
@@ -763,6 +785,17 @@ void XrdFrmPurge::Scan()
                                               bFiles, (bFiles != 1 ? "s":""));
    VMSG("Scan", "Name space scan ended;", buff);
 
+// Save the index and report what it saved us
+//
+   if (ixP)
+      {XrdOucNSIndex::Totals ixTots;
+       ixP->Save(Config.scanIndex);
+       ixP->Stats(ixTots);
+       sprintf(buff, "%d of %d directories (%lld files) unchanged",
+               ixTots.Dirs, ixTots.Ents, ixTots.Files);
+       VMSG("Scan", "Name space index:", buff);
+      }
+
 // Issue warning if we encountered errors
 //
    if (Bad) Say.Emsg("Scan", "Errors encountered while scanning for "
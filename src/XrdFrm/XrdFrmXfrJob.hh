@@ -47,6 +47,8 @@ XrdFrcReqFile *reqFQ;
 char          *reqFile;
 XrdFrcRequest  reqData;
 const char    *Type;
+long long      Size;        // Transfer size if known, -1 otherwise
+unsigned long  bKey;        // Batch key (hash of volume hint or directory)
 char           PFN[MAXPATHLEN+16];
 int            pfnEnd;
 int            RetCode;
@@ -45,6 +45,7 @@
 #include "XrdFrm/XrdFrmXfrQueue.hh"
 #include "XrdNet/XrdNetMsg.hh"
 #include "XrdOss/XrdOss.hh"
+#include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucTList.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
@@ -63,6 +64,7 @@ XrdOucHash<XrdFrmXfrJob>  XrdFrmXfrQueue::hTab;
   
 XrdSysMutex               XrdFrmXfrQueue::qMutex;
 XrdSysSemaphore           XrdFrmXfrQueue::qReady(0);
+bool                      XrdFrmXfrQueue::qRated = false;
 
 XrdFrmXfrQueue::theQueue  XrdFrmXfrQueue::xfrQ[XrdFrcRequest::numQ];
 
@@ -158,6 +160,8 @@ int XrdFrmXfrQueue::Add(XrdFrcRequest *rP, XrdFrcReqFile *reqFQ, int qNum)
    xP->qNum     = qNum;
    xP->Act      =*xfrType;
    xP->Type     = xfrType+1;
+   xP->Size     = (Outgoing ? buf.st_size : -1);
+   xP->bKey     = batchKey(&(xP->reqData), xP->Size);
 
 // Add this to the table of requests
 //
@@ -204,9 +208,12 @@ void XrdFrmXfrQueue::Done(XrdFrmXfrJob *xP, const char *Msg)
 //
    hMutex.Lock(); hTab.Del(xP->reqFile); hMutex.UnLock();
   
-// Place job element on the free queue
+// Place job element on the free queue. If the queue was at its transfer limit
+// an agent may now be able to take the next request from it.
 //
    qMutex.Lock();
+   xfrQ[xP->qNum].Active--;
+   if (xfrQ[xP->qNum].First && Config.xfrQMax[xP->qNum]) qReady.Post();
    xP->Next = xfrQ[xP->qNum].Free;
    xfrQ[xP->qNum].Free = xP;
    xfrQ[xP->qNum].Avail.Post();
@@ -220,10 +227,15 @@ void XrdFrmXfrQueue::Done(XrdFrmXfrJob *xP, const char *Msg)
 XrdFrmXfrJob *XrdFrmXfrQueue::Get(int ioQType)
 {
    XrdFrmXfrJob *xfrP;
+   bool isRated;
 
-// Wait for an available job and return it
+// Wait for an available job and return it. If nothing could be selected only
+// because a queue has used its bandwidth, poll until the budget is refilled.
 //
-   do {qReady.Wait();} while(!(xfrP = Pull(ioQType)));
+   do {qReady.Wait();
+       while(!(xfrP = Pull(ioQType, isRated)) && isRated)
+            XrdSysTimer::Wait(250);
+      } while(!xfrP);
    return xfrP;
 }
   
@@ -287,11 +299,131 @@ int XrdFrmXfrQueue::Init()
    return 1;
 }
 
+/******************************************************************************/
+/* Private:                     b a t c h K e y                               */
+/******************************************************************************/
+  
+unsigned long XrdFrmXfrQueue::batchKey(XrdFrcRequest *rP, long long &Size)
+{
+   const char *kP = 0, *eP;
+   unsigned long hVal = 5381;
+   int kLen;
+
+// Requests carrying a volume hint (frm.vol) are batched by volume. A size hint
+// (oss.asize) is used when we do not know the size from the local file.
+//
+   if (rP->Opaque)
+      {XrdOucEnv theEnv(rP->LFN+rP->Opaque);
+       char *vP;
+       if (Size < 0 && (vP = theEnv.Get("oss.asize")))
+          {char *endP;
+           long long hSize = strtoll(vP, &endP, 10);
+           if (!*endP && hSize >= 0) Size = hSize;
+          }
+       if ((vP = theEnv.Get("frm.vol")) && *vP)
+          {while(*vP) hVal = ((hVal << 5) + hVal) ^ (unsigned char)*vP++;
+           return hVal | 1;
+          }
+      }
+
+// Otherwise, requests are batched by the directory holding the file as
+// files in the same directory were most likely written together.
+//
+   kP = (rP->LFN)+rP->LFO;
+   if (!(eP = rindex(kP, '/'))) return 0;
+   kLen = eP - kP;
+   while(kLen--) hVal = ((hVal << 5) + hVal) ^ (unsigned char)*kP++;
+   return hVal & ~1UL;
+}
+
+/******************************************************************************/
+/* Private:                      B l o c k e d                                */
+/******************************************************************************/
+  
+bool XrdFrmXfrQueue::Blocked(int qNum) // Called with qMutex locked!
+{
+   theQueue &theQ = xfrQ[qNum];
+
+// Check the transfer limit
+//
+   if (Config.xfrQMax[qNum] && theQ.Active >= Config.xfrQMax[qNum]) return true;
+
+// Check the bandwidth budget, refilling it once a second. We allow the budget
+// to go negative so that a file larger than the rate can still be started.
+//
+   if (Config.xfrQRate[qNum] && theQ.First)
+      {time_t Now = time(0);
+       if (Now != theQ.bTime)
+          {long long Rate = Config.xfrQRate[qNum];
+           theQ.Budget += Rate * (theQ.bTime ? Now - theQ.bTime : 1);
+           if (theQ.Budget > Rate) theQ.Budget = Rate;
+           theQ.bTime = Now;
+          }
+       if (theQ.Budget <= 0) {qRated = true; return true;}
+      }
+   return false;
+}
+
+/******************************************************************************/
+/* Private:                         P i c k                                   */
+/******************************************************************************/
+  
+XrdFrmXfrJob *XrdFrmXfrQueue::Pick(int qNum) // Called with qMutex locked!
+{
+   static const int maxScan = 64;
+   theQueue &theQ = xfrQ[qNum];
+   XrdFrmXfrJob *xP, *pP, *pickP = 0, *pickPP = 0, *wantP = 0, *wantPP = 0;
+   int n;
+   bool isSmall;
+
+// Nothing to do if the queue is empty
+//
+   if (!(xP = theQ.First)) return 0;
+
+// The oldest request goes first once it has waited too long. Otherwise, look
+// for the next request in the current batch; failing that for a request of
+// the size class we want next. We only look at the first few requests.
+//
+   if (!Config.xfrAgeMax || time(0) - xP->reqData.addTOD < Config.xfrAgeMax)
+      {pP = 0;
+       for (n = 0; xP && n < maxScan; n++, pP = xP, xP = xP->Next)
+           {if (theQ.bLeft > 0 && xP->bKey == theQ.bKey)
+               {pickP = xP; pickPP = pP; break;}
+            if (Config.xfrSmall && !wantP
+            &&  (xP->Size >= 0 && xP->Size < Config.xfrSmall) == theQ.wSmall)
+               {wantP = xP; wantPP = pP;
+                if (theQ.bLeft <= 0) break;
+               }
+           }
+       if (!pickP && wantP) {pickP = wantP; pickPP = wantPP;}
+      }
+   if (!pickP) {pickP = theQ.First; pickPP = 0;}
+
+// Unlink the request
+//
+   if (pickPP) pickPP->Next = pickP->Next;
+      else     theQ.First   = pickP->Next;
+   if (theQ.Last == pickP) theQ.Last = pickPP;
+   pickP->Next = 0;
+
+// Update the batch, interleave, and bandwidth state
+//
+   if (Config.xfrBatch && pickP->bKey)
+      {if (theQ.bLeft > 0 && pickP->bKey == theQ.bKey) theQ.bLeft--;
+          else {theQ.bKey = pickP->bKey; theQ.bLeft = Config.xfrBatch - 1;}
+      } else theQ.bLeft = 0;
+   isSmall = pickP->Size >= 0 && pickP->Size < Config.xfrSmall;
+   theQ.wSmall = !isSmall;
+   if (Config.xfrQRate[qNum] && pickP->Size > 0) theQ.Budget -= pickP->Size;
+   theQ.Active++;
+   return pickP;
+}
+
 /******************************************************************************/
 /* Private:                         P u l l                                   */
 /******************************************************************************/
   
-XrdFrmXfrJob *XrdFrmXfrQueue::Pull(int ioQType)
+XrdFrmXfrJob *XrdFrmXfrQueue::Pull(int ioQType, bool &isRated)
 {
    static bool ioX = false, prevQ[2] = {0,0};
    XrdFrmXfrJob *xfrP;
@@ -300,15 +432,17 @@ XrdFrmXfrJob *XrdFrmXfrQueue::Pull(int ioQType)
 // Setup to pick a request equally multiplexing between all possible queues
 //
    qMutex.Lock();
+   qRated = false;
 do{if (!ioQType) ioX = !ioX;
       else {ioX = (ioQType < 0 ? 1 : 0); nSel = 0;}
    if (ioX) {Q1 = XrdFrcRequest::migQ; Q2 = XrdFrcRequest::putQ; pikQ = 1;}
       else  {Q1 = XrdFrcRequest::stgQ; Q2 = XrdFrcRequest::getQ; pikQ = 0;}
 
-// Check if we should avoid either queue because it is stopped
+// Check if we should avoid either queue because it is stopped or it has
+// reached its transfer or bandwidth limit.
 //
-   if (xfrQ[Q1].Stop || Stopped(Q1)) Q1 = XrdFrcRequest::nilQ;
-   if (xfrQ[Q2].Stop || Stopped(Q2)) Q2 = XrdFrcRequest::nilQ;
+   if (xfrQ[Q1].Stop || Stopped(Q1) || Blocked(Q1)) Q1 = XrdFrcRequest::nilQ;
+   if (xfrQ[Q2].Stop || Stopped(Q2) || Blocked(Q2)) Q2 = XrdFrcRequest::nilQ;
 
 // Pick the oldest possible request
 //
@@ -322,13 +456,14 @@ do{if (!ioQType) ioX = !ioX;
 
 // Dequeue the request (we may have an empty selectoin here)
 //
-   if ((xfrP = xfrQ[theQ].First)
-   &&  !(xfrQ[theQ].First = xfrP->Next)) xfrQ[theQ].Last = 0;
+   xfrP = Pick(theQ);
   } while(!xfrP && nSel--);
 
-// Return the job, if any
+// Return the job, if any, and whether a queue was skipped for bandwidth. The
+// latter is only valid while we hold the queue mutex.
 //
    prevQ[pikQ] = theQ;
+   isRated = qRated;
    qMutex.UnLock();
    return xfrP;
 }
@@ -61,7 +61,10 @@ static void          StopMon(void *parg);
 
 private:
 
-static XrdFrmXfrJob *Pull(int ioQType);
+static unsigned long batchKey(XrdFrcRequest *rP, long long &Size);
+static bool          Blocked(int qNum);
+static XrdFrmXfrJob *Pick(int qNum);
+static XrdFrmXfrJob *Pull(int ioQType, bool &isRated);
 static int           Notify(XrdFrcRequest *rP,int qN,int rc,const char *msg=0);
 static void          Send2File(char *Dest, char *Msg, int Mln);
 static void          Send2UDP(char *Dest, char *Msg, int Mln);
@@ -73,6 +76,8 @@ static XrdOucHash<XrdFrmXfrJob>  hTab;
 
 static XrdSysMutex               qMutex;
 static XrdSysSemaphore           qReady;
+static bool                      qRated;  // A queue is waiting for bandwidth
+                                          // (protected by qMutex)
 
 struct theQueue
       {XrdSysSemaphore           Avail;
@@ -84,7 +89,15 @@ struct theQueue
               const char        *Name;
               int                Stop;
               int                qNum;
-              theQueue() : Avail(0),Free(0),First(0),Last(0),Alert(0),Stop(0) {}
+              int                Active;  // Transfers in progress
+              int                bLeft;   // Picks left in the current batch
+              unsigned long      bKey;    // Key of the current batch
+              bool               wSmall;  // Next pick should be a small file
+              long long          Budget;  // Bytes that may still be started
+              time_t             bTime;   // When Budget was last refilled
+              theQueue() : Avail(0),Free(0),First(0),Last(0),Alert(0),Stop(0),
+                           Active(0),bLeft(0),bKey(0),wSmall(true),Budget(0),
+                           bTime(0) {}
              ~theQueue() {}
       };
 static theQueue                  xfrQ[XrdFrcRequest::numQ];
@@ -84,6 +84,7 @@ char *XrdHttpProtocol::sslkey = 0;
 char *XrdHttpProtocol::sslcadir = 0;
 int XrdHttpProtocol::crlRefIntervalSec = XrdTlsContext::DEFAULT_CRL_REF_INT_SEC;
 bool XrdHttpProtocol::allowMissingCRL = false;
+bool XrdHttpProtocol::useKTLS = false;
 char *XrdHttpProtocol::sslcipherfilter = 0;
 char *XrdHttpProtocol::listredir = 0;
 bool XrdHttpProtocol::listdeny = false;
@@ -148,6 +149,8 @@ static const int hsmOn   =  1; // Dual purpose but use a meaningful varname
 
 int  httpsmode = hsmAuto;
 int  tlsCache  = XrdTlsContext::scOff;
+int  tlsTktRot = 0;
+char *tlsTktKeys = 0;
 bool tlsClientAuth = true;
 bool httpsspec = false;
 bool xrdctxVer = false;
@@ -1142,6 +1145,10 @@ int XrdHttpProtocol::Config(const char *ConfigFN, XrdOucEnv *myEnv) {
        if (cP->opts & XrdTlsContext::crlAM) {
           allowMissingCRL = true;
        }
+
+       if (cP->opts & XrdTlsContext::ktlsOn) {
+          useKTLS = true;
+       }
       }
 
 // If a gridmap or secxtractor is present then we must be able to verify certs
@@ -1845,6 +1852,10 @@ bool XrdHttpProtocol::InitTLS() {
     opts |= XrdTlsContext::crlAM;
   }
 
+  if (useKTLS) {
+    opts |= XrdTlsContext::ktlsOn;
+  }
+
 // Create a new TLS context
 //
    if (sslverifydepth > 255) sslverifydepth = 255;
@@ -1868,6 +1879,14 @@ bool XrdHttpProtocol::InitTLS() {
    unsigned int n =(unsigned int)(strlen(sess_ctx_id)+1);
    xrdctx->SessionCache(tlsCache, sess_ctx_id, n);
 
+// Setup managed session tickets if so wanted.
+//
+   if ((tlsTktRot || tlsTktKeys)
+   &&  !xrdctx->SessionTickets(tlsTktRot, tlsTktKeys, &eMsg))
+      {eDest.Say("Config failure: ", eMsg.c_str());
+       return false;
+      }
+
 // Set special ciphers if so specified.
 //
    if (sslcipherfilter && !xrdctx->SetContextCiphers(sslcipherfilter))
@@ -2948,7 +2967,13 @@ int XrdHttpProtocol::xsslcipherfilter(XrdOucStream & Config) {
 
 /* Function: xtlsreuse
 
-   Purpose:  To parse the directive: tlsreuse {on | off}
+   Purpose:  To parse the directive: tlsreuse {on | off} [rotate <rt>]
+                                                          [keyfile <path>]
+
+             <rt>      issues session tickets with keys that are rotated every
+                       <rt> time units (minimum 60 seconds).
+             <path>    issues session tickets with keys read from <path> which
+                       may be shared by all servers in a cluster.
 
    Output: 0 upon success or 1 upon failure.
  */
@@ -2967,14 +2992,37 @@ int XrdHttpProtocol::xtlsreuse(XrdOucStream & Config) {
 //
    if (!strcmp(val, "off"))
       {tlsCache = XrdTlsContext::scOff;
+       tlsTktRot = 0;
+       if (tlsTktKeys) {free(tlsTktKeys); tlsTktKeys = 0;}
        return 0;
       }
 
-// If it's on we set it on.
+// If it's on we set it on and process any ticket options.
 //
    if (!strcmp(val, "on"))
-      {tlsCache = XrdTlsContext::scSrvr;
-       return 0;
+      {int num;
+       tlsCache = XrdTlsContext::scSrvr;
+       while((val = Config.GetWord()))
+            {if (!strcmp(val, "rotate"))
+                {if (!(val = Config.GetWord()))
+                    {eDest.Emsg("Config","tlsreuse rotate value not specified");
+                     return 1;
+                    }
+                 if (XrdOuca2x::a2tm(eDest,"tlsreuse rotate",val,&num,60))
+                    return 1;
+                 tlsTktRot = num;
+                }
+             else if (!strcmp(val, "keyfile"))
+                {if (!(val = Config.GetWord()) || *val != '/')
+                    {eDest.Emsg("Config","tlsreuse keyfile path not specified");
+                     return 1;
+                    }
+                 if (tlsTktKeys) free(tlsTktKeys);
+                 tlsTktKeys = strdup(val);
+                }
+             else break;
+            }
+       if (!val) return 0;
       }
 
 // Bad argument
@@ -77,11 +77,13 @@ class XrdHttpExtHandler;
 struct XrdVersionInfo;
 class XrdOucGMap;
 class XrdCryptoFactory;
+class XrdHttpConfigTests;
 
 class XrdHttpProtocol : public XrdProtocol {
   
   friend class XrdHttpReq;
   friend class XrdHttpExtReq;
+  friend class ::XrdHttpConfigTests;
   
 public:
 
@@ -409,6 +411,9 @@ protected:
   // Allows missing CRL for CA verification
   static bool allowMissingCRL;
 
+  /// Use kernel TLS (inherited from the xrd.tls directive)
+  static bool useKTLS;
+
   /// Gridmap file location. The same used by XrdSecGsi
   static char *gridmap;// [s] gridmap file [/etc/grid-security/gridmap]
   static bool isRequiredGridmap; // If true treat gridmap errors as fatal
@@ -530,7 +530,7 @@ int XrdHttpReq::File(XrdXrootd::Bridge::Context &info, //!< the result context
         ) {
 
   // sendfile about to be sent by bridge for fetching data for GET:
-  // no https, no chunked+trailer, no multirange
+  // no https (unless kernel TLS), no chunked+trailer, no multirange
 
   //prot->SendSimpleResp(200, NULL, NULL, NULL, dlen);
   int rc = info.Send(0, 0, 0, 0);
@@ -1267,10 +1267,11 @@ int XrdHttpReq::ProcessHTTPReq() {
             xrdreq.read.offset = htonll(offs);
             xrdreq.read.rlen = htonl(l);
 
-            // If we are using HTTPS or if the client requested trailers, or if the
-            // read concerns a multirange reponse, disable sendfile
+            // If we are using HTTPS without kernel TLS, or if the client requested
+            // trailers, or if the read concerns a multirange reponse, disable sendfile
             // (in the latter two cases, the extra framing is only done in PostProcessHTTPReq)
-            if (prot->ishttps || (m_transfer_encoding_chunked && m_trailer_headers) ||
+            if ((prot->ishttps && !prot->Link->sfTLS()) ||
+                (m_transfer_encoding_chunked && m_trailer_headers) ||
                 !readRangeHandler.isSingleRange()) {
               if (!prot->Bridge->setSF((kXR_char *) fhandle, false)) {
                 TRACE(REQ, " XrdBridge::SetSF(false) failed.");
@@ -22,6 +22,7 @@ public:
     AuthzCheck(const char *req_path, const Access_Operation req_oper, ssize_t max_duration, XrdSysError &log);
 
     const std::string &GetSecName() const {return m_sec_name;}
+    time_t GetExpiry() const {return m_expiry;}
     const std::string &GetErrorMessage() const {return m_emsg;}
 
     static int verify_before_s(void *authz_ptr,
@@ -54,6 +55,7 @@ private:
     std::string m_sec_name;
     Access_Operation m_oper;
     time_t m_now;
+    time_t m_expiry{0};
 };
 
 static XrdAccPrivs AddPriv(Access_Operation op, XrdAccPrivs privs)
@@ -188,6 +190,27 @@ Authz::Access(const XrdSecEntity *Entity, const char *path,
         return OnMissing(Entity, path, oper, env);
     }
 
+    // A macaroon recently verified for this very operation and path need not
+    // be parsed and verified again; its caveats would be satisfied the same way.
+    // The key is laid out so that it cannot be ambiguous: the path can not
+    // contain a null byte and the operation is a single character.
+    std::string decision_key;
+    time_t now = time(nullptr);
+    if (path)
+    {
+        decision_key = static_cast<char>('A' + oper);
+        decision_key += path;
+        decision_key += '\0';
+        decision_key += authz;
+        if (auto decision = m_decisions.Find(decision_key, now))
+        {
+            if (Entity && decision->name.size()) {
+                Entity->eaAPI->Add("request.name", decision->name, true);
+            }
+            return decision->privs;
+        }
+    }
+
     macaroon_returncode mac_err = MACAROON_SUCCESS;
     struct macaroon* macaroon = macaroon_deserialize(
         authz,
@@ -267,8 +290,18 @@ Authz::Access(const XrdSecEntity *Entity, const char *path,
         Entity->eaAPI->Add("request.name", username,true);
     }
 
-    // We passed verification - give the correct privilege.
-    return AddPriv(oper, XrdAccPriv_None);
+    // We passed verification - give the correct privilege. Remember the
+    // outcome until the macaroon expires, but only for a short while as the
+    // same request is likely to be repeated soon or not at all.
+    auto decision = std::make_shared<Decision>();
+    decision->privs = AddPriv(oper, XrdAccPriv_None);
+    decision->name = check_helper.GetSecName();
+    time_t expiry = now + m_decision_secs;
+    if (check_helper.GetExpiry() && check_helper.GetExpiry() < expiry) {
+        expiry = check_helper.GetExpiry();
+    }
+    m_decisions.Add(decision_key, decision, expiry, now);
+    return decision->privs;
 }
 
 bool Authz::Validate(const char   *token,
@@ -452,6 +485,8 @@ AuthzCheck::verify_before(const unsigned char * pred, size_t pred_sz)
         return 1;
     }
 
+    if (!m_expiry || caveat_time < m_expiry) m_expiry = caveat_time;
+
     int result = (m_now >= caveat_time);
     if (!result)
     {
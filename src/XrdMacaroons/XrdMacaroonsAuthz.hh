@@ -1,4 +1,5 @@
 #include "XrdAcc/XrdAccAuthorize.hh"
+#include "XrdAcc/XrdAccTokenCache.hh"
 #include "XrdSciTokens/XrdSciTokensHelper.hh"
 #include "XrdSys/XrdSysError.hh"
 
@@ -46,12 +47,23 @@ private:
                           const Access_Operation  oper,
                                 XrdOucEnv        *env);
 
+    // The outcome of a successful verification of a macaroon for a given
+    // operation and path; reused until it expires.
+    struct Decision
+    {
+        XrdAccPrivs privs;
+        std::string name;
+    };
+
     ssize_t m_max_duration;
     XrdAccAuthorize *m_chain;
     XrdSysError m_log;
     std::string m_secret;
     std::string m_location;
     int m_authz_behavior;
+    XrdAccTokenCache<Decision> m_decisions;
+
+    static constexpr time_t m_decision_secs = 60;
 };
 
 } // namespace Macaroons
@@ -55,6 +55,7 @@
 #include "XrdNet/XrdNetUtils.hh"
 
 #include "XrdOfs/XrdOfs.hh"
+#include "XrdOfs/XrdOfsAsyncOpen.hh"
 #include "XrdOfs/XrdOfsChkPnt.hh"
 #include "XrdOfs/XrdOfsCksFile.hh"
 #include "XrdOfs/XrdOfsConfigCP.hh"
@@ -227,6 +228,7 @@ XrdOfs::XrdOfs() : dMask{0000,0775}, fMask{0000,0775}, // Legacy
 
 // Other options
 //
+   asyncOpen = false;
    DirRdr    = false;
    reProxy   = false;
    OssHasPGrw= false;
@@ -700,6 +702,16 @@ int XrdOfsFile::open(const char          *path,      // In
        OOIDENTENV(client, Open_Env);
       }
 
+// If an asynchronous open completed for this client, pick up the opened file.
+// Otherwise, see if the open may be done asynchronously. This is only done for
+// read-only opens and only when the client accepts a deferred response.
+//
+   bool doAsync = false;
+   if (XrdOfsFS->asyncOpen && !isRW && !tpcKey)
+      {if (!(oP.fP = XrdOfsAsyncOpen::Claim(tident, path)))
+          doAsync = (error.getErrCB() != 0);
+      }
+
 // Get a handle for this file.
 //
    if ((retc = XrdOfsHandle::Alloc(path, isRW, &oP.hP)))
@@ -741,6 +753,7 @@ int XrdOfsFile::open(const char          *path,      // In
        if (tpcKey && isRW)
           return XrdOfsFS->Emsg(epname, error, EALREADY, "tpc", path,
                            "+ofs_open: this tpc is already in progress");
+       if (oP.fP) {oP.fP->Close(); delete oP.fP; oP.fP = 0;}
        XrdOfsFS->ocMutex.Lock(); oh = oP.hP; XrdOfsFS->ocMutex.UnLock();
        FTRACE(open, "attach use=" <<oh->Usage());
        if (oP.poscNum > 0) XrdOfsFS->poscQ->Commit(path, oP.poscNum);
@@ -752,9 +765,10 @@ int XrdOfsFile::open(const char          *path,      // In
        return oP.OK();
       }
 
-// Get a storage system object
+// Get a storage system object unless we already have an opened one
 //
-   if (!(oP.fP = XrdOfsOss->newFile(tident)))
+   bool isOpen = (oP.fP != 0);
+   if (!isOpen && !(oP.fP = XrdOfsOss->newFile(tident)))
       return XrdOfsFS->Emsg(epname, error, ENOMEM, "open", path);
 
 // We need to make special provisions for proxy servers in the presence of
@@ -774,9 +788,17 @@ int XrdOfsFile::open(const char          *path,      // In
        oP.cP = 0;
       }
 
-// Open the file
+// Open the file. If possible, do it asynchronously in which case the client
+// is told to wait and, once the open completes, to retry the open.
 //
-   if ((retc = oP.fP->Open(path, open_flag, theMode, Open_Env)))
+   retc = (isOpen ? 0 : -ENOTSUP);
+   if (doAsync)
+      {retc = XrdOfsAsyncOpen::Start(oP.fP, path, open_flag, theMode,
+                                     Open_Env, error, tident);
+       if (!retc) {oP.fP = 0; return XrdOfsFS->fsError(error, SFS_STARTED);}
+      }
+   if (retc == -ENOTSUP) retc = oP.fP->Open(path, open_flag, theMode, Open_Env);
+   if (retc)
       {if (retc > 0) return XrdOfsFS->Stall(error, retc, path);
        if (retc == -EINPROGRESS)
           {XrdOfsFS->evrObject.Wait4Event(path,&error);
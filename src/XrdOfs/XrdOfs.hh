@@ -492,6 +492,7 @@ int               usxMaxVsz;      // Maximum length of attribute value
 static XrdOfsHandle     *dummyHandle;
 XrdSysMutex              ocMutex; // Global mutex for open/close
 
+bool              asyncOpen;      // Oss opens may be done asynchronously
 bool              DirRdr;         // Opendir() can be redirected.
 bool              reProxy;        // Reproxying required for TPC
 bool              OssHasPGrw;     // True: oss implements full rgRead/Write
@@ -532,6 +533,7 @@ int           FSctl(XrdOfsFile &file, int cmd, int alen, const char *args,
                     const XrdSecEntity *client);
 int           Reformat(XrdOucErrInfo &);
 const char   *theRole(int opts);
+int           xaopn(XrdOucStream &, XrdSysError &);
 int           xcksrt(XrdOucStream &, XrdSysError &);
 int           xcrds(XrdOucStream &, XrdSysError &);
 int           xcrm(XrdOucStream &, XrdSysError &);
@@ -0,0 +1,232 @@
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O f s A s y n c O p e n . c c                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "Xrd/XrdScheduler.hh"
+#include "XrdOfs/XrdOfsAsyncOpen.hh"
+#include "XrdOss/XrdOss.hh"
+#include "XrdSfs/XrdSfsInterface.hh"
+#include "XrdSys/XrdSysE2T.hh"
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+int                                      XrdOfsAsyncOpen::maxWait = 300;
+
+XrdSysMutex                              XrdOfsAsyncOpen::readyMutex;
+std::multimap<std::string,
+              XrdOfsAsyncOpen::Ready>    XrdOfsAsyncOpen::readyTab;
+time_t                                   XrdOfsAsyncOpen::nextExpire = 0;
+XrdScheduler                            *XrdOfsAsyncOpen::schedP = 0;
+XrdOfsAsyncOpen::ExpireJob               XrdOfsAsyncOpen::expireJob;
+bool                                     XrdOfsAsyncOpen::expirePending = false;
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdOfsAsyncOpen::XrdOfsAsyncOpen(XrdOssDF *ossp, const char *path,
+                                 XrdOucErrInfo &einfo, const char *tident)
+                                : openCB(this), ossP(ossp), Path(path),
+                                  openRC(0), numEvents(0)
+{
+   Key  = tident;
+   Key += ' ';
+   Key += path;
+   User = einfo.getErrUser();
+   evtCB = einfo.getErrCB(evtCBarg);
+}
+
+/******************************************************************************/
+/*                                 C l a i m                                  */
+/******************************************************************************/
+
+XrdOssDF *XrdOfsAsyncOpen::Claim(const char *tident, const char *path)
+{
+   XrdSysMutexHelper mHelp(readyMutex);
+   std::string key(tident);
+   XrdOssDF *ossp;
+
+// Quickly return if nothing is pending
+//
+   if (readyTab.empty()) return 0;
+
+// Find the file opened on behalf of this client
+//
+   key += ' ';
+   key += path;
+   auto it = readyTab.find(key);
+   if (it == readyTab.end()) return 0;
+
+// Remove it and return it
+//
+   ossp = it->second.ossP;
+   readyTab.erase(it);
+   return ossp;
+}
+
+/******************************************************************************/
+/*                                  D o n e                                   */
+/******************************************************************************/
+
+void XrdOfsAsyncOpen::Done(int &Result, XrdOucErrInfo *eInfo, const char *Path)
+{
+   (void)Result; (void)eInfo; (void)Path;
+   bool doFinish;
+
+// The client has been told to wait. We can only send the final response after
+// this has happened as the client may otherwise get the responses out of order.
+//
+   myMutex.Lock();
+   doFinish = (++numEvents == 2);
+   myMutex.UnLock();
+   if (doFinish) Finish();
+}
+
+/******************************************************************************/
+/*                                E x p i r e                                 */
+/******************************************************************************/
+
+// Run by the scheduler for as long as there are unclaimed files.
+
+void XrdOfsAsyncOpen::Expire()
+{
+   XrdSysMutexHelper mHelp(readyMutex);
+   time_t now = time(0);
+
+// Close what has expired and come back later if anything remains
+//
+   Expire(now);
+   if (readyTab.empty()) expirePending = false;
+      else schedP->Schedule(&expireJob, nextExpire);
+}
+
+// Must be called with readyMutex held!
+
+void XrdOfsAsyncOpen::Expire(time_t now)
+{
+
+// Close any opened files that the client never came back for. There are
+// usually none, so we do this while holding the lock.
+//
+   for (auto it = readyTab.begin(); it != readyTab.end();)
+       {if (now - it->second.when >= maxKeep)
+           {it->second.ossP->Close();
+            delete it->second.ossP;
+            it = readyTab.erase(it);
+           } else ++it;
+       }
+   nextExpire = now + maxKeep/2;
+}
+
+/******************************************************************************/
+/*                                F i n i s h                                 */
+/******************************************************************************/
+
+void XrdOfsAsyncOpen::Finish()
+{
+   XrdOucErrInfo *einfo = new XrdOucErrInfo(User, (XrdOucEICB *)0, evtCBarg);
+   int Result;
+
+// If the open failed, tell the client why. Otherwise, save the file so that
+// the client can claim it when it retries the open.
+//
+   if (openRC)
+      {std::string eText("Unable to open " + Path + "; ");
+       std::string xText;
+       if (ossP->getErrMsg(xText)) eText += xText;
+          else eText += XrdSysE2T(-openRC);
+       einfo->setErrInfo(-openRC, eText.c_str());
+       delete ossP;
+       Result = SFS_ERROR;
+      } else {
+       time_t now = time(0);
+       Ready rdy = {ossP, now};
+       readyMutex.Lock();
+       if (now >= nextExpire) Expire(now);
+       readyTab.insert(std::make_pair(Key, rdy));
+       if (schedP && !expirePending)
+          {expirePending = true;
+           schedP->Schedule(&expireJob, now + maxKeep/2);
+          }
+       readyMutex.UnLock();
+       einfo->setErrInfo(0, "");
+       Result = SFS_OK;
+      }
+
+// Send the result to the client and we are done
+//
+   evtCB->Done(Result, einfo);
+   delete this;
+}
+
+/******************************************************************************/
+/*                                O p e n e d                                 */
+/******************************************************************************/
+
+void XrdOfsAsyncOpen::Opened(int result)
+{
+   bool doFinish;
+
+// Record the result and finish up if the client was already told to wait
+//
+   myMutex.Lock();
+   openRC = result;
+   doFinish = (++numEvents == 2);
+   myMutex.UnLock();
+   if (doFinish) Finish();
+}
+
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+
+int XrdOfsAsyncOpen::Start(XrdOssDF *ossP, const char *path, int Oflag,
+                           mode_t Mode, XrdOucEnv &env, XrdOucErrInfo &einfo,
+                           const char *tident)
+{
+   XrdOfsAsyncOpen *aoP = new XrdOfsAsyncOpen(ossP, path, einfo, tident);
+   int rc;
+
+// Replace the original callback with ours so that we know when the client
+// has been told to wait. Note that the open may complete before we return.
+//
+   einfo.setErrCB(aoP, aoP->evtCBarg);
+   if ((rc = ossP->OpenAsync(path, Oflag, Mode, env, aoP->openCB)))
+      {einfo.setErrCB(aoP->evtCB, aoP->evtCBarg);
+       delete aoP;
+       return rc;
+      }
+
+// Tell the client how long it may need to wait
+//
+   einfo.setErrCode(maxWait);
+   return 0;
+}
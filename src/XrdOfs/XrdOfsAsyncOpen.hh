@@ -0,0 +1,164 @@
+#ifndef _XRDOFSASYNCOPEN_H
+#define _XRDOFSASYNCOPEN_H
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O f s A s y n c O p e n . h h                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <sys/types.h>
+
+#include "Xrd/XrdJob.hh"
+#include "XrdOuc/XrdOucCache.hh"
+#include "XrdOuc/XrdOucErrInfo.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+class XrdOssDF;
+class XrdOucEnv;
+class XrdScheduler;
+
+//-----------------------------------------------------------------------------
+//! Drive an oss open asynchronously so that the requesting thread need not
+//! wait for it. The client is told to wait for a response (SFS_STARTED) and,
+//! once the open completes, is asked to retry the open. The retry picks up
+//! the already opened oss file via Claim(). Failures are reported directly.
+//-----------------------------------------------------------------------------
+
+class XrdOfsAsyncOpen : public XrdOucEICB
+{
+public:
+
+//-----------------------------------------------------------------------------
+//! Claim a file object whose asynchronous open completed for a client.
+//!
+//! @param  tident - The client's trace identifier.
+//! @param  path   - The path that was opened.
+//!
+//! @return Pointer to the opened file object, now owned by the caller, or
+//!         nil if there is none.
+//-----------------------------------------------------------------------------
+
+static XrdOssDF *Claim(const char *tident, const char *path);
+
+//-----------------------------------------------------------------------------
+//! Start an asynchronous open.
+//!
+//! @param  ossP   - Pointer to the oss file object to open. Ownership passes
+//!                  to this class only if the open was started.
+//! @param  path   - The path to open.
+//! @param  Oflag  - Standard open flags.
+//! @param  Mode   - File open mode.
+//! @param  env    - Reference to environmental information.
+//! @param  einfo  - The client's error object which must have a callback.
+//! @param  tident - The client's trace identifier.
+//!
+//! @return 0 if the open was started; the caller should return SFS_STARTED.
+//!         Otherwise, -errno or -osserr as returned by XrdOssDF::OpenAsync().
+//-----------------------------------------------------------------------------
+
+static int       Start(XrdOssDF *ossP, const char *path, int Oflag,
+                       mode_t Mode, XrdOucEnv &env, XrdOucErrInfo &einfo,
+                       const char *tident);
+
+//-----------------------------------------------------------------------------
+//! Set the number of seconds the client is asked to wait for the open.
+//-----------------------------------------------------------------------------
+
+static void      SetWait(int secs) {maxWait = secs;}
+
+//-----------------------------------------------------------------------------
+//! Set the scheduler used to periodically close unclaimed opened files.
+//-----------------------------------------------------------------------------
+
+static void      SetSched(XrdScheduler *sP) {schedP = sP;}
+
+static int       maxWait;   // Seconds client waits for a response
+
+// XrdOucEICB methods; Done() is called once the client was told to wait.
+//
+void             Done(int &Result, XrdOucErrInfo *eInfo,
+                      const char *Path=0) override;
+
+int              Same(unsigned long long arg1, unsigned long long arg2)
+                     override {(void)arg1; (void)arg2; return 0;}
+
+private:
+
+class OpenCB : public XrdOucCacheIOCB
+{
+public:
+void             Done(int result) override {aoP->Opened(result);}
+
+                 OpenCB(XrdOfsAsyncOpen *aop) : aoP(aop) {}
+                ~OpenCB() {}
+XrdOfsAsyncOpen *aoP;
+};
+
+class ExpireJob : public XrdJob
+{
+public:
+void             DoIt() override {XrdOfsAsyncOpen::Expire();}
+
+                 ExpireJob() : XrdJob("async open expire") {}
+                ~ExpireJob() {}
+};
+
+struct Ready {XrdOssDF *ossP; time_t when;};
+
+                 XrdOfsAsyncOpen(XrdOssDF *ossP, const char *path,
+                                 XrdOucErrInfo &einfo, const char *tident);
+                ~XrdOfsAsyncOpen() {}
+
+void             Finish();
+void             Opened(int result);
+static void      Expire();
+static void      Expire(time_t now);
+
+static const int maxKeep = 120;     // Seconds an unclaimed open is kept
+
+static XrdSysMutex                        readyMutex;
+static std::multimap<std::string, Ready>  readyTab;
+static time_t                             nextExpire;
+static XrdScheduler                      *schedP;
+static ExpireJob                          expireJob;
+static bool                               expirePending;
+
+XrdSysMutex         myMutex;
+OpenCB              openCB;
+XrdOssDF           *ossP;
+std::string         Key;
+std::string         Path;
+const char         *User;
+XrdOucEICB         *evtCB;
+unsigned long long  evtCBarg;
+int                 openRC;
+int                 numEvents;
+};
+#endif
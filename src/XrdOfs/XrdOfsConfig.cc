@@ -52,6 +52,7 @@
 #include "XrdSfs/XrdSfsFlags.hh"
 
 #include "XrdOfs/XrdOfs.hh"
+#include "XrdOfs/XrdOfsAsyncOpen.hh"
 #include "XrdOfs/XrdOfsCksFile.hh"
 #include "XrdOfs/XrdOfsConfigCP.hh"
 #include "XrdOfs/XrdOfsConfigPI.hh"
@@ -175,6 +176,7 @@ int XrdOfs::Configure(XrdSysError &Eroute, XrdOucEnv *EnvInfo) {
        NoGo = 1;
       }
    ofsSchedP = (XrdScheduler *)EnvInfo->GetPtr("XrdScheduler*");
+   XrdOfsAsyncOpen::SetSched(ofsSchedP);
 
 // Preset all variables with common defaults
 //
@@ -390,6 +392,14 @@ int XrdOfs::Configure(XrdSysError &Eroute, XrdOucEnv *EnvInfo) {
 //
    OssHasPGrw = (ossFeatures & XRDOSS_HASPGRW) != 0;
 
+// Asynchronous opens require that the oss plugin support them
+//
+   if (asyncOpen && !(ossFeatures & XRDOSS_HASAOPN))
+      {Eroute.Say("Config warning: asyncopen ignored; "
+                  "oss plugin does not support asynchronous opens.");
+       asyncOpen = false;
+      }
+
 // If POSC processing is enabled (as by default) do it. Warning! This must be
 // the last item in the configuration list as we need a working filesystem.
 // Note that in proxy mode we always disable posc!
@@ -875,6 +885,7 @@ int XrdOfs::ConfigXeq(char *var, XrdOucStream &Config,
 
     // Now assign the appropriate global variable
     //
+    TS_Xeq("asyncopen",     xaopn);
     TS_Bit("authorize",     Options, Authorize);
     TS_XPI("authlib",       theAutLib);
     TS_XPI("ckslib",        theCksLib);
@@ -935,6 +946,54 @@ bool XrdOfs::ValidCST(const char* cst)
    return false;
 }
 
+/******************************************************************************/
+/*                                 x a o p n                                  */
+/******************************************************************************/
+
+/* Function: xaopn
+
+   Purpose:  To parse the directive: asyncopen {off | on [wait <sec>]}
+
+             off     opens are always done synchronously. This is the default.
+             on      read-only opens are done asynchronously when the oss
+                     plugin supports it (e.g. the proxy plugin). The thread
+                     handling the request is released while the open is in
+                     progress. The client waits for a response and then
+                     retries the open which picks up the opened file.
+             wait    the maximum number of seconds the client is asked to
+                     wait for the open to complete. The default is 300.
+
+  Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOfs::xaopn(XrdOucStream &Config, XrdSysError &Eroute)
+{
+   char *val;
+   int wsec;
+
+// Get the parameter
+//
+   if (!(val = Config.GetWord()) || !val[0])
+      {Eroute.Emsg("Config", "asyncopen parameter not specified"); return 1;}
+
+// Set appropriate option
+//
+        if (!strcmp(val, "off")) {asyncOpen = false; return 0;}
+   else if (!strcmp(val, "on"))   asyncOpen = true;
+   else {Eroute.Emsg("Config", "Invalid asyncopen parameter -", val); return 1;}
+
+// Process the optional wait
+//
+   if (!(val = Config.GetWord()) || !val[0]) return 0;
+   if (strcmp(val, "wait"))
+      {Eroute.Emsg("Config", "Invalid asyncopen option -", val); return 1;}
+   if (!(val = Config.GetWord()) || !val[0])
+      {Eroute.Emsg("Config", "asyncopen wait value not specified"); return 1;}
+   if (XrdOuca2x::a2tm(Eroute, "asyncopen wait", val, &wsec, 1)) return 1;
+   XrdOfsAsyncOpen::SetWait(wsec);
+   return 0;
+}
+
 /******************************************************************************/
 /*                                x c k s r t                                 */
 /******************************************************************************/
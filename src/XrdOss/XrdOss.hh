@@ -46,6 +46,7 @@
 #include "XrdOuc/XrdOucRange.hh"
 
 struct XrdOucCloneSeg;
+class XrdOucCacheIOCB;
 class XrdOucEnv;
 class XrdSysLogger;
 class XrdSfsAio;
@@ -507,6 +508,31 @@ const char     *getTID() {return tident;}
 
 virtual        ~XrdOssDF() {}
 
+//-----------------------------------------------------------------------------
+//! Open a file asynchronously. This is only called when Features() reports
+//! XRDOSS_HASAOPN and the open may be deferred. It is declared after all other
+//! virtual methods so that plugins built against earlier headers keep their
+//! vtable layout.
+//!
+//! @param  path   - Pointer to the path of the file to be opened.
+//! @param  Oflag  - Standard open flags.
+//! @param  Mode   - File open mode (ignored unless creating a file).
+//! @param  env    - Reference to environmental information. It need not
+//!                  remain valid after this method returns.
+//! @param  cbP    - Reference to the callback object whose Done() method is
+//!                  invoked with 0 or -errno when the open completes.
+//!
+//! @return 0 if the open was started; the callback will be invoked. Otherwise
+//!         -errno or -osserr (see XrdOssError.hh) and the callback is not
+//!         invoked. -ENOTSUP means the open must be done using Open().
+//-----------------------------------------------------------------------------
+
+virtual int     OpenAsync(const char *path, int Oflag, mode_t Mode,
+                          XrdOucEnv &env, XrdOucCacheIOCB &cbP)
+                         {(void)path; (void)Oflag; (void)Mode; (void)env;
+                          (void)cbP; return -ENOTSUP;
+                         }
+
 
 protected:
 
@@ -542,6 +568,7 @@ short       rsvd;    // Reserved
 #define XRDOSS_HASRPXY 0x0000000000000040ULL
 #define XRDOSS_HASXERT 0x0000000000000080ULL
 #define XRDOSS_HASFICL 0x0000000000000100ULL
+#define XRDOSS_HASAOPN 0x0000000000000200ULL
 
 // Options that can be passed to Stat()
 //
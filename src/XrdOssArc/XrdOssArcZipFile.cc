@@ -34,11 +34,9 @@
 #include <unistd.h>
 #include <sys/stat.h>
 
-#include <zip.h>
+#include <zlib.h>
 
-#include "XrdOss/XrdOss.hh"
 #include "XrdOssArc/XrdOssArcZipFile.hh"
-#include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucString.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
@@ -53,14 +51,20 @@ extern XrdSysError     Elog;
 }
 using namespace XrdOssArcGlobals;
 
+namespace
+{
+static const int inBuffSize = 65536;
+}
+
 /******************************************************************************/
 /*                           C o n s t r u c t o r                            */
 /******************************************************************************/
 
 XrdOssArcZipFile::XrdOssArcZipFile(const char* path, int &rc)
 {
-   XrdOucEnv zipEnv;
-   int zFD, zrc;
+// Record path
+//
+   zPath = strdup(path);
 
 // Try to open the file. We only support read mode.
 //
@@ -69,22 +73,19 @@ XrdOssArcZipFile::XrdOssArcZipFile(const char* path, int &rc)
        return;
       }
 
-// Get the stat information for the archive now using the retrned FD as
-// as attaching the FD to a zipfile "destroys" the original FD.
-//
-   if (fstat(zFD, &zFStat)) memset(&zFStat, 0, sizeof(zFStat));
-
-// Record path
-//
-   zPath = strdup(path);
-
-// Convert open to archive open
+// Get the stat information for the archive. It also identifies the archive
+// for the purpose of finding its central directory index.
 //
-   if ((zFile = zip_fdopen(zFD, ZIP_CHECKCONS, &zrc)) == 0)
-      {rc = zip2syserr("fdopen", zrc);
-       close(zFD);
+   if (fstat(zFD, &zFStat))
+      {rc = -errno;
        return;
       }
+
+// Get the index of the archive; this only parses the central directory if
+// no one else has done so for this version of the archive.
+//
+   if (!(zIndex = XrdOssArcZipIndex::Get(path, zFD, zFStat, rc)))
+      zipEmsg("index", rc);
 }
   
 /******************************************************************************/
@@ -95,17 +96,21 @@ XrdOssArcZipFile::~XrdOssArcZipFile()
 {
 // If we have an open subfile, close it
 //
-   if (zSubFile) Close();
+   if (zMbr) Close();
 
-// Close the archive itself
+// Release the inflation state
 //
-   if (zFile)
-      {if (zip_close(zFile))
-          {zipEmsg("close", zip_get_error(zFile));
-           zip_discard(zFile);
-          }
-       zFile = 0;
+   if (zStrm)
+      {inflateEnd(zStrm);
+       delete zStrm;
       }
+   delete [] zWin;
+   delete [] zInBuff;
+
+// Release the index and close the archive itself
+//
+   if (zIndex) zIndex->Recycle();
+   if (zFD >= 0) close(zFD);
 
 // Free up any storage
 //
@@ -118,22 +123,16 @@ XrdOssArcZipFile::~XrdOssArcZipFile()
   
 int XrdOssArcZipFile::Close()
 {
-   int zrc = 0;
-
-// Close the member subfile if it is open
-//
-   if (zSubFile)
-      {if ((zrc = zip_fclose(zSubFile))) zrc = zip2syserr("close member", zrc);
-       zSubFile = 0;
-      }
 
 // Remove all vestigaes of this subfile
 //
    if (zMember) {free(zMember); zMember = 0;}
+   zMbr  = 0;
+   zLive = false;
 
 // All done
 //
-   return zrc;
+   return 0;
 }
 
 /******************************************************************************/
@@ -142,39 +141,42 @@ int XrdOssArcZipFile::Close()
   
 int XrdOssArcZipFile::Open(const char* member)
 {
-   int rc; 
+   XrdOssArcZipIndex::Member* mbr;
+   long long dOff;
 
 // Make sure we have an open archive here
 //
-   if (zFile == 0) return -EBADF;
+   if (zIndex == 0) return -EBADF;
 
 // If an archive member is alreaddy open then close it
 //
-   if (zSubFile)
-      {if ((rc = zip_fclose(zSubFile))) zip2syserr("close", rc, true);
-       free(zMember);
-       zMember  = 0;
-       zSubFile = 0;
-      }
+   if (zMbr) Close();
 
 // Set member name we are handling
 //
    if (zMember) free(zMember);
    zMember = strdup(member);
 
-// Open the archive member
+// Locate the archive member. We can only handle unencrypted members that are
+// either stored or deflated.
 //
-   zSubFile = zip_fopen(zFile, zMember, 0);   
-   if (zSubFile == 0) return zip2syserr("open", zip_get_error(zFile));
+   if (!(mbr = zIndex->Find(zMember))) return -ENOENT;
+   if (mbr->flags & 0x0001
+   || (mbr->method != XrdOssArcZipIndex::methStored
+   &&  mbr->method != XrdOssArcZipIndex::methDeflate))
+      {zipEmsg("open", EOPNOTSUPP);
+       return -EOPNOTSUPP;
+      }
 
-// We should check if this is a compressed archive as ther can onl be read
-// sequentially. However, that is not supported until v 10.1 and the current
-// rpms available at 1.7. So, we punt on this and assume it not compressed and
-// is  seekable. Note that compressed files are not seekable.
+// Locate the data. Stored members are read directly at this offset while
+// deflated ones are inflated starting from the nearest seek point.
 //
-// zSeek = zip_file_is_seekable(zSubFile) == 1;
-   zSeek = true;
-   zOffset = 0;
+   if ((dOff = zIndex->DataOffset(*mbr, zFD)) < 0)
+      {zipEmsg("open", (int)-dOff);
+       return (int)dOff;
+      }
+   zData = dOff;
+   zMbr  = mbr;
 
 // All done
 //
@@ -187,35 +189,36 @@ int XrdOssArcZipFile::Open(const char* member)
 
 ssize_t XrdOssArcZipFile::Read(void *buff, off_t offset, size_t blen)
 {
-// Make sure this file is actually open
-//
-   if (zSubFile == 0) return -EBADF;
-   if (!blen) return 0;
+   ssize_t ret, totr = 0;
 
-// If this file does not support seeks, return a seek error if a seek wanted
+// Make sure this file is actually open
 //
-   if (offset != zOffset)
-      {if (!zSeek) return -ESPIPE;
-       if (zip_fseek(zSubFile, offset, SEEK_SET))
-          return zip2syserr("seek into", zip_file_get_error(zSubFile));
-       zEOF = false;
-      }
+   if (zMbr == 0) return -EBADF;
+   if (offset < 0) return -EINVAL;
 
-// Check if we have reached EOF
+// Trim the request to the size of the member
 //
-   if (zEOF) return 0;
+   if ((uint64_t)offset >= zMbr->uSize || !blen) return 0;
+   if (blen > zMbr->uSize - offset) blen = zMbr->uSize - offset;
 
-// Perform the read
+// Deflated members need to be inflated
 //
-   zip_int64_t ret = zip_fread(zSubFile, buff, blen);  
-   if (ret < 0)
-      return zip2syserr("read", zip_file_get_error(zSubFile));
+   if (zMbr->method != XrdOssArcZipIndex::methStored)
+      return Inflate((char *)buff, offset, blen);
 
-// Update offset and check for EOF
+// Stored members are read directly from the archive
 //
-   zOffset += ret;
-   if (ret < (zip_int64_t)blen) zEOF = true;
-   return ret;
+   while(blen)
+        {if ((ret = pread(zFD, buff, blen, zData + offset)) <= 0)
+            {if (!ret) break;
+             if (errno == EINTR) continue;
+             ret = errno;
+             zipEmsg("read", ret);
+             return -ret;
+            }
+         buff = (char *)buff + ret; offset += ret; blen -= ret; totr += ret;
+        }
+   return totr;
 }
 
 /******************************************************************************/
@@ -224,61 +227,189 @@ ssize_t XrdOssArcZipFile::Read(void *buff, off_t offset, size_t blen)
 
 int XrdOssArcZipFile::Stat(struct stat& buf)
 {
-   zip_stat_t zStat;
-
 // Make sure this file is actually open
 //
-   if (zSubFile == 0) return -EBADF;
+   if (zMbr == 0) return -EBADF;
 
-// Iniialize the stat buffer
+// Return the archive information adjusted for the member
 //
-  memcpy(&buf, &zFStat, sizeof(struct stat));
+   memcpy(&buf, &zFStat, sizeof(struct stat));
+   buf.st_ino  = zIndex->Ordinal(zMbr);
+   buf.st_size = zMbr->uSize;
+   return 0;
+}
 
-// Clear the stat structures
-//
-   zip_stat_init(&zStat);
+/******************************************************************************/
 
-// Get information
+int XrdOssArcZipFile::Stat(const char* mName, struct stat& buf)
+{
+   XrdOssArcZipIndex::Member* mbr;
+
+// Make sure we have an open archive here
 //
-   if (zip_stat(zFile, zMember, 0, &zStat) < 0)
-      return zip2syserr("stat", zip_get_error(zFile));
+   if (zIndex == 0) return -EBADF;
 
-// Copy the relevant information
+// Locate the member
 //
-   if (zStat.valid & ZIP_STAT_INDEX) buf.st_ino  = zStat.index;
-   if (zStat.valid & ZIP_STAT_SIZE)  buf.st_size = zStat.size;
+   if (!(mbr = zIndex->Find(mName))) return -ENOENT;
 
-// All done
+// Return the archive information adjusted for the member
 //
+   memcpy(&buf, &zFStat, sizeof(struct stat));
+   buf.st_ino  = zIndex->Ordinal(mbr);
+   buf.st_size = mbr->uSize;
    return 0;
 }
 
+/******************************************************************************/
+/* Private:                      I n f l a t e                                */
 /******************************************************************************/
 
-int XrdOssArcZipFile::Stat(const char* mName, struct stat& buf)
+ssize_t XrdOssArcZipFile::Inflate(char *buff, off_t offset, size_t blen)
 {
-   zip_stat_t zStat;
-
-// Iniialize the stat buffer
-//
-  memcpy(&buf, &zFStat, sizeof(struct stat));
+   XrdOssArcZipIndex::Point pnt;
+   size_t totr = 0;
+   int rc, zrc, wlen, n;
+
+// Get positioned so that the next inflated byte is at or before offset
+//
+   if ((rc = Position(offset))) return rc;
+
+// Inflate until we have satisfied the request. Inflation stops at each
+// deflate block boundary so that we can record seek points as we go.
+//
+   while(totr < blen && !zEOF)
+        {if (!zStrm->avail_in && zCPos < (off_t)zMbr->cSize)
+            {off_t left = zMbr->cSize - zCPos;
+             n = (left < inBuffSize ? (int)left : inBuffSize);
+             if ((n = pread(zFD, zInBuff, n, zData + zCPos)) <= 0)
+                {if (n && errno == EINTR) continue;
+                 rc = (n ? errno : ENOEXEC);
+                 break;
+                }
+             zStrm->next_in  = (Bytef *)zInBuff;
+             zStrm->avail_in = n;
+             zCPos += n;
+            }
+
+         if (zWPos == XrdOssArcZipIndex::winSize) zWPos = 0;
+         wlen = XrdOssArcZipIndex::winSize - zWPos;
+         zStrm->next_out  = (Bytef *)(zWin + zWPos);
+         zStrm->avail_out = wlen;
+
+         zrc = inflate(zStrm, Z_BLOCK);
+         if (zrc != Z_OK && zrc != Z_STREAM_END && zrc != Z_BUF_ERROR)
+            {rc = (zrc == Z_MEM_ERROR ? ENOMEM : EILSEQ);
+             break;
+            }
+
+         // Hand out whatever part of the output falls within the request
+         //
+         if ((n = wlen - zStrm->avail_out))
+            {off_t want = offset + totr;
+             if (zUPos + n > want)
+                {size_t skip = want - zUPos, mlen = n - skip;
+                 if (mlen > blen - totr) mlen = blen - totr;
+                 memcpy(buff + totr, zWin + zWPos + skip, mlen);
+                 totr += mlen;
+                }
+             zWPos  += n;
+             zUPos  += n;
+             zWFill += n;
+             if (zWFill > XrdOssArcZipIndex::winSize)
+                zWFill = XrdOssArcZipIndex::winSize;
+            }
+
+         // No progress means the compressed data ended prematurely
+         //
+         if (zrc == Z_STREAM_END) zEOF = true;
+            else if (zrc == Z_BUF_ERROR && !n) {rc = ENOEXEC; break;}
+
+         // At a block boundary remember where we are, if far enough along
+         //
+         if ((zStrm->data_type & 128) && !(zStrm->data_type & 64)
+         &&  zUPos >= zNextPt)
+            {int head = XrdOssArcZipIndex::winSize - zWPos;
+             pnt.uOff   = zUPos;
+             pnt.cOff   = zCPos - zStrm->avail_in;
+             pnt.bits   = zStrm->data_type & 7;
+             pnt.wLen   = zWFill;
+             pnt.window = new char[zWFill];
+             if (zWFill < XrdOssArcZipIndex::winSize)
+                memcpy(pnt.window, zWin, zWFill);
+                else {memcpy(pnt.window, zWin + zWPos, head);
+                      memcpy(pnt.window + head, zWin, zWPos);
+                     }
+             zIndex->AddPoint(*zMbr, pnt);
+             zNextPt = zUPos + XrdOssArcZipIndex::pointSpan;
+            }
+        }
+
+// Diagnose any errors. The stream is no longer trustworthy and is restarted
+// on the next read.
+//
+   if (rc)
+      {zLive = false;
+       zipEmsg("inflate", rc);
+       return -rc;
+      }
+   return totr;
+}
 
-// Clear the stat structures
-//
-   zip_stat_init(&zStat);
+/******************************************************************************/
+/* Private:                     P o s i t i o n                               */
+/******************************************************************************/
 
-// Get information
-//
-   if (zip_stat(zFile, mName, 0, &zStat) < 0)
-      return zip2syserr("stat", zip_get_error(zFile));
+int XrdOssArcZipFile::Position(off_t offset)
+{
+   XrdOssArcZipIndex::Point pnt;
+   bool havePnt;
+   int rc;
+
+// Allocate the inflation state on first use
+//
+   if (!zStrm)
+      {zStrm = new z_stream;
+       memset(zStrm, 0, sizeof(z_stream));
+       if (inflateInit2(zStrm, -MAX_WBITS) != Z_OK)
+          {delete zStrm; zStrm = 0;
+           return -ENOMEM;
+          }
+       zWin    = new char[XrdOssArcZipIndex::winSize];
+       zInBuff = new char[inBuffSize];
+      }
 
-// Copy the relevant information
+// If we can simply continue inflating, do so unless there is a seek point
+// that gets us closer to where we want to be.
 //
-   if (zStat.valid & ZIP_STAT_INDEX) buf.st_ino  = zStat.index;
-   if (zStat.valid & ZIP_STAT_SIZE)  buf.st_size = zStat.size;
+   havePnt = zIndex->GetPoint(*zMbr, offset, pnt);
+   if (zLive && offset >= zUPos && (!havePnt || pnt.uOff <= zUPos)) return 0;
 
-// All done
+// Restart the stream either at the seek point or at the front of the member
 //
+   inflateReset(zStrm);
+   zStrm->avail_in = 0;
+   zLive = zEOF = false;
+   if (havePnt)
+      {zCPos = pnt.cOff;
+       if (pnt.bits)
+          {unsigned char byte;
+           if (pread(zFD, &byte, 1, zData + pnt.cOff - 1) != 1) return -EIO;
+           inflatePrime(zStrm, pnt.bits, byte >> (8 - pnt.bits));
+          }
+       if ((rc = inflateSetDictionary(zStrm, (Bytef *)pnt.window, pnt.wLen)))
+          return -EILSEQ;
+       memcpy(zWin, pnt.window, pnt.wLen);
+       zWFill  = zWPos = pnt.wLen;
+       zUPos   = pnt.uOff;
+       zNextPt = pnt.uOff + XrdOssArcZipIndex::pointSpan;
+      } else {
+       zCPos   = 0;
+       zWFill  = zWPos = 0;
+       zUPos   = 0;
+       zNextPt = XrdOssArcZipIndex::pointSpan;
+      }
+   zLive = true;
    return 0;
 }
 
@@ -286,7 +417,7 @@ int XrdOssArcZipFile::Stat(const char* mName, struct stat& buf)
 /*                               z i p E m s g                                */
 /******************************************************************************/
   
-void XrdOssArcZipFile::zipEmsg(const char *what, zip_error_t* zerr)
+void XrdOssArcZipFile::zipEmsg(const char *what, int rc)
 {
    XrdOucString target(zPath, 280);
 
@@ -294,55 +425,9 @@ void XrdOssArcZipFile::zipEmsg(const char *what, zip_error_t* zerr)
 //
    target += '[';
    if (zMember) target += zMember;
-   target += "];";
-
-// Create starting error message
-//
-   char eText[80];
-   snprintf(eText, sizeof(eText), "unable to %s", what);
+   target += "]";
 
 // Issue message
 //
-   Elog.Emsg("ZipFile", eText, target.c_str(), zip_error_strerror(zerr));
-}
-  
-/******************************************************************************/
-/* Private:                   z i p 2 s y s e r r                             */
-/******************************************************************************/
-  
-int XrdOssArcZipFile::zip2syserr(const char *what, zip_error_t* zerr, bool msg)
-{
-   int retc = zip_error_code_zip(zerr);
-   if (retc != ZIP_ER_OK)
-      {switch(retc)
-             {case ZIP_ER_CRC:       retc = EILSEQ;         break; 
-              case ZIP_ER_EXISTS:    retc = EEXIST;         break; 
-              case ZIP_ER_INCONS:    retc = ENOEXEC;        break; 
-              case ZIP_ER_INUSE:     retc = EBUSY;          break; 
-              case ZIP_ER_INVAL:     retc = EINVAL;         break; 
-              case ZIP_ER_MEMORY:    retc = ENOMEM;         break; 
-              case ZIP_ER_NOENT:     retc = ENOENT;         break; 
-              case ZIP_ER_NOZIP:     retc = ENOTBLK;        break; 
-              case ZIP_ER_OPNOTSUPP: retc = EOPNOTSUPP;     break; 
-              case ZIP_ER_RDONLY:    retc = EROFS;          break; 
-              case ZIP_ER_READ:      retc = EIO;            break; 
-              case ZIP_ER_SEEK:      retc = ESPIPE;         break; 
-              case ZIP_ER_WRITE:     retc = EIO;            break; 
-              default:               retc = EDOM;           break; 
-             }
-      } else {
-       retc = zip_error_code_system(zerr);
-       if (retc == 0) retc = ENOMSG;
-          else if (retc < 0) retc = -retc;
-      }
-   if (msg) zipEmsg(what, zerr);
-   zip_error_fini(zerr);
-   return -retc;
-}
-
-int XrdOssArcZipFile::zip2syserr(const char *what, int zrc, bool msg)
-{
-   zip_error_t zerr;
-   zip_error_init_with_code(&zerr, zrc);
-   return zip2syserr(what, &zerr, msg); 
+   Elog.Emsg("ZipFile", (rc < 0 ? -rc : rc), what, target.c_str());
 }
@@ -30,17 +30,14 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+
 #include <string.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 
-struct  stat;
-struct  zip;
-typedef zip zip_t;
-struct  zip_file;
-typedef zip_file  zip_file_t;
-struct  zip_error;
-typedef zip_error zip_error_t;
-class   XrdOssDF;
+#include "XrdOssArc/XrdOssArcZipIndex.hh"
+
+struct  z_stream_s;
 
 class XrdOssArcZipFile 
 {
@@ -62,17 +59,30 @@ int     Stat(const char* mName, struct stat& buf);
 
 private:
 
-void zipEmsg(const char *what, zip_error_t* zerr);
-int  zip2syserr(const char *what, zip_error_t* zerr, bool msg=true);
-int  zip2syserr(const char *what, int zrc, bool msg=true);
-
-struct stat zFStat;
-char*       zPath     = 0;
-char*       zMember   = 0;
-zip_t*      zFile     = 0;
-zip_file_t* zSubFile  = 0;
-off_t       zOffset   = 0;
-bool        zSeek     = false;
-bool        zEOF      = false;
+ssize_t Inflate(char *buff, off_t offset, size_t blen);
+int     Position(off_t offset);
+void    zipEmsg(const char *what, int rc);
+
+struct stat                 zFStat;
+char*                       zPath     = 0;
+char*                       zMember   = 0;
+XrdOssArcZipIndex*          zIndex    = 0;
+XrdOssArcZipIndex::Member*  zMbr      = 0;
+long long                   zData     = 0;   // Offset of member data
+int                         zFD       = -1;
+
+// Inflation state for deflated members. Output is produced into a circular
+// window so that seek points can be recorded along the way.
+//
+struct z_stream_s*          zStrm     = 0;
+char*                       zWin      = 0;
+char*                       zInBuff   = 0;
+off_t                       zUPos     = 0;   // Uncompressed offset of zWin
+off_t                       zCPos     = 0;   // Compressed offset of zInBuff
+off_t                       zNextPt   = 0;   // Record next point past this
+int                         zWPos     = 0;   // Next write position in zWin
+int                         zWFill    = 0;   // Valid bytes in zWin
+bool                        zLive     = false;
+bool                        zEOF      = false;
 };
 #endif
@@ -0,0 +1,361 @@
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d O s s A r c Z i p I n d e x . c c                   */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <algorithm>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "XrdOssArc/XrdOssArcTrace.hh"
+#include "XrdOssArc/XrdOssArcZipIndex.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdZip/XrdZipCDFH.hh"
+#include "XrdZip/XrdZipEOCD.hh"
+#include "XrdZip/XrdZipExtra.hh"
+#include "XrdZip/XrdZipLFH.hh"
+#include "XrdZip/XrdZipZIP64EOCD.hh"
+#include "XrdZip/XrdZipZIP64EOCDL.hh"
+
+/******************************************************************************/
+/*                        S t a t i c   O b j e c t s                         */
+/******************************************************************************/
+  
+namespace XrdOssArcGlobals
+{
+extern XrdSysError     Elog;
+
+XrdSysMutex zixMutex;
+long long   zixIdleSeq = 0;
+int         zixIdleNum = 0;
+}
+using namespace XrdOssArcGlobals;
+
+std::map<XrdOssArcZipIndex::Key, XrdOssArcZipIndex*> XrdOssArcZipIndex::zixCache;
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdOssArcZipIndex::Member::~Member()
+{
+   if (pVec)
+      {for (auto& pnt : *pVec) delete [] pnt.window;
+       delete pVec;
+      }
+}
+
+/******************************************************************************/
+
+XrdOssArcZipIndex::~XrdOssArcZipIndex()
+{
+   delete [] mVec;
+   if (mapAddr) munmap(mapAddr, mapLen);
+}
+
+/******************************************************************************/
+/*                              A d d P o i n t                               */
+/******************************************************************************/
+
+bool XrdOssArcZipIndex::AddPoint(Member& mbr, Point& pnt)
+{
+   XrdSysMutexHelper mHelp(pMutex);
+
+// Points are recorded as members are inflated front to back, so keeping them
+// in order only requires that we reject anything not beyond the last one.
+//
+   if (!mbr.pVec) mbr.pVec = new std::vector<Point>;
+      else if (!mbr.pVec->empty()
+           &&  pnt.uOff < mbr.pVec->back().uOff + pointSpan)
+              {delete [] pnt.window;
+               pnt.window = 0;
+               return false;
+              }
+
+   mbr.pVec->push_back(pnt);
+   return true;
+}
+
+/******************************************************************************/
+/*                            D a t a O f f s e t                             */
+/******************************************************************************/
+
+long long XrdOssArcZipIndex::DataOffset(Member& mbr, int fd)
+{
+   static const int lfhSize = XrdZip::LFH::lfhBaseSize;
+   long long dOff;
+   char lfh[lfhSize];
+
+// The central directory does not tell us where the data starts as the local
+// header has its own name and extra field. Read it once and remember.
+//
+   if ((dOff = mbr.dOff.load(std::memory_order_relaxed)) >= 0) return dOff;
+
+   if (pread(fd, lfh, lfhSize, mbr.lfhOff) != lfhSize) return -EIO;
+   if (XrdZip::to<uint32_t>(lfh) != XrdZip::LFH::lfhSign) return -ENOEXEC;
+
+   dOff = mbr.lfhOff + lfhSize + XrdZip::to<uint16_t>(lfh + 26)
+                               + XrdZip::to<uint16_t>(lfh + 28);
+   if (dOff + (long long)mbr.cSize > arcSize) return -ENOEXEC;
+
+   mbr.dOff.store(dOff, std::memory_order_relaxed);
+   return dOff;
+}
+
+/******************************************************************************/
+/*                                  F i n d                                   */
+/******************************************************************************/
+
+XrdOssArcZipIndex::Member* XrdOssArcZipIndex::Find(const char* name)
+{
+   auto it = mMap.find(std::string_view(name));
+
+   return (it == mMap.end() ? 0 : it->second);
+}
+
+/******************************************************************************/
+/*                                   G e t                                    */
+/******************************************************************************/
+
+XrdOssArcZipIndex* XrdOssArcZipIndex::Get(const char* path, int fd,
+                                          const struct stat& Stat, int& rc)
+{
+   TraceInfo("ZipIndex",0);
+   XrdOssArcZipIndex* zixP;
+   Key iKey = {Stat.st_dev, Stat.st_ino, Stat.st_mtim.tv_sec,
+               Stat.st_mtim.tv_nsec};
+
+// See if we already have this archive indexed
+//
+   zixMutex.Lock();
+   auto it = zixCache.find(iKey);
+   if (it != zixCache.end())
+      {zixP = it->second;
+       if (!(zixP->numRefs++)) zixIdleNum--;
+       zixMutex.UnLock();
+       rc = 0;
+       return zixP;
+      }
+   zixMutex.UnLock();
+
+// Parse the directory without holding the lock as this may take a while
+//
+   zixP = new XrdOssArcZipIndex(iKey);
+   if ((rc = zixP->Parse(path, fd, Stat.st_size)))
+      {delete zixP;
+       return 0;
+      }
+   DEBUG("Indexed "<<zixP->mNum<<" members in "<<path);
+
+// Add it to the cache unless someone beat us to it
+//
+   zixMutex.Lock();
+   auto rc2 = zixCache.insert(std::make_pair(iKey, zixP));
+   if (!rc2.second)
+      {delete zixP;
+       zixP = rc2.first->second;
+       if (!(zixP->numRefs++)) zixIdleNum--;
+      } else zixP->numRefs = 1;
+   zixMutex.UnLock();
+   return zixP;
+}
+
+/******************************************************************************/
+/*                              G e t P o i n t                               */
+/******************************************************************************/
+
+bool XrdOssArcZipIndex::GetPoint(Member& mbr, off_t offset, Point& pnt)
+{
+   XrdSysMutexHelper mHelp(pMutex);
+
+   if (!mbr.pVec || mbr.pVec->empty()) return false;
+
+   auto it = std::upper_bound(mbr.pVec->begin(), mbr.pVec->end(), offset,
+                              [](off_t off, const Point& p)
+                                {return off < p.uOff;});
+   if (it == mbr.pVec->begin()) return false;
+
+// Windows are never freed while the index exists so the copy stays valid
+//
+   pnt = *(--it);
+   return true;
+}
+
+/******************************************************************************/
+/*                               R e c y c l e                                */
+/******************************************************************************/
+
+void XrdOssArcZipIndex::Recycle()
+{
+   XrdSysMutexHelper mHelp(zixMutex);
+
+   if (--numRefs > 0) return;
+
+// Keep the index around in case the archive is opened again. When there are
+// too many idle ones, drop the one that has been idle the longest.
+//
+   idleSeq = ++zixIdleSeq;
+   if (++zixIdleNum <= maxIdle) return;
+
+   auto old = zixCache.end();
+   for (auto it = zixCache.begin(); it != zixCache.end(); ++it)
+       {if (!it->second->numRefs
+        &&  (old == zixCache.end() || it->second->idleSeq < old->second->idleSeq))
+           old = it;
+       }
+   if (old != zixCache.end())
+      {delete old->second;
+       zixCache.erase(old);
+       zixIdleNum--;
+      }
+}
+
+/******************************************************************************/
+/* Private:                        P a r s e                                  */
+/******************************************************************************/
+
+int XrdOssArcZipIndex::Parse(const char* path, int fd, off_t fSize)
+{
+   static const int eocdSize  = XrdZip::EOCD::eocdBaseSize;
+   static const int eoclSize  = XrdZip::ZIP64_EOCDL::zip64EocdlSize;
+   static const int e64Size   = XrdZip::ZIP64_EOCD::zip64EocdBaseSize;
+   static const int cdfhSize  = XrdZip::CDFH::cdfhBaseSize;
+   static const int tailMax   = eocdSize + XrdZip::EOCD::maxCommentLength
+                              + eoclSize;
+   char tail[tailMax], e64[e64Size];
+   const char *eocd, *cdP, *cdEnd;
+   uint64_t cdOff, cdSize, cdNum;
+   int tLen;
+
+   arcSize = fSize;
+
+// Read the tail of the archive and locate the end of central directory record
+//
+   tLen = (fSize < tailMax ? (int)fSize : tailMax);
+   if (tLen < eocdSize) return -ENOTBLK;
+   if (pread(fd, tail, tLen, fSize - tLen) != tLen) return -EIO;
+   if (!(eocd = XrdZip::EOCD::Find(tail, tLen))) return -ENOTBLK;
+
+   cdNum  = XrdZip::to<uint16_t>(eocd + 10);
+   cdSize = XrdZip::to<uint32_t>(eocd + 12);
+   cdOff  = XrdZip::to<uint32_t>(eocd + 16);
+
+// Large archives have the real values in the zip64 end of directory record
+// which is found via the locator that immediately precedes the record above.
+//
+   if (cdNum  == XrdZip::ovrflw<uint16_t>::value
+   ||  cdSize == XrdZip::ovrflw<uint32_t>::value
+   ||  cdOff  == XrdZip::ovrflw<uint32_t>::value)
+      {const char* eocl = eocd - eoclSize;
+       if (eocl < tail
+       ||  XrdZip::to<uint32_t>(eocl) != XrdZip::ZIP64_EOCDL::zip64EocdlSign)
+          return -ENOEXEC;
+       uint64_t e64Off = XrdZip::to<uint64_t>(eocl + 8);
+       if (e64Off + e64Size > (uint64_t)fSize
+       ||  pread(fd, e64, e64Size, e64Off) != e64Size
+       ||  XrdZip::to<uint32_t>(e64) != XrdZip::ZIP64_EOCD::zip64EocdSign)
+          return -ENOEXEC;
+       cdNum  = XrdZip::to<uint64_t>(e64 + 32);
+       cdSize = XrdZip::to<uint64_t>(e64 + 40);
+       cdOff  = XrdZip::to<uint64_t>(e64 + 48);
+      }
+   if (cdOff + cdSize > (uint64_t)fSize || cdNum > cdSize / cdfhSize + 1)
+      return -ENOEXEC;
+
+// Map the central directory. Names are left in the mapping and referred to
+// from there so that large directories do not get copied.
+//
+   if (cdSize)
+      {off_t pgSz = sysconf(_SC_PAGESIZE);
+       off_t mOff = cdOff & ~(pgSz - 1);
+       mapLen = cdOff + cdSize - mOff;
+       mapAddr = mmap(0, mapLen, PROT_READ, MAP_SHARED, fd, mOff);
+       if (mapAddr == MAP_FAILED)
+          {int rc = errno;
+           mapAddr = 0;
+           Elog.Emsg("ZipIndex", rc, "map central directory of", path);
+           return -rc;
+          }
+       madvise(mapAddr, mapLen, MADV_WILLNEED);
+       cdP = (const char*)mapAddr + (cdOff - mOff);
+      } else cdP = 0;
+   cdEnd = cdP + cdSize;
+
+// Parse each directory entry
+//
+   mVec = new Member[cdNum];
+   mMap.reserve(cdNum);
+   for (mNum = 0; mNum < (int)cdNum; mNum++)
+       {Member& mbr = mVec[mNum];
+        if (cdEnd - cdP < cdfhSize
+        ||  XrdZip::to<uint32_t>(cdP) != XrdZip::CDFH::cdfhSign) return -ENOEXEC;
+
+        mbr.flags  = XrdZip::to<uint16_t>(cdP +  8);
+        mbr.method = XrdZip::to<uint16_t>(cdP + 10);
+        mbr.cSize  = XrdZip::to<uint32_t>(cdP + 20);
+        mbr.uSize  = XrdZip::to<uint32_t>(cdP + 24);
+        mbr.nLen   = XrdZip::to<uint16_t>(cdP + 28);
+        mbr.lfhOff = XrdZip::to<uint32_t>(cdP + 42);
+        int xLen   = XrdZip::to<uint16_t>(cdP + 30);
+        int eLen   = cdfhSize + mbr.nLen + xLen + XrdZip::to<uint16_t>(cdP + 32);
+        if (cdEnd - cdP < eLen) return -ENOEXEC;
+        mbr.name   = cdP + cdfhSize;
+
+        // Overflowed values are in the zip64 extra field in a fixed order
+        //
+        if (mbr.uSize  == XrdZip::ovrflw<uint32_t>::value
+        ||  mbr.cSize  == XrdZip::ovrflw<uint32_t>::value
+        ||  mbr.lfhOff == XrdZip::ovrflw<uint32_t>::value)
+           {const char* xP = XrdZip::Extra::Find(mbr.name + mbr.nLen, xLen);
+            if (!xP) return -ENOEXEC;
+            const char* xEnd = xP + 4 + XrdZip::to<uint16_t>(xP + 2);
+            if (xEnd > mbr.name + mbr.nLen + xLen) return -ENOEXEC;
+            xP += 4;
+            uint64_t* vals[] = {&mbr.uSize, &mbr.cSize, &mbr.lfhOff};
+            for (uint64_t* vP : vals)
+                {if (*vP != XrdZip::ovrflw<uint32_t>::value) continue;
+                 if (xEnd - xP < 8) return -ENOEXEC;
+                 *vP = XrdZip::to<uint64_t>(xP);
+                 xP += 8;
+                }
+           }
+        if (mbr.lfhOff + mbr.cSize > (uint64_t)fSize) return -ENOEXEC;
+
+        // Should a name appear more than once, the first entry wins
+        //
+        mMap.emplace(std::string_view(mbr.name, mbr.nLen), &mbr);
+        cdP += eLen;
+       }
+
+// All done
+//
+   return 0;
+}
@@ -0,0 +1,155 @@
+#ifndef _XRDOSSARCZIPINDEX_H
+#define _XRDOSSARCZIPINDEX_H
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d O s s A r c Z i p I n d e x . h h                   */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+struct stat;
+
+// This class holds the parsed central directory of an archive. The directory
+// is memory mapped and parsed once; the result is shared by every open of a
+// member of the same archive (same device, inode, and modification time) and
+// is kept around for a while after the last close so that a subsequent open
+// need not parse it again. For deflated members the index also accumulates
+// the seek points found while inflating them so later reads can start near
+// the wanted offset instead of at the beginning of the member.
+//
+class XrdOssArcZipIndex
+{
+public:
+
+struct Point                    // Restart point in a deflated member
+      {off_t       uOff;        // Offset in the uncompressed data
+       off_t       cOff;        // Offset in the compressed data
+       int         bits;        // Bits to prime from the byte before cOff
+       int         wLen;        // Length of the window
+       char*       window;      // Preceding 32K of uncompressed data
+      };
+
+struct Member
+      {const char*             name;    // Points into the mapped directory
+       uint64_t                cSize;   // Compressed size
+       uint64_t                uSize;   // Uncompressed size
+       uint64_t                lfhOff;  // Offset of the local header
+       std::atomic<long long>  dOff;    // Offset of the data (-1 -> unknown)
+       std::vector<Point>*     pVec;    // Seek points (deflated only)
+       uint16_t                nLen;    // Length of the name
+       uint16_t                method;  // Compression method
+       uint16_t                flags;   // General purpose flags
+
+       Member() : dOff(-1), pVec(0) {}
+      ~Member();
+      };
+
+static const int    methStored  = 0;
+static const int    methDeflate = 8;
+static const int    winSize     = 32768;
+static const off_t  pointSpan   = 4*1024*1024;
+
+// Add a seek point to a deflated member. The window, allocated via new[],
+// becomes owned by the index. Points must be at least pointSpan apart and
+// are only accepted in ascending order; return false if not accepted.
+//
+bool                AddPoint(Member& mbr, Point& pnt);
+
+// Return the offset of the member's data in the archive or -errno.
+//
+long long           DataOffset(Member& mbr, int fd);
+
+// Find a member by name; return nil if it does not exist.
+//
+Member*             Find(const char* name);
+
+// Return the index for the archive open on fd, parsing it if need be. The
+// index must be released with Recycle(). Upon failure nil is returned with
+// rc holding -errno.
+//
+static
+XrdOssArcZipIndex*  Get(const char* path, int fd, const struct stat& Stat,
+                        int& rc);
+
+// Return the seek point nearest to but not after offset, false if none.
+//
+bool                GetPoint(Member& mbr, off_t offset, Point& pnt);
+
+int                 Members() {return mNum;}
+
+int                 Ordinal(const Member* mbr) {return (int)(mbr - mVec);}
+
+// Release the index obtained via Get().
+//
+void                Recycle();
+
+private:
+
+struct Key
+      {dev_t  dev;
+       ino_t  ino;
+       time_t mtime;
+       long   mnsec;
+
+       bool operator<(const Key& rhs) const
+            {if (dev   != rhs.dev)   return dev   < rhs.dev;
+             if (ino   != rhs.ino)   return ino   < rhs.ino;
+             if (mtime != rhs.mtime) return mtime < rhs.mtime;
+             return mnsec < rhs.mnsec;
+            }
+      };
+
+      XrdOssArcZipIndex(const Key& key) : iKey(key) {}
+     ~XrdOssArcZipIndex();
+
+int   Parse(const char* path, int fd, off_t fSize);
+
+static const int maxIdle = 64;   // Unreferenced indexes kept around
+
+static std::map<Key, XrdOssArcZipIndex*> zixCache;
+
+std::unordered_map<std::string_view, Member*> mMap;
+Member*             mVec    = 0;
+XrdSysMutex         pMutex;      // Protects the seek point vectors
+Key                 iKey;
+void*               mapAddr = 0;
+size_t              mapLen  = 0;
+long long           idleSeq = 0; // When the last reference went away
+off_t               arcSize = 0;
+int                 mNum    = 0;
+int                 numRefs = 0;
+};
+#endif
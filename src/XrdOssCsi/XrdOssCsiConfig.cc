@@ -86,6 +86,16 @@ int XrdOssCsiConfig::Init(XrdSysError &Eroute, const char *config_fn, const char
       {
          disableLooseWrite_ = true;
       }
+      else if (item == "tagstore")
+      {
+         if (value == "mmap") mmapTags_ = true;
+         else if (value == "file") mmapTags_ = false;
+         else
+         {
+            Eroute.Emsg("Config","tagstore must be file or mmap");
+            NoGo = 1;
+         }
+      }
    }
 
    if (NoGo) return NoGo;
@@ -99,6 +109,7 @@ int XrdOssCsiConfig::Init(XrdSysError &Eroute, const char *config_fn, const char
    Eroute.Say("       allow files without CRCs: ", allowMissingTags_ ? "yes" : "no");
    Eroute.Say("       pgWrite can extend      : ", disablePgExtend_ ? "no" : "yes");
    Eroute.Say("       loose writes            : ", disableLooseWrite_ ? "no" : "yes");
+   Eroute.Say("       tag store               : ", mmapTags_ ? "mmap" : "file");
    Eroute.Say("       trace level             : ", std::to_string((long long int)OssCsiTrace.What).c_str());
    Eroute.Say("       prefix                  : ", tagParam_.prefix_.empty() ? "[empty]" : tagParam_.prefix_.c_str());
 
@@ -188,7 +188,7 @@ class XrdOssCsiConfig
 {
 public:
 
-  XrdOssCsiConfig() : fillFileHole_(true), xrdtSpaceName_("public"), allowMissingTags_(true), disablePgExtend_(false), disableLooseWrite_(false) { }
+  XrdOssCsiConfig() : fillFileHole_(true), xrdtSpaceName_("public"), allowMissingTags_(true), disablePgExtend_(false), disableLooseWrite_(false), mmapTags_(false) { }
   ~XrdOssCsiConfig() { }
 
   int Init(XrdSysError &, const char *, const char *, XrdOucEnv *);
@@ -203,6 +203,8 @@ public:
 
   bool disableLooseWrite() const { return disableLooseWrite_; }
 
+  bool mmapTags() const { return mmapTags_; }
+
   TagPath tagParam_;
 
 private:
@@ -217,6 +219,7 @@ private:
   bool allowMissingTags_;
   bool disablePgExtend_;
   bool disableLooseWrite_;
+  bool mmapTags_;
 };
 
 #endif
@@ -32,6 +32,7 @@
 #include "XrdOssCsi.hh"
 #include "XrdOssCsiTrace.hh"
 #include "XrdOssCsiTagstoreFile.hh"
+#include "XrdOssCsiTagstoreMmap.hh"
 #include "XrdOssCsiPages.hh"
 #include "XrdOssCsiRanges.hh"
 #include "XrdOuc/XrdOucCRC.hh"
@@ -257,8 +258,15 @@ int XrdOssCsiFile::createPageUpdater(const int Oflag, XrdOucEnv &Env)
    }
 
    std::unique_ptr<XrdOssDF> integFile(parentOss_->newFile(tident));
-   std::unique_ptr<XrdOssCsiTagstore> ts(new
-      XrdOssCsiTagstoreFile(pmi_->dpath, std::move(integFile), tident));
+   std::unique_ptr<XrdOssCsiTagstore> ts;
+   if (config_.mmapTags())
+   {
+      ts.reset(new XrdOssCsiTagstoreMmap(pmi_->dpath, std::move(integFile), tident));
+   }
+   else
+   {
+      ts.reset(new XrdOssCsiTagstoreFile(pmi_->dpath, std::move(integFile), tident));
+   }
    std::unique_ptr<XrdOssCsiPages> pages(new
       XrdOssCsiPages(pmi_->dpath, std::move(ts), config_.fillFileHole(), config_.allowMissingTags(),
                      config_.disablePgExtend(), config_.disableLooseWrite(), tident));
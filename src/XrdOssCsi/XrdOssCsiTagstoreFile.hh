@@ -133,7 +133,7 @@ public:
       return nwritten;
    }
 
-private:
+protected:
    const std::string fn_;
    std::unique_ptr<XrdOssDF> fd_;
    off_t trackinglen_;
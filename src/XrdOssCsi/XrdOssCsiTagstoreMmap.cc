@@ -0,0 +1,272 @@
+/******************************************************************************/
+/*                                                                            */
+/*              X r d O s s C s i T a g s t o r e M m a p . c c               */
+/*                                                                            */
+/* (C) Copyright 2026 CERN.                                                   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* In applying this licence, CERN does not waive the privileges and           */
+/* immunities granted to it by virtue of its status as an Intergovernmental   */
+/* Organization or submit itself to any jurisdiction.                         */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XrdOssCsiTrace.hh"
+#include "XrdOssCsiTagstoreMmap.hh"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+extern XrdOucTrace  OssCsiTrace;
+
+int XrdOssCsiTagstoreMmap::Open(const char *path, const off_t dsize, const int Oflag, XrdOucEnv &Env)
+{
+   writable_ = ((Oflag & O_ACCMODE) != O_RDONLY);
+   canmap_ = true;
+
+   // the file based open validates the header and calls ResetSizes, which
+   // establishes the mapping
+   return XrdOssCsiTagstoreFile::Open(path, dsize, Oflag, Env);
+}
+
+int XrdOssCsiTagstoreMmap::Close()
+{
+   if (!isOpen) return -EBADF;
+   {
+      XrdSysRWLockHelper lck(maplock_, false);
+      (void)SyncDirty(false);
+      Unmap();
+   }
+   return XrdOssCsiTagstoreFile::Close();
+}
+
+void XrdOssCsiTagstoreMmap::Flush()
+{
+   if (!isOpen) return;
+   {
+      XrdSysRWLockHelper lck(maplock_);
+      (void)SyncDirty(false);
+   }
+   XrdOssCsiTagstoreFile::Flush();
+}
+
+int XrdOssCsiTagstoreMmap::Fsync()
+{
+   if (!isOpen) return -EBADF;
+   {
+      XrdSysRWLockHelper lck(maplock_);
+      const int sret = SyncDirty(true);
+      if (sret<0) return sret;
+   }
+   return XrdOssCsiTagstoreFile::Fsync();
+}
+
+ssize_t XrdOssCsiTagstoreMmap::WriteTags(const uint32_t *const buf, const off_t off, const size_t n)
+{
+   if (!isOpen) return -EBADF;
+
+   const size_t start = 20 + 4*off;
+   const size_t len = 4*n;
+   {
+      XrdSysRWLockHelper lck(maplock_);
+      if (mapbase_ && writable_ && start+len <= maplen_)
+      {
+         memcpy(&mapbase_[start], buf, len);
+         XrdSysMutexHelper dlck(dirtymtx_);
+         if (dirtylo_ == dirtyhi_)
+         {
+            dirtylo_ = start;
+            dirtyhi_ = start+len;
+         }
+         else
+         {
+            dirtylo_ = std::min(dirtylo_, start);
+            dirtyhi_ = std::max(dirtyhi_, start+len);
+         }
+         return n;
+      }
+   }
+
+   // outside of the mapping, usually extending the tag file. The new part is
+   // mapped on a later read once the file has grown enough.
+   const ssize_t ret = XrdOssCsiTagstoreFile::WriteTags(buf, off, n);
+   if (ret > 0) GrowFileLen(start + 4*ret);
+   return ret;
+}
+
+ssize_t XrdOssCsiTagstoreMmap::ReadTags(uint32_t *const buf, const off_t off, const size_t n)
+{
+   if (!isOpen) return -EBADF;
+
+   const size_t start = 20 + 4*off;
+   const size_t len = 4*n;
+   bool remap;
+   {
+      XrdSysRWLockHelper lck(maplock_);
+      if (mapbase_ && start+len <= maplen_)
+      {
+         memcpy(buf, &mapbase_[start], len);
+         return n;
+      }
+      remap = NeedRemap();
+   }
+
+   // the tag file has grown well past the mapping, map it again; otherwise
+   // the tail is read with pread
+   if (remap)
+   {
+      Remap();
+      XrdSysRWLockHelper lck(maplock_);
+      if (mapbase_ && start+len <= maplen_)
+      {
+         memcpy(buf, &mapbase_[start], len);
+         return n;
+      }
+   }
+   return XrdOssCsiTagstoreFile::ReadTags(buf, off, n);
+}
+
+int XrdOssCsiTagstoreMmap::Truncate(const off_t size, const bool datatoo)
+{
+   if (!isOpen) return -EBADF;
+
+   // the file length changes: access to a mapping beyond the end of file
+   // would fault, so remove it before and map again after
+   XrdSysRWLockHelper lck(maplock_, false);
+   (void)SyncDirty(false);
+   Unmap();
+   const int ret = XrdOssCsiTagstoreFile::Truncate(size, datatoo);
+   Map();
+   return ret;
+}
+
+int XrdOssCsiTagstoreMmap::ResetSizes(const off_t size)
+{
+   if (!isOpen) return -EBADF;
+
+   XrdSysRWLockHelper lck(maplock_, false);
+   (void)SyncDirty(false);
+   Unmap();
+   const int ret = XrdOssCsiTagstoreFile::ResetSizes(size);
+   Map();
+   return ret;
+}
+
+//
+// Map: map the whole of the current tag file. Must be called with maplock_
+//      held exclusively. Only the part from offset from onwards, which was
+//      not mapped before, is advised to be read in. On any failure the store
+//      silently continues using read/write calls.
+//
+void XrdOssCsiTagstoreMmap::Map(const size_t from)
+{
+   EPNAME("TagstoreMmap::Map");
+
+   if (!isOpen || mapbase_ || !canmap_) return;
+
+   // mapped tags are used as is, so only native byte order can be served
+   const int fd = fd_->getFD();
+   if (machineIsBige_ != fileIsBige_ || fd<0)
+   {
+      canmap_ = false;
+      return;
+   }
+
+   struct stat sb;
+   if (fd_->Fstat(&sb)<0) return;
+   filelen_ = sb.st_size;
+   if (sb.st_size <= 20) return;
+
+   const int prot = writable_ ? (PROT_READ|PROT_WRITE) : PROT_READ;
+   void *const p = mmap(NULL, sb.st_size, prot, MAP_SHARED, fd, 0);
+   if (p == MAP_FAILED)
+   {
+      TRACE(Warn, "Could not map tagfile for " << fn_ << ", error " << errno << ", using read/write");
+      canmap_ = false;
+      return;
+   }
+
+   // tags are usually needed for the whole file: ask for them to be read in
+   const size_t pgsz = sysconf(_SC_PAGESIZE);
+   const size_t advlo = std::min((from / pgsz) * pgsz, (size_t)sb.st_size);
+   (void)madvise((uint8_t*)p + advlo, sb.st_size - advlo, MADV_WILLNEED);
+
+   mapbase_ = (uint8_t*)p;
+   maplen_ = sb.st_size;
+}
+
+//
+// GrowFileLen: note that the tag file now extends at least to len.
+//
+void XrdOssCsiTagstoreMmap::GrowFileLen(const size_t len)
+{
+   size_t cur = filelen_;
+   while(cur < len && !filelen_.compare_exchange_weak(cur, len)) { }
+}
+
+//
+// Unmap: must be called with maplock_ held exclusively, after SyncDirty.
+//
+void XrdOssCsiTagstoreMmap::Unmap()
+{
+   if (!mapbase_) return;
+   (void)munmap(mapbase_, maplen_);
+   mapbase_ = NULL;
+   maplen_ = 0;
+   XrdSysMutexHelper dlck(dirtymtx_);
+   dirtylo_ = dirtyhi_ = 0;
+}
+
+//
+// SyncDirty: start (or with wait, complete) the write-back of the part of
+//            the mapping modified since the last call. Must be called with
+//            maplock_ held.
+//
+int XrdOssCsiTagstoreMmap::SyncDirty(const bool wait)
+{
+   size_t lo, hi;
+   {
+      XrdSysMutexHelper dlck(dirtymtx_);
+      lo = dirtylo_;
+      hi = dirtyhi_;
+      dirtylo_ = dirtyhi_ = 0;
+   }
+   if (!mapbase_ || lo == hi) return 0;
+
+   // msync requires a page aligned start address
+   const size_t pgsz = sysconf(_SC_PAGESIZE);
+   lo = (lo / pgsz) * pgsz;
+   if (msync(&mapbase_[lo], hi-lo, wait ? MS_SYNC : MS_ASYNC))
+   {
+      const int ret = -errno;
+      // keep the range so that a later call will retry
+      XrdSysMutexHelper dlck(dirtymtx_);
+      dirtylo_ = (dirtylo_ == dirtyhi_) ? lo : std::min(dirtylo_, lo);
+      dirtyhi_ = std::max(dirtyhi_, hi);
+      return ret;
+   }
+   return 0;
+}
@@ -0,0 +1,120 @@
+#ifndef _XRDOSSCSITAGSTOREMMAP_H
+#define _XRDOSSCSITAGSTOREMMAP_H
+/******************************************************************************/
+/*                                                                            */
+/*              X r d O s s C s i T a g s t o r e M m a p . h h               */
+/*                                                                            */
+/* (C) Copyright 2026 CERN.                                                   */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* In applying this licence, CERN does not waive the privileges and           */
+/* immunities granted to it by virtue of its status as an Intergovernmental   */
+/* Organization or submit itself to any jurisdiction.                         */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XrdOssCsiTagstoreFile.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <sys/types.h>
+
+//
+// Tagstore using the same on-disk format as XrdOssCsiTagstoreFile, but with
+// the tag file memory mapped (shared) so that reading and updating tags
+// that are already within the file become memory copies instead of
+// pread/pwrite system calls. Anything the mapping cannot serve (tag files
+// without a local descriptor, opposite endian files, extending the file) is
+// passed to XrdOssCsiTagstoreFile.
+//
+// A tag file being appended is not remapped on every read past the mapping:
+// the mapping is only extended once the file has grown by at least the
+// current mapping length (and at least remapMin bytes), until then reads of
+// the tail use pread.
+//
+// Flush() schedules write-back of the pages modified through the mapping
+// (msync MS_ASYNC), while Fsync() waits for them (msync MS_SYNC) before
+// syncing the file, so durability is the same as for the file based store.
+//
+class XrdOssCsiTagstoreMmap : public XrdOssCsiTagstoreFile
+{
+public:
+   XrdOssCsiTagstoreMmap(const std::string &fn, std::unique_ptr<XrdOssDF> fd, const char *tid) :
+      XrdOssCsiTagstoreFile(fn, std::move(fd), tid), maplock_(XrdSysRWLock::prefWR), mapbase_(NULL),
+      maplen_(0), filelen_(0), writable_(false), canmap_(false), dirtylo_(0), dirtyhi_(0) { }
+   virtual ~XrdOssCsiTagstoreMmap() { if (isOpen) { (void)Close(); } }
+
+   virtual int Open(const char *, off_t, int, XrdOucEnv &) /* override */;
+   virtual int Close() /* override */;
+
+   virtual void Flush() /* override */;
+   virtual int Fsync() /* override */;
+
+   virtual ssize_t WriteTags(const uint32_t *, off_t, size_t) /* override */;
+   virtual ssize_t ReadTags(uint32_t *, off_t, size_t) /* override */;
+
+   virtual int Truncate(off_t, bool) /* override */;
+   virtual int ResetSizes(off_t) /* override */;
+
+private:
+   // protects the mapping itself: held shared while copying to or from it
+   // and exclusively while it is (re)established or removed
+   XrdSysRWLock maplock_;
+   uint8_t *mapbase_;
+   size_t maplen_;
+   // length of the tag file as last seen by fstat or extended by WriteTags
+   std::atomic<size_t> filelen_;
+   bool writable_;
+   bool canmap_;
+
+   // byte range of the mapping modified since the last Flush/Fsync
+   XrdSysMutex dirtymtx_;
+   size_t dirtylo_;
+   size_t dirtyhi_;
+
+   // minimum growth of the tag file before the mapping is extended
+   static const size_t remapMin = 256*1024;
+
+   void Map(size_t from=0);
+   void Unmap();
+   int SyncDirty(bool);
+   void GrowFileLen(size_t);
+
+   // whether the tag file has grown enough to be worth mapping again. Must
+   // be called with maplock_ held.
+   bool NeedRemap() const
+   {
+      return canmap_ && filelen_ >= maplen_ + std::max(maplen_, remapMin);
+   }
+
+   void Remap()
+   {
+      XrdSysRWLockHelper lck(maplock_, false);
+      if (!NeedRemap()) return;
+      (void)SyncDirty(false);
+      const size_t oldlen = maplen_;
+      Unmap();
+      Map(oldlen);
+   }
+};
+
+#endif
@@ -1,18 +1,36 @@
 #include "XrdOssMirage.hh"
 #include "XrdOssMirageDir.hh"
 #include "XrdOssMirageFile.hh"
+#include "XrdOssMiragePattern.hh"
 #include "XrdOssMirageXAttr.hh"
 #include "XrdVersion.hh"
 
+#include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFAttr.hh"
 
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <thread>
+
+using namespace std::literals;
+
 XrdVERSIONINFO(XrdOssGetStorageSystem, XrdOssMirage);
 
 extern "C"
 {
     XrdOss *XrdOssGetStorageSystem(XrdOss* native_oss, XrdSysLogger* lp, const char* config_fn, const char* parms)
     {
-        return static_cast<XrdOss *>(new XrdOssMirage);
+        auto oss = std::make_unique<XrdOssMirage>();
+
+        if (std::string error; !oss->configure(parms, error))
+        {
+            XrdSysError(lp, "MirageOss").Emsg("Config", error.c_str());
+            return nullptr;
+        }
+
+        return static_cast<XrdOss *>(oss.release());
     }
 }
 
@@ -33,21 +51,26 @@ int XrdOssMirage::Chmod(const char * path, mode_t mode, XrdOucEnv *envP)
 
 int XrdOssMirage::Create(const char *tid, const char *path, mode_t mode, XrdOucEnv &env, int opts)
 {
-    const std::lock_guard lock(mutex);
-
-    if (has_entry(path))
+    Shard &shard = shard_of(path);
     {
-        if (opts & XRDOSS_new)
-            return -EEXIST;  
+        const std::unique_lock lock(shard.mutex);
 
-        if (is_entry_being_written(path))
-            return -EBUSY;
+        if (has_entry(shard, path))
+        {
+            if (opts & XRDOSS_new)
+                return -EEXIST;
+
+            if (is_entry_being_written(shard, path))
+                return -EBUSY;
+        }
+
+        // preserve previous configuration but reset the size in case it already exists
+        const auto [it, inserted] = shard.entries.try_emplace(path, std::make_shared<XrdOssMirageEntry>());
+        if (inserted)
+            it->second->seed = XrdOssMiragePattern::seed(path);
+        it->second->size = 0;
     }
 
-    // preserve previous configuration but reset the size in case it already exists
-    entries.try_emplace(path, std::make_shared<XrdOssMirageEntry>());
-    entries[path]->size = 0;
-
     static std::once_flag xattr_injection_flag;
     std::call_once(xattr_injection_flag, [this]() noexcept
         {
@@ -80,86 +103,191 @@ int XrdOssMirage::Remdir(const char *path, int Opts, XrdOucEnv *envP)
 
 int XrdOssMirage::Rename(const char *oPath, const char *nPath, XrdOucEnv  *oEnvP, XrdOucEnv *nEnvP)
 {
-    const std::lock_guard lock(mutex);
-
-    if (!has_entry(oPath))
+    Shard &oShard = shard_of(oPath);
+    Shard &nShard = shard_of(nPath);
+
+    std::unique_lock<std::shared_mutex> oLock(oShard.mutex, std::defer_lock);
+    std::unique_lock<std::shared_mutex> nLock(nShard.mutex, std::defer_lock);
+    if (&oShard == &nShard)
+        oLock.lock();
+    else
+        std::lock(oLock, nLock);
+
+    const auto it = oShard.entries.find(oPath);
+    if (it == oShard.entries.end())
         return -ENOENT;
 
-    if (has_entry(nPath))
+    if (has_entry(nShard, nPath))
         return -EEXIST;
 
-    entries[nPath] = std::move(entries[oPath]);
-    entries.erase(oPath);
+    nShard.entries.emplace(nPath, std::move(it->second));
+    oShard.entries.erase(it);
 
     return XrdOssOK;
 }
 
 int XrdOssMirage::Stat(const char *path, struct stat *buff, int opts, XrdOucEnv *envP)
 {
-    const std::lock_guard lock(mutex);
+    Shard &shard = shard_of(path);
+    const std::shared_lock lock(shard.mutex);
 
-    if (!has_entry(path))
+    const auto it = shard.entries.find(path);
+    if (it == shard.entries.end())
         return -ENOENT;
 
     *buff = {};
-    buff->st_size = entries[path]->size;
+    buff->st_size = it->second->size;
 
     return XrdOssOK;
 }
 
 int XrdOssMirage::Truncate(const char *path, unsigned long long fsize, XrdOucEnv *envP)
 {
-    const std::lock_guard lock(mutex);
+    Shard &shard = shard_of(path);
+    const std::unique_lock lock(shard.mutex);
 
-    if (!has_entry(path))
+    if (!has_entry(shard, path))
         return -ENOENT;
 
-    if (is_entry_being_written(path))
+    if (is_entry_being_written(shard, path))
         return -EBUSY;
 
-    entries[path]->size = fsize;
-    
+    shard.entries[path]->size = fsize;
+
     return XrdOssOK;
 }
 
 int XrdOssMirage::Unlink(const char *path, int Opts, XrdOucEnv *envP)
 {
-    const std::lock_guard lock(mutex);
+    Shard &shard = shard_of(path);
+    const std::unique_lock lock(shard.mutex);
 
-    if (!has_entry(path))
+    if (shard.entries.erase(path) == 0)
         return -ENOENT;
 
-    entries.erase(path);
-
     return XrdOssOK;
 }
 
 std::optional<XrdOssMirageEntry> XrdOssMirage::get_entry_read(const char *path)
 {
-    const std::lock_guard lock(mutex);
+    Shard &shard = shard_of(path);
+    const std::shared_lock lock(shard.mutex);
 
-    if (!has_entry(path) || is_entry_being_written(path))
+    const auto it = shard.entries.find(path);
+    if (it == shard.entries.end() || it->second.use_count() > 1)
         return {};
 
-    return *entries[path];
+    return *it->second;
 }
 
 std::optional<XrdOssMirageEntryPtr> XrdOssMirage::get_entry_write(const char *path)
 {
-    const std::lock_guard lock(mutex);
+    Shard &shard = shard_of(path);
+    const std::unique_lock lock(shard.mutex);
 
-    if (!has_entry(path) || is_entry_being_written(path))
+    if (!has_entry(shard, path) || is_entry_being_written(shard, path))
         return {};
 
-    return entries[path];    
+    return shard.entries[path];
+}
+
+bool XrdOssMirage::configure(const char *parms, std::string &error)
+{
+    std::istringstream stream(parms ? parms : "");
+    std::string token;
+
+    while (stream >> token)
+    {
+        const auto eq = token.find('=');
+        const std::string key = token.substr(0, eq);
+        const std::string value = eq == std::string::npos ? std::string{} : token.substr(eq + 1);
+
+        try
+        {
+            std::size_t end = 0;
+            if (key == "content"sv && (value == "bench"sv || value == "none"sv))
+            {
+                config.bench_content = value == "bench"sv;
+                continue;
+            }
+            else if (key == "latency.open"sv)
+                config.open_latency = std::chrono::microseconds(std::stoul(value, &end));
+            else if (key == "latency.read"sv)
+                config.read_latency = std::chrono::microseconds(std::stoul(value, &end));
+            else if (key == "latency.write"sv)
+                config.write_latency = std::chrono::microseconds(std::stoul(value, &end));
+            else if (key == "maxrate"sv)
+            {
+                config.max_rate = std::stoull(value, &end);
+                if (end + 1 == value.size())
+                {
+                    switch (value[end++])
+                    {
+                        case 'k': config.max_rate <<= 10; break;
+                        case 'm': config.max_rate <<= 20; break;
+                        case 'g': config.max_rate <<= 30; break;
+                        default: --end;
+                    }
+                }
+            }
+            else
+            {
+                error = "invalid option '" + token + "'";
+                return false;
+            }
+
+            if (end != value.size())
+                throw std::invalid_argument(value);
+        }
+        catch (std::logic_error &)
+        {
+            error = "invalid value in '" + token + "'";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void XrdOssMirage::delay(std::chrono::microseconds latency, std::size_t num_bytes)
+{
+    using namespace std::chrono;
+
+    if (latency == latency.zero() && config.max_rate == 0)
+        return;
+
+    auto until = steady_clock::now() + latency;
+
+    // reserve a slot of the shared transfer budget; concurrent requests queue
+    // up one after the other without taking a lock
+    if (config.max_rate != 0 && num_bytes != 0)
+    {
+        const std::int64_t now = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+        const std::int64_t cost = static_cast<std::int64_t>(num_bytes * 1e9 / config.max_rate);
+
+        std::int64_t start = rate_next.load(std::memory_order_relaxed);
+        while (!rate_next.compare_exchange_weak(start, std::max(start, now) + cost, std::memory_order_relaxed))
+            ;
+
+        until = std::max(until, steady_clock::time_point(nanoseconds(std::max(start, now) + cost)));
+    }
+
+    if (until > steady_clock::now())
+        std::this_thread::sleep_until(until);
+}
+
+XrdOssMirage::Shard &XrdOssMirage::shard_of(const char *path)
+{
+    return shards[std::hash<std::string_view>{}(path) % num_shards];
 }
 
-bool XrdOssMirage::has_entry(const char *path)
+bool XrdOssMirage::has_entry(Shard &shard, const char *path)
 {
-    return entries.find(path) != entries.end();
+    return shard.entries.find(path) != shard.entries.end();
 }
 
-bool XrdOssMirage::is_entry_being_written(const char *path)
+bool XrdOssMirage::is_entry_being_written(Shard &shard, const char *path)
 {
-    return entries[path].use_count() > 1;
+    const auto it = shard.entries.find(path);
+    return it != shard.entries.end() && it->second.use_count() > 1;
 }
@@ -5,17 +5,42 @@
 
 #include <XrdOss/XrdOss.hh>
 
-#include <mutex>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <optional>
+#include <shared_mutex>
+#include <string>
 #include <unordered_map>
 
+struct XrdOssMirageConfig
+{
+    bool bench_content{false};               // deterministic content for files without a pattern
+    std::chrono::microseconds open_latency{};
+    std::chrono::microseconds read_latency{};
+    std::chrono::microseconds write_latency{};
+    std::uint64_t max_rate{};                // bytes per second read and written, 0 is unlimited
+};
+
 class XrdOssMirage : public XrdOss {
 private:
-    std::unordered_map<std::string, XrdOssMirageEntryPtr> entries;
-    std::mutex mutex;
+    // the entries are spread over shards so that lookups of different paths
+    // do not contend and lookups of the same path only take a shared lock
+    struct Shard
+    {
+        std::unordered_map<std::string, XrdOssMirageEntryPtr> entries;
+        std::shared_mutex mutex;
+    };
+
+    static constexpr std::size_t num_shards = 64;
 
-    bool has_entry(const char *path);
-    bool is_entry_being_written(const char *path);
+    std::array<Shard, num_shards> shards;
+    XrdOssMirageConfig config;
+    std::atomic<std::int64_t> rate_next{0};
+
+    Shard &shard_of(const char *path);
+    bool has_entry(Shard &shard, const char *path);
+    bool is_entry_being_written(Shard &shard, const char *path);
 
 public:
     XrdOssMirage() = default;
@@ -36,6 +61,10 @@ public:
 
     std::optional<XrdOssMirageEntry>     get_entry_read(const char *path);
     std::optional<XrdOssMirageEntryPtr>  get_entry_write(const char *path);
+
+    bool configure(const char *parms, std::string &error);
+    const XrdOssMirageConfig &get_config() const { return config; }
+    void delay(std::chrono::microseconds latency, std::size_t num_bytes);
 };
 
 #endif
@@ -26,6 +26,7 @@ struct XrdOssMirageEntry
 
     std::string pattern{};
     std::size_t size{};
+    std::uint64_t seed{};
 };
 
 using XrdOssMirageEntryPtr = std::shared_ptr<XrdOssMirageEntry>;
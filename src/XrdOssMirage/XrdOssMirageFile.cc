@@ -1,4 +1,5 @@
 #include "XrdOssMirageFile.hh"
+#include "XrdOssMiragePattern.hh"
 #include "XrdSfs/XrdSfsAio.hh"
 #include "XrdSys/XrdSysXAttr.hh"
 #include "XrdSys/XrdSysFAttr.hh"
@@ -71,6 +72,8 @@ int XrdOssMirageFile::Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &
     if (entry->open.return_code != XrdOssOK)
         return -entry->open.return_code;
 
+    oss.delay(oss.get_config().open_latency, 0);
+
     return XrdOssOK;
 }
 
@@ -106,8 +109,16 @@ ssize_t XrdOssMirageFile::Read(void *buffer, off_t offset, size_t size)
         entry->read.return_position <= static_cast<std::size_t>(offset + size))
         return -entry->read.return_code;
 
+    if (static_cast<std::size_t>(offset) >= entry->size)
+        return 0;
+
     const std::size_t num_bytes = std::min(size, static_cast<std::size_t>(entry->size - offset));
 
+    oss.delay(oss.get_config().read_latency, num_bytes);
+
+    if (entry->pattern.empty() && oss.get_config().bench_content)
+        XrdOssMiragePattern::fill(entry->seed, offset, static_cast<char *>(buffer), num_bytes);
+
     if (entry->pattern.size() == 1)
         std::fill_n(static_cast<char *>(buffer), num_bytes, entry->pattern.front());
 
@@ -136,6 +147,8 @@ ssize_t XrdOssMirageFile::Write(const void *buffer, off_t offset, size_t size)
         entry->write.return_position <= static_cast<std::size_t>(offset + size))
         return -entry->write.return_code;
 
+    oss.delay(oss.get_config().write_latency, size);
+
     entry->size += size;
     return size;
 }
@@ -0,0 +1,84 @@
+#include "XrdOssMiragePattern.hh"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+const char *XrdOssMiragePattern::pages()
+{
+    // twice the period so that any copy of up to one period is contiguous
+    static const std::unique_ptr<char[]> buffer = []()
+        {
+            auto buff = std::make_unique<char[]>(2 * period);
+            std::uint64_t x = 0x9E3779B97F4A7C15ULL;
+            for (std::size_t i = 0; i < period; i += sizeof(x))
+            {
+                x ^= x >> 12;
+                x ^= x << 25;
+                x ^= x >> 27;
+                const std::uint64_t v = x * 0x2545F4914F6CDD1DULL;
+                std::memcpy(buff.get() + i, &v, sizeof(v));
+            }
+            std::memcpy(buff.get() + period, buff.get(), period);
+            return buff;
+        }();
+
+    return buffer.get();
+}
+
+std::uint64_t XrdOssMiragePattern::seed(std::string_view path)
+{
+    // FNV-1a, stable across platforms and runs
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const char c : path)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash % period;
+}
+
+void XrdOssMiragePattern::fill(std::uint64_t seed, std::uint64_t offset, char *buffer, std::size_t size)
+{
+    const char *src = pages();
+    std::size_t pos = (seed + offset) % period;
+
+    // every chunk but the last is a full period, which ends where it started
+    while (size > 0)
+    {
+        const std::size_t num_bytes = std::min(size, period);
+        std::memcpy(buffer, src + pos, num_bytes);
+        buffer += num_bytes;
+        size -= num_bytes;
+    }
+}
+
+std::uint32_t XrdOssMiragePattern::adler32(std::uint64_t seed, std::uint64_t size)
+{
+    const Bytef *src = reinterpret_cast<const Bytef *>(pages()) + seed;
+
+    // the file is a number of full (rotated) periods followed by a prefix of one
+    const std::uint64_t full = size / period;
+    const std::uint64_t rest = size % period;
+
+    uLong result = ::adler32(0L, Z_NULL, 0);
+    if (full)
+    {
+        const uLong one = ::adler32(result, src, period);
+        uLong acc = one;
+        for (int bit = 62 - __builtin_clzll(full); bit >= 0; --bit)
+        {
+            const std::uint64_t len = (full >> (bit + 1)) * period;
+            acc = adler32_combine64(acc, acc, len);
+            if (full & (1ULL << bit))
+                acc = adler32_combine64(acc, one, period);
+        }
+        result = acc;
+    }
+    if (rest)
+        result = adler32_combine64(result, ::adler32(::adler32(0L, Z_NULL, 0), src, rest), rest);
+
+    return static_cast<std::uint32_t>(result);
+}
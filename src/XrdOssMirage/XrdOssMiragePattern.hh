@@ -0,0 +1,26 @@
+#ifndef __XRD_OSS_MIRAGE_PATTERN_HH__
+#define __XRD_OSS_MIRAGE_PATTERN_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Deterministic file content for benchmarking. All files share a single
+// read-only buffer of pseudo-random bytes generated once; a file is that
+// buffer repeated and rotated by a per-file seed, so byte i of a file is
+// pages[(seed + i) % period]. Reads are plain copies out of the buffer and
+// the checksum of any file can be computed without reading it.
+class XrdOssMiragePattern
+{
+public:
+    static constexpr std::size_t period = 1 << 20;
+
+    static std::uint64_t seed(std::string_view path);
+    static void          fill(std::uint64_t seed, std::uint64_t offset, char *buffer, std::size_t size);
+    static std::uint32_t adler32(std::uint64_t seed, std::uint64_t size);
+
+private:
+    static const char *pages();
+};
+
+#endif
@@ -1,7 +1,9 @@
 #include "XrdOssMirageXAttr.hh"
+#include "XrdOssMiragePattern.hh"
 #include "XrdVersion.hh"
 
 #include <algorithm>
+#include <cstdio>
 #include <stdexcept>
 #include <string_view>
 
@@ -78,6 +80,12 @@ int XrdOssMirageXAttr::Get(const char *Aname, void *Aval, int Avsz, const char *
         value = std::to_string(entry.write.return_position);
     else if (name == "U.pattern"sv)
         value = entry.pattern;
+    else if (name == "U.adler32"sv && entry.pattern.empty() && oss->get_config().bench_content)
+    {
+        char hex[9];
+        std::snprintf(hex, sizeof(hex), "%08x", XrdOssMiragePattern::adler32(entry.seed, entry.size));
+        value = hex;
+    }
     else
         return -EINVAL;
 
@@ -47,6 +47,7 @@
 
 #include "XrdOuc/XrdOucCRC.hh"
 #include "XrdOuc/XrdOucCRC32C.hh"
+#include <algorithm>
 
 /*****************************************************************/
 /*                                                               */
@@ -199,20 +200,11 @@ uint32_t XrdOucCRC::Calc32C(const void* data, size_t count, uint32_t prevcs)
   
 void XrdOucCRC::Calc32C(const void* data, size_t count, uint32_t* csval)
 {
-   int i, numpages = count/XrdSys::PageSize;
-   const uint8_t* dataP = (const uint8_t*)data;
-
-// Calculate the CRC32C for each page
-//
-   for (i = 0; i < numpages; i++)
-       {csval[i] = crc32c(0, dataP, XrdSys::PageSize);
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
-       }
 
-// if there is anything left, calculate that as well
+// Calculate the CRC32C for each page, including any trailing partial page.
+// Independent pages are checksummed several at a time when possible.
 //
-   if (count > 0) csval[i] = crc32c(0, dataP, count);
+   crc32c_pages(data, count, XrdSys::PageSize, csval);
 }
 
 /******************************************************************************/
@@ -236,33 +228,28 @@ bool XrdOucCRC::Ver32C(const void*    data,  size_t    count,
 int  XrdOucCRC::Ver32C(const void*     data,  size_t    count,
                        const uint32_t* csval, uint32_t& valcs)
 {
-   int i, numpages = count/XrdSys::PageSize;
+   static const size_t batchPages = 48;
    const uint8_t* dataP = (const uint8_t*)data;
-   uint32_t actualCS;
+   uint32_t actualCS[batchPages];
+   int i, pgBase = 0;
 
-// Calculate the CRC32C for each page and make sure it is the same.
-//
-   for (i = 0; i < numpages; i++)
-       {
-        actualCS = crc32c(0, dataP, XrdSys::PageSize);
-        if (csval[i] != actualCS)
-           {valcs = actualCS;
-            return i;
-           }
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
-       }
-
-// if there is anything left, verify that as well
+// Calculate the CRC32C for a batch of pages at a time and make sure each one
+// is the same. Any trailing partial page is handled as part of the last batch.
 //
-   if (count > 0)
-      {
-       actualCS = crc32c(0, dataP, count);
-       if (csval[i] != actualCS)
-          {valcs = actualCS;
-           return i;
-          }
-      }
+   while(count)
+        {size_t bLen = std::min(count, batchPages*XrdSys::PageSize);
+         int n = (bLen + XrdSys::PageSize - 1)/XrdSys::PageSize;
+         crc32c_pages(dataP, bLen, XrdSys::PageSize, actualCS);
+         for (i = 0; i < n; i++)
+             {if (csval[pgBase+i] != actualCS[i])
+                 {valcs = actualCS[i];
+                  return pgBase+i;
+                 }
+             }
+         pgBase += n;
+         dataP  += bLen;
+         count  -= bLen;
+        }
 
 // Everything matched.
 //
@@ -274,30 +261,27 @@ int  XrdOucCRC::Ver32C(const void*     data,  size_t    count,
 bool XrdOucCRC::Ver32C(const void*     data,  size_t count,
                        const uint32_t* csval, bool*  valok)
 {
-   int i, numpages = count/XrdSys::PageSize;
+   static const size_t batchPages = 48;
    const uint8_t* dataP = (const uint8_t*)data;
-   uint32_t actualCS;
+   uint32_t actualCS[batchPages];
+   int i, pgBase = 0;
    bool retval = true;
 
-// Calculate the CRC32C for each page and make sure it is the same.
-//
-   for (i = 0; i < numpages; i++)
-       {
-        actualCS = crc32c(0, dataP, XrdSys::PageSize);
-        if (csval[i] == actualCS) valok[i] = true;
-           else valok[i] = retval = false;
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
-       }
-
-// if there is anything left, verify that as well
+// Calculate the CRC32C for a batch of pages at a time and record whether each
+// one is the same. Any trailing partial page is part of the last batch.
 //
-   if (count > 0)
-      {
-       actualCS = crc32c(0, dataP, count);
-       if (csval[i] == actualCS) valok[i] = true;
-           else valok[i] = retval = false;
-      }
+   while(count)
+        {size_t bLen = std::min(count, batchPages*XrdSys::PageSize);
+         int n = (bLen + XrdSys::PageSize - 1)/XrdSys::PageSize;
+         crc32c_pages(dataP, bLen, XrdSys::PageSize, actualCS);
+         for (i = 0; i < n; i++)
+             {if (csval[pgBase+i] == actualCS[i]) valok[pgBase+i] = true;
+                 else valok[pgBase+i] = retval = false;
+             }
+         pgBase += n;
+         dataP  += bLen;
+         count  -= bLen;
+        }
 
 // All done.
 //
@@ -309,27 +293,14 @@ bool XrdOucCRC::Ver32C(const void*     data,  size_t count,
 bool XrdOucCRC::Ver32C(const void*     data,  size_t    count,
                        const uint32_t* csval, uint32_t* valcs)
 {
-   int i, numpages = count/XrdSys::PageSize;
-   const uint8_t* dataP = (const uint8_t*)data;
+   int i, numpages = (count + XrdSys::PageSize - 1)/XrdSys::PageSize;
    bool retval = true;
 
-// Calculate the CRC32C for each page and make sure it is the same.
-//
-   for (i = 0; i < numpages; i++)
-       {
-        valcs[i] = crc32c(0, dataP, XrdSys::PageSize);
-        if (csval[i] != valcs[i]) retval = false;
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
-       }
-
-// if there is anything left, verify that as well
+// Calculate the CRC32C for each page, including any trailing partial page,
+// directly into valcs and then make sure each is the same.
 //
-   if (count > 0)
-      {
-       valcs[i] = crc32c(0, dataP, count);
-       if (csval[i] != valcs[i]) retval = false;
-      }
+   crc32c_pages(data, count, XrdSys::PageSize, valcs);
+   for (i = 0; i < numpages; i++) if (csval[i] != valcs[i]) retval = false;
 
 // All done.
 //
@@ -16,4 +16,13 @@ uint32_t crc32c(uint32_t crc, void const *buf, size_t len);
 // crc32c_sw() is the same, but does not use the hardware instruction, even if
 // available.
 uint32_t crc32c_sw(uint32_t crc, void const *buf, size_t len);
+
+// Compute the CRC-32C (each starting from zero) of every pgsz block in
+// buf[0..len-1], storing them in crcs[], which must hold (len+pgsz-1)/pgsz
+// values.  The last block may be short.  When the Intel crc32 instruction is
+// available three blocks are computed concurrently.
+void crc32c_pages(void const *buf, size_t len, size_t pgsz, uint32_t *crcs);
+
+// crc32c_pages_sw() is the same, but does not use the hardware instruction.
+void crc32c_pages_sw(void const *buf, size_t len, size_t pgsz, uint32_t *crcs);
 #endif
@@ -29,9 +29,13 @@
 /******************************************************************************/
 
 #include <cctype>
+#include <cstdio>
 #include <cstring>
 #include <dirent.h>
+#include <string>
 #include <unistd.h>
+#include <unordered_map>
+#include <vector>
 
 #include "XrdOuc/XrdOucNSWalk.hh"
 #include "XrdOuc/XrdOucTList.hh"
@@ -39,6 +43,49 @@
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysHeaders.hh"
 #include "XrdSys/XrdSysPlatform.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+// Prefetch threads use this callback so that an empty directory is noted
+// without being acted upon. The real callback is made by the Index() caller.
+//
+class nullCB : public XrdOucNSWalk::CallBack
+{public:
+void isEmpty(struct stat *dStat, const char *dPath, const char *lkFn) {}
+     nullCB() {}
+    ~nullCB() {}
+} noteEmpty;
+}
+
+struct XrdOucNSWalk::wPool
+{
+struct Done {Done        *Next;
+             NSEnt       *Ents;
+             struct stat  dStat;
+             int          rc;
+             int          Empty;
+             char         Path[1032];
+            };
+
+XrdSysCondVar          pCV;      // Protects everything below
+XrdOucTList           *Todo;     // Directories waiting to be read
+Done                  *First;    // Directories that have been read
+Done                  *Last;
+std::vector<pthread_t> Tids;
+int                    Busy;     // Number of directories being read
+int                    numDone;
+int                    maxDone;  // Readahead limit
+int                    Stop;
+
+       wPool(int maxd) : pCV(0, "NSWalk"), Todo(0), First(0), Last(0),
+                         Busy(0), numDone(0), maxDone(maxd), Stop(0) {}
+      ~wPool() {}
+};
 
 
 /******************************************************************************/
@@ -61,6 +108,11 @@ XrdOucNSWalk::XrdOucNSWalk(XrdSysError *erp, const char *dpath,
    errOK= opts & skpErrs;
    DEnts= 0;
    edCB = 0;
+   Pool = 0;
+   nsIX = 0;
+   ixCut= 0;
+   isEmpty = 0;
+   nThr = 0;
 
 // Copy the exclude list if one exists
 //
@@ -79,6 +131,26 @@ XrdOucNSWalk::~XrdOucNSWalk()
 {
    XrdOucTList *tP;
 
+// Stop any prefetch threads and discard whatever they have read
+//
+   if (Pool)
+      {wPool::Done *dP;
+       NSEnt *eP;
+       Pool->pCV.Lock();
+       Pool->Stop = 1;
+       Pool->pCV.Broadcast();
+       Pool->pCV.UnLock();
+       for (int i = 0; i < (int)Pool->Tids.size(); i++)
+           XrdSysThread::Join(Pool->Tids[i], 0);
+       while((tP = Pool->Todo)) {Pool->Todo = tP->next; delete tP;}
+       while((dP = Pool->First))
+            {Pool->First = dP->Next;
+             while((eP = dP->Ents)) {dP->Ents = eP->Next; delete eP;}
+             delete dP;
+            }
+       delete Pool;
+      }
+
    if (LKFn) free(LKFn);
 
    while((tP = DList)) {DList = tP->next; delete tP;}
@@ -95,6 +167,10 @@ XrdOucNSWalk::NSEnt *XrdOucNSWalk::Index(int &rc, const char **dPath)
    XrdOucTList *tP;
    NSEnt *eP;
 
+// Hand off to the prefetch threads if so wanted
+//
+   if (nThr && (Opts & Recurse)) return pIndex(rc, dPath);
+
 // Sequence the directory
 //
    rc = 0; *DPath = '\0';
@@ -163,7 +239,10 @@ int XrdOucNSWalk::Build()
                                                 }
                  } theEnt;
    struct dirent  *dp;
-   int             rc = 0, getLI = Opts & retLink;
+   struct stat     ixStat;
+   XrdOucNSIndex::dirSum dSum = {0, 0, 0, 0};
+   XrdOucTList    *dHead = DList;
+   int             rc = 0, getLI = Opts & retLink, ixOK = 0;
    int             nEnt = 0, xLKF = 0, chkED = (edCB != 0) && (LKFn != 0);
 
 // Initialize the empty flag prior to doing anything else
@@ -179,6 +258,23 @@ int XrdOucNSWalk::Build()
    DPfd = -1;
 #endif
 
+// If we are indexing, see if this directory changed since we last listed it.
+// If it didn't, we simply traverse the subdirectories we found back then.
+//
+   if (nsIX && !(DPfd < 0 ? stat(DPath, &ixStat) : fstat(DPfd, &ixStat)))
+      {XrdOucTList *sdP, *tP;
+       if (nsIX->Skip(DPath, ixStat, ixCut, edCB != 0, sdP))
+          {while((tP = sdP))
+                {sdP = tP->next;
+                 if (Opts & Recurse && (!XList || !inXList(tP->text)))
+                    {tP->next = DList; DList = tP;}
+                    else delete tP;
+                }
+           return 0;
+          }
+       ixOK = 1;
+      }
+
 // Open the directory
 //
    if (!(theEnt.D = opendir(DPath)))
@@ -194,12 +290,12 @@ int XrdOucNSWalk::Build()
          rc = getStat(theEnt.P, getLI);
          switch(theEnt.P->Type)
                {case NSEnt::isDir:
-                     if (Opts & Recurse && (!getLI || !isSymlink())
-                     &&  (!XList || !inXList(File)))
+                     if (Opts & Recurse && (!XList || !inXList(DPath)))
                         DList = new XrdOucTList(DPath, 0, DList);
                      if (!(Opts & retDir)) continue;
                      break;
                 case NSEnt::isFile:
+                     if (ixOK) XrdOucNSIndex::Tally(dSum, theEnt.P->Stat);
                      if ((chkED && !xLKF && (xLKF = !strcmp(File, LKFn)))
                      ||  !(Opts & retFile)) continue;
                      break;
@@ -208,6 +304,8 @@ int XrdOucNSWalk::Build()
                         memset(&theEnt.P->Stat, 0, sizeof(struct stat));
                         else if ((Opts & retStat) && (rc = getStat(theEnt.P)))
                                 {theEnt.P->Type = NSEnt::isLink; rc = 0;}
+                     if (ixOK && theEnt.P->Type == NSEnt::isFile)
+                        XrdOucNSIndex::Tally(dSum, theEnt.P->Stat);
                      break;
                 case NSEnt::isMisc:
                      if (!(Opts & retMisc)) continue;
@@ -217,7 +315,7 @@ int XrdOucNSWalk::Build()
                      break;
                }
          errno = 0;
-         if (rc) {if (errOK) continue; return rc;}
+         if (rc) {ixOK = 0; if (errOK) continue; return rc;}
          addEnt(theEnt.P); theEnt.P = 0; 
         }
 
@@ -233,6 +331,14 @@ int XrdOucNSWalk::Build()
       {if ((DPfd < 0 ? !stat(DPath, &dStat) : !fstat(DPfd, &dStat))) isEmpty=1;
           else Emsg("Build", errno, "stat directory", DPath);
       }
+
+// Record what we found if indexing. Directories modified within the last
+// couple of seconds are not recorded as a later change may go unnoticed.
+//
+   if (ixOK && ixStat.st_ctime < time(0)-1 && ixStat.st_mtime < time(0)-1)
+      {dSum.Empty = (xLKF == nEnt);
+       nsIX->Add(DPath, ixStat, dSum, DList, dHead);
+      }
    return 0;
 }
 
@@ -319,7 +425,7 @@ int XrdOucNSWalk::inXList(const char *dName)
 
 // Search for the directory entry
 //
-    while(xTP && strcmp(DPath, xTP->text)) {pTP = xTP; xTP = xTP->next;}
+    while(xTP && strcmp(dName, xTP->text)) {pTP = xTP; xTP = xTP->next;}
 
 // If not found return false. Otherwise, delete the entry and return true.
 //
@@ -330,31 +436,6 @@ int XrdOucNSWalk::inXList(const char *dName)
    return 1;
 }
   
-/******************************************************************************/
-/*                             i s S y m l i n k                              */
-/******************************************************************************/
-  
-int XrdOucNSWalk::isSymlink()
-{
-   struct stat buf;
-   int rc;
-
-
-// The following code either uses fstatat() or regular stat()
-//
-#ifdef HAVE_FSTATAT
-do{rc = fstatat(DPfd, File, &buf, AT_SYMLINK_NOFOLLOW);
-#else
-do{rc = lstat(DPath, &buf);
-#endif
-  } while(rc && errno == EINTR);
-
-// Check for errors
-//
-   if (rc) return 0;
-   return (buf.st_mode & S_IFMT) == S_IFLNK;
-}
-
 /******************************************************************************/
 /*                              L o c k F i l e                               */
 /******************************************************************************/
@@ -392,6 +473,63 @@ int XrdOucNSWalk::LockFile()
    return rc;
 }
 
+/******************************************************************************/
+/*                                p I n d e x                                 */
+/******************************************************************************/
+
+XrdOucNSWalk::NSEnt *XrdOucNSWalk::pIndex(int &rc, const char **dPath)
+{
+   wPool::Done *dP;
+   NSEnt *eP = 0;
+
+// Start the prefetch threads if this is the first call. Should we not be able
+// to start any, we revert to doing everything ourselves.
+//
+   if (!Pool)
+      {pthread_t tid;
+       Pool = new wPool(nThr*4);
+       Pool->Todo = DList; DList = 0;
+       for (int i = 0; i < nThr; i++)
+           {if (XrdSysThread::Run(&tid, XrdOucNSWalk::Worker, (void *)this,
+                                  XRDSYSTHREAD_HOLD, "NSWalk prefetch"))
+               {Emsg("Index", errno, "start namespace prefetch thread");
+                break;
+               }
+            Pool->Tids.push_back(tid);
+           }
+       if (Pool->Tids.empty())
+          {DList = Pool->Todo; Pool->Todo = 0;
+           delete Pool; Pool = 0; nThr = 0;
+           return Index(rc, dPath);
+          }
+      }
+
+// Return the next directory that was read, making any needed callbacks
+//
+   rc = 0; *DPath = '\0';
+   do {Pool->pCV.Lock();
+       while(!Pool->First && (Pool->Todo || Pool->Busy)) Pool->pCV.Wait();
+       if ((dP = Pool->First))
+          {if (!(Pool->First = dP->Next)) Pool->Last = 0;
+           Pool->numDone--;
+           Pool->pCV.Broadcast();
+          }
+       Pool->pCV.UnLock();
+       if (!dP) break;
+
+       strcpy(DPath, dP->Path); File = DPath + strlen(DPath);
+       eP = dP->Ents; rc = dP->rc; isEmpty = dP->Empty; dStat = dP->dStat;
+       delete dP;
+       if (eP || (rc && !errOK)) break;
+       if (edCB && isEmpty) edCB->isEmpty(&dStat, DPath, LKFn);
+      } while(1);
+
+// Return the result
+//
+   if (dPath) *dPath = DPath;
+   return eP;
+}
+
 /******************************************************************************/
 /*                               s e t P a t h                                */
 /******************************************************************************/
@@ -406,3 +544,335 @@ void XrdOucNSWalk::setPath(char *newpath)
       {DPath[n++] = '/'; DPath[n] = '\0';}
    File = DPath+n;
 }
+
+/******************************************************************************/
+/*                                  W o r k                                   */
+/******************************************************************************/
+
+void XrdOucNSWalk::Work()
+{
+   XrdOucNSWalk wkObj(eDest, "", LKFn, Opts, XList);
+   XrdOucTList *tP, *sdP;
+   wPool::Done *dP;
+   int rc;
+
+// Our private walker only ever reads the directory we give it
+//
+   delete wkObj.DList; wkObj.DList = 0;
+   wkObj.mPfx  = mPfx;
+   wkObj.edCB  = (edCB ? &noteEmpty : 0);
+   wkObj.nsIX  = nsIX;
+   wkObj.ixCut = ixCut;
+
+// Read directories until we are told to stop. We wait when the caller has
+// fallen too far behind to avoid holding the whole namespace in memory.
+//
+   Pool->pCV.Lock();
+   do {while(!Pool->Stop && (!Pool->Todo || Pool->numDone >= Pool->maxDone))
+             Pool->pCV.Wait();
+       if (Pool->Stop) break;
+       tP = Pool->Todo; Pool->Todo = tP->next;
+       Pool->Busy++;
+       Pool->pCV.UnLock();
+
+       wkObj.setPath(tP->text); delete tP;
+       wkObj.isEmpty = 0;
+       if (!LKFn || !(rc = wkObj.LockFile())) rc = wkObj.Build();
+       if (wkObj.LKfd >= 0) {close(wkObj.LKfd); wkObj.LKfd = -1;}
+
+       dP = new wPool::Done;
+       dP->Next  = 0;
+       dP->Ents  = wkObj.DEnts; wkObj.DEnts = 0;
+       dP->dStat = wkObj.dStat;
+       dP->rc    = rc;
+       dP->Empty = wkObj.isEmpty;
+       strcpy(dP->Path, wkObj.DPath);
+       sdP = wkObj.DList; wkObj.DList = 0;
+
+       Pool->pCV.Lock();
+       while((tP = sdP))
+            {sdP = tP->next; tP->next = Pool->Todo; Pool->Todo = tP;}
+       if (Pool->Last) Pool->Last->Next = dP;
+          else         Pool->First      = dP;
+       Pool->Last = dP;
+       Pool->numDone++;
+       Pool->Busy--;
+       Pool->pCV.Broadcast();
+      } while(1);
+   Pool->pCV.UnLock();
+}
+
+/******************************************************************************/
+/*                                W o r k e r                                 */
+/******************************************************************************/
+
+void *XrdOucNSWalk::Worker(void *pp)
+{
+   ((XrdOucNSWalk *)pp)->Work();
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                     C l a s s   X r d O u c N S I n d e x                  */
+/******************************************************************************/
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+struct ixHdr {long long mTime;
+              long long cTime;
+              long long minAT;
+              long long Bytes;
+              int       Files;
+              int       Empty;
+              int       pLen;
+              int       nSubs;
+             };
+
+static const char ixMagic[16] = {'X','r','d','O','u','c','N','S',
+                                 'I','n','d','e','x',' ','1','\n'};
+}
+
+struct XrdOucNSIndex::ixTab
+{
+struct ixEnt {time_t                   mTime;
+              time_t                   cTime;
+              dirSum                   Sum;
+              std::vector<std::string> Subs;
+              unsigned int             Gen;
+             };
+
+XrdSysMutex                            Mutex;
+std::unordered_map<std::string, ixEnt> Tab;
+Totals                                 Skipped;
+unsigned int                           Gen;
+
+       ixTab() : Gen(1) {Skipped.Files = Skipped.Bytes = 0;
+                         Skipped.Dirs  = Skipped.Ents  = 0;
+                        }
+      ~ixTab() {}
+};
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdOucNSIndex::XrdOucNSIndex(XrdSysError *erp) : ixTP(new ixTab), eDest(erp)
+{}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdOucNSIndex::~XrdOucNSIndex() {delete ixTP;}
+
+/******************************************************************************/
+/*                                   A d d                                    */
+/******************************************************************************/
+
+void XrdOucNSIndex::Add(const char *dPath, struct stat &dStat, dirSum &dSum,
+                        XrdOucTList *sdP, XrdOucTList *sdEnd)
+{
+   XrdSysMutexHelper mHelp(ixTP->Mutex);
+   ixTab::ixEnt &ent = ixTP->Tab[dPath];
+   int n = strlen(dPath);
+
+// Record the directory summary along with the names of its subdirectories
+// that were queued for traversal (i.e. those preceding sdEnd).
+//
+   ent.mTime = dStat.st_mtime;
+   ent.cTime = dStat.st_ctime;
+   ent.Sum   = dSum;
+   ent.Gen   = ixTP->Gen;
+   ent.Subs.clear();
+   while(sdP && sdP != sdEnd)
+        {if (!strncmp(sdP->text, dPath, n)) ent.Subs.push_back(sdP->text+n);
+         sdP = sdP->next;
+        }
+}
+
+/******************************************************************************/
+/*                                  L o a d                                   */
+/******************************************************************************/
+
+int XrdOucNSIndex::Load(const char *path)
+{
+   XrdSysMutexHelper mHelp(ixTP->Mutex);
+   ixHdr hdr;
+   char magic[sizeof(ixMagic)], buff[4096];
+   FILE *fP;
+   int n, rc = 0;
+
+// Start with an empty index
+//
+   ixTP->Tab.clear();
+   ixTP->Gen = 1;
+
+// Open the file, it need not exist
+//
+   if (!(fP = fopen(path, "r")))
+      {rc = errno;
+       if (rc != ENOENT && eDest) eDest->Emsg("NSIndex", rc, "open", path);
+       return rc;
+      }
+
+// Verify that this is an index we understand
+//
+   if (fread(magic, sizeof(magic), 1, fP) != 1
+   ||  memcmp(magic, ixMagic, sizeof(ixMagic))) rc = EDOM;
+
+// Read in each entry. Entries are marked as not yet visited.
+//
+   while(!rc && fread(&hdr, sizeof(hdr), 1, fP) == 1)
+        {if (hdr.pLen <= 0 || hdr.pLen >= (int)sizeof(buff) || hdr.nSubs < 0
+         ||  fread(buff, hdr.pLen, 1, fP) != 1) {rc = EDOM; break;}
+         ixTab::ixEnt &ent = ixTP->Tab[std::string(buff, hdr.pLen)];
+         ent.mTime     = hdr.mTime;
+         ent.cTime     = hdr.cTime;
+         ent.Sum.minAT = hdr.minAT;
+         ent.Sum.Bytes = hdr.Bytes;
+         ent.Sum.Files = hdr.Files;
+         ent.Sum.Empty = hdr.Empty;
+         ent.Gen       = 0;
+         for (int i = 0; i < hdr.nSubs; i++)
+             {if (fread(&n, sizeof(n), 1, fP) != 1
+              ||  n <= 0 || n >= (int)sizeof(buff)
+              ||  fread(buff, n, 1, fP) != 1) {rc = EDOM; break;}
+              ent.Subs.push_back(std::string(buff, n));
+             }
+        }
+   if (!rc && ferror(fP)) rc = EIO;
+   fclose(fP);
+
+// If the index is not usable then start afresh
+//
+   if (rc)
+      {ixTP->Tab.clear();
+       if (eDest) eDest->Emsg("NSIndex", path, "is unusable; index ignored.");
+      }
+   return rc;
+}
+
+/******************************************************************************/
+/*                                  S a v e                                   */
+/******************************************************************************/
+
+int XrdOucNSIndex::Save(const char *path)
+{
+   XrdSysMutexHelper mHelp(ixTP->Mutex);
+   std::string tmpPath(path);
+   ixHdr hdr;
+   FILE *fP;
+   int n, rc = 0;
+
+// Write the index to a temporary file first
+//
+   tmpPath += ".new";
+   if (!(fP = fopen(tmpPath.c_str(), "w")))
+      {rc = errno;
+       if (eDest) eDest->Emsg("NSIndex", rc, "create", tmpPath.c_str());
+       return rc;
+      }
+   setvbuf(fP, 0, _IOFBF, 1024*1024);
+   fwrite(ixMagic, sizeof(ixMagic), 1, fP);
+
+// Write out every entry that was visited, discarding the ones that were not.
+//
+   auto it = ixTP->Tab.begin();
+   while(it != ixTP->Tab.end())
+        {ixTab::ixEnt &ent = it->second;
+         if (ent.Gen != ixTP->Gen) {it = ixTP->Tab.erase(it); continue;}
+         memset(&hdr, 0, sizeof(hdr));
+         hdr.mTime = ent.mTime;
+         hdr.cTime = ent.cTime;
+         hdr.minAT = ent.Sum.minAT;
+         hdr.Bytes = ent.Sum.Bytes;
+         hdr.Files = ent.Sum.Files;
+         hdr.Empty = ent.Sum.Empty;
+         hdr.pLen  = it->first.size();
+         hdr.nSubs = ent.Subs.size();
+         fwrite(&hdr, sizeof(hdr), 1, fP);
+         fwrite(it->first.data(), hdr.pLen, 1, fP);
+         for (int i = 0; i < hdr.nSubs; i++)
+             {n = ent.Subs[i].size();
+              fwrite(&n, sizeof(n), 1, fP);
+              fwrite(ent.Subs[i].data(), n, 1, fP);
+             }
+         ++it;
+        }
+   ixTP->Gen++;
+
+// Make sure it all got written and replace the old index
+//
+   if (ferror(fP)) rc = EIO;
+   if (fclose(fP) && !rc) rc = errno;
+   if (!rc && rename(tmpPath.c_str(), path)) rc = errno;
+   if (rc)
+      {unlink(tmpPath.c_str());
+       if (eDest) eDest->Emsg("NSIndex", rc, "save index in", path);
+      }
+   return rc;
+}
+
+/******************************************************************************/
+/*                                  S k i p                                   */
+/******************************************************************************/
+
+bool XrdOucNSIndex::Skip(const char *dPath, struct stat &dStat, time_t cutOff,
+                         bool chkEmpty, XrdOucTList *&sdP)
+{
+   XrdSysMutexHelper mHelp(ixTP->Mutex);
+   std::string subPath(dPath);
+   int n = subPath.size();
+
+// Find the directory, it must be unchanged to be skipped. Additionally, all
+// of its files must have been accessed after the cutoff and it must not be
+// empty if the caller wants to know about empty directories.
+//
+   sdP = 0;
+   auto it = ixTP->Tab.find(subPath);
+   if (it == ixTP->Tab.end()) return false;
+   ixTab::ixEnt &ent = it->second;
+   if (ent.mTime != dStat.st_mtime || ent.cTime != dStat.st_ctime
+   ||  (ent.Sum.Files && ent.Sum.minAT <= cutOff)
+   ||  (chkEmpty && ent.Sum.Empty)) return false;
+
+// We can skip this directory. Return the full path of every subdirectory.
+//
+   ent.Gen = ixTP->Gen;
+   for (int i = ent.Subs.size()-1; i >= 0; i--)
+       {subPath.replace(n, std::string::npos, ent.Subs[i]);
+        sdP = new XrdOucTList(subPath.c_str(), 0, sdP);
+       }
+   ixTP->Skipped.Files += ent.Sum.Files;
+   ixTP->Skipped.Bytes += ent.Sum.Bytes;
+   ixTP->Skipped.Dirs++;
+   return true;
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+
+void XrdOucNSIndex::Stats(Totals &tots)
+{
+   XrdSysMutexHelper mHelp(ixTP->Mutex);
+
+   tots = ixTP->Skipped;
+   tots.Ents = ixTP->Tab.size();
+   ixTP->Skipped.Files = ixTP->Skipped.Bytes = 0;
+   ixTP->Skipped.Dirs  = 0;
+}
+
+/******************************************************************************/
+/*                                 T a l l y                                  */
+/******************************************************************************/
+
+void XrdOucNSIndex::Tally(dirSum &dSum, struct stat &fStat)
+{
+   if (!dSum.Files || fStat.st_atime < dSum.minAT) dSum.minAT = fStat.st_atime;
+   dSum.Bytes += fStat.st_size;
+   dSum.Files++;
+}
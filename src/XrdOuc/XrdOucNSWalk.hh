@@ -36,6 +36,7 @@
 #include <sys/stat.h>
   
 
+class XrdOucNSIndex;
 class XrdOucTList;
 class XrdSysError;
 
@@ -101,6 +102,25 @@ void         setCallBack(CallBack *cbP=0) {edCB = cbP;}
 //
 void         setMsgOn(const char *pfx) {mPfx = pfx;}
 
+// When opts & Recurse, setThreads() may be used before the first call to
+// Index() to have up to nThreads threads read and stat directories ahead of
+// the caller. Index() still returns one directory at a time and all callbacks
+// are made in the caller's thread. However, directories are no longer
+// returned in depth-first order. A value less than two disables prefetching.
+//
+void         setThreads(int nThreads) {nThr = (nThreads > 1 ? nThreads : 0);}
+
+// setIndex() enables incremental traversal using the supplied index (see
+// XrdOucNSIndex below). A directory whose mtime and ctime are the same as the
+// last time it was fully listed, and whose oldest file atime is more recent
+// than cutOff, is not read; its entries are not returned and the previously
+// recorded subdirectories are traversed instead. The index is only consulted
+// when opts & retStat as link targets must be examined. Use setIndex(0) to
+// disable incremental traversal.
+//
+void         setIndex(XrdOucNSIndex *ixP, time_t cutOff=0)
+                     {nsIX = (Opts & retStat ? ixP : 0); ixCut = cutOff;}
+
 // The following are processing options passed to the constructor
 //
 static const int retDir =  0x0001; // Return directories (implies retStat)
@@ -130,6 +150,7 @@ static const int skpErrs=  0x8000; // Skip any entry causing an error
 //       as a directory entry if an empty directory call back has been set.
 
 private:
+struct        wPool;
 void          addEnt(XrdOucNSWalk::NSEnt *eP);
 int           Build();
 int           Emsg(const char *pfx, int rc, const char *tx1, const char *tx2=0);
@@ -137,9 +158,11 @@ int           getLink(XrdOucNSWalk::NSEnt *eP);
 int           getStat(XrdOucNSWalk::NSEnt *eP, int doLstat=0);
 int           getStat();
 int           inXList(const char *dName);
-int           isSymlink();
 int           LockFile();
+XrdOucNSWalk::NSEnt *pIndex(int &rc, const char **dPath);
 void          setPath(char *newpath);
+void          Work();
+static void  *Worker(void *pp);
 
 XrdSysError  *eDest;
 XrdOucTList  *DList;
@@ -148,6 +171,9 @@ struct NSEnt *DEnts;
 struct stat   dStat;
 CallBack     *edCB;
 const char   *mPfx;
+wPool        *Pool;
+XrdOucNSIndex*nsIX;
+time_t        ixCut;
 char          DPath[1032];
 char         *File;
 char         *LKFn;
@@ -156,5 +182,61 @@ int           DPfd;
 int           Opts;
 int           errOK;
 int           isEmpty;
+int           nThr;
+};
+
+/******************************************************************************/
+/*                     C l a s s   X r d O u c N S I n d e x                  */
+/******************************************************************************/
+
+// The XrdOucNSIndex object records a summary of each directory fully listed
+// by an XrdOucNSWalk object that was given the index via setIndex(). The
+// summary consists of the directory's mtime and ctime, the number, size, and
+// oldest atime of its files, and the names of its subdirectories. It may be
+// shared by any number of walkers and persists across runs via Load()/Save().
+//
+class XrdOucNSIndex
+{
+public:
+
+// Load() replaces the index with the contents of a file written by Save().
+// It returns 0 upon success or the errno value. ENOENT is not reported via
+// the error object as an index need not yet exist.
+//
+int          Load(const char *path);
+
+// Save() writes all entries that were listed or skipped since the last Load()
+// or Save() to the file, replacing it atomically. Entries for directories
+// that were not visited are discarded. It returns 0 upon success or the errno.
+//
+int          Save(const char *path);
+
+// Stats() returns what was skipped since the last call and then resets them.
+//
+struct Totals {long long Files;   // Number of files in skipped directories
+               long long Bytes;   // Bytes in the above files
+               int       Dirs;    // Number of directories skipped
+               int       Ents;    // Number of directories in the index
+              };
+
+void         Stats(Totals &tots);
+
+             XrdOucNSIndex(XrdSysError *erp=0);
+            ~XrdOucNSIndex();
+
+private:
+friend class XrdOucNSWalk;
+
+struct       dirSum {long long Bytes; time_t minAT; int Files; int Empty;};
+
+void         Add(const char *dPath, struct stat &dStat, dirSum &dSum,
+                 XrdOucTList *sdP, XrdOucTList *sdEnd);
+bool         Skip(const char *dPath, struct stat &dStat, time_t cutOff,
+                  bool chkEmpty, XrdOucTList *&sdP);
+static void  Tally(dirSum &dSum, struct stat &fStat);
+
+struct       ixTab;
+ixTab       *ixTP;
+XrdSysError *eDest;
 };
 #endif
@@ -227,11 +227,13 @@ bool XrdPosixConfig::initCCM(XrdOucPsx &parms)
 // maxfiles=n  - maximum number of files to support.
 // minp=n      - minimum number of pages needed.
 // mode={c|s}  - running as a client (default) or server.
+// opthp=1     - back the cache with huge pages
 // optlg=1     - log statistics
 // optpr=1     - enable pre-reads
 // optsf=<val> - optimize structured file: 1 = all, 0 = off, .<sfx> specific
 // optwr=1     - cache can be written to.
 // pagesz=n    - individual byte size of a page (can be suffized in k, m, g).
+// parts=n     - number of independently locked cache partitions.
 //
 
 void XrdPosixConfig::initEnv(char *eData)
@@ -257,6 +259,10 @@ void XrdPosixConfig::initEnv(char *eData)
                                           myParms.minPages = Val;
                                          }
    initEnv(theEnv, "pagesz",    Val); if (Val >= 0) myParms.PageSize  = Val;
+   initEnv(theEnv, "parts",     Val); if (Val >= 0)
+                                         {if (Val > 32767) Val = 32767;
+                                          myParms.Partitions = Val;
+                                         }
 
 // Get Debug setting
 //
@@ -290,6 +296,8 @@ void XrdPosixConfig::initEnv(char *eData)
       myParms.Options |= XrdRmc::logStats;
    if ((tP = theEnv.Get("optpr")) && *tP && *tP != '0')
       myParms.Options |= XrdRmc::canPreRead;
+   if ((tP = theEnv.Get("opthp")) && *tP && *tP != '0')
+      myParms.Options |= XrdRmc::useHugePg;
 // if ((tP = theEnv.Get("optwr")) && *tP && *tP != '0') isRW = 1;
 
 // Now allocate a cache. Indicate that we already serialize the I/O to avoid
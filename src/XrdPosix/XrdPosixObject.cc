@@ -28,8 +28,11 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
 #include <cerrno>
 #include <fcntl.h>
+#include <new>
+#include <sched.h>
 #include <sys/resource.h>
 #include <sys/stat.h>
 
@@ -46,13 +49,51 @@ namespace XrdPosixGlobals
 {
 extern thread_local XrdOucECMsg ecMsg;
 }
+
+/******************************************************************************/
+/*                          L o c a l   C l a s s e s                         */
+/******************************************************************************/
+
+namespace
+{
+// Lookups walk the fd table without taking fdMutex. Each reader registers in
+// the counter of the current epoch for as long as it may hold a table pointer
+// it has not yet validated. A writer that removes an object flips the epoch
+// and waits for the previous epoch to drain before the object may be deleted.
+// Writers are serialized by fdMutex and never register as readers.
+//
+std::atomic<unsigned int> rdEpoch(0);
+std::atomic<int>          rdCount[2];
+
+class rdGuard
+{
+public:
+
+void Leave() {if (slot >= 0) {rdCount[slot].fetch_sub(1); slot = -1;}}
+
+     rdGuard(bool isWriter) : slot(-1)
+               {unsigned int e;
+                if (isWriter) return;
+                do {e = rdEpoch.load();
+                    rdCount[e & 1].fetch_add(1);
+                    if (rdEpoch.load() == e) break;
+                    rdCount[e & 1].fetch_sub(1);
+                   } while(1);
+                slot = e & 1;
+               }
+    ~rdGuard() {Leave();}
+
+private:
+int slot;
+};
+}
   
 /******************************************************************************/
 /*                        S t a t i c   M e m b e r s                         */
 /******************************************************************************/
 
 XrdSysMutex      XrdPosixObject::fdMutex;
-XrdPosixObject **XrdPosixObject::myFiles  =  0;
+std::atomic<XrdPosixObject*> *XrdPosixObject::myFiles = 0;
 int              XrdPosixObject::highFD   = -1;
 int              XrdPosixObject::lastFD   = -1;
 int              XrdPosixObject::baseFD   =  0;
@@ -74,21 +115,21 @@ bool XrdPosixObject::AssignFD(bool isStream)
 //
    if (baseFD)
       { if (isStream) return 0;
-        for (fd = freeFD; fd < posxFD && myFiles[fd]; fd++) {}
+        for (fd = freeFD; fd < posxFD && myFiles[fd].load(); fd++) {}
         if (fd >= posxFD) return 0;
         freeFD = fd+1;
       } else {
         do{if ((fd = dup(devNull)) < 0) return false;
            if (fd >= lastFD || (isStream && fd > 255))
               {close(fd); return 0;}
-           if (!myFiles[fd]) break;
+           if (!myFiles[fd].load()) break;
            DMSG("AssignFD", "FD " <<fd <<" closed outside of XrdPosix!");
           } while(1);
       }
 
 // Enter object in out vector of objects and assign it the FD
 //
-   myFiles[fd] = this;
+   myFiles[fd].store(this, std::memory_order_release);
    if (fd > highFD) highFD = fd;
    fdNum  = fd + baseFD;
 
@@ -113,11 +154,17 @@ XrdPosixDir *XrdPosixObject::Dir(int fd, bool glk)
 do{if (fd >= lastFD || fd < baseFD)
       {errno = EBADF; return (XrdPosixDir *)0;}
 
-// Obtain the file object, if any
+// Obtain the file object, if any. Only callers that will remove the object
+// from the table need the global lock; everyone else does a lock-free lookup
+// that stays registered with the current read epoch until it is validated.
 //
-   fdMutex.Lock();
-   if (!(oP = myFiles[fd - baseFD]) || !(oP->Who(&dP)))
-      {fdMutex.UnLock(); errno = EBADF; return (XrdPosixDir *)0;}
+   rdGuard epGuard(glk);
+   if (glk) fdMutex.Lock();
+   if (!(oP = myFiles[fd - baseFD].load(std::memory_order_acquire))
+   ||  !(oP->Who(&dP)))
+      {if (glk) fdMutex.UnLock();
+       errno = EBADF; return (XrdPosixDir *)0;
+      }
 
 // Attempt to lock the object in the appropriate mode. If we fail, then we need
 // to retry this after dropping the global lock. We pause a bit to let the
@@ -127,18 +174,24 @@ do{if (fd >= lastFD || fd < baseFD)
    if (glk) haveLock = oP->objMutex.CondWriteLock();
       else  haveLock = oP->objMutex.CondReadLock();
    if (!haveLock)
-      {fdMutex.UnLock();
+      {if (glk) fdMutex.UnLock();
+       epGuard.Leave();
        waitCount++;
        if (waitCount > 120) break;
        XrdSysTimer::Wait(500); // We wait 500 milliseconds
        continue;
       }
 
-// If the global lock is to be held, then release the object lock as this
-// is a call to destroy the object and there is no need for the local lock.
+// A lock-free lookup may have raced with a close. Once we hold the read lock
+// the object can no longer be removed, so make sure it is still in the table.
+//
+   if (!glk && myFiles[fd - baseFD].load(std::memory_order_acquire) != oP)
+      {oP->UnLock(); errno = EBADF; return (XrdPosixDir *)0;}
+
+// If the global lock is held, then we keep the object write lock as well. This
+// is a call to destroy the object and the lock keeps lock-free readers from
+// validating it until it has been removed from the table (see Release()).
 //
-   if (glk) oP->UnLock();
-      else  fdMutex.UnLock();
    return dP;
   } while(1);
 
@@ -164,11 +217,17 @@ XrdPosixFile *XrdPosixObject::File(int fd, bool glk)
 do{if (fd >= lastFD || fd < baseFD)
       {errno = EBADF; return (XrdPosixFile *)0;}
 
-// Obtain the file object, if any
+// Obtain the file object, if any. Only callers that will remove the object
+// from the table need the global lock; everyone else does a lock-free lookup
+// that stays registered with the current read epoch until it is validated.
 //
-   fdMutex.Lock();
-   if (!(oP = myFiles[fd - baseFD]) || !(oP->Who(&fP)))
-      {fdMutex.UnLock(); errno = EBADF; return (XrdPosixFile *)0;}
+   rdGuard epGuard(glk);
+   if (glk) fdMutex.Lock();
+   if (!(oP = myFiles[fd - baseFD].load(std::memory_order_acquire))
+   ||  !(oP->Who(&fP)))
+      {if (glk) fdMutex.UnLock();
+       errno = EBADF; return (XrdPosixFile *)0;
+      }
 
 // Attempt to lock the object in the appropriate mode. If we fail, then we need
 // to retry this after dropping the global lock. We pause a bit to let the
@@ -178,18 +237,24 @@ do{if (fd >= lastFD || fd < baseFD)
    if (glk) haveLock = oP->objMutex.CondWriteLock();
       else  haveLock = oP->objMutex.CondReadLock();
    if (!haveLock)
-      {fdMutex.UnLock();
+      {if (glk) fdMutex.UnLock();
+       epGuard.Leave();
        waitCount++;
        if (waitCount > 120) break;
        XrdSysTimer::Wait(500); // We wait 500 milliseconds
        continue;
       }
 
-// If the global lock is to be held, then release the object lock as this
-// is a call to destroy the object and there is no need for the local lock.
+// A lock-free lookup may have raced with a close. Once we hold the read lock
+// the object can no longer be removed, so make sure it is still in the table.
+//
+   if (!glk && myFiles[fd - baseFD].load(std::memory_order_acquire) != oP)
+      {oP->UnLock(); errno = EBADF; return (XrdPosixFile *)0;}
+
+// If the global lock is held, then we keep the object write lock as well. This
+// is a call to destroy the object and the lock keeps lock-free readers from
+// validating it until it has been removed from the table (see Release()).
 //
-   if (glk) oP->UnLock();
-      else  fdMutex.UnLock();
    return fP;
   } while(1);
 
@@ -207,7 +272,7 @@ int XrdPosixObject::Init(int fdnum)
 {
    static const int maxFD = 1048576;
    struct rlimit rlim;
-   int isize, limfd;
+   int limfd;
 
 // Initialize the /dev/null file descriptors, bail if we cannot
 //
@@ -235,12 +300,12 @@ int XrdPosixObject::Init(int fdnum)
 //
    if (fdnum < 0) {posxFD = fdnum = -fdnum; baseFD = limfd;}
       else         fdnum = limfd;
-   isize = fdnum * sizeof(XrdPosixFile *);
 
 // Allocate the table for fd-type pointers
 //
-   if (!(myFiles = (XrdPosixObject **)malloc(isize))) lastFD = -1;
-      else {memset((void *)myFiles, 0, isize); lastFD = fdnum+baseFD;}
+   if (!(myFiles = new (std::nothrow) std::atomic<XrdPosixObject*>[fdnum]()))
+      lastFD = -1;
+      else lastFD = fdnum+baseFD;
 
 // All done
 //
@@ -262,12 +327,17 @@ void XrdPosixObject::Release(XrdPosixObject *oP, bool needlk)
    if (baseFD)
       {int myFD = oP->fdNum - baseFD;
        if (myFD < freeFD) freeFD = myFD;
-       myFiles[myFD] = 0;
+       myFiles[myFD].store(0, std::memory_order_release);
       } else {
-       myFiles[oP->fdNum] = 0;
+       myFiles[oP->fdNum].store(0, std::memory_order_release);
        close(oP->fdNum);
       }
 
+// Wait for any lock-free lookup that may have seen the object to go away so
+// that the caller is free to delete it once we return.
+//
+   Synchronize();
+
 // Zorch the object fd and release the global lock
 //
    oP->fdNum = -1;
@@ -286,9 +356,11 @@ XrdPosixDir *XrdPosixObject::ReleaseDir(int fd)
 //
    if (!(dP = Dir(fd, true))) return (XrdPosixDir *)0;
 
-// Release it and return the underlying object
+// Release it, drop the object lock obtained above, and return the object
 //
-   Release((XrdPosixObject *)dP, false);
+   XrdPosixObject *oP = (XrdPosixObject *)dP;
+   Release(oP, false);
+   oP->UnLock();
    return dP;
 }
 
@@ -304,9 +376,11 @@ XrdPosixFile *XrdPosixObject::ReleaseFile(int fd)
 //
    if (!(fP = File(fd, true))) return (XrdPosixFile *)0;
 
-// Release it and return the underlying object
+// Release it, drop the object lock obtained above, and return the object
 //
-   Release((XrdPosixObject *)fP, false);
+   XrdPosixObject *oP = (XrdPosixObject *)fP;
+   Release(oP, false);
+   oP->UnLock();
    return fP;
 }
   
@@ -324,13 +398,27 @@ void XrdPosixObject::Shutdown()
    fdMutex.Lock();
    if (myFiles)
       {for (i = 0; i <= highFD; i++) 
-           if ((oP = myFiles[i]))
-              {myFiles[i] = 0;
+           if ((oP = myFiles[i].exchange(0)))
+              {Synchronize();
                if (oP->fdNum >= 0) close(oP->fdNum);
                oP->fdNum = -1;
                delete oP;
               };
-       free(myFiles); myFiles = 0;
+       delete [] myFiles; myFiles = 0;
       }
    fdMutex.UnLock();
 }
+
+/******************************************************************************/
+/*                           S y n c h r o n i z e                            */
+/******************************************************************************/
+
+void XrdPosixObject::Synchronize()
+{
+// Move readers to the next epoch and wait for the ones still registered in the
+// previous epoch to leave. The caller must hold fdMutex so that only one
+// writer flips the epoch at a time. Readers never block while registered.
+//
+   unsigned int oldEpoch = rdEpoch.fetch_add(1);
+   while(rdCount[oldEpoch & 1].load()) sched_yield();
+}
@@ -30,6 +30,7 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
 #include <sys/types.h>
 
 #include "XrdOuc/XrdOucECMsg.hh"
@@ -62,15 +63,9 @@ static  int           Init(int numfd);
                               else objMutex.ReadLock();
                           }
 
-        void          Ref()    {AtomicBeg(updMutex);
-                                AtomicInc(refCnt);
-                                AtomicEnd(updMutex);
-                               }
-        int           Refs()   {AtomicRet(updMutex, refCnt);}
-        void          unRef()  {AtomicBeg(updMutex);
-                                AtomicDec(refCnt);
-                                AtomicEnd(updMutex);
-                               }
+        void          Ref()    {refCnt.fetch_add(1, std::memory_order_relaxed);}
+        int           Refs()   {return refCnt.load(std::memory_order_acquire);}
+        void          unRef()  {refCnt.fetch_sub(1, std::memory_order_acq_rel);}
 
 static  void          Release(XrdPosixObject *oP, bool needlk=true);
 
@@ -84,7 +79,8 @@ static  void          Shutdown();
 
 static  bool          Valid(int fd)
                            {return fd >= baseFD && fd <= (highFD+baseFD)
-                                   && myFiles && myFiles[fd-baseFD];}
+                                   && myFiles
+                                   && myFiles[fd-baseFD].load(std::memory_order_acquire);}
 
 virtual bool          Who(XrdPosixDir  **dirP)  {return false;}
 
@@ -99,12 +95,18 @@ protected:
        XrdSysRecMutex   updMutex;
        XrdSysRWLock     objMutex;
        int              fdNum;
-       int              refCnt;
+       std::atomic<int> refCnt;
 
 private:
 
+static void             Synchronize();
+
+// The fd table is read without any global lock. Slots are only changed while
+// holding fdMutex and a released object is not reused until all readers that
+// may have seen it have left (see Synchronize()).
+//
 static XrdSysMutex      fdMutex;
-static XrdPosixObject **myFiles;
+static std::atomic<XrdPosixObject*> *myFiles;
 static int              lastFD;
 static int              highFD;
 static int              baseFD;
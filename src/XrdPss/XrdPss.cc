@@ -52,9 +52,11 @@
 
 #include "XrdNet/XrdNetSecurity.hh"
 #include "XrdPss/XrdPss.hh"
+#include "XrdPss/XrdPssStream.hh"
 #include "XrdPss/XrdPssTrace.hh"
 #include "XrdPss/XrdPssUrlInfo.hh"
 #include "XrdPss/XrdPssUtils.hh"
+#include "XrdPosix/XrdPosixCallBack.hh"
 #include "XrdPosix/XrdPosixConfig.hh"
 #include "XrdPosix/XrdPosixExtra.hh"
 #include "XrdPosix/XrdPosixInfo.hh"
@@ -166,7 +168,7 @@ XrdOss *XrdOssGetStorageSystem2(XrdOss       *native_oss,
 XrdPssSys::XrdPssSys() : HostArena(0), LocalRoot(0), theN2N(0), DirFlags(0),
                          myVersion(&XrdVERSIONINFOVAR(XrdOssGetStorageSystem2)),
                          myFeatures(XRDOSS_HASPRXY|XRDOSS_HASPGRW|
-                         XRDOSS_HASNOSF|XRDOSS_HASXERT)
+                         XRDOSS_HASNOSF|XRDOSS_HASXERT|XRDOSS_HASAOPN)
                          {}
 
 /******************************************************************************/
@@ -1003,6 +1005,106 @@ int XrdPssFile::Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &Env)
           }
       }
 
+// Setup streaming I/O if so wanted
+//
+   if (XrdPssStream::Enabled(rwMode)) strmP = new XrdPssStream(fd, rwMode);
+
+// All done
+//
+   return XrdOssOK;
+}
+
+/******************************************************************************/
+/*                             O p e n A s y n c                              */
+/******************************************************************************/
+
+class XrdPssFile::OpenCB : public XrdPosixCallBack
+{
+public:
+
+void Complete(int Result) override
+             {if (Result >= 0)
+                 {fileP->fd = Result; Result = XrdOssOK;
+                  if (XrdPssStream::Enabled(false))
+                     fileP->strmP = new XrdPssStream(fileP->fd, false);
+                 } else fileP->lastEtrc = 0;
+              cbP.Done(Result);
+              delete this;
+             }
+
+     OpenCB(XrdPssFile *fP, XrdOucCacheIOCB &cb) : fileP(fP), cbP(cb) {}
+    ~OpenCB() {}
+
+private:
+XrdPssFile      *fileP;
+XrdOucCacheIOCB &cbP;
+};
+
+/*
+  Function: Start opening the file `path' in the mode indicated by `Oflag'.
+
+  Input:    path      - The fully qualified name of the file to open.
+            Oflag     - Standard open flags.
+            Mode      - Create mode (i.e., rwx).
+            env       - Environmental information.
+            cbP       - The callback to invoke when the open completes.
+
+  Output:   XrdOssOK if the open was started; -errno otherwise. -ENOTSUP is
+            returned for opens that need special handling by Open().
+*/
+int XrdPssFile::OpenAsync(const char *path, int Oflag, mode_t Mode,
+                          XrdOucEnv &Env, XrdOucCacheIOCB &cbP)
+{
+   EPNAME("OpenAsync");
+   unsigned long long popts = XrdPssSys::XPList.Find(path);
+   const char *Cgi = "";
+   char pbuff[PBsz];
+   int  rc;
+
+// Only plain read-only opens are done asynchronously. Third party copies,
+// direct cache access and cache-control checks are left to Open().
+//
+   if ((Oflag & (O_ACCMODE | O_NOFOLLOW | O_DIRECT)) != O_RDONLY || cacheFSctl)
+      return -ENOTSUP;
+
+// Return an error if the object is already open
+//
+   if (fd >= 0 || tpcPath) return -XRDOSS_E8003;
+
+// Record the security environment
+//
+   entity = Env.secEnv();
+
+// Setup any required cgi information (see Open() above)
+//
+   if (!XrdProxy::outProxy && *path == '/' && !(XRDEXP_STAGE & popts))
+      Cgi = osslclCGI;
+
+// Construct the url info and convert path to URL
+//
+   XrdPssUrlInfo uInfo(&Env, path, Cgi);
+   uInfo.setID();
+   if ((rc = XrdPssSys::P2URL(pbuff, PBsz, uInfo, XrdPssSys::xLfn2Pfn)))
+      return rc;
+
+// Do some tracing
+//
+  if(DEBUGON) {
+    auto urlObf = obfuscateAuth(pbuff);
+    DEBUG(uInfo.Tident(),"url="<<urlObf);
+  }
+
+// Start the open. The callback may be invoked before we return. A result
+// other than EINPROGRESS means the callback will never be invoked.
+//
+   OpenCB *ocbP = new OpenCB(this, cbP);
+   if (XrdPosixXrootd::Open(pbuff, Oflag, Mode, ocbP) < 0 && errno != EINPROGRESS)
+      {rc = -errno;
+       lastEtrc = XrdPosixXrootd::QueryError(lastEtext);
+       delete ocbP;
+       return rc;
+      }
+
 // All done
 //
    return XrdOssOK;
@@ -1020,7 +1122,7 @@ int XrdPssFile::Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &Env)
   Output:   Returns XrdOssOK upon success aud -errno upon failure.
 */
 int XrdPssFile::Close(long long *retsz)
-{   int rc;
+{   int rc, wrc = 0;
 
 // We don't support returning the size (we really should fix this)
 //
@@ -1035,11 +1137,23 @@ int XrdPssFile::Close(long long *retsz)
         return XrdOssOK;
        }
 
+// Write out anything still buffered. A failure of any deferred write is
+// reported here unless the close itself fails.
+//
+    if (strmP)
+       {wrc = strmP->Drain();
+        delete strmP;
+        strmP = 0;
+       }
+
 // Close the file
 //
     rc = XrdPosixXrootd::Close(fd);
     fd = -1;
-    if (rc == 0) return XrdOssOK;
+    if (rc == 0)
+       {if (wrc) {lastEtext = "deferred write failed"; lastEtrc = -wrc;}
+        return wrc;
+       }
     rc = -errno;
     lastEtrc = XrdPosixXrootd::QueryError(lastEtext);
     return rc;
@@ -1092,6 +1206,18 @@ ssize_t XrdPssFile::pgRead(void     *buffer,
 //
    if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
+// When streaming, the data comes from the stream and we compute checksums
+//
+   if (strmP)
+      {if ((bytes = strmP->Read(buffer, offset, rdlen)) < 0)
+          {lastEtrc = XrdPosixXrootd::QueryError(lastEtext, fd);
+           return bytes;
+          }
+       if (bytes && csvec)
+          XrdOucPgrwUtils::csCalc((const char *)buffer, offset, bytes, csvec);
+       return bytes;
+      }
+
 // Set options as needed
 //
    psxOpts = (csvec ? XrdPosixExtra::forceCS : 0);
@@ -1172,8 +1298,15 @@ ssize_t XrdPssFile::pgWrite(void     *buffer,
        memcpy(vecCS.data(), csvec, n*sizeof(uint32_t));
       }
 
-// Issue the pgwrite
+// Issue the pgwrite. When streaming, the (verified) data is written behind.
 //
+   if (strmP)
+      {if ((bytes = strmP->Write(buffer, offset, wrlen)) < 0)
+          {lastEtext = "deferred write failed";
+           lastEtrc = -bytes;
+          }
+       return bytes;
+      }
    bytes = XrdPosixExtra::pgWrite(fd, buffer, offset, wrlen, vecCS);
 
 // Return result
@@ -1229,6 +1362,12 @@ ssize_t XrdPssFile::Read(void *buff, off_t offset, size_t blen)
 
      if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
+     if (strmP)
+        {if ((retval = strmP->Read(buff, offset, blen)) < 0)
+            lastEtrc = XrdPosixXrootd::QueryError(lastEtext, fd);
+         return retval;
+        }
+
      if ((retval = XrdPosixXrootd::Pread(fd, buff, blen, offset)) < 0)
         {int rc = -errno;
          lastEtrc = XrdPosixXrootd::QueryError(lastEtext, fd);
@@ -1260,6 +1399,8 @@ ssize_t XrdPssFile::ReadV(XrdOucIOVec     *readV,     // In
 
     if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
+    if (strmP && (retval = strmP->Drain())) return retval;
+
     if ((retval = XrdPosixXrootd::VRead(fd, readV, readCount)) < 0)
        {int rc = -errno;
         lastEtrc = XrdPosixXrootd::QueryError(lastEtext, fd);
@@ -1310,6 +1451,14 @@ ssize_t XrdPssFile::Write(const void *buff, off_t offset, size_t blen)
 
      if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
+     if (strmP)
+        {if ((retval = strmP->Write(buff, offset, blen)) < 0)
+            {lastEtext = "deferred write failed";
+             lastEtrc = -retval;
+            }
+         return retval;
+        }
+
      if ((retval = XrdPosixXrootd::Pwrite(fd, buff, blen, offset)) < 0)
         {int rc = -errno;
          lastEtrc = XrdPosixXrootd::QueryError(lastEtext, fd);
@@ -1381,11 +1530,14 @@ int XrdPssFile::Fstat(struct stat *buff)
 {
    EPNAME("fstat");
 
-// If we have a file descriptor then return a stat for it
+// If we have a file descriptor then return a stat for it. Buffered writes
+// must be out for the size to be correct so report any failure to do so.
 //
    if (fd >= 0)
-      {if (XrdPosixXrootd::Fstat(fd, buff) == 0) return XrdOssOK;
-       int rc = -errno;
+      {int rc;
+       if (strmP && (rc = strmP->Drain())) return rc;
+       if (XrdPosixXrootd::Fstat(fd, buff) == 0) return XrdOssOK;
+       rc = -errno;
        lastEtrc = XrdPosixXrootd::QueryError(lastEtext, fd);
        return (ssize_t)rc;
       }
@@ -1472,6 +1624,15 @@ int XrdPssFile::Fsync(void)
 {
     if (fd < 0) return -XRDOSS_E8004;
 
+    if (strmP)
+       {int wrc = strmP->Drain();
+        if (wrc)
+           {lastEtext = "deferred write failed";
+            lastEtrc = -wrc;
+            return wrc;
+           }
+       }
+
     if (XrdPosixXrootd::Fsync(fd) == 0) return XrdOssOK;
     int rc = -errno;
     lastEtrc = XrdPosixXrootd::QueryError(lastEtext, fd);
@@ -1504,6 +1665,11 @@ int XrdPssFile::Ftruncate(unsigned long long flen)
 {
     if (fd < 0) return -XRDOSS_E8004;
 
+    if (strmP)
+       {int wrc = strmP->Drain();
+        if (wrc) return wrc;
+       }
+
     if (XrdPosixXrootd::Ftruncate(fd, flen) == 0) return XrdOssOK;
     int rc = -errno;
     lastEtrc = XrdPosixXrootd::QueryError(lastEtext, fd);
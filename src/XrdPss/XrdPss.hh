@@ -80,6 +80,7 @@ private:
 /******************************************************************************/
 
 struct XrdOucIOVec;
+class  XrdPssStream;
 class  XrdSecEntity;
 class  XrdSfsAio;
   
@@ -92,6 +93,8 @@ public:
 //
 virtual int     Close(long long *retsz=0) override;
 virtual int     Open(const char *, int, mode_t, XrdOucEnv &) override;
+virtual int     OpenAsync(const char *, int, mode_t, XrdOucEnv &,
+                          XrdOucCacheIOCB &) override;
 
 int     Fchmod(mode_t mode) override {return XrdOssOK;}
 int     Fctl(int cmd, int alen, const char *args, char **resp=0) override;
@@ -117,7 +120,8 @@ int     Write(XrdSfsAio *aiop) override;
          // Constructor and destructor
          XrdPssFile(const char *tid)
                    : XrdOssDF(tid, XrdOssDF::DF_isFile|XrdOssDF::DF_isProxy),
-                     rpInfo(0), tpcPath(0), entity(0), lastEtrc(0) {}
+                     rpInfo(0), tpcPath(0), entity(0), strmP(0),
+                     lastEtrc(0) {}
 
 virtual ~XrdPssFile() {if (fd >= 0) Close();
                        if (rpInfo) delete(rpInfo);
@@ -126,6 +130,8 @@ virtual ~XrdPssFile() {if (fd >= 0) Close();
 
 private:
 
+class OpenCB;
+
 struct tprInfo
       {char  *tprPath;
        char  *dstURL;
@@ -140,6 +146,7 @@ struct tprInfo
 
       char         *tpcPath;
 const XrdSecEntity *entity;
+XrdPssStream       *strmP;
 std::string         lastEtext;
 int                 lastEtrc;
 };
@@ -248,5 +255,6 @@ int    xexp( XrdSysError *Eroute, XrdOucStream &Config);
 int    xperm(XrdSysError *errp,   XrdOucStream &Config);
 int    xpers(XrdSysError *errp,   XrdOucStream &Config);
 int    xorig(XrdSysError *errp,   XrdOucStream &Config);
+int    xstrm(XrdSysError *Eroute, XrdOucStream &Config);
 };
 #endif
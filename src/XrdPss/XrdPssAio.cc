@@ -53,6 +53,14 @@
 int XrdPssFile::Fsync(XrdSfsAio *aiop)
 {
 
+// Streaming files must first drain their write-behind buffers, do it inline
+//
+   if (strmP)
+      {aiop->Result = Fsync();
+       aiop->doneWrite();
+       return 0;
+      }
+
 // Execute this request in an asynchronous fashion
 //
    XrdPosixXrootd::Fsync(fd, XrdPssAioCB::Alloc(aiop, true));
@@ -76,6 +84,18 @@ int XrdPssFile::Fsync(XrdSfsAio *aiop)
   
 int XrdPssFile::pgRead(XrdSfsAio* aiop, uint64_t opts)
 {
+
+// Streaming files are served from the read-ahead window, do it inline
+//
+   if (strmP)
+      {aiop->Result = pgRead((void *)aiop->sfsAio.aio_buf,
+                             (off_t)aiop->sfsAio.aio_offset,
+                             (size_t)aiop->sfsAio.aio_nbytes,
+                             aiop->cksVec, opts);
+       aiop->doneRead();
+       return 0;
+      }
+
    XrdPssAioCB *aioCB = XrdPssAioCB::Alloc(aiop, false, true);
    uint64_t psxOpts = (aiop->cksVec ? XrdPosixExtra::forceCS : 0);
 
@@ -106,6 +126,17 @@ int XrdPssFile::pgRead(XrdSfsAio* aiop, uint64_t opts)
 int XrdPssFile::pgWrite(XrdSfsAio *aiop, uint64_t opts)
 {
 
+// Streaming files buffer the data for write-behind, do it inline
+//
+   if (strmP)
+      {aiop->Result = pgWrite((void *)aiop->sfsAio.aio_buf,
+                              (off_t)aiop->sfsAio.aio_offset,
+                              (size_t)aiop->sfsAio.aio_nbytes,
+                              aiop->cksVec, opts);
+       aiop->doneWrite();
+       return 0;
+      }
+
 // Check if caller wants to verify the checksums before writing
 //
    if (aiop->cksVec && (opts & XrdOssDF::Verify))
@@ -165,6 +196,16 @@ int XrdPssFile::pgWrite(XrdSfsAio *aiop, uint64_t opts)
 int XrdPssFile::Read(XrdSfsAio *aiop)
 {
 
+// Streaming files are served from the read-ahead window, do it inline
+//
+   if (strmP)
+      {aiop->Result = Read((void *)aiop->sfsAio.aio_buf,
+                           (off_t)aiop->sfsAio.aio_offset,
+                           (size_t)aiop->sfsAio.aio_nbytes);
+       aiop->doneRead();
+       return 0;
+      }
+
 // Execute this request in an asynchronous fashion
 //
    XrdPosixXrootd::Pread(fd, (void *)aiop->sfsAio.aio_buf,
@@ -192,6 +233,16 @@ int XrdPssFile::Read(XrdSfsAio *aiop)
 int XrdPssFile::Write(XrdSfsAio *aiop)
 {
 
+// Streaming files buffer the data for write-behind, do it inline
+//
+   if (strmP)
+      {aiop->Result = Write((const void *)aiop->sfsAio.aio_buf,
+                            (off_t)aiop->sfsAio.aio_offset,
+                            (size_t)aiop->sfsAio.aio_nbytes);
+       aiop->doneWrite();
+       return 0;
+      }
+
 // Execute this request in an asynchronous fashion
 //
    XrdPosixXrootd::Pwrite(fd, (const void *)aiop->sfsAio.aio_buf,
@@ -45,6 +45,7 @@
 #include "XrdNet/XrdNetSecurity.hh"
 
 #include "XrdPss/XrdPss.hh"
+#include "XrdPss/XrdPssStream.hh"
 #include "XrdPss/XrdPssTrace.hh"
 #include "XrdPss/XrdPssUrlInfo.hh"
 #include "XrdPss/XrdPssUtils.hh"
@@ -242,9 +243,16 @@ int XrdPssSys::Configure(const char *cfn, XrdOucEnv *envP)
        psxConfig->xLfn2Pfn = false;
       }
 
-// If we have a cache, indicate so in the feature set
+// If we have a cache, indicate so in the feature set. Streaming is pointless
+// when a cache sits in front of the origin.
 //
-   if(psxConfig->hasCache()) myFeatures |= XRDOSS_HASCACH;
+   if(psxConfig->hasCache())
+     {myFeatures |= XRDOSS_HASCACH;
+      if (XrdPssStream::rdBlocks || XrdPssStream::wrBlocks)
+         {eDest.Say("Config warning: ignoring 'pss.stream'; a cache is in use!");
+          XrdPssStream::rdBlocks = XrdPssStream::wrBlocks = 0;
+         }
+     }
 
 // If we need to reproxy, then open the directory where the reproxy information
 // will ne placed. The path is in the Env.
@@ -517,6 +525,7 @@ int XrdPssSys::ConfigXeq(char *var, XrdOucStream &Config)
    TS_Xeq("permit",        xperm);
    TS_Xeq("persona",       xpers);
    TS_PSX("setopt",        ParseSet);
+   TS_Xeq("stream",        xstrm);
    TS_PSX("trace",         ParseTrace);
 
    if (!strcmp("reproxy", var))
@@ -967,3 +976,89 @@ int XrdPssSys::xpers(XrdSysError *Eroute, XrdOucStream &Config)
 //
     return 0;
 }
+
+/******************************************************************************/
+/*                                 x s t r m                                  */
+/******************************************************************************/
+
+/* Function: xstrm
+
+   Purpose:  To parse the directive: stream {off | [readahead <n>]
+                                                    [writebehind <n>]
+                                                    [blocksize <bsz>]
+                                                    [maxmem <msz>]}
+
+             off       turns off streaming I/O (the default).
+             <n>       the number of blocks per file to use for read-ahead or
+                       write-behind. A value of 0 turns off that function.
+                       The default for each is 4.
+             <bsz>     the size of each block (default 1m).
+             <msz>     the maximum amount of memory all files together may
+                       use for blocks (default 1g). A value of 0 removes
+                       the limit.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdPssSys::xstrm(XrdSysError *Eroute, XrdOucStream &Config)
+{
+   char *val;
+   long long bsz, msz = 1024LL*1024*1024;
+   int rdN = 4, wrN = 4;
+
+// Check for off
+//
+   if ((val = Config.GetWord()) && !strcmp(val, "off"))
+      {XrdPssStream::rdBlocks = XrdPssStream::wrBlocks = 0;
+       return 0;
+      }
+
+// Process the options
+//
+   while(val)
+        {     if (!strcmp(val, "readahead"))
+                 {if (!(val = Config.GetWord()))
+                     {Eroute->Emsg("Config","stream readahead not specified");
+                      return 1;
+                     }
+                  if (XrdOuca2x::a2i(*Eroute,"stream readahead",val,&rdN,0,64))
+                     return 1;
+                 }
+         else if (!strcmp(val, "writebehind"))
+                 {if (!(val = Config.GetWord()))
+                     {Eroute->Emsg("Config","stream writebehind not specified");
+                      return 1;
+                     }
+                  if (XrdOuca2x::a2i(*Eroute,"stream writebehind",val,&wrN,0,64))
+                     return 1;
+                 }
+         else if (!strcmp(val, "blocksize"))
+                 {if (!(val = Config.GetWord()))
+                     {Eroute->Emsg("Config","stream blocksize not specified");
+                      return 1;
+                     }
+                  if (XrdOuca2x::a2sz(*Eroute,"stream blocksize",val,&bsz,
+                                      64*1024, 64*1024*1024)) return 1;
+                  XrdPssStream::blkSize = static_cast<int>(bsz);
+                 }
+         else if (!strcmp(val, "maxmem"))
+                 {if (!(val = Config.GetWord()))
+                     {Eroute->Emsg("Config","stream maxmem not specified");
+                      return 1;
+                     }
+                  if (XrdOuca2x::a2sz(*Eroute,"stream maxmem",val,&msz,0))
+                     return 1;
+                 }
+         else {Eroute->Emsg("Config", "Invalid stream option -", val);
+               return 1;
+              }
+         val = Config.GetWord();
+        }
+
+// Set the values
+//
+   XrdPssStream::rdBlocks = rdN;
+   XrdPssStream::wrBlocks = wrN;
+   XrdPssStream::maxMem   = msz;
+   return 0;
+}
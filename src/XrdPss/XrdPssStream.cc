@@ -0,0 +1,401 @@
+/******************************************************************************/
+/*                                                                            */
+/*                       X r d P s s S t r e a m . c c                        */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+#include "XrdPosix/XrdPosixXrootd.hh"
+#include "XrdPss/XrdPssStream.hh"
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+class XrdPssStream::Block : public XrdPosixCallBackIO
+{
+public:
+
+void    Complete(ssize_t Result) override {strmP->Done(this, Result);}
+
+        Block(XrdPssStream *sP, char *bP)
+             : strmP(sP), buff(bP), offset(-1), result(0), length(0),
+               inFlight(false) {}
+
+virtual ~Block() {free(buff); memUsed -= blkSize;}
+
+XrdPssStream *strmP;
+char         *buff;
+off_t         offset;   // -1 when the block holds nothing useful
+ssize_t       result;   // Bytes transferred or -errno
+int           length;   // Bytes requested or buffered
+bool          inFlight;
+};
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+int XrdPssStream::rdBlocks = 0;
+int XrdPssStream::wrBlocks = 0;
+int XrdPssStream::blkSize  = 1024*1024;
+
+long long                XrdPssStream::maxMem  = 1024LL*1024*1024;
+std::atomic<long long>   XrdPssStream::memUsed{0};
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdPssStream::XrdPssStream(int fdnum, bool isRW)
+                          : strmCV(0), fillP(0), nextOff(0), raOff(0),
+                            eofOff(0x7fffffffffffffffLL), fd(fdnum),
+                            inFlight(0), wrErr(0), isWrite(isRW)
+{
+   blkVec.reserve(isRW ? wrBlocks : rdBlocks);
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdPssStream::~XrdPssStream()
+{
+// We cannot free any buffer that is still being used by an I/O request
+//
+   strmCV.Lock();
+   while(inFlight) strmCV.Wait();
+   strmCV.UnLock();
+
+   for (auto bP : blkVec) delete bP;
+}
+
+/******************************************************************************/
+/*                                 D r a i n                                  */
+/******************************************************************************/
+
+int XrdPssStream::Drain()
+{
+   int rc;
+
+// Read-ahead data never needs to be drained
+//
+   if (!isWrite) return 0;
+
+// Write out whatever is buffered and wait for all writes to complete
+//
+   strmCV.Lock();
+   if (fillP) {if (fillP->length) Flush(); else fillP = 0;}
+   while(inFlight) strmCV.Wait();
+   rc = wrErr;
+   strmCV.UnLock();
+   return -rc;
+}
+
+/******************************************************************************/
+/* Private:                         D o n e                                   */
+/******************************************************************************/
+
+void XrdPssStream::Done(Block *bP, ssize_t result)
+{
+   strmCV.Lock();
+
+// For writes, record the first error and release the block. For reads, a
+// short read tells us where the file ends.
+//
+   if (isWrite)
+      {if (!wrErr && result != bP->length) wrErr = (result < 0 ? -result : EIO);
+       bP->offset = -1;
+       bP->length = 0;
+      } else {
+       if (result >= 0 && result < bP->length && bP->offset + result < eofOff)
+          eofOff = bP->offset + result;
+      }
+
+// Indicate this block is no longer busy and wakeup anyone waiting for it
+//
+   bP->result   = result;
+   bP->inFlight = false;
+   inFlight--;
+   strmCV.Broadcast();
+   strmCV.UnLock();
+}
+
+/******************************************************************************/
+/* Private:                         F i n d                                   */
+/******************************************************************************/
+
+// Caller must hold the strmCV lock.
+//
+XrdPssStream::Block *XrdPssStream::Find(off_t offset)
+{
+   for (auto bP : blkVec)
+       {if (bP->offset >= 0 && offset >= bP->offset
+        &&  offset < bP->offset + bP->length) return bP;
+       }
+   return 0;
+}
+
+/******************************************************************************/
+/* Private:                        F l u s h                                  */
+/******************************************************************************/
+
+// Caller must hold the strmCV lock which is temporarily released. Writes that
+// overlap one being flushed must complete first so that data lands in order.
+//
+void XrdPssStream::Flush()
+{
+   Block *bP = fillP;
+
+   fillP = 0;
+   while(Overlaps(bP)) strmCV.Wait();
+   bP->inFlight = true;
+   inFlight++;
+
+   strmCV.UnLock();
+   XrdPosixXrootd::Pwrite(fd, bP->buff, bP->length, bP->offset, bP);
+   strmCV.Lock();
+}
+
+/******************************************************************************/
+/* Private:                      G e t F r e e                                */
+/******************************************************************************/
+
+// Caller must hold the strmCV lock. Read-ahead blocks that lie wholly before
+// the current position have been consumed and may be reused.
+//
+XrdPssStream::Block *XrdPssStream::GetFree()
+{
+   int maxBlocks = (isWrite ? wrBlocks : rdBlocks);
+   void *buff;
+
+// Look for an idle block
+//
+   for (auto bP : blkVec)
+       {if (bP->inFlight || bP == fillP) continue;
+        if (bP->offset < 0
+        || (!isWrite && bP->offset + bP->length <= nextOff)) return bP;
+       }
+
+// Allocate a new block if we have not reached our limit nor the global one
+//
+   if ((int)blkVec.size() >= maxBlocks) return 0;
+   if ((memUsed += blkSize) > maxMem && maxMem)
+      {memUsed -= blkSize;
+       return 0;
+      }
+   if (posix_memalign(&buff, sysconf(_SC_PAGESIZE), blkSize))
+      {memUsed -= blkSize;
+       return 0;
+      }
+   blkVec.push_back(new Block(this, (char *)buff));
+   return blkVec.back();
+}
+
+/******************************************************************************/
+/* Private:                     O v e r l a p s                               */
+/******************************************************************************/
+
+// Caller must hold the strmCV lock.
+//
+bool XrdPssStream::Overlaps(Block *bP)
+{
+   off_t bEnd = bP->offset + bP->length;
+
+   for (auto xP : blkVec)
+       {if (xP != bP && xP->inFlight && bP->offset < xP->offset + xP->length
+        &&  xP->offset < bEnd) return true;
+       }
+   return false;
+}
+
+/******************************************************************************/
+/*                                  R e a d                                   */
+/******************************************************************************/
+
+ssize_t XrdPssStream::Read(void *buff, off_t offset, size_t blen)
+{
+   std::vector<Block *> raVec;
+   char   *bP = (char *)buff;
+   size_t  done = 0;
+   ssize_t rc;
+   bool    atEOF = false, isSeq;
+
+// Writers must make sure their data is out before reading it back
+//
+   if (isWrite)
+      {strmCV.Lock();
+       if (fillP && fillP->length) Flush();
+       while(inFlight) strmCV.Wait();
+       strmCV.UnLock();
+       if ((rc = XrdPosixXrootd::Pread(fd, buff, blen, offset)) < 0)
+          return -errno;
+       return rc;
+      }
+
+// A read that does not continue where the previous one ended breaks the
+// sequential pattern and whatever was read ahead is likely useless.
+//
+   strmCV.Lock();
+   if (!(isSeq = (offset == nextOff))) Reset();
+   nextOff = offset + blen;
+
+// Copy out whatever the read-ahead window holds for this request
+//
+   while(done < blen)
+        {off_t  pos = offset + done;
+         Block *rbP = Find(pos);
+         if (!rbP) break;
+         if (rbP->inFlight)
+            {strmCV.Wait();
+             continue;
+            }
+         if (rbP->result < 0) {rbP->offset = -1; break;}
+         ssize_t avail = rbP->offset + rbP->result - pos;
+         if (avail <= 0) {atEOF = true; break;}
+         size_t n = (size_t)avail < blen - done ? (size_t)avail : blen - done;
+         memcpy(bP + done, rbP->buff + (pos - rbP->offset), n);
+         done += n;
+         if (rbP->result < rbP->length && (ssize_t)n == avail)
+            {atEOF = true; break;}
+        }
+
+// Keep the read-ahead window full for sequential readers unless we know we
+// are at the end of the file.
+//
+   if (isSeq && !atEOF) Schedule(raVec);
+   strmCV.UnLock();
+
+   for (auto raP : raVec)
+       XrdPosixXrootd::Pread(fd, raP->buff, raP->length, raP->offset, raP);
+
+// Read whatever we did not find in the window. This overlaps with any
+// read-ahead we just started.
+//
+   if (done < blen && !atEOF)
+      {if ((rc = XrdPosixXrootd::Pread(fd, bP+done, blen-done, offset+done)) < 0)
+          return -errno;
+       done += rc;
+      }
+   return done;
+}
+
+/******************************************************************************/
+/* Private:                        R e s e t                                  */
+/******************************************************************************/
+
+// Caller must hold the strmCV lock. Blocks with reads in flight are kept
+// as their data is still valid should a later read want it.
+//
+void XrdPssStream::Reset()
+{
+   for (auto bP : blkVec) if (!bP->inFlight) bP->offset = -1;
+   raOff = 0;
+}
+
+/******************************************************************************/
+/* Private:                     S c h e d u l e                               */
+/******************************************************************************/
+
+// Caller must hold the strmCV lock. The blocks placed in bVec must be read
+// after the lock is released.
+//
+void XrdPssStream::Schedule(std::vector<Block *> &bVec)
+{
+   Block *bP;
+
+   if (raOff < nextOff) raOff = nextOff;
+
+   while(raOff < eofOff && (bP = GetFree()))
+        {bP->offset   = raOff;
+         bP->length   = blkSize;
+         bP->result   = 0;
+         bP->inFlight = true;
+         inFlight++;
+         raOff += blkSize;
+         bVec.push_back(bP);
+        }
+}
+
+/******************************************************************************/
+/*                                 W r i t e                                  */
+/******************************************************************************/
+
+ssize_t XrdPssStream::Write(const void *buff, off_t offset, size_t blen)
+{
+   const char *bP = (const char *)buff;
+   size_t left = blen;
+   ssize_t rc;
+
+// Aggregate contiguous writes into blocks and write them out once full
+//
+   strmCV.Lock();
+   while(left)
+        {if (wrErr) break;
+         if (fillP && fillP->offset + fillP->length != offset)
+            {if (fillP->length) Flush();
+                else fillP = 0;
+             continue;
+            }
+         if (!fillP)
+            {if (!(fillP = GetFree()))
+                {if (inFlight) {strmCV.Wait(); continue;}
+                 break;
+                }
+             fillP->offset = offset;
+             fillP->length = 0;
+            }
+         size_t n = blkSize - fillP->length;
+         if (n > left) n = left;
+         memcpy(fillP->buff + fillP->length, bP, n);
+         fillP->length += n;
+         offset += n; bP += n; left -= n;
+         if (fillP->length >= blkSize) Flush();
+        }
+
+// Return any deferred error
+//
+   if (wrErr)
+      {rc = wrErr;
+       strmCV.UnLock();
+       return -rc;
+      }
+
+// If we could not get a buffer at all (nothing is in flight at this point)
+// write the remainder directly.
+//
+   strmCV.UnLock();
+   if (left)
+      {if ((rc = XrdPosixXrootd::Pwrite(fd, bP, left, offset)) < 0)
+          return -errno;
+      }
+   return blen;
+}
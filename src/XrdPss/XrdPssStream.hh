@@ -0,0 +1,142 @@
+#ifndef __XRDPSSSTREAM_HH__
+#define __XRDPSSSTREAM_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                       X r d P s s S t r e a m . h h                        */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <atomic>
+#include <sys/types.h>
+#include <vector>
+
+#include "XrdPosix/XrdPosixCallBack.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+//-----------------------------------------------------------------------------
+//! XrdPssStream implements streaming I/O for a proxied file. Files opened for
+//! reading get pipelined read-ahead into a bounded set of buffers once the
+//! access pattern is sequential. Files opened for writing get write-behind,
+//! where contiguous writes are aggregated into large buffers that are written
+//! asynchronously. Write errors are sticky and are reported by the next
+//! Write() or Drain(), the latter being used at sync and close time. No disk
+//! cache is involved; all buffers are released when the file is closed.
+//! Besides the per-file block limits, all streams together never hold more
+//! than maxMem bytes; once reached, I/O simply bypasses the buffers.
+//!
+//! Calls complete synchronously so aio requests on a streaming file are run
+//! inline by the caller. This normally only costs a memory copy as the I/O
+//! underneath is asynchronous; the caller blocks only when the read-ahead
+//! window misses or when all write-behind blocks are in flight.
+//-----------------------------------------------------------------------------
+
+class XrdPssStream
+{
+public:
+
+//-----------------------------------------------------------------------------
+//! Write any buffered data and wait for all outstanding writes to complete.
+//! This is a no-op for read-ahead streams.
+//!
+//! @return 0 upon success or -errno of the first failed deferred write.
+//-----------------------------------------------------------------------------
+
+int     Drain();
+
+//-----------------------------------------------------------------------------
+//! Indicate whether a stream should be used for a file.
+//!
+//! @param  isRW   - true if the file is open for writing.
+//!
+//! @return true if streaming is enabled for this kind of open.
+//-----------------------------------------------------------------------------
+
+static
+bool    Enabled(bool isRW) {return (isRW ? wrBlocks : rdBlocks) > 0;}
+
+//-----------------------------------------------------------------------------
+//! Read data, using the read-ahead window when access is sequential.
+//!
+//! @param  buff   - Address of the buffer in which to place the data.
+//! @param  offset - The offset at which to read.
+//! @param  blen   - The number of bytes to read.
+//!
+//! @return the number of bytes read upon success and -errno upon failure.
+//-----------------------------------------------------------------------------
+
+ssize_t Read(void *buff, off_t offset, size_t blen);
+
+//-----------------------------------------------------------------------------
+//! Write data through the write-behind buffers.
+//!
+//! @param  buff   - Address of the buffer holding the data.
+//! @param  offset - The offset at which to write.
+//! @param  blen   - The number of bytes to write.
+//!
+//! @return blen upon success and -errno upon failure.
+//-----------------------------------------------------------------------------
+
+ssize_t Write(const void *buff, off_t offset, size_t blen);
+
+//-----------------------------------------------------------------------------
+//! Configuration values (see pss.stream directive).
+//-----------------------------------------------------------------------------
+
+static int rdBlocks;   //!< Number of read-ahead blocks per file (0 -> off)
+static int wrBlocks;   //!< Number of write-behind blocks per file (0 -> off)
+static int blkSize;    //!< Size of each block
+static long long maxMem; //!< Bytes all streams may use for blocks (0 -> any)
+
+        XrdPssStream(int fdnum, bool isRW);
+       ~XrdPssStream();
+
+private:
+
+class Block;
+
+void    Done(Block *bP, ssize_t result);
+Block  *Find(off_t offset);
+void    Flush();
+Block  *GetFree();
+bool    Overlaps(Block *bP);
+void    Reset();
+void    Schedule(std::vector<Block *> &bVec);
+
+static std::atomic<long long> memUsed;
+
+XrdSysCondVar        strmCV;
+std::vector<Block *> blkVec;
+Block               *fillP;    // Write-behind block being filled
+off_t                nextOff;  // Offset expected next when sequential
+off_t                raOff;    // Offset of the next read-ahead
+off_t                eofOff;   // End of file if known
+int                  fd;
+int                  inFlight;
+int                  wrErr;
+bool                 isWrite;
+};
+#endif
@@ -86,7 +86,15 @@
            if the preread was triggered using 'maxiRead' then the pages are
            marked for single use only. This means that the moment data is
            delivered from the page, the page is recycled.
-    15. Invalid options silently force the use of the default.
+    15. The cache is split into independent partitions, each with its own
+        lock, page hash chains, LRU list, and preread queue. A page always
+        lives in the partition selected by its hash so lookups of different
+        pages rarely contend. The default is 16 partitions when isServer has
+        been specified and 4 otherwise; no partition has less than 64 pages.
+    16. When useHugePg is specified, the cache memory is allocated from the
+        huge page pool when one is configured. Otherwise, transparent huge
+        pages are requested for it, when the platform supports them.
+    17. Invalid options silently force the use of the default.
 */
 
 class XrdRmc
@@ -104,12 +112,12 @@ struct Parms
        int       MaxFiles;  //!< Maximum number of files    (default 256 or 8K)
        int       Options;   //!< Options as defined below   (default r/o cache)
        short     minPages;  //!< Minimum number of pages    (default 256)
-       short     Reserve1;  //!< Reserved for future use
+       short     Partitions;//!< Number of cache partitions (default 4 or 16)
        int       Reserve2;  //!< Reserved for future use
 
                  Parms() : CacheSize(104857600), PageSize(32768),
                            Max2Cache(0), MaxFiles(0), Options(0),
-                           minPages(0), Reserve1(0),  Reserve2(0) {}
+                           minPages(0), Partitions(0), Reserve2(0) {}
       };
 
 // Valid option values in Parms::Options
@@ -126,6 +134,9 @@ canPreRead   = 0x0040; //!< Enable pre-read operations (o/w ignored)
 static const int
 logStats     = 0x0080; //!< Display statistics upon detach
 
+static const int
+useHugePg    = 0x0100; //!< Back the cache memory with huge pages, if possible
+
 static const int
 Serialized   = 0x0004; //!< Caller ensures MRSW semantics
 
@@ -58,9 +58,10 @@ void *XrdRmcRealPRXeq(void *parg)
 XrdRmcReal::XrdRmcReal(int &rc, XrdRmc::Parms &ParmV,
                        XrdOucCacheIO::aprParms *aprP)
                 : XrdOucCache("rmc"),
-                  Slots(0), Slash(0), Base((char *)MAP_FAILED), Dbg(0), Lgs(0),
-                  AZero(0), Attached(0), prFirst(0), prLast(0),
-                  prReady(0), prStop(0), prNum(0)
+                  Parts(0), nParts(1), pSlots(0),
+                  Slots(0), Slash(0), Base((char *)MAP_FAILED), BaseSz(0),
+                  Dbg(0), Lgs(0), AZero(0), Attached(0),
+                  prReady(0), prStop(0), prNum(0), prHome(0)
 {
    size_t Bytes;
    int n, minPag, isServ = ParmV.Options & XrdRmc::isServer;
@@ -99,19 +100,51 @@ XrdRmcReal::XrdRmcReal(int &rc, XrdRmc::Parms &ParmV,
       else maxCache = ParmV.Max2Cache/SegSize*SegSize;
    SegFull = (Options & XrdRmc::isServer ? XrdRmcSlot::lenMask : SegSize);
 
-// Allocate the cache plus the cache hash table
+// Allocate the cache plus the cache hash table. When huge pages are wanted
+// try the reserved pool first and fall back to transparent huge pages.
 //
    Bytes = static_cast<size_t>(SegSize)*SegCnt;
-   Base = (char *)mmap(0, Bytes + SegCnt*sizeof(int), PROT_READ|PROT_WRITE,
-                       MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
-   if (Base == MAP_FAILED) {rc = errno; return;}
+   BaseSz = Bytes + SegCnt*sizeof(int);
+#ifdef MAP_HUGETLB
+   if (Options & XrdRmc::useHugePg)
+      {size_t hpSz = (BaseSz + hpAlign - 1) & ~(hpAlign - 1);
+       Base = (char *)mmap(0, hpSz, PROT_READ|PROT_WRITE,
+                           MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+       if (Base != MAP_FAILED) BaseSz = hpSz;
+      }
+#endif
+   if (Base == MAP_FAILED)
+      {Base = (char *)mmap(0, BaseSz, PROT_READ|PROT_WRITE,
+                           MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+       if (Base == MAP_FAILED) {rc = errno; return;}
+#ifdef MADV_HUGEPAGE
+       if (Options & XrdRmc::useHugePg) madvise(Base, BaseSz, MADV_HUGEPAGE);
+#endif
+      }
    Slash = (int *)(Base + Bytes); HNum = SegCnt/2*2-1;
 
+// Establish the number of partitions. Each one must have a reasonable number
+// of pages so that a hot partition does not thrash.
+//
+   if (ParmV.Partitions > 0) nParts = ParmV.Partitions;
+      else nParts = (isServ ? 16 : 4);
+   if (nParts > maxParts) nParts = maxParts;
+   if (SegCnt/nParts < minPPag)
+      nParts = (SegCnt/minPPag > 0 ? static_cast<int>(SegCnt/minPPag) : 1);
+   pSlots = SegCnt/nParts;
+   if (!(Parts = new rmcPart[nParts])) return;
+
 // Now allocate the actual slots. We add additional slots to map files. These
 // do not have any memory backing but serve as anchors for memory mappings.
+// The first slot of every partition is the anchor for its LRU list. The first
+// partition's anchor is slot 0 whose page holds the file hash table.
 //
    if (!(Slots = new XrdRmcSlot[SegCnt+maxFiles])) return;
-   XrdRmcSlot::Init(Slots, SegCnt);
+   for (n = 0; n < nParts; n++)
+       {int pEnd = (n == nParts-1 ? SegCnt : (n+1)*pSlots);
+        Parts[n].Anchor = n*pSlots;
+        XrdRmcSlot::Init(Slots, n*pSlots, pEnd);
+       }
 
 // Set pointers to be able to keep track of CacheIO objects and map them to
 // CacheData objects. The hash table will be the first page of slot memory.
@@ -176,14 +209,15 @@ XrdRmcReal::~XrdRmcReal()
        prMutex.Lock();
       }
 
-// Delete the slots
+// Delete the slots and the partitions
 //
-   delete Slots; Slots = 0;
+   delete [] Slots; Slots = 0;
+   delete [] Parts; Parts = 0;
 
 // Unmap cache memory and associated hash table
 //
    if (Base != MAP_FAILED)
-      {munmap(Base, static_cast<size_t>(SegSize)*SegCnt);
+      {munmap(Base, BaseSz);
        Base = (char *)(MAP_FAILED);
       }
 
@@ -257,7 +291,9 @@ int XrdRmcReal::Detach(XrdOucCacheIO *ioP)
    if (!sNum || sNum > 1) return 0;
 
 // We will be deleting the CramData object. So, we need to recycle its slots.
+// Its pages may be in any partition so we need to hold all of them.
 //
+   LockAll();
    oP = &Slots[Fnum];
    while(oP->Own.Next != Fnum)
         {sP = &Slots[oP->Own.Next];
@@ -265,10 +301,11 @@ int XrdRmcReal::Detach(XrdOucCacheIO *ioP)
          if (sP->Contents < 0 || sP->Status.LRU.Next < 0) Faults++;
             else {sP->Hide(Slots, Slash, sP->Contents%HNum);
                   sP->Pull(Slots);
-                  sP->unRef(Slots);
+                  sP->unRef(Slots, pSlot(sP-Slots).Anchor);
                   Free++;
                  }
         }
+   UnLockAll();
 
 // Reduce attach count and check if the cache is being deleted
 //
@@ -308,7 +345,8 @@ void XrdRmcReal::eMsg(const char *Path, const char *What, long long xOff,
   
 char *XrdRmcReal::Get(XrdOucCacheIO *ioP, long long lAddr, int &rAmt, int &noIO)
 {
-   XrdSysMutexHelper Monitor(CMutex);
+   rmcPart &Part = pAddr(lAddr);
+   XrdSysMutexHelper Monitor(Part.Mutex);
    XrdRmcSlot::ioQ *Waiter;
    XrdRmcSlot *sP;
    int nUse, Fnum, Slot, segHash = lAddr%HNum;
@@ -326,7 +364,7 @@ char *XrdRmcReal::Get(XrdOucCacheIO *ioP, long long lAddr, int &rAmt, int &noIO)
            XrdRmcSlot::ioQ ioTrans(sP->Status.waitQ, &ioSem);
            sP->Status.waitQ = &ioTrans;
            if (Dbg > 1) std::cerr <<"Cache: Wait slot " <<Slot <<std::endl;
-           CMutex.UnLock(); ioSem.Wait(); CMutex.Lock();
+           Part.Mutex.UnLock(); ioSem.Wait(); Part.Mutex.Lock();
            if (sP->Contents != lAddr) {rAmt = -EIO; return 0;}
           } else {
             if (sP->Status.inUse < 0) sP->Status.inUse--;
@@ -341,16 +379,19 @@ char *XrdRmcReal::Get(XrdOucCacheIO *ioP, long long lAddr, int &rAmt, int &noIO)
       }
 
 // Page is not here. If no allocation wanted or we cannot obtain a free slot
-// return and indicate there is no associated cache page.
+// from this partition, return and indicate there is no associated cache page.
 //
-   if (!ioP || !(Slot = Slots[Slots->Status.LRU.Next].Pull(Slots)))
+   if (!ioP || (Slot = Slots[Part.Anchor].Status.LRU.Next) == Part.Anchor)
       {rAmt = -ENOMEM; return 0;}
+   Slots[Slot].Pull(Slots);
 
-// Remove ownership over this slot and remove it from the hash table
+// Remove ownership over this slot and remove it from the hash table. The hash
+// chain belongs to this partition as the slot's contents always hash to it.
 //
    sP = &Slots[Slot];
    if (sP->Contents >= 0)
-      {if (sP->Own.Next != Slot) sP->Owner(Slots);
+      {if (sP->Own.Next != Slot)
+          {OMutex.Lock(); sP->Owner(Slots); OMutex.UnLock();}
        sP->Hide(Slots, Slash, sP->Contents%HNum);
       }
 
@@ -358,10 +399,10 @@ char *XrdRmcReal::Get(XrdOucCacheIO *ioP, long long lAddr, int &rAmt, int &noIO)
 //
    sP->Count |= XrdRmcSlot::inTrans;
    sP->Status.waitQ = 0;
-   CMutex.UnLock();
+   Part.Mutex.UnLock();
    cBuff = Base+(static_cast<long long>(Slot)*SegSize);
    rAmt = ioP->Read(cBuff, (lAddr & Strip) << SegShft, SegSize);
-   CMutex.Lock();
+   Part.Mutex.Lock();
 
 // Post anybody waiting for this slot. We hold the cache lock which will give us
 // time to complete the slot definition before the waiting thread looks at it.
@@ -381,7 +422,9 @@ char *XrdRmcReal::Get(XrdOucCacheIO *ioP, long long lAddr, int &rAmt, int &noIO)
        sP->HLink      = Slash[segHash];
        Slash[segHash] = Slot;
        Fnum = (lAddr >> Shift) + SegCnt;
+       OMutex.Lock();
        Slots[Fnum].Owner(Slots, sP);
+       OMutex.UnLock();
        sP->Count = (rAmt == SegSize ? SegFull : rAmt|XrdRmcSlot::isShort);
        sP->Status.inUse = nUse;
        if (Dbg > 2) std::cerr <<"Cache: Miss slot " <<Slot <<" sz "
@@ -390,7 +433,7 @@ char *XrdRmcReal::Get(XrdOucCacheIO *ioP, long long lAddr, int &rAmt, int &noIO)
        eMsg(ioP->Path(), "reading", (lAddr & Strip) << SegShft, SegSize, rAmt);
        cBuff = 0;
        sP->Contents = -1;
-       sP->unRef(Slots);
+       sP->unRef(Slots, Part.Anchor);
       }
 
 // Return the associated buffer or zero, as per above
@@ -456,19 +499,25 @@ int XrdRmcReal::ioDel(XrdOucCacheIO *KeyVal, int &iNum)
 void XrdRmcReal::PreRead()
 {
    prTask *prP;
+   int pHome;
+
+// Pick the partition whose queue we look at first
+//
+   prMutex.Lock();
+   pHome = prHome++ % nParts;
+   prMutex.UnLock();
 
-// Simply wait and dispatch elements
+// Simply wait and dispatch elements. Each posting corresponds to a queued
+// request or to the stop request, which is only honored once queues are empty.
 //
    if (Dbg) std::cerr <<"Cache: preread thread started; now " <<prNum <<std::endl;
    while(1)
         {prReady.Wait();
-         prMutex.Lock();
-         if (prStop) break;
-         if ((prP = prFirst))
-            {if (!(prFirst = prP->Next)) prLast = 0;
-             prMutex.UnLock();
-             prP->Data->Preread();
-            } else prMutex.UnLock();
+         if ((prP = prGet(pHome))) prP->Data->Preread();
+            else {prMutex.Lock();
+                  if (prStop) break;
+                  prMutex.UnLock();
+                 }
         }
 
 // The cache is being deleted, wind down the prereads
@@ -484,18 +533,46 @@ void XrdRmcReal::PreRead()
 
 void XrdRmcReal::PreRead(XrdRmcReal::prTask *prReq)
 {
+   union {short sV[4]; XrdRmcData *pV;} Key = {{0,0,0,0}};
+   Key.pV = prReq->Data;
+   rmcPart &Part = Parts[((Key.sV[0]^Key.sV[1]^Key.sV[2]^Key.sV[3])&0x7fff)%nParts];
 
-// Place this element on the queue
+// Place this element on the queue of the partition the file hashes to
 //
-   prMutex.Lock();
-   if (prLast) {prLast->Next = prReq; prLast = prReq;}
-      else      prLast = prFirst = prReq;
+   Part.prMutex.Lock();
+   if (Part.prLast) {Part.prLast->Next = prReq; Part.prLast = prReq;}
+      else           Part.prLast = Part.prFirst = prReq;
    prReq->Next = 0;
+   Part.prMutex.UnLock();
 
 // Tell a pre-reader that something is ready
 //
    prReady.Post();
-   prMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                                 p r G e t                                  */
+/******************************************************************************/
+
+XrdRmcReal::prTask *XrdRmcReal::prGet(int pHome)
+{
+   prTask *prP;
+   int i, pNum = pHome;
+
+// Take the first request starting with our home partition
+//
+   for (i = 0; i < nParts; i++)
+       {rmcPart &Part = Parts[pNum];
+        Part.prMutex.Lock();
+        if ((prP = Part.prFirst))
+           {if (!(Part.prFirst = prP->Next)) Part.prLast = 0;
+            Part.prMutex.UnLock();
+            return prP;
+           }
+        Part.prMutex.UnLock();
+        if (++pNum >= nParts) pNum = 0;
+       }
+   return 0;
 }
 
 /******************************************************************************/
@@ -504,12 +581,14 @@ void XrdRmcReal::PreRead(XrdRmcReal::prTask *prReq)
   
 int XrdRmcReal::Ref(char *Addr, int rAmt, int sFlags)
 {
-    XrdRmcSlot *sP = &Slots[(Addr-Base)>>SegShft];
+    int Slot = (Addr-Base)>>SegShft;
+    XrdRmcSlot *sP = &Slots[Slot];
+    rmcPart &Part = pSlot(Slot);
     int eof = 0;
 
 // Indicate how much data was not yet referenced
 //
-   CMutex.Lock();
+   Part.Mutex.Lock();
    if (sP->Contents >= 0)
       {if (sP->Count < 0) eof = 1;
        sP->Status.inUse++;
@@ -517,11 +596,12 @@ int XrdRmcReal::Ref(char *Addr, int rAmt, int sFlags)
           {if (sFlags) sP->Count |= sFlags;
               else if (!eof && (sP->Count -= rAmt) < 0) sP->Count = 0;
           } else {
-           if (sFlags) {sP->Count |= sFlags;                 sP->reRef(Slots);}
+           if (sFlags) {sP->Count |= sFlags;       sP->reRef(Slots, Part.Anchor);}
               else {     if (sP->Count & XrdRmcSlot::isSUSE)
-                                                             sP->unRef(Slots);
-                    else if (eof || (sP->Count -= rAmt) > 0) sP->reRef(Slots);
-                    else   {sP->Count = SegSize/2;           sP->unRef(Slots);}
+                                                   sP->unRef(Slots, Part.Anchor);
+                    else if (eof || (sP->Count -= rAmt) > 0)
+                                                   sP->reRef(Slots, Part.Anchor);
+                    else   {sP->Count = SegSize/2; sP->unRef(Slots, Part.Anchor);}
                    }
           }
       } else eof = 1;
@@ -532,7 +612,7 @@ int XrdRmcReal::Ref(char *Addr, int rAmt, int sFlags)
                      << " slot " <<((Addr-Base)>>SegShft)
                      <<" sz " <<(sP->Count & XrdRmcSlot::lenMask)
                      <<" uc " <<sP->Status.inUse <<std::endl;
-   CMutex.UnLock();
+   Part.Mutex.UnLock();
    return !eof;
 }
 
@@ -548,6 +628,7 @@ void XrdRmcReal::Trunc(XrdOucCacheIO *ioP, long long lAddr)
 
 // We will be truncating CacheData pages. So, we need to recycle those slots.
 //
+   LockAll();
    oP = &Slots[Fnum]; sP = &Slots[oP->Own.Next];
    while(oP != sP)
         {sNum = sP->Own.Next;
@@ -555,11 +636,12 @@ void XrdRmcReal::Trunc(XrdOucCacheIO *ioP, long long lAddr)
             else {sP->Owner(Slots);
                   sP->Hide(Slots, Slash, sP->Contents%HNum);
                   sP->Pull(Slots);
-                  sP->unRef(Slots);
+                  sP->unRef(Slots, pSlot(sP-Slots).Anchor);
                   Free++;
                  }
          sP = &Slots[sNum];
         }
+   UnLockAll();
 
 // Issue debugging message
 //
@@ -574,11 +656,13 @@ void XrdRmcReal::Trunc(XrdOucCacheIO *ioP, long long lAddr)
   
 void XrdRmcReal::Upd(char *Addr, int wLen, int wOff)
 {
-    XrdRmcSlot *sP = &Slots[(Addr-Base)>>SegShft];
+    int Slot = (Addr-Base)>>SegShft;
+    XrdRmcSlot *sP = &Slots[Slot];
+    rmcPart &Part = pSlot(Slot);
 
 // Check if we extended a short page
 //
-   CMutex.Lock();
+   Part.Mutex.Lock();
    if (sP->Count < 0)
       {int theLen = sP->Count & XrdRmcSlot::lenMask;
        if (wLen + wOff > theLen)
@@ -588,7 +672,7 @@ void XrdRmcReal::Upd(char *Addr, int wLen, int wOff)
 // Adjust the reference counter and if no references, place on the LRU chain
 //
    sP->Status.inUse++;
-   if (sP->Status.inUse >= 0) sP->reRef(Slots);
+   if (sP->Status.inUse >= 0) sP->reRef(Slots, Part.Anchor);
 
 // All done
 //
@@ -596,5 +680,5 @@ void XrdRmcReal::Upd(char *Addr, int wLen, int wOff)
                      << " slot " <<((Addr-Base)>>SegShft)
                      <<" sz " <<(sP->Count & XrdRmcSlot::lenMask)
                      <<" uc " <<sP->Status.inUse <<std::endl;
-   CMutex.UnLock();
+   Part.Mutex.UnLock();
 }
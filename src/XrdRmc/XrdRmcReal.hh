@@ -36,9 +36,12 @@
 
 /* This class defines an actual implementation of an XrdOucCache object. */
 
+class XrdRmcTests;
+
 class XrdRmcReal : public XrdOucCache
 {
 friend class XrdRmcData;
+friend class ::XrdRmcTests;
 public:
 
 XrdOucCacheIO *Attach(XrdOucCacheIO *ioP, int Options=0);
@@ -79,16 +82,53 @@ int       Ref(char *Addr, int rAmt, int sFlags=0);
 void      Trunc(XrdOucCacheIO *ioP, long long lAddr);
 void      Upd(char *Addr, int wAmt, int wOff);
 
+// Each partition owns a contiguous range of slots, the hash chains whose
+// index maps to it, an LRU list anchored at its first slot, and a queue of
+// preread requests. Locks are always taken as CMutex, then partitions in
+// ascending order, then OMutex.
+//
+struct prTask;
+
+struct alignas(64) rmcPart
+      {XrdSysMutex      Mutex;       // Serializes the partition's slots
+       int              Anchor;      // Slot number of the LRU anchor
+       prTask          *prFirst;     // Preread queue
+       prTask          *prLast;
+       XrdSysMutex      prMutex;     // Serializes the preread queue
+
+                        rmcPart() : Anchor(0), prFirst(0), prLast(0) {}
+      };
+
+inline
+rmcPart  &pAddr(long long lAddr) {return Parts[(lAddr%HNum)%nParts];}
+
+inline
+rmcPart  &pSlot(int Slot)
+               {int pN = Slot/pSlots;
+                return Parts[(pN < nParts ? pN : nParts-1)];
+               }
+
+void      LockAll()   {for (int i = 0;        i < nParts; i++) Parts[i].Mutex.Lock();}
+void      UnLockAll() {for (int i = nParts-1; i >= 0;     i--) Parts[i].Mutex.UnLock();}
+
 static const long long Shift = 48;
 static const long long Strip = 0x00000000ffffffffLL;  //
 static const long long MaxFO = 0x000007ffffffffffLL;  // Min 4K page -> 8TB-1
+static const size_t    hpAlign = 2*1024*1024;          // Huge page alignment
+static const int       maxParts = 256;                 // Maximum partitions
+static const int       minPPag  = 64;                  // Min pages/partition
 
 XrdOucCacheIO::aprParms aprDefault; // Default automatic preread
 
-XrdSysMutex      CMutex;
+XrdSysMutex      CMutex;      // Serializes attach, detach, and the file table
+XrdSysMutex      OMutex;      // Serializes the per-file ownership chains
+rmcPart         *Parts;       // Cache partitions
+int              nParts;      // Number of partitions
+int              pSlots;      // Slots per partition (last one may have more)
 XrdRmcSlot     *Slots;       // 1-to-1 slot to memory map
 int             *Slash;       // Slot hash table
 char            *Base;        // Base of memory cache
+size_t           BaseSz;      // Bytes mapped at Base
 long long        HNum;
 long long        SegCnt;
 long long        SegSize;
@@ -124,11 +164,11 @@ struct prTask
        XrdRmcData *Data;
       };
 void             PreRead(XrdRmcReal::prTask *prReq);
-prTask          *prFirst;
-prTask          *prLast;
-XrdSysMutex      prMutex;
+prTask          *prGet(int pHome);
+XrdSysMutex      prMutex;     // Serializes preread thread start and stop
 XrdSysSemaphore  prReady;
 XrdSysSemaphore *prStop;
 int              prNum;
+int              prHome;      // Next partition to assign to a prereader
 };
 #endif
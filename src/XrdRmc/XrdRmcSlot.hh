@@ -60,14 +60,17 @@ inline void       Hide(XrdRmcSlot *Base, int *hTab, int hI)
                        Count = 0; Contents = -1;
                       }
 
-static void       Init(XrdRmcSlot *Base, int Num)
-                     {int i;
-                      Base->Status.LRU.Next = Base->Status.LRU.Prev = 0;
-                      Base->Own.Next        = Base->Own.Prev = 0;
-                      for (i = 1; i < Num; i++)
+static void       Init(XrdRmcSlot *Base, int Num) {Init(Base, 0, Num);}
+
+static void       Init(XrdRmcSlot *Base, int Beg, int End)
+                     {XrdRmcSlot *aP = &Base[Beg];
+                      int i;
+                      aP->Status.LRU.Next = aP->Status.LRU.Prev = Beg;
+                      aP->Own.Next        = aP->Own.Prev = Beg;
+                      for (i = Beg+1; i < End; i++)
                           {Base[i].Status.LRU.Next = Base[i].Status.LRU.Prev = i;
                            Base[i].Own.Next = Base[i].Own.Prev = i;
-                           Base->Push(Base, &Base[i]);
+                           aP->Push(Base, &Base[i]);
                           }
                      }
 
@@ -99,18 +102,20 @@ inline void       Owner(XrdRmcSlot *Base, XrdRmcSlot *sP)
                        Base[Own.Prev].Own.Next = UrNum; Own.Prev = UrNum;
                       }
 
-inline void       reRef(XrdRmcSlot *Base)
-                      {      Status.LRU.Prev           = Base->Status.LRU.Prev;
+inline void       reRef(XrdRmcSlot *Base, int Anchor=0)
+                      {XrdRmcSlot *aP = &Base[Anchor];
+                             Status.LRU.Prev           = aP->Status.LRU.Prev;
                        Base[ Status.LRU.Prev].Status.LRU.Next = this-Base;
-                       Base->Status.LRU.Prev           = this-Base;
-                             Status.LRU.Next           = 0;
+                       aP->  Status.LRU.Prev           = this-Base;
+                             Status.LRU.Next           = Anchor;
                       }
 
-inline void       unRef(XrdRmcSlot *Base)
-                      {      Status.LRU.Next           = Base->Status.LRU.Next;
+inline void       unRef(XrdRmcSlot *Base, int Anchor=0)
+                      {XrdRmcSlot *aP = &Base[Anchor];
+                             Status.LRU.Next           = aP->Status.LRU.Next;
                        Base [Status.LRU.Next].Status.LRU.Prev = this-Base;
-                       Base->Status.LRU.Next           = this-Base;
-                             Status.LRU.Prev           = 0;
+                       aP->  Status.LRU.Next           = this-Base;
+                             Status.LRU.Prev           = Anchor;
                       }
 
 struct SlotList
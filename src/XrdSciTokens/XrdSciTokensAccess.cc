@@ -1,11 +1,13 @@
 
 #include "XrdAcc/XrdAccAuthorize.hh"
+#include "XrdAcc/XrdAccTokenCache.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucGatherConf.hh"
 #include "XrdOuc/XrdOucPrivateUtils.hh"
 #include "XrdSec/XrdSecEntity.hh"
 #include "XrdSec/XrdSecEntityAttr.hh"
 #include "XrdSys/XrdSysLogger.hh"
+#include "XrdSys/XrdSysPthread.hh"
 #include "XrdTls/XrdTlsContext.hh"
 #include "XrdVersion.hh"
 
@@ -406,7 +408,7 @@ public:
       return false;
     }
 
-    bool expired() const {return monotonic_time() > m_expiry_time;}
+    uint64_t expiry() const {return m_expiry_time;}
 
     void parse(const AccessRulesRaw &rules) {
         m_rules.reserve(rules.size());
@@ -486,9 +488,9 @@ class XrdAccSciTokens : public XrdAccAuthorize, public XrdSciTokensHelper,
 
 public:
     XrdAccSciTokens(XrdSysLogger *lp, const char *parms, XrdAccAuthorize* chain, XrdOucEnv *envP) :
+        m_map(m_max_tokens),
         m_chain(chain),
         m_parms(parms ? parms : ""),
-        m_next_clean(monotonic_time() + m_expiry_secs),
         m_log(lp, "scitokens_")
     {
         pthread_rwlock_init(&m_config_lock, nullptr);
@@ -497,9 +499,27 @@ public:
         if (!Config(envP)) {
             throw std::runtime_error("Failed to configure SciTokens authorization.");
         }
+            // Cache cleaning, reconfiguration and key refreshes are done by a
+            // background thread so that requests never wait on them.
+        int rc;
+        if ((rc = XrdSysThread::Run(&m_maintain_tid, Maintain, static_cast<void *>(this),
+                                    XRDSYSTHREAD_HOLD, "SciTokens maintenance"))) {
+            m_log.Emsg("Config", rc, "start SciTokens maintenance thread");
+            throw std::runtime_error("Failed to start SciTokens maintenance thread.");
+        }
+        m_maintain_started = true;
     }
 
     virtual ~XrdAccSciTokens() {
+            // The maintenance thread uses this object; stop it before
+            // anything is torn down.
+        if (m_maintain_started) {
+            m_maintain_cv.Lock();
+            m_maintain_stop = true;
+            m_maintain_cv.Signal();
+            m_maintain_cv.UnLock();
+            XrdSysThread::Join(m_maintain_tid, nullptr);
+        }
         if (m_config_lock_initialized) {
             pthread_rwlock_destroy(&m_config_lock);
         }
@@ -529,16 +549,8 @@ public:
             return OnMissing(Entity, path, oper, env);
         }
         m_log.Log(LogMask::Debug, "Access", "Trying token-based access control");
-        std::shared_ptr<XrdAccRules> access_rules;
         uint64_t now = monotonic_time();
-        Check(now);
-        {
-            std::lock_guard<std::mutex> guard(m_map_mutex);
-            const auto iter = m_map.find(authz);
-            if (iter != m_map.end() && !iter->second->expired()) {
-                access_rules = iter->second;
-            }
-        }
+        std::shared_ptr<XrdAccRules> access_rules = m_map.Find(authz, now);
         if (!access_rules) {
             m_log.Log(LogMask::Debug, "Access", "Token not found in recent cache; parsing.");
             try {
@@ -564,8 +576,7 @@ public:
                 m_log.Log(LogMask::Warning, "Access", "Error generating ACLs for authorization", exc.what());
                 return OnMissing(Entity, path, oper, env);
             }
-            std::lock_guard<std::mutex> guard(m_map_mutex);
-            m_map[authz] = access_rules;
+            m_map.Add(authz, access_rules, access_rules->expiry(), now);
         } else if (m_log.getMsgMask() & LogMask::Debug) {
             m_log.Log(LogMask::Debug, "Access", "Cached token", access_rules->str().c_str());
         }
@@ -1403,48 +1414,76 @@ private:
         return true;
     }
 
-    void Check(uint64_t now)
+    static void *Maintain(void *arg)
     {
-        // Bail out if another thread is already checking
-        std::unique_lock<std::mutex> lock(m_check_mutex, std::try_to_lock);
-        if (!lock.owns_lock()) {return;}
+        auto me = static_cast<XrdAccSciTokens *>(arg);
+        uint64_t next_refresh = monotonic_time() + m_refresh_secs;
+
+        me->m_maintain_cv.Lock();
+        while (!me->m_maintain_stop) {
+            me->m_maintain_cv.Wait(static_cast<int>(m_expiry_secs));
+            if (me->m_maintain_stop) break;
+            me->m_maintain_cv.UnLock();
+
+            uint64_t now = monotonic_time();
+            me->m_map.Purge(now);
+            me->Reconfig();
+            if (now >= next_refresh) {
+                me->RefreshKeys();
+                next_refresh = now + m_refresh_secs;
+            }
+            me->m_maintain_cv.Lock();
+        }
+        me->m_maintain_cv.UnLock();
+        return nullptr;
+    }
 
-        // Check if cleaning is required
-        if (now <= m_next_clean) {return;}
+    // Fetch the signing keys of each issuer ahead of the key cache's own
+    // update time; otherwise the first request after that time would wait
+    // on the issuer while the keys are downloaded.
+    void RefreshKeys()
+    {
+#ifdef HAVE_KEYCACHE_REFRESH_JWKS
+        std::vector<std::string> urls;
+        pthread_rwlock_rdlock(&m_config_lock);
+        for (const auto &issuer : m_issuers) {
+            urls.push_back(issuer.second.m_url);
+        }
+        pthread_rwlock_unlock(&m_config_lock);
 
-        // Clean expired m_map entries
-        {
-            std::lock_guard<std::mutex> guard(m_map_mutex);
-            for (auto iter = m_map.begin(); iter != m_map.end(); ) {
-                if (iter->second->expired()) {
-                    iter = m_map.erase(iter);
-                } else {
-                    ++iter;
-                }
+        for (const auto &url : urls) {
+            char *err_msg = nullptr;
+            if (keycache_refresh_jwks(url.c_str(), &err_msg)) {
+                m_log.Log(LogMask::Warning, "RefreshKeys", "Failed to refresh keys for", url.c_str(),
+                          err_msg ? err_msg : "unknown error");
+                free(err_msg);
+            } else {
+                m_log.Log(LogMask::Debug, "RefreshKeys", "Refreshed keys for", url.c_str());
             }
         }
-        Reconfig();
-
-        m_next_clean = monotonic_time() + m_expiry_secs;
+#endif
     }
 
     bool m_config_lock_initialized{false};
     pthread_rwlock_t m_config_lock;
+    XrdSysCondVar m_maintain_cv{0};     // Wakes the maintenance thread to stop
+    bool m_maintain_stop{false};        // Protected by m_maintain_cv
+    bool m_maintain_started{false};
+    pthread_t m_maintain_tid;
     std::vector<std::string> m_audiences;
     std::vector<const char *> m_audiences_array;
-    std::map<std::string, std::shared_ptr<XrdAccRules>> m_map;
-    std::mutex m_check_mutex;
-    std::mutex m_map_mutex;
+    XrdAccTokenCache<XrdAccRules> m_map;
     XrdAccAuthorize* m_chain;
     const std::string m_parms;
     std::vector<const char*> m_valid_issuers_array;
     std::unordered_map<std::string, IssuerConfig> m_issuers;
-    uint64_t m_next_clean{0};
     XrdSysError m_log;
     AuthzBehavior m_authz_behavior{AuthzBehavior::PASSTHROUGH};
     std::string m_cfg_file;
 
     static constexpr uint64_t m_expiry_secs = 60;
+    static constexpr uint64_t m_refresh_secs = 300;
+    static constexpr int m_max_tokens = 65536;
 };
 
 void InitAccSciTokens(XrdSysLogger *lp, const char *cfn, const char *parm,
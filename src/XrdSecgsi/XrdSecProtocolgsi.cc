@@ -170,6 +170,7 @@ XrdSecgsiAuthzKey_t XrdSecProtocolgsi::AuthzKey = 0;
 int    XrdSecProtocolgsi::AuthzCertFmt = -1;
 int    XrdSecProtocolgsi::GMAPCacheTimeOut = -1;
 int    XrdSecProtocolgsi::AuthzCacheTimeOut = 43200;  // 12h, default
+int    XrdSecProtocolgsi::VfyCacheTimeOut = 300;
 String XrdSecProtocolgsi::SrvAllowedNames;
 int    XrdSecProtocolgsi::VOMSAttrOpt = vatIgnore; // Was '1' or extract
 XrdSecgsiAuthz_t XrdSecProtocolgsi::VOMSFun = 0;
@@ -192,6 +193,9 @@ XrdSutCache  XrdSecProtocolgsi::cacheCert(8,13); // Server certificates info cac
 XrdSutCache  XrdSecProtocolgsi::cachePxy(8,13);  // Client proxies cache (Fibonacci-based sizes)
 XrdSutCache  XrdSecProtocolgsi::cacheGMAPFun; // Entries mapped by GMAPFun (default size 144)
 XrdSutCache  XrdSecProtocolgsi::cacheAuthzFun; // Entities filled by AuthzFun (default size 144)
+XrdSutCache  XrdSecProtocolgsi::cacheVfy; // Chain verification outcomes (default size 144)
+time_t       XrdSecProtocolgsi::lastVfyTrim = 0;
+XrdSysMutex  XrdSecProtocolgsi::mutexVfy;  // Mutex to control cacheVfy trims
 //
 // Services
 XrdOucGMap *XrdSecProtocolgsi::servGMap = 0; // Grid map service
@@ -831,6 +835,12 @@ char *XrdSecProtocolgsi::Init(gsiOptions opt, XrdOucErrInfo *erp)
          GMAPCacheTimeOut = opt.gmapto;
          DEBUG("grid-map cache entries expire after "<<GMAPCacheTimeOut<<" secs");
       }
+      //
+      // Expiration of chain verification cache entries (0 disables caching)
+      if (opt.vfyto >= 0) {
+         VfyCacheTimeOut = opt.vfyto;
+         DEBUG("chain verification cache entries expire after "<<VfyCacheTimeOut<<" secs");
+      }
 
       //
       // Request for proxy export for authorization
@@ -2325,6 +2335,7 @@ void gsiOptions::Print(XrdOucTrace *t)
       POPTS(t, " GRIDmap file: " << (gridmap ? gridmap : XrdSecProtocolgsi::GMAPFile));
       POPTS(t, " GRIDmap option: "<< getOptName(gmoOpts,ogmap));
       POPTS(t, " GRIDmap cache entries expiration (secs): "<< gmapto);
+      POPTS(t, " Chain verification cache entries expiration (secs): "<< vfyto);
       if (gmapfun) {
          POPTS(t, " DN mapping function: " << gmapfun);
          if (gmapfunparms) POPTS(t, " DN mapping function parms: " << gmapfunparms);
@@ -2599,6 +2610,7 @@ char *XrdSecProtocolgsiInit(const char mode,
       //              [-authzfunparms:<authz_function_init_parameters>]
       //              [-authzto:<authz_cache_entry_validity_in_secs>]
       //              [-gmapto:<grid_map_cache_entry_validity_in_secs>]
+      //              [-vfyto:<chain_verification_cache_entry_validity_in_secs>]
       //              [-gmapopt:<grid_map_check_option>]
       //              [-dlgpxy:<proxy_req_option>]
       //              [-exppxy:<filetemplate>]
@@ -2632,6 +2644,7 @@ char *XrdSecProtocolgsiInit(const char mode,
       int ogmap = 1;
       int gmapto = 600;
       int authzto = -1;
+      int vfyto = 300;
       int authzcall = 1;
       int dlgpxy = dlgIgnore;
       int authzpxy = 0;
@@ -2686,6 +2699,8 @@ char *XrdSecProtocolgsiInit(const char mode,
                authzto = atoi(op+9);
             } else if (!strncmp(op, "-gmapto:",8)) {
                gmapto = atoi(op+8);
+            } else if (!strncmp(op, "-vfyto:",7)) {
+               vfyto = atoi(op+7);
             } else if (!strncmp(op, "-dlgpxy:",8)) {
                opts.dlgpxy = getOptVal(sDlgOpts, op+8);
             } else if (!strncmp(op, "-exppxy:",8)) {
@@ -2739,6 +2754,7 @@ char *XrdSecProtocolgsiInit(const char mode,
       opts.gmapto = gmapto;
       opts.authzcall = authzcall;
       opts.authzto = authzto;
+      opts.vfyto = vfyto;
       opts.dlgpxy = (dlgpxy >= dlgIgnore && dlgpxy <= dlgReqSign) ? dlgpxy : 0;
       opts.authzpxy = authzpxy;
       opts.vomsat = vomsat;
@@ -3858,13 +3874,7 @@ int XrdSecProtocolgsi::ServerDoCert(XrdSutBuffer *br,  XrdSutBuffer **bm,
    }
    //
    // Verify the chain
-   x509ChainVerifyOpt_t vopt = {0,static_cast<int>(hs->TimeStamp),-1,hs->Crl};
-   XrdCryptoX509Chain::EX509ChainErr ecode = XrdCryptoX509Chain::kNone;
-   if (!(hs->Chain->Verify(ecode, &vopt))) {
-      cmsg = "certificate chain verification failed: ";
-      cmsg += hs->Chain->LastError();
-      return -1;
-   }
+   if (!VerifyChain(bck, cmsg)) return -1;
 
    //
    // Extract the client public key from the certificate
@@ -4620,6 +4630,122 @@ bool XrdSecProtocolgsi::VerifyCA(int opt, X509Chain *cca, XrdCryptoFactory *CF)
    return verified;
 }
 
+//_____________________________________________________________________________
+static bool VerifyChainCheck(XrdSutCacheEntry *e, void *a) {
+
+   time_t ts_ref = (time_t)(*((XrdSutCacheArg_t *)a)).arg1;
+
+   if (e && e->status == kCE_ok) {
+      // Entries are good until the stored expiration time
+      if (e->mtime > ts_ref) return true;
+      e->status = kCE_expired;
+   }
+   return false;
+}
+
+//_____________________________________________________________________________
+static bool VerifyChainTrim(XrdSutCacheEntry *e, void *a) {
+
+   time_t ts_ref = (time_t)(*((XrdSutCacheArg_t *)a)).arg1;
+
+   return (e->status != kCE_ok || e->mtime <= ts_ref);
+}
+
+//_____________________________________________________________________________
+bool XrdSecProtocolgsi::VerifyChain(XrdSutBucket *bck, String &emsg)
+{
+   // Verify hs->Chain, completed with the content of bucket 'bck'.
+   // Handshakes presenting the same certificates against the same CA and CRL
+   // share the outcome of a successful verification for VfyCacheTimeOut
+   // seconds, capped by the earliest expiration in the chain.
+   // Return true if the chain is valid, false otherwise with emsg filled.
+   EPNAME("VerifyChain");
+
+   x509ChainVerifyOpt_t vopt = {0,static_cast<int>(hs->TimeStamp),-1,hs->Crl};
+   XrdCryptoX509Chain::EX509ChainErr ecode = XrdCryptoX509Chain::kNone;
+   time_t now = hs->TimeStamp;
+
+   //
+   // The tag is the digest of the presented certificates plus the identity
+   // of the CA and, if any, of the CRL they are checked against
+   XrdCryptoMsgDigest *md = 0;
+   if (VfyCacheTimeOut > 0 && hs->Chain->Begin())
+      md = sessionCF->MsgDigest("sha256");
+   if (!md || md->Update(bck->buffer, bck->size) || md->Final()) {
+      delete md;
+      if (!(hs->Chain->Verify(ecode, &vopt))) {
+         emsg = "certificate chain verification failed: ";
+         emsg += hs->Chain->LastError();
+         return false;
+      }
+      return true;
+   }
+   String tag = md->AsHexString();
+   delete md;
+   tag += ':'; tag += hs->Chain->Begin()->SubjectHash();
+   if (hs->Crl) { tag += ':'; tag += (int) hs->Crl->LastUpdate(); }
+
+   //
+   // Look for a still valid outcome
+   XrdSutCERef ceref;
+   bool rdlock = false;
+   XrdSutCacheArg_t arg = {now, 0, 0, 0};
+   XrdSutCacheEntry *cent = cacheVfy.Get(tag.c_str(), rdlock, VerifyChainCheck, (void *) &arg);
+   if (!cent) {
+      emsg = "unable to get cache entry for chain verification";
+      return false;
+   }
+   ceref.Set(&(cent->rwmtx));
+
+   if (rdlock) {
+      // Verified already: we still need the chain in order, which also sets
+      // the end-entity name and hash as a full verification would
+      ceref.UnLock();
+      if (hs->Chain->Reorder() != 0) {
+         emsg = "certificate chain verification failed: inconsistent chain";
+         return false;
+      }
+      DEBUG("chain verification outcome found in cache");
+      return true;
+   }
+
+   //
+   // Full verification
+   if (!(hs->Chain->Verify(ecode, &vopt))) {
+      cent->status = kCE_inactive;
+      ceref.UnLock();
+      emsg = "certificate chain verification failed: ";
+      emsg += hs->Chain->LastError();
+      return false;
+   }
+
+   //
+   // Record the outcome
+   time_t expire = now + VfyCacheTimeOut;
+   XrdCryptoX509 *xc = hs->Chain->Begin();
+   while (xc) {
+      if (xc->NotAfter() < expire) expire = xc->NotAfter();
+      xc = hs->Chain->Next();
+   }
+   cent->status = kCE_ok;
+   cent->mtime = expire;
+   cent->cnt = 0;
+   ceref.UnLock();
+
+   //
+   // Bound the cache by dropping outdated entries once in a while
+   if (mutexVfy.CondLock()) {
+      if (now - lastVfyTrim > VfyCacheTimeOut) {
+         lastVfyTrim = now;
+         int ntrim = cacheVfy.Trim(VerifyChainTrim, (void *) &arg);
+         DEBUG("trimmed "<<ntrim<<" chain verification cache entries");
+      }
+      mutexVfy.UnLock();
+   }
+
+   return true;
+}
+
 //_____________________________________________________________________________
 static bool GetCACheck(XrdSutCacheEntry *e, void *a) {
 
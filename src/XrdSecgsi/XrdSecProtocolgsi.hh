@@ -197,6 +197,7 @@ public:
    char  *authzfunparms;// [s] parameters for the function to fill entities [0]
    int    authzcall; // [s] when to call authz function [1 -> always]
    int    authzto; // [s] validity in secs of authz cache entries [-1 => unlimited]
+   int    vfyto;  // [s] validity in secs of chain verification cache entries [300 s]
    int    ogmap;  // [s] gridmap file checking option
    int    dlgpxy; // [c] explicitely ask the creation of a delegated proxy; default 0
                   // [s] ask client for proxies; default: do not accept delegated proxies
@@ -221,7 +222,7 @@ public:
                   proxy = 0; valid = 0; deplen = 0; bits = XrdCryptoDefRSABits;
                   gridmap = 0; gmapto = 600;
                   gmapfun = 0; gmapfunparms = 0; authzfun = 0; authzfunparms = 0;
-                  authzto = -1; authzcall = 1;
+                  authzto = -1; authzcall = 1; vfyto = 300;
                   ogmap = 1; dlgpxy = 0; sigpxy = 1; srvnames = 0;
                   exppxy = 0; authzpxy = 0;
                   vomsat = 1; vomsfun = 0; vomsfunparms = 0; moninfo = 0;
@@ -350,6 +351,7 @@ private:
    static XrdSecgsiAuthzKey_t AuthzKey; 
    static int              AuthzCertFmt; 
    static int              AuthzCacheTimeOut;
+   static int              VfyCacheTimeOut;
    static int              PxyReqOpts;
    static int              AuthzPxyWhat;
    static int              AuthzPxyWhere;
@@ -376,6 +378,9 @@ private:
    static XrdSutCache   cachePxy;  // Client proxies cache; 
    static XrdSutCache   cacheGMAPFun; // Cache for entries mapped by GMAPFun
    static XrdSutCache   cacheAuthzFun; // Cache for entities filled by AuthzFun
+   static XrdSutCache   cacheVfy;  // Outcome of client chain verifications
+   static time_t        lastVfyTrim; // time of last trim of cacheVfy
+   static XrdSysMutex   mutexVfy;    // mutex to control cacheVfy trims
    //
    // Services
    static XrdOucGMap      *servGMap;  // Grid mapping service 
@@ -448,6 +453,7 @@ private:
    static bool    VerifyCA(int opt, X509Chain *cca, XrdCryptoFactory *cf);
    static int     VerifyCRL(XrdCryptoX509Crl *crl, XrdCryptoX509 *xca, XrdOucString crldir,
                            XrdCryptoFactory *CF, int hashalg);
+   bool           VerifyChain(XrdSutBucket *bck, String &emsg);
    bool           ServerCertNameOK(const char *subject, const char *hname, String &e);
    static XrdSutCacheEntry *GetSrvCertEnt(XrdSutCERef   &gcref,
                                        XrdCryptoFactory *cf,
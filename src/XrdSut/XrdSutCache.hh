@@ -46,10 +46,23 @@ typedef struct {
    long long arg4;
 } XrdSutCacheArg_t;
 
+extern unsigned long XrdOucHashVal(const char *KeyVal);
+
+//
+// The table is split in shards, each protected by its own read/write lock,
+// so that lookups of different tags do not serialize and lookups of existing
+// tags (the common case) do not exclude each other. A shard is write-locked
+// only to add or remove entries.
+//
 class XrdSutCache {
 public:
-   XrdSutCache(int psize = 89, int size = 144, int load = 80) : table(psize, size, load) {}
-   virtual ~XrdSutCache() {}
+   XrdSutCache(int psize = 89, int size = 144, int load = 80) {
+      for (int i = 0; i < kShards; i++)
+         shards[i].table = new XrdOucHash<XrdSutCacheEntry>(psize, size, load);
+   }
+   virtual ~XrdSutCache() {
+      for (int i = 0; i < kShards; i++) delete shards[i].table;
+   }
 
    XrdSutCacheEntry *Get(const char *tag) {
       // Get the entry with 'tag'.
@@ -58,12 +71,13 @@ public:
       // Returns null if not found.
 
       XrdSutCacheEntry *cent = 0;
+      Shard &sh = GetShard(tag);
 
-      // Exclusive access to the table
-      XrdSysMutexHelper raii(mtx);
+      // Shared access to the shard
+      XrdSysRWLockHelper raii(sh.rwlk);
 
       // Look for an entry
-      if (!(cent = table.Find(tag))) {
+      if (!(cent = sh.table->Find(tag))) {
          // none found
          return cent;
       }
@@ -89,26 +103,81 @@ public:
       // The status of the lock is returned in rdlock (true if read-locked).
       rdlock = false;
       XrdSutCacheEntry *cent = 0;
+      Shard &sh = GetShard(tag);
 
-      // Exclusive access to the table
-      XrdSysMutexHelper raii(mtx);
+      // Look for an existing entry with shared access to the shard
+      {  XrdSysRWLockHelper raii(sh.rwlk);
+         if ((cent = sh.table->Find(tag)))
+            return Lock(cent, rdlock, condition, arg);
+      }
 
-      // Look for an entry
-      if (!(cent = table.Find(tag))) {
-         // If none, create a new one and write-lock for validation
-         cent = new XrdSutCacheEntry(tag);
-         int status = 0;
-         cent->rwmtx.WriteLock( status );
-         if (status) {
-            // A problem occurred: delete the entry and fail
-            delete cent;
-            return (XrdSutCacheEntry *)0;
-         }
-         // Register it in the table
-         table.Add(tag, cent);
-         return cent;
+      // Exclusive access to the shard to add a new one; recheck as someone
+      // else may have added it in the meantime
+      XrdSysRWLockHelper raii(sh.rwlk, false);
+      if ((cent = sh.table->Find(tag)))
+         return Lock(cent, rdlock, condition, arg);
+
+      // If none, create a new one and write-lock for validation
+      cent = new XrdSutCacheEntry(tag);
+      int status = 0;
+      cent->rwmtx.WriteLock( status );
+      if (status) {
+         // A problem occurred: delete the entry and fail
+         delete cent;
+         return (XrdSutCacheEntry *)0;
       }
+      // Register it in the table
+      sh.table->Add(tag, cent);
+      return cent;
+   }
 
+   inline int Num() {
+      int n = 0;
+      for (int i = 0; i < kShards; i++) {
+         XrdSysRWLockHelper raii(shards[i].rwlk);
+         n += shards[i].table->Num();
+      }
+      return n;
+   }
+
+   inline void Reset() {
+      for (int i = 0; i < kShards; i++) {
+         XrdSysRWLockHelper raii(shards[i].rwlk, false);
+         shards[i].table->Purge();
+      }
+   }
+
+   int Trim(XrdSutCacheGet_t condition, void *arg = 0) {
+      // Remove the entries for which condition, applied with arguments 'arg',
+      // returns true. Entries currently referenced by someone are skipped.
+      // Returns the number of entries removed.
+      TrimArg targ = {condition, arg, 0};
+      for (int i = 0; i < kShards; i++) {
+         XrdSysRWLockHelper raii(shards[i].rwlk, false);
+         shards[i].table->Apply(TrimOne, (void *) &targ);
+      }
+      return targ.ntrim;
+   }
+
+private:
+   static const int kShards = 16;
+
+   struct Shard {
+      XrdSysRWLock                  rwlk;  // Protect access to table
+      XrdOucHash<XrdSutCacheEntry> *table; // table with content
+   };
+
+   struct TrimArg {
+      XrdSutCacheGet_t condition;
+      void            *arg;
+      int              ntrim;
+   };
+
+   Shard &GetShard(const char *tag) {
+      return shards[XrdOucHashVal(tag) % kShards];
+   }
+
+   XrdSutCacheEntry *Lock(XrdSutCacheEntry *cent, bool &rdlock, XrdSutCacheGet_t condition, void *arg) {
       // We found an existing entry:
       // lock until we get the ability to read (another thread may be valudating it)
       int status = 0;
@@ -143,12 +212,19 @@ public:
       return cent;
    }
 
-   inline int Num() { return table.Num(); }
-   inline void Reset() { return table.Purge(); }
+   static int TrimOne(const char *, XrdSutCacheEntry *cent, void *a) {
+      // The shard is write-locked so nobody can find the entry; if we can
+      // write-lock it nobody is holding it either and it can go
+      TrimArg *targ = (TrimArg *) a;
+      if (!cent->rwmtx.CondWriteLock()) return 0;
+      bool trim = (*(targ->condition))(cent, targ->arg);
+      cent->rwmtx.UnLock();
+      if (!trim) return 0;
+      targ->ntrim++;
+      return -1;
+   }
 
-private:
-   XrdSysRecMutex         mtx;  // Protect access to table
-   XrdOucHash<XrdSutCacheEntry> table; // table with content
+   Shard shards[kShards];
 };
 
 #endif
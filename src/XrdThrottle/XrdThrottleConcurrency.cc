@@ -0,0 +1,73 @@
+/******************************************************************************/
+/*                                                                            */
+/* (c) 2026 by the Morgridge Institute for Research                           */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include "XrdThrottle/XrdThrottleConcurrency.hh"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace XrdThrottle;
+
+ConcurrencyController::ConcurrencyController(int min_limit, int max_limit, int initial_limit)
+    : m_min_limit(std::max(1, min_limit)),
+      m_max_limit(std::max(std::max(1, min_limit), max_limit)),
+      m_limit(std::min(std::max(initial_limit, m_min_limit), m_max_limit))
+{
+}
+
+int
+ConcurrencyController::Update(unsigned long ops, double io_time_secs, int active_ops)
+{
+    // Too little activity to say anything about the storage; keep the limit.
+    if (ops < m_min_samples || io_time_secs <= 0) {
+        return GetLimit();
+    }
+
+    m_latency = io_time_secs / static_cast<double>(ops);
+    if (m_baseline == 0) {
+        m_baseline = m_latency;
+    } else {
+        m_baseline = (1 - m_baseline_alpha) * m_baseline + m_baseline_alpha * m_latency;
+    }
+
+    // If the load does not reach the limit, there is no evidence the limit
+    // is too low; do not let it grow without bound while idle.
+    if (active_ops < m_limit / 2) {
+        return GetLimit();
+    }
+
+    // If the latency recovers below the long-term average, pull the average
+    // down faster so a past overload is not taken as the normal latency.
+    if (m_latency < m_baseline) {
+        m_baseline = m_latency;
+    }
+
+    double gradient = std::max(0.5, std::min(1.0, m_tolerance * m_baseline / m_latency));
+    double new_limit = m_limit * gradient + std::sqrt(m_limit);
+    new_limit = (1 - m_smoothing) * m_limit + m_smoothing * new_limit;
+    m_limit = std::min(std::max(new_limit, static_cast<double>(m_min_limit)),
+                       static_cast<double>(m_max_limit));
+    return GetLimit();
+}
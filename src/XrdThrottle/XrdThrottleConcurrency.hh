@@ -0,0 +1,92 @@
+/******************************************************************************/
+/*                                                                            */
+/* (c) 2026 by the Morgridge Institute for Research                           */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#ifndef XrdThrottle_Concurrency_hh
+#define XrdThrottle_Concurrency_hh
+
+/*
+ * Adaptive concurrency limit for the throttle manager.
+ *
+ * Every recompute interval, the throttle manager reports the number of IO
+ * operations started and the total time spent in IO during the interval.
+ * By Little's law, their ratio is the average latency of an operation.
+ * The controller compares the latency in the last interval against a
+ * slowly-moving long-term average:
+ *
+ * - If the latency is near the long-term average, the storage is not
+ *   saturated and the limit grows (by roughly the square root of the limit
+ *   per interval).
+ * - If the latency increases, requests are queueing inside the storage and
+ *   the limit is reduced in proportion.
+ *
+ * This is a "gradient" algorithm, similar to TCP Vegas: the limit converges
+ * to the concurrency that maximizes throughput without inflating latency,
+ * which differs between disk types and changes with the workload.
+ */
+
+namespace XrdThrottle {
+
+class ConcurrencyController {
+public:
+    ConcurrencyController(int min_limit, int max_limit, int initial_limit);
+
+    // Update the limit given the activity in the last interval.
+    //
+    // - ops: number of IO operations during the interval.
+    // - io_time_secs: total time spent in IO operations during the interval.
+    // - active_ops: number of operations in progress at the end of the interval.
+    //
+    // Returns the new concurrency limit.
+    int Update(unsigned long ops, double io_time_secs, int active_ops);
+
+    int GetLimit() const {return static_cast<int>(m_limit);}
+
+    // The average IO latency in the last interval and the long-term
+    // average, in seconds; zero until enough samples have been seen.
+    double GetLatency() const {return m_latency;}
+    double GetBaselineLatency() const {return m_baseline;}
+
+    // Minimum number of operations in an interval for it to be considered.
+    static constexpr unsigned long m_min_samples = 10;
+
+private:
+    const int m_min_limit;
+    const int m_max_limit;
+    double m_limit;
+    double m_latency{0};
+    double m_baseline{0};
+
+    // Allowed ratio between the current and long-term latency before the
+    // limit is reduced.
+    static constexpr double m_tolerance = 1.5;
+    // Weight of the new latency in the long-term average.
+    static constexpr double m_baseline_alpha = 0.05;
+    // Weight of the new limit in the smoothed limit.
+    static constexpr double m_smoothing = 0.2;
+};
+
+} // namespace XrdThrottle
+
+#endif // XrdThrottle_Concurrency_hh
@@ -67,6 +67,7 @@ Configuration::Configure(const std::string &config_file)
         TS_Xeq("throttle.max_open_files", xmaxopen);
         TS_Xeq("throttle.max_active_connections", xmaxconn);
         TS_Xeq("throttle.throttle", xthrottle);
+        TS_Xeq("throttle.adaptive_concurrency", xadaptive);
         TS_Xeq("throttle.loadshed", xloadshed);
         TS_Xeq("throttle.max_wait_time", xmaxwait);
         TS_Xeq("throttle.trace", xtrace);
@@ -166,9 +167,12 @@ Configuration::xmaxwait(XrdOucStream &Config)
 /* Function: xthrottle
 
    Purpose:  To parse the directive: throttle [data <drate>] [iops <irate>] [concurrency <climit>] [interval <rint>]
+                                              [opcost <ocost>]
 
              <drate>    maximum bytes per second through the server.
              <irate>    maximum IOPS per second through the server.
+             <ocost>    bytes charged against <drate> for each IO operation,
+                        in addition to its size.
              <climit>   maximum number of concurrent IO connections.
              <rint>     minimum interval in milliseconds between throttle re-computing.
 
@@ -177,7 +181,7 @@ Configuration::xmaxwait(XrdOucStream &Config)
 int
 Configuration::xthrottle(XrdOucStream &Config)
 {
-    long long drate = -1, irate = -1, rint = 1000, climit = -1;
+    long long drate = -1, irate = -1, rint = 1000, climit = -1, ocost = 0;
     char *val;
 
     while ((val = Config.GetWord()))
@@ -200,6 +204,12 @@ Configuration::xthrottle(XrdOucStream &Config)
              {m_log.Emsg("Config", "recompute interval not specified (in ms)."); return 1;}
           if (XrdOuca2x::a2sp(m_log,"recompute interval value (in ms)",val,&rint,10)) return 1;
        }
+       else if (strcmp("opcost", val) == 0)
+       {
+          if (!(val = Config.GetWord()))
+             {m_log.Emsg("Config", "IO operation cost not specified."); return 1;}
+          if (XrdOuca2x::a2sz(m_log,"IO operation cost value",val,&ocost,0)) return 1;
+       }
        else if (strcmp("concurrency", val) == 0)
        {
           if (!(val = Config.GetWord()))
@@ -216,7 +226,57 @@ Configuration::xthrottle(XrdOucStream &Config)
     m_throttle_iops_rate = irate;
     m_throttle_concurrency_limit = climit;
     m_throttle_recompute_interval_ms = rint;
+    m_throttle_op_cost = ocost;
+
+    return 0;
+}
+
+/******************************************************************************/
+/*                            x a d a p t i v e                               */
+/******************************************************************************/
+
+/* Function: xadaptive
+
+   Purpose:  To parse the directive: adaptive_concurrency [min <cmin>] max <cmax>
+
+             <cmin>     lowest concurrency limit the controller may choose; defaults to 1.
+             <cmax>     highest concurrency limit the controller may choose.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+int
+Configuration::xadaptive(XrdOucStream &Config)
+{
+    long long cmin = 1, cmax = -1;
+    char *val;
+
+    while ((val = Config.GetWord()))
+    {
+       if (strcmp("min", val) == 0)
+       {
+          if (!(val = Config.GetWord()))
+             {m_log.Emsg("Config", "adaptive concurrency minimum not specified."); return 1;}
+          if (XrdOuca2x::a2sz(m_log,"adaptive concurrency minimum",val,&cmin,1)) return 1;
+       }
+       else if (strcmp("max", val) == 0)
+       {
+          if (!(val = Config.GetWord()))
+             {m_log.Emsg("Config", "adaptive concurrency maximum not specified."); return 1;}
+          if (XrdOuca2x::a2sz(m_log,"adaptive concurrency maximum",val,&cmax,1)) return 1;
+       }
+       else
+       {
+          m_log.Emsg("Config", "Warning - unknown adaptive_concurrency option specified", val, ".");
+       }
+    }
+
+    if (cmax < 0)
+       {m_log.Emsg("Config", "adaptive concurrency maximum not specified."); return 1;}
+    if (cmin > cmax)
+       {m_log.Emsg("Config", "adaptive concurrency minimum is above the maximum."); return 1;}
 
+    m_adaptive_min = cmin;
+    m_adaptive_max = cmax;
     return 0;
 }
 
@@ -88,6 +88,16 @@ public:
     // If -1, no limit is set.
     long long GetThrottleIOPSRate() const { return m_throttle_iops_rate; }
 
+    // Get the configuration for the number of bytes each I/O operation is
+    // charged against the data rate, in addition to its size.
+    // If not set, the default is 0.
+    long long GetThrottleOpCost() const { return m_throttle_op_cost; }
+
+    // Get the bounds for the adaptive concurrency limit.
+    // If the maximum is -1, the concurrency limit is not adaptive.
+    long long GetAdaptiveConcurrencyMin() const { return m_adaptive_min; }
+    long long GetAdaptiveConcurrencyMax() const { return m_adaptive_max; }
+
     // Get the configuration for the recompute interval, in milliseconds.
     // If not set, the default is 1000 ms.
     long long GetThrottleRecomputeIntervalMS() const { return m_throttle_recompute_interval_ms; }
@@ -101,6 +111,7 @@ public:
     const std::string &GetUserConfigFile() const { return m_user_config_file; }
 
 private:
+    int xadaptive(XrdOucStream &Config);
     int xloadshed(XrdOucStream &Config);
     int xmaxopen(XrdOucStream &Config);
     int xmaxconn(XrdOucStream &Config);
@@ -121,6 +132,9 @@ private:
     long long m_throttle_concurrency_limit{-1};
     long long m_throttle_data_rate{-1};
     long long m_throttle_iops_rate{-1};
+    long long m_throttle_op_cost{0};
+    long long m_adaptive_min{1};
+    long long m_adaptive_max{-1};
     long long m_throttle_recompute_interval_ms{1000};
     int m_trace_levels{0};
     std::string m_user_config_file;
@@ -1,5 +1,6 @@
 
 #include "XrdThrottleManager.hh"
+#include "XrdThrottleConcurrency.hh"
 
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdSec/XrdSecEntity.hh"
@@ -18,6 +19,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <limits>
 #include <random>
 #include <sstream>
 
@@ -55,6 +57,23 @@ XrdThrottleManager::XrdThrottleManager(XrdSysError *lP, XrdOucTrace *tP) :
    m_loadshed_port(0),
    m_loadshed_frequency(0)
 {
+   for (int i=0; i<m_max_users; i++)
+   {
+      m_user_weight[i] = 1.0;
+      m_user_group[i] = -1;
+   }
+}
+
+XrdThrottleManager::~XrdThrottleManager()
+{
+}
+
+void
+XrdThrottleManager::SetAdaptiveConcurrency(int min_limit, int max_limit)
+{
+   int initial = (m_concurrency_limit > 0) ? static_cast<int>(m_concurrency_limit) : max_limit;
+   m_adaptive.reset(new XrdThrottle::ConcurrencyController(min_limit, max_limit, initial));
+   m_concurrency_limit = m_adaptive->GetLimit();
 }
 
 void
@@ -72,6 +91,11 @@ XrdThrottleManager::FromConfig(XrdThrottle::Configuration &config)
        config.GetThrottleIOPSRate(),
        config.GetThrottleConcurrency(),
        static_cast<float>(config.GetThrottleRecomputeIntervalMS())/1000.0);
+    SetOpCost(config.GetThrottleOpCost());
+    if (config.GetAdaptiveConcurrencyMax() > 0)
+    {
+       SetAdaptiveConcurrency(config.GetAdaptiveConcurrencyMin(), config.GetAdaptiveConcurrencyMax());
+    }
 
     m_trace->What = config.GetTraceLevels();
 
@@ -105,6 +129,8 @@ XrdThrottleManager::Init()
    m_secondary_bytes_shares.resize(m_max_users);
    m_primary_ops_shares.resize(m_max_users);
    m_secondary_ops_shares.resize(m_max_users);
+   m_bytes_allocation.resize(m_max_users);
+   m_ops_allocation.resize(m_max_users);
    for (auto & waiter : m_waiter_info) {
       waiter.m_manager = this;
    }
@@ -116,6 +142,8 @@ XrdThrottleManager::Init()
       m_secondary_bytes_shares[i] = 0;
       m_primary_ops_shares[i] = 10;
       m_secondary_ops_shares[i] = 0;
+      m_bytes_allocation[i] = m_last_round_allocation;
+      m_ops_allocation[i] = 10;
    }
 
    int rc;
@@ -144,9 +172,45 @@ XrdThrottleManager::GetUserInfo(const XrdSecEntity *client) {
     }
     if (user.empty()) {user = client->name ? client->name : "nobody";}
     uint16_t uid = GetUid(user.c_str());
+
+    // Remember the fairshare weight for the user's slot.  If several users
+    // hash to the same slot, the most recent one wins.
+    SetUserWeight(uid, user);
     return std::make_tuple(user, uid);
 }
 
+/*
+ * Record the user now mapped to a slot and look up the slot's weight.  The
+ * lookup is done under m_user_name_mutex so that it cannot race with the
+ * refresh done when the per-user limits are reloaded.
+ */
+void
+XrdThrottleManager::SetUserWeight(uint16_t uid, const std::string &username)
+{
+    std::lock_guard<std::mutex> lock(m_user_name_mutex);
+    int group;
+    m_user_name[uid] = username;
+    m_user_weight[uid] = GetUserWeight(username, group);
+    m_user_group[uid] = group;
+}
+
+/*
+ * Look up the weight of every occupied slot again after the per-user
+ * limits have changed.
+ */
+void
+XrdThrottleManager::RefreshUserWeights()
+{
+    std::lock_guard<std::mutex> lock(m_user_name_mutex);
+    for (int i=0; i<m_max_users; i++)
+    {
+        if (m_user_name[i].empty()) continue;
+        int group;
+        m_user_weight[i] = GetUserWeight(m_user_name[i], group);
+        m_user_group[i] = group;
+    }
+}
+
 /*
  * Take as many shares as possible to fulfill the request; update
  * request with current remaining value, or zero if satisfied.
@@ -343,6 +407,16 @@ XrdThrottleManager::Apply(int reqsize, int reqops, int uid)
 {
    if (m_bytes_per_second < 0)
       reqsize = 0;
+   else if (m_op_cost_bytes > 0 && reqops > 0)
+   {
+      // Charge the fixed cost of each operation in 64 bits and clamp, as a
+      // large cost times the number of operations need not fit in an int.
+      const long long max_size = std::numeric_limits<int>::max();
+      long long charged = max_size;
+      if (m_op_cost_bytes <= (max_size - reqsize) / reqops)
+         charged = reqsize + m_op_cost_bytes * reqops;
+      reqsize = static_cast<int>(charged);
+   }
    if (m_ops_per_second < 0)
       reqops = 0;
    while (reqsize || reqops)
@@ -423,6 +497,7 @@ XrdThrottleManager::ComputeWaiterOrder()
 
     std::vector<double> share;
     share.resize(m_max_users);
+    std::vector<bool> waiting_user(m_max_users, false);
     size_t users_with_waiters = 0;
     // For each user, compute their current concurrency and determine how many waiting users
     // total there are.
@@ -454,6 +529,7 @@ XrdThrottleManager::ComputeWaiterOrder()
             if (share[i] == 0) {
                 share[i] = 0.1;
             }
+            waiting_user[i] = true;
             users_with_waiters++;
         }
         else
@@ -461,7 +537,18 @@ XrdThrottleManager::ComputeWaiterOrder()
             share[i] = 0;
         }
     }
-    auto fair_share = static_cast<double>(m_concurrency_limit) / static_cast<double>(users_with_waiters);
+    // Each waiting user's fair share of the concurrency limit is in proportion to its weight.
+    std::vector<double> fair_share;
+    ComputeWeights(waiting_user, fair_share);
+    double weight_sum = 0;
+    for (int idx = 0; idx < m_max_users; idx++)
+    {
+        if (waiting_user[idx]) weight_sum += fair_share[idx];
+    }
+    for (int idx = 0; idx < m_max_users; idx++)
+    {
+        fair_share[idx] = waiting_user[idx] ? static_cast<double>(m_concurrency_limit) * fair_share[idx] / weight_sum : 0;
+    }
     std::vector<uint16_t> waiter_order;
     waiter_order.resize(m_max_users);
 
@@ -472,7 +559,7 @@ XrdThrottleManager::ComputeWaiterOrder()
     for (int idx = 0; idx < m_max_users; idx++)
     {
         if (share[idx]) {
-            shares_sum += fair_share / share[idx];
+            shares_sum += fair_share[idx] / share[idx];
         }
     }
 
@@ -484,7 +571,7 @@ XrdThrottleManager::ComputeWaiterOrder()
     size_t offset = 0;
     for (int uid = 0; uid < m_max_users; uid++) {
         if (share[uid] > 0) {
-            auto shares = static_cast<unsigned>(scale_factor * fair_share / share[uid]) + 1;
+            auto shares = static_cast<unsigned>(scale_factor * fair_share[uid] / share[uid]) + 1;
             TRACE(DEBUG, "User " << uid << " has " << shares << " shares");
             for (unsigned idx = 0; idx < shares; idx++)
             {
@@ -616,37 +703,51 @@ XrdThrottleManager::RecomputeInternal()
    AtomicBeg(m_compute_var);
    float active_users = 0;
    long bytes_used = 0;
+   std::vector<bool> active(m_max_users, false);
    for (int i=0; i<m_max_users; i++)
    {
       int primary = AtomicFAZ(m_primary_bytes_shares[i]);
-      if (primary != m_last_round_allocation)
+      if (primary != m_bytes_allocation[i])
       {
          active_users++;
+         active[i] = true;
          if (primary >= 0)
             m_secondary_bytes_shares[i] = primary;
          primary = AtomicFAZ(m_primary_ops_shares[i]);
          if (primary >= 0)
              m_secondary_ops_shares[i] = primary;
-         bytes_used += (primary < 0) ? m_last_round_allocation : (m_last_round_allocation-primary);
+         bytes_used += (primary < 0) ? m_bytes_allocation[i] : (m_bytes_allocation[i]-primary);
       }
    }
 
-   if (active_users == 0)
+   // Split the shares in proportion to the weight of each active user.
+   // Note we also allocate shares to the inactive users, the share they
+   // would get at their weight, without counting them in the weight sum.
+   // If a new user becomes active in the next interval, we'll go over our
+   // bandwidth budget just a bit.
+   std::vector<double> weights;
+   ComputeWeights(active, weights);
+   double weight_sum = 0;
+   for (int i=0; i<m_max_users; i++)
+   {
+      if (active[i]) weight_sum += weights[i];
+   }
+   if (weight_sum <= 0)
    {
-      active_users++;
+      weight_sum = 1;
    }
 
-   // Note we allocate the same number of shares to *all* users, not
-   // just the active ones.  If a new user becomes active in the next
-   // interval, we'll go over our bandwidth budget just a bit.
-   m_last_round_allocation = static_cast<int>(total_bytes_shares / active_users);
-   int ops_shares = static_cast<int>(total_ops_shares / active_users);
-   TRACE(BANDWIDTH, "Round byte allocation " << m_last_round_allocation << " ; last round used " << bytes_used << ".");
-   TRACE(IOPS, "Round ops allocation " << ops_shares);
+   m_last_round_allocation = static_cast<int>(total_bytes_shares / weight_sum);
+   int ops_shares = static_cast<int>(total_ops_shares / weight_sum);
+   TRACE(BANDWIDTH, "Round byte allocation " << m_last_round_allocation << " per unit weight across "
+                    << active_users << " active users; last round used " << bytes_used << ".");
+   TRACE(IOPS, "Round ops allocation " << ops_shares << " per unit weight");
    for (int i=0; i<m_max_users; i++)
    {
-      m_primary_bytes_shares[i] = m_last_round_allocation;
-      m_primary_ops_shares[i] = ops_shares;
+      m_bytes_allocation[i] = static_cast<int>(total_bytes_shares * weights[i] / weight_sum);
+      m_ops_allocation[i] = static_cast<int>(total_ops_shares * weights[i] / weight_sum);
+      m_primary_bytes_shares[i] = m_bytes_allocation[i];
+      m_primary_ops_shares[i] = m_ops_allocation[i];
    }
 
    AtomicEnd(m_compute_var);
@@ -659,22 +760,47 @@ XrdThrottleManager::RecomputeInternal()
    m_compute_var.Lock();
    m_stable_io_active = m_io_active.load(std::memory_order_acquire);
    auto io_active = m_stable_io_active;
-   m_stable_io_total = m_io_total;
-   auto io_total = m_stable_io_total;
+   uint64_t io_total = m_io_total.load();
+   auto io_ops = io_total - m_stable_io_total;
+   m_stable_io_total = io_total;
    auto io_wait_rep = m_io_active_time.exchange(std::chrono::steady_clock::duration(0).count());
    m_stable_io_wait += std::chrono::steady_clock::duration(io_wait_rep);
 
    m_compute_var.UnLock();
 
+   // Let the adaptive controller, if any, pick the concurrency limit for the
+   // next interval based on the latency of the IO in this one.
+   if (m_adaptive)
+   {
+      std::chrono::duration<double> io_wait_secs = std::chrono::steady_clock::duration(io_wait_rep);
+      int old_limit = m_concurrency_limit;
+      auto new_limit = m_adaptive->Update(io_ops, io_wait_secs.count(), io_active);
+      m_concurrency_limit = new_limit;
+      TRACE(IOLOAD, "Adaptive concurrency limit " << old_limit << " -> " << new_limit << "; IO latency "
+                    << m_adaptive->GetLatency() << "s, baseline " << m_adaptive->GetBaselineLatency() << "s.");
+   }
+
    auto io_wait_ms = std::chrono::duration_cast<std::chrono::milliseconds>(m_stable_io_wait).count();
    TRACE(IOLOAD, "Current IO counter is " << io_active << "; total IO active time is " << io_wait_ms << "ms.");
    if (m_gstream)
    {
-        char buf[128];
-        auto len = snprintf(buf, 128,
-                            R"({"event":"throttle_update","io_wait":%.4f,"io_active":%d,"io_total":%llu})",
-                            static_cast<double>(io_wait_ms) / 1000.0, io_active, static_cast<long long unsigned>(io_total));
-        auto suc = (len < 128) ? m_gstream->Insert(buf, len + 1) : false;
+        char buf[256];
+        int len;
+        if (m_adaptive)
+        {
+           len = snprintf(buf, 256,
+                          R"({"event":"throttle_update","io_wait":%.4f,"io_active":%d,"io_total":%llu,)"
+                          R"("io_limit":%d,"io_latency":%.6f,"io_latency_base":%.6f})",
+                          static_cast<double>(io_wait_ms) / 1000.0, io_active, static_cast<long long unsigned>(io_total),
+                          static_cast<int>(m_concurrency_limit), m_adaptive->GetLatency(), m_adaptive->GetBaselineLatency());
+        }
+        else
+        {
+           len = snprintf(buf, 256,
+                          R"({"event":"throttle_update","io_wait":%.4f,"io_active":%d,"io_total":%llu})",
+                          static_cast<double>(io_wait_ms) / 1000.0, io_active, static_cast<long long unsigned>(io_total));
+        }
+        auto suc = (len < 256) ? m_gstream->Insert(buf, len + 1) : false;
         if (!suc)
         {
             TRACE(IOLOAD, "Failed g-stream insertion of throttle_update record (len=" << len << "): " << buf);
@@ -683,6 +809,38 @@ XrdThrottleManager::RecomputeInternal()
    m_compute_var.Broadcast();
 }
 
+/*
+ * Compute the effective weight of each user slot.  Users that are not part
+ * of a group use their own weight.  A group's weight is divided evenly among
+ * its active members; an inactive member is given the share it would get
+ * if it were to become active.
+ */
+void
+XrdThrottleManager::ComputeWeights(const std::vector<bool> &active, std::vector<double> &weights)
+{
+   std::unordered_map<int, unsigned> group_active;
+   for (int i=0; i<m_max_users; i++)
+   {
+      int group = m_user_group[i];
+      if (active[i] && group >= 0) group_active[group]++;
+   }
+
+   weights.resize(m_max_users);
+   for (int i=0; i<m_max_users; i++)
+   {
+      double weight = m_user_weight[i];
+      int group = m_user_group[i];
+      if (group >= 0)
+      {
+         auto iter = group_active.find(group);
+         unsigned members = (iter == group_active.end()) ? 0 : iter->second;
+         if (!active[i]) members++;
+         weight /= members;
+      }
+      weights[i] = weight;
+   }
+}
+
 /*
  * Do a simple hash across the username.
  */
@@ -876,6 +1034,12 @@ XrdThrottleManager::Waiter::Wait()
  * [wildcarduser]
  * name = wildcarduser*
  * maxconn = 10
+ *
+ * [vo]
+ * name = cms:*
+ * weight = 4
+ *
+ * Each section must set maxconn, weight or both.
  */
 int
 XrdThrottleManager::LoadUserLimits(const std::string &config_file)
@@ -895,6 +1059,7 @@ XrdThrottleManager::LoadUserLimits(const std::string &config_file)
     }
 
     std::unordered_map<std::string, UserLimit> new_limits;
+    int next_group = 0;
 
     // Process all sections
     for (const auto &section : reader.Sections())
@@ -908,16 +1073,27 @@ XrdThrottleManager::LoadUserLimits(const std::string &config_file)
         }
 
         long max_conn = reader.GetInteger(section, "maxconn", 0);
-        if (max_conn <= 0)
+        double weight = reader.GetReal(section, "weight", 0);
+        bool has_weight = !reader.Get(section, "weight", "").empty();
+        if (has_weight && weight <= 0)
+        {
+            m_log->Say("ThrottleManager", "Section", section.c_str(), "has invalid 'weight' parameter; skipping");
+            continue;
+        }
+        if (max_conn <= 0 && !has_weight)
         {
             m_log->Say("ThrottleManager", "Section", section.c_str(), "has invalid or missing 'maxconn' parameter; skipping");
             continue;
         }
 
         UserLimit limit;
-        limit.max_conn = static_cast<unsigned long>(max_conn);
+        limit.max_conn = max_conn > 0 ? static_cast<unsigned long>(max_conn) : 0;
+        limit.weight = static_cast<float>(weight);
         // Check if name contains wildcard (including '*' for default/catch-all)
         limit.is_wildcard = (name.find('*') != std::string::npos);
+        // Every wildcard pattern, except for the catch-all, forms a group
+        // sharing its weight.
+        if (limit.is_wildcard && name != "*") limit.group = next_group++;
         new_limits[name] = limit;
     }
 
@@ -927,6 +1103,7 @@ XrdThrottleManager::LoadUserLimits(const std::string &config_file)
         std::unique_lock<std::shared_mutex> lock(m_user_limits_mutex);
         m_user_limits = std::move(new_limits);
     }
+    RefreshUserWeights();
 
     m_log->Say("ThrottleManager", "Loaded", std::to_string(num_entries).c_str(), "per-user limit entries from", config_file.c_str());
     return 0;
@@ -958,28 +1135,56 @@ XrdThrottleManager::GetUserMaxConn(const std::string &username)
 {
     std::shared_lock lock(m_user_limits_mutex);
 
+    auto limit = MatchUserLimit(username, [](const UserLimit &entry) {return entry.max_conn > 0;});
+    return limit ? limit->max_conn : 0;
+}
+
+/*
+ * Get the fairshare weight for a given username, using the same matching
+ * rules as GetUserMaxConn.  Returns 1.0 if no weight is configured.
+ */
+float
+XrdThrottleManager::GetUserWeight(const std::string &username, int &group)
+{
+    std::shared_lock lock(m_user_limits_mutex);
+
+    auto limit = MatchUserLimit(username, [](const UserLimit &entry) {return entry.weight > 0;});
+    group = limit ? limit->group : -1;
+    return limit ? limit->weight : 1.0;
+}
+
+/*
+ * Find the limit entry for a given username among the entries accepted by
+ * the predicate.
+ * Priority: exact match > wildcard match (longest prefix) > "*" > none
+ */
+template<typename Pred>
+const XrdThrottleManager::UserLimit *
+XrdThrottleManager::MatchUserLimit(const std::string &username, Pred pred)
+{
     // First, try exact match
     auto exact_iter = m_user_limits.find(username);
-    if (exact_iter != m_user_limits.end() && !exact_iter->second.is_wildcard)
+    if (exact_iter != m_user_limits.end() && !exact_iter->second.is_wildcard &&
+        pred(exact_iter->second))
     {
-        return exact_iter->second.max_conn;
+        return &exact_iter->second;
     }
 
     // Then, try wildcard matches (prefer longest matching prefix)
-    unsigned long best_match = 0;
+    const UserLimit *best_match = nullptr;
     size_t best_prefix_len = 0;
-    unsigned long catch_all_match = 0;
+    const UserLimit *catch_all_match = nullptr;
 
     for (const auto &entry : m_user_limits)
     {
-        if (!entry.second.is_wildcard) continue;
+        if (!entry.second.is_wildcard || !pred(entry.second)) continue;
 
         const std::string &pattern = entry.first;
 
         // Special case: "*" is a catch-all pattern - store it but don't use it yet
         if (pattern == "*")
         {
-            catch_all_match = entry.second.max_conn;
+            catch_all_match = &entry.second;
             continue;
         }
 
@@ -989,22 +1194,20 @@ XrdThrottleManager::GetUserMaxConn(const std::string &username)
         // Extract prefix before wildcard
         std::string prefix = pattern.substr(0, wildcard_pos);
         if (username.length() >= prefix.length() &&
-            username.substr(0, prefix.length()) == prefix)
+            username.compare(0, prefix.length(), prefix) == 0)
         {
             // Prefer longer prefix matches
-            if (prefix.length() > best_prefix_len)
+            if (!best_match || prefix.length() > best_prefix_len)
             {
                 best_prefix_len = prefix.length();
-                best_match = entry.second.max_conn;
+                best_match = &entry.second;
             }
         }
     }
 
     // If we found a specific wildcard match, use it
-    if (best_match > 0) return best_match;
+    if (best_match) return best_match;
 
     // If no specific wildcard match, use catch-all if available
-    // return 0 if not
     return catch_all_match;
-
 }
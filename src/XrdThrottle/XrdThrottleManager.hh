@@ -10,7 +10,9 @@
  * The XrdThrottleManager is user-aware and provides fairshare.
  *
  * This works by having a separate thread periodically refilling
- * each user's shares.
+ * each user's shares.  Shares are split in proportion to the weight
+ * configured for the user (or for a wildcard group of users, such as
+ * all the users of a VO) in the per-user configuration file.
  *
  * Note that we do not actually keep close track of users, but rather
  * put them into a hash.  This way, we can pretend there's a constant
@@ -46,15 +48,18 @@ class XrdSysError;
 class XrdOucTrace;
 class XrdThrottleTimer;
 class XrdXrootdGStream;
+class XrdThrottleUserLimitsTests;
 
 namespace XrdThrottle {
    class Configuration;
+   class ConcurrencyController;
 }
 
 class XrdThrottleManager
 {
 
 friend class XrdThrottleTimer;
+friend class ::XrdThrottleUserLimitsTests;
 
 public:
 
@@ -78,6 +83,11 @@ void        SetThrottles(float reqbyterate, float reqoprate, int concurrency, fl
             {m_interval_length_seconds = interval_length; m_bytes_per_second = reqbyterate;
              m_ops_per_second = reqoprate; m_concurrency_limit = concurrency;}
 
+// Set the number of bytes each I/O operation is charged against the data
+// rate share in addition to its size; this models the fixed cost (e.g.,
+// a seek) of small random requests.
+void        SetOpCost(long long op_cost) {m_op_cost_bytes = op_cost;}
+
 void        SetLoadShed(std::string &hostname, unsigned port, unsigned frequency)
             {m_loadshed_host = hostname; m_loadshed_port = port; m_loadshed_frequency = frequency;}
 
@@ -98,6 +108,13 @@ int         ReloadUserLimits();
 // Returns 0 if no per-user limit is set (use global), otherwise returns the limit
 unsigned long GetUserMaxConn(const std::string &username);
 
+// Get the fairshare weight for a given username.
+// Returns 1.0 if no weight is configured for the user.  If the weight comes
+// from a wildcard pattern, group is set to a non-negative identifier for
+// that pattern: the weight is then shared by all active users in the group.
+// Otherwise, group is set to -1.
+float       GetUserWeight(const std::string &username, int &group);
+
 void        SetMonitor(XrdXrootdGStream *gstream) {m_gstream = gstream;}
 
 //int         Stats(char *buff, int blen, int do_sync=0) {return m_pool.Stats(buff, blen, do_sync);}
@@ -114,9 +131,15 @@ bool        CheckLoadShed(const std::string &opaque);
 
 void        PerformLoadShed(const std::string &opaque, std::string &host, unsigned &port);
 
+// Let the concurrency limit adapt to the observed IO latency, between the
+// given bounds; the current limit, if any, is used as the starting point.
+void        SetAdaptiveConcurrency(int min_limit, int max_limit);
+
+int         GetConcurrencyLimit() {return m_concurrency_limit;}
+
             XrdThrottleManager(XrdSysError *lP, XrdOucTrace *tP);
 
-           ~XrdThrottleManager() {} // The buffmanager is never deleted
+           ~XrdThrottleManager(); // The buffmanager is never deleted
 
 protected:
 
@@ -173,7 +196,10 @@ XrdSysCondVar m_compute_var;
 float       m_interval_length_seconds;
 float       m_bytes_per_second;
 float       m_ops_per_second;
-int         m_concurrency_limit;
+XrdSys::RAtomic<int> m_concurrency_limit; // May be changed by the adaptive controller at each recompute.
+
+// Adaptive concurrency controller; null if the limit is static.
+std::unique_ptr<XrdThrottle::ConcurrencyController> m_adaptive;
 
 // Maintain the shares
 
@@ -182,7 +208,29 @@ std::vector<int> m_primary_bytes_shares;
 std::vector<int> m_secondary_bytes_shares;
 std::vector<int> m_primary_ops_shares;
 std::vector<int> m_secondary_ops_shares;
-int         m_last_round_allocation;
+int         m_last_round_allocation; // Allocation of a user with unit weight in the last round.
+std::vector<int> m_bytes_allocation; // Per-user byte allocation in the last round.
+std::vector<int> m_ops_allocation;   // Per-user ops allocation in the last round.
+long long   m_op_cost_bytes{0};
+
+// Fairshare weight and group (or -1) of the user most recently mapped to each
+// UID.  The user names are kept so the weights can be looked up again when the
+// per-user limits are reloaded; they are protected by m_user_name_mutex.
+std::array<XrdSys::RAtomic<float>, m_max_users> m_user_weight;
+std::array<XrdSys::RAtomic<int>, m_max_users> m_user_group;
+std::array<std::string, m_max_users> m_user_name;
+std::mutex m_user_name_mutex;
+
+// Map a user to a UID slot and set the slot's weight and group.
+void        SetUserWeight(uint16_t uid, const std::string &username);
+
+// Recompute the weight and group of every occupied slot.
+void        RefreshUserWeights();
+
+// Compute the effective weight of each user, given which users are active:
+// the weight of a group is divided among its active members.  An inactive
+// user is given the weight they would have if they became active.
+void        ComputeWeights(const std::vector<bool> &active, std::vector<double> &weights);
 
 // Waiter counts for each user
 struct alignas(64) Waiter
@@ -259,11 +307,18 @@ std::unordered_map<std::string, unsigned long> m_conn_counters;
 std::unordered_map<std::string, std::unique_ptr<std::unordered_map<pid_t, unsigned long>>> m_active_conns;
 std::mutex m_file_mutex;
 
-// Per-user connection limits
+// Per-user connection limits and fairshare weights
 struct UserLimit {
     unsigned long max_conn{0};  // 0 means no limit (use global)
+    float weight{0};            // 0 means no weight set (use 1.0)
+    int group{-1};              // Group identifier for wildcard patterns
     bool is_wildcard{false};    // true if this is a wildcard pattern
 };
+
+// Find the limit entry that applies to the username, considering only the
+// entries for which the predicate is true.  Must hold m_user_limits_mutex.
+template<typename Pred>
+const UserLimit *MatchUserLimit(const std::string &username, Pred pred);
 std::unordered_map<std::string, UserLimit> m_user_limits;
 std::shared_mutex m_user_limits_mutex;
 std::string m_user_config_file;
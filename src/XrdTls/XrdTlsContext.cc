@@ -17,14 +17,28 @@
 //------------------------------------------------------------------------------
 
 #include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <memory>
+#include <vector>
 #include <openssl/bio.h>
 #include <openssl/crypto.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 #include <openssl/opensslv.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#else
+#include <openssl/hmac.h>
+#endif
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include "XrdOuc/XrdOucUtils.hh"
+#include "XrdSys/XrdSysE2T.hh"
 #include "XrdSys/XrdSysRAtomic.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPthread.hh"
@@ -47,6 +61,174 @@ namespace XrdTlsGlobal
 extern XrdSysTrace SysTrace;
 };
   
+/******************************************************************************/
+/*                S e s s i o n   T i c k e t   S u p p o r t                 */
+/******************************************************************************/
+
+namespace XrdTlsTkt
+{
+// A ticket key is the 16 byte key name, followed by the 32 byte HMAC key and
+// the 32 byte AES key. This is also the layout of keys in a key file.
+//
+struct TicketKey
+      {unsigned char name[16];
+       unsigned char hmac[32];
+       unsigned char aes [32];
+      };
+
+static const int maxKeys = 8;
+
+class KeyStore
+{
+public:
+
+bool Find(const unsigned char *name, TicketKey &key, bool &renew);
+
+bool Load(std::string *eMsg);
+
+void Refresh(time_t now);
+
+     KeyStore(int rot, const char *kfile)
+             : keyFile(kfile ? kfile : ""), rotInt(rot), nextChk(0),
+               fileMT(0) {}
+
+    ~KeyStore() {if (keys.size())
+                    OPENSSL_cleanse(keys.data(), keys.size()*sizeof(TicketKey));
+                }
+
+std::vector<TicketKey> keys;    // keys[0] is used to issue tickets
+
+private:
+
+XrdSysMutex            ksMutex;
+std::string            keyFile;
+int                    rotInt;
+time_t                 nextChk;
+time_t                 fileMT;
+};
+
+/******************************************************************************/
+/*                                  F i n d                                   */
+/******************************************************************************/
+
+// When name is nil, the current key is returned for issuing a ticket.
+// Otherwise, the key matching the name is returned and renew is set when
+// the ticket should be reissued with the current key.
+//
+bool KeyStore::Find(const unsigned char *name, TicketKey &key, bool &renew)
+{
+   XrdSysMutexHelper mHelp(ksMutex);
+
+   Refresh(time(0));
+
+   for (int i = 0; i < (int)keys.size(); i++)
+       {if (!name || !memcmp(name, keys[i].name, sizeof(key.name)))
+           {key = keys[i];
+            renew = i != 0;
+            return true;
+           }
+       }
+   return false;
+}
+
+/******************************************************************************/
+/*                                  L o a d                                   */
+/******************************************************************************/
+
+bool KeyStore::Load(std::string *eMsg)
+{
+   TicketKey newKeys[maxKeys];
+   struct stat Stat;
+   const char *eTxt = 0;
+   int fd, rc = 0;
+
+// Open the key file and make sure it is sensible. As it holds secrets, only
+// the owner may have access to it.
+//
+   if ((fd = open(keyFile.c_str(), O_RDONLY)) < 0 || fstat(fd, &Stat))
+      eTxt = XrdSysE2T(errno);
+      else if (Stat.st_mode & (S_IRWXG | S_IRWXO))
+              eTxt = "must only be accessible by its owner";
+      else if (!Stat.st_size || Stat.st_size % sizeof(TicketKey)
+           ||  Stat.st_size > (off_t)sizeof(newKeys))
+              eTxt = "does not contain 1 to 8 80-byte keys";
+      else if ((rc = read(fd, newKeys, Stat.st_size)) != Stat.st_size)
+              eTxt = (rc < 0 ? XrdSysE2T(errno) : "read incomplete");
+   if (fd >= 0) close(fd);
+
+// Check for errors
+//
+   if (eTxt)
+      {if (eMsg)
+          {*eMsg  = "Unable to load session ticket keys from ";
+           *eMsg += keyFile; *eMsg += "; "; *eMsg += eTxt;
+          }
+       OPENSSL_cleanse(newKeys, sizeof(newKeys));
+       return false;
+      }
+
+// Replace the keys
+//
+   if (keys.size())
+      OPENSSL_cleanse(keys.data(), keys.size()*sizeof(TicketKey));
+   keys.assign(newKeys, newKeys + Stat.st_size/sizeof(TicketKey));
+   OPENSSL_cleanse(newKeys, sizeof(newKeys));
+   fileMT  = Stat.st_mtime;
+   nextChk = time(0) + 60;
+   return true;
+}
+
+/******************************************************************************/
+/*                               R e f r e s h                                */
+/******************************************************************************/
+
+// Caller must hold the ksMutex or have exclusive use of the object.
+//
+void KeyStore::Refresh(time_t now)
+{
+   if (now < nextChk) return;
+
+// When keys come from a file, someone else rotates them. We simply check
+// whether the file changed once a minute. Should it be unusable we keep
+// using the keys we have.
+//
+   if (keyFile.size())
+      {struct stat Stat;
+       std::string eMsg;
+       nextChk = now + 60;
+       if (!stat(keyFile.c_str(), &Stat) && Stat.st_mtime != fileMT
+       &&  !Load(&eMsg)) XrdTls::Emsg("SessionTickets:", eMsg.c_str(), false);
+       return;
+      }
+
+// Generate a new key and keep the previous one so that tickets issued just
+// before the rotation remain usable for a full interval.
+//
+   TicketKey newKey;
+   if (RAND_bytes((unsigned char *)&newKey, sizeof(newKey)) != 1)
+      {nextChk = now + 60;
+       return;
+      }
+   keys.insert(keys.begin(), newKey);
+   OPENSSL_cleanse(&newKey, sizeof(newKey));
+   if (keys.size() > 2)
+      {OPENSSL_cleanse(&keys[2], sizeof(TicketKey));
+       keys.resize(2);
+      }
+   nextChk = now + rotInt;
+}
+
+/******************************************************************************/
+/*                                 I n d e x                                  */
+/******************************************************************************/
+
+int Index()
+{
+   static int ksIndex = SSL_CTX_get_ex_new_index(0, NULL, NULL, NULL, NULL);
+   return ksIndex;
+}
+}
+  
 /******************************************************************************/
 /*                      X r d T l s C o n t e x t I m p l                     */
 /******************************************************************************/
@@ -60,6 +242,7 @@ struct XrdTlsContextImpl
    ~XrdTlsContextImpl() {if (ctx)     SSL_CTX_free(ctx);
                          if (ctxnew)  delete ctxnew;
                          if (flsCVar) delete flsCVar;
+                         for (auto &it : cliSess) SSL_SESSION_free(it.second);
                         }
 
     SSL_CTX                      *ctx;
@@ -74,6 +257,10 @@ struct XrdTlsContextImpl
     time_t                        lastCertModTime = 0;
     int                           sessionCacheOpts = -1;
     std::string                   sessionCacheId;
+    std::shared_ptr<XrdTlsTkt::KeyStore> tktKeys;
+    XrdSysMutex                   cliMutex;
+    std::map<std::string, SSL_SESSION*> cliSess;
+    bool                          cliCache = false;
 };
   
 /******************************************************************************/
@@ -541,6 +728,77 @@ int verifyPeerCB(int aOK, X509_STORE_CTX *x509P) {
    return aOK;
 }
 
+/**
+ *
+ * OpenSSL session ticket key callback. Returns 1 if the key was set up, 2 if
+ * the ticket should be renewed, 0 if there is no key, and -1 upon error.
+ */
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+int ticketKeyCB(SSL *ssl, unsigned char *kname, unsigned char *iv,
+                EVP_CIPHER_CTX *ectx, EVP_MAC_CTX *hctx, int enc)
+#else
+int ticketKeyCB(SSL *ssl, unsigned char *kname, unsigned char *iv,
+                EVP_CIPHER_CTX *ectx, HMAC_CTX *hctx, int enc)
+#endif
+{
+   XrdTlsTkt::KeyStore *ksP = static_cast<XrdTlsTkt::KeyStore *>
+             (SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), XrdTlsTkt::Index()));
+   const EVP_CIPHER *cipher = EVP_aes_256_cbc();
+   XrdTlsTkt::TicketKey key;
+   bool renew = false;
+   int rc;
+
+// Find the key to be used. When issuing a ticket we also need a new iv.
+//
+   if (!ksP) return 0;
+   if (enc)
+      {if (!ksP->Find(0, key, renew)
+       ||  RAND_bytes(iv, EVP_CIPHER_iv_length(cipher)) != 1) return 0;
+       memcpy(kname, key.name, sizeof(key.name));
+       rc = EVP_EncryptInit_ex(ectx, cipher, 0, key.aes, iv);
+      } else {
+       if (!ksP->Find(kname, key, renew)) return 0;
+       rc = EVP_DecryptInit_ex(ectx, cipher, 0, key.aes, iv);
+      }
+
+// Setup the HMAC key
+//
+   if (rc)
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+      {OSSL_PARAM parms[3];
+       parms[0] = OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY,
+                                                    key.hmac, sizeof(key.hmac));
+       parms[1] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+                                                   (char *)"SHA256", 0);
+       parms[2] = OSSL_PARAM_construct_end();
+       rc = EVP_MAC_CTX_set_params(hctx, parms);
+      }
+#else
+      rc = HMAC_Init_ex(hctx, key.hmac, sizeof(key.hmac), EVP_sha256(), 0);
+#endif
+   OPENSSL_cleanse(&key, sizeof(key));
+
+// All done. TLS 1.3 clients use a ticket only once, so a resumed session
+// always needs a new ticket. OpenSSL only sends one when we ask for renewal.
+//
+   if (!rc) return -1;
+   return (renew || (!enc && SSL_version(ssl) >= TLS1_3_VERSION) ? 2 : 1);
+}
+}
+
+/******************************************************************************/
+/*                            S e t T i c k e t s                             */
+/******************************************************************************/
+
+void SetTickets(SSL_CTX *ctx, XrdTlsTkt::KeyStore *ksP)
+{
+   SSL_CTX_set_ex_data(ctx, XrdTlsTkt::Index(), ksP);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+   SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, ticketKeyCB);
+#else
+   SSL_CTX_set_tlsext_ticket_key_cb(ctx, ticketKeyCB);
+#endif
+   SSL_CTX_clear_options(ctx, SSL_OP_NO_TICKET);
 }
   
 } // Anonymous namespace end
@@ -675,6 +933,13 @@ XrdTlsContext::XrdTlsContext(const char *cert,  const char *key,
 //
    SSL_CTX_set_options(pImpl->ctx, sslOpts);
 
+// Enable kernel TLS offload if so wanted. OpenSSL silently falls back to
+// user space TLS when the kernel or the negotiated cipher does not support it.
+//
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+   if (opts & ktlsOn) SSL_CTX_set_options(pImpl->ctx, SSL_OP_ENABLE_KTLS);
+#endif
+
 // Handle session re-negotiation automatically
 //
 // SSL_CTX_set_mode(pImpl->ctx, sslMode);
@@ -815,6 +1080,11 @@ XrdTlsContext *XrdTlsContext::Clone(bool full,bool startCRLRefresh)
            //A SessionCache() call was done for the current context, so apply it for this new cloned context
            xtc->SessionCache(pImpl->sessionCacheOpts,pImpl->sessionCacheId.c_str(),pImpl->sessionCacheId.size());
        }
+       if (pImpl->tktKeys) {
+           //Share the ticket keys so that tickets survive a context refresh
+           xtc->pImpl->tktKeys = pImpl->tktKeys;
+           SetTickets(xtc->pImpl->ctx, pImpl->tktKeys.get());
+       }
        return xtc;
    }
 
@@ -842,6 +1112,39 @@ const XrdTlsContext::CTX_Params *XrdTlsContext::GetParams()
   return &pImpl->Parm;
 }
 
+/******************************************************************************/
+/*                            G e t S e s s i o n                             */
+/******************************************************************************/
+
+void *XrdTlsContext::GetSession(const char *key)
+{
+   SSL_SESSION *sess;
+
+// If we are not caching client sessions there is nothing to find
+//
+   if (!pImpl->cliCache) return 0;
+
+// Find the session
+//
+   XrdSysMutexHelper mHelp(pImpl->cliMutex);
+   auto it = pImpl->cliSess.find(key);
+   if (it == pImpl->cliSess.end()) return 0;
+
+// Expired sessions are useless, remove them
+//
+   sess = it->second;
+   if (SSL_SESSION_get_time(sess) + SSL_SESSION_get_timeout(sess) <= time(0))
+      {SSL_SESSION_free(sess);
+       pImpl->cliSess.erase(it);
+       return 0;
+      }
+
+// Return the session with a reference for the caller
+//
+   SSL_SESSION_up_ref(sess);
+   return sess;
+}
+
 /******************************************************************************/
 /*                                  I n i t                                   */
 /******************************************************************************/
@@ -870,6 +1173,61 @@ bool XrdTlsContext::isOK()
    return pImpl->ctx != 0;
 }
   
+/******************************************************************************/
+/*                            P u t S e s s i o n                             */
+/******************************************************************************/
+
+void XrdTlsContext::PutSession(const char *key, void *sess)
+{
+   static const unsigned int maxSess = 1024;
+   SSL_SESSION *sP = static_cast<SSL_SESSION *>(sess);
+
+// If we are not caching client sessions there is nothing to do
+//
+   if (!pImpl->cliCache) return;
+
+// If we already have a session for this key, replace it
+//
+   XrdSysMutexHelper mHelp(pImpl->cliMutex);
+   auto it = pImpl->cliSess.find(key);
+   if (it != pImpl->cliSess.end())
+      {if (it->second == sP) return;
+       SSL_SESSION_free(it->second);
+       it->second = sP;
+       SSL_SESSION_up_ref(sP);
+       return;
+      }
+
+// Make sure the cache does not grow without bounds. First we remove expired
+// sessions and if that is not enough, the oldest one.
+//
+   if (pImpl->cliSess.size() >= maxSess)
+      {time_t now = time(0);
+       auto oldest = pImpl->cliSess.end();
+       for (it = pImpl->cliSess.begin(); it != pImpl->cliSess.end();)
+           {SSL_SESSION *xP = it->second;
+            if (SSL_SESSION_get_time(xP) + SSL_SESSION_get_timeout(xP) <= now)
+               {SSL_SESSION_free(xP);
+                it = pImpl->cliSess.erase(it);
+                continue;
+               }
+            if (oldest == pImpl->cliSess.end()
+            ||  SSL_SESSION_get_time(xP) < SSL_SESSION_get_time(oldest->second))
+               oldest = it;
+            ++it;
+           }
+       if (pImpl->cliSess.size() >= maxSess)
+          {SSL_SESSION_free(oldest->second);
+           pImpl->cliSess.erase(oldest);
+          }
+      }
+
+// Add the session
+//
+   SSL_SESSION_up_ref(sP);
+   pImpl->cliSess.emplace(key, sP);
+}
+
 /******************************************************************************/
 /*                               S e s s i o n                                */
 /******************************************************************************/
@@ -968,7 +1326,7 @@ int XrdTlsContext::SessionCache(int opts, const char *id, int idlen)
    int flushT = opts & scFMax;
 
    pImpl->sessionCacheOpts = opts;
-   pImpl->sessionCacheId = id;
+   if (id) pImpl->sessionCacheId = id;
 
 // If initialization failed there is nothing to do
 //
@@ -981,6 +1339,9 @@ int XrdTlsContext::SessionCache(int opts, const char *id, int idlen)
           else {if (opts & scSrvr) sslopt  = SSL_SESS_CACHE_SERVER;
                 if (opts & scClnt) sslopt |= SSL_SESS_CACHE_CLIENT;
                }
+       pImpl->cliCache = (opts & (scOff | scClnt)) == scClnt;
+       if (pImpl->cliCache && !(opts & scSrvr))
+          sslopt |= SSL_SESS_CACHE_NO_INTERNAL_STORE;
       }
 
 // Check if we should set any cache options or simply get them
@@ -1018,6 +1379,44 @@ int XrdTlsContext::SessionCache(int opts, const char *id, int idlen)
    return opts;
 }
   
+/******************************************************************************/
+/*                        S e s s i o n T i c k e t s                         */
+/******************************************************************************/
+
+bool XrdTlsContext::SessionTickets(int rotate, const char *keyfile,
+                                   std::string *eMsg)
+{
+   std::shared_ptr<XrdTlsTkt::KeyStore> ksP;
+
+// If initialization failed there is nothing to do
+//
+   if (pImpl->ctx == 0)
+      {if (eMsg) *eMsg = "TLS context is not initialized";
+       return false;
+      }
+
+// Obtain the initial set of keys
+//
+   if (rotate < 60) rotate = 60;
+   ksP = std::make_shared<XrdTlsTkt::KeyStore>(rotate, keyfile);
+   if (keyfile)
+      {if (!ksP->Load(eMsg)) return false;
+      } else {
+       ksP->Refresh(time(0));
+       if (ksP->keys.empty())
+          {if (eMsg) *eMsg = "Unable to generate session ticket key";
+           return false;
+          }
+       SSL_CTX_set_timeout(pImpl->ctx, rotate);
+      }
+
+// Install the keys in our context
+//
+   pImpl->tktKeys = ksP;
+   SetTickets(pImpl->ctx, ksP.get());
+   return true;
+}
+
 /******************************************************************************/
 /*                     S e t C o n t e x t C i p h e r s                      */
 /******************************************************************************/
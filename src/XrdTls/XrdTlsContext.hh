@@ -99,6 +99,18 @@ CTX_Params     *GetParams();
 static
 const char     *Init();
 
+//------------------------------------------------------------------------
+//! Obtain a previously saved client session for resumption. This is only
+//! effective when the client session cache is enabled (see scClnt below).
+//!
+//! @param  key      The key under which the session was saved.
+//!
+//! @return A pointer to an unexpired SSL session or nil if there is none.
+//!         The caller is responsible for freeing the returned session.
+//------------------------------------------------------------------------
+
+void           *GetSession(const char *key);
+
 //------------------------------------------------------------------------
 //! Determine if this object was correctly built.
 //!
@@ -140,6 +152,40 @@ static const int scFMax = 0x00007fff; //!< Maximum flush interval in seconds
 
       int       SessionCache(int opts=scNone, const char *id=0, int idlen=0);
 
+//------------------------------------------------------------------------
+//! Save a client session so that later connections using the same key may
+//! resume it. This is only effective when the client session cache is
+//! enabled (see scClnt above). The session should only be saved after the
+//! peer has been fully verified as a resumed session is not re-verified.
+//!
+//! @param  key      The key identifying the peer (e.g. host, port, and
+//!                  credentials used).
+//! @param  sess     Pointer to the SSL session to save. A reference is taken.
+//------------------------------------------------------------------------
+
+void            PutSession(const char *key, void *sess);
+
+//------------------------------------------------------------------------
+//! Enable stateless session tickets whose encryption keys are managed by
+//! this context instead of the TLS library. This allows tickets to remain
+//! usable across context refreshes and, with a key file, across servers.
+//!
+//! @param  rotate   The number of seconds a generated key is used to issue
+//!                  tickets (minimum 60). The previous key is accepted for
+//!                  one more interval. Ignored when keyfile is specified.
+//! @param  keyfile  When not nil, the path of a file holding one or more
+//!                  80-byte keys shared by all servers in a cluster. The
+//!                  first key issues tickets, all are accepted. The file
+//!                  must only be accessible by its owner and is re-read
+//!                  whenever it is modified.
+//! @param  eMsg     If not nil, receives the reason for a failure.
+//!
+//! @return True if tickets were enabled; false otherwise.
+//------------------------------------------------------------------------
+
+bool            SessionTickets(int rotate, const char *keyfile=0,
+                               std::string *eMsg=0);
+
 //------------------------------------------------------------------------
 //! Set allowed ciphers for this context.
 //!
@@ -216,6 +262,7 @@ void            SetDefaultCiphers(const char *ciphers);
 //!                  crlRF   - Initial crl refresh interval in minutes.
 //!                  dnsok   - trust DNS when verifying hostname.
 //!                  hsto    - the handshake timeout value in seconds.
+//!                  ktlsOn  - Use kernel TLS offload when available.
 //!                  logVF   - Turn on verification failure logging.
 //!                  nopxy   - Do not allow proxy cert (normally allowed)
 //!                  servr   - This is a server-side context and x509 peer
@@ -256,6 +303,7 @@ static const uint64_t crlAM = 0x0000001000000000; //!< Allow CA validation when
 static const int      crlRS = 16;                 //!< Bits to shift   vdept
 static const uint64_t artON = 0x0000002000000000; //!< Auto retry Handshake
 static const uint64_t clcOF = 0x0000010000000000; //!< Disable client certificate request
+static const uint64_t ktlsOn= 0x0000020000000000; //!< Use kernel TLS if available
 
 
 static int ctxIndex;
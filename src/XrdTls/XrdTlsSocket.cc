@@ -49,7 +49,8 @@ struct XrdTlsSocketImpl
 {
     XrdTlsSocketImpl() : tlsctx(0), ssl(0), traceID(""), sFD(-1), hsWait(15),
                          hsDone(false), fatal(0), isClient(false),
-                         cOpts(0), cAttr(0), hsNoBlock(false), isSerial(true) {}
+                         cOpts(0), cAttr(0), hsNoBlock(false), isSerial(true),
+                         sessTry(0) {}
 
     XrdSysMutex      sslMutex;  //!< Mutex to serialize calls
     XrdTlsContext   *tlsctx;    //!< Associated context object
@@ -64,6 +65,8 @@ struct XrdTlsSocketImpl
     char             cAttr;     //!< Connection attributes
     bool             hsNoBlock; //!< Handshake handling nonblocking if true
     bool             isSerial;  //!< True if calls must be serialized
+    unsigned char    sessTry;   //!< Reads left to try saving the session
+    std::string      sessKey;   //!< Client session cache key (may be empty)
 };
 
 /******************************************************************************/
@@ -247,6 +250,25 @@ void XrdTlsSocket::AcceptEMsg(std::string *eWhy, const char *reason)
       }
 }
 
+/******************************************************************************/
+/*                           C a n S e n d F i l e                            */
+/******************************************************************************/
+
+bool XrdTlsSocket::CanSendFile()
+{
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+   BIO *wbio;
+
+// Sending file data directly is only possible when the kernel encrypts the
+// data being sent. This is only known after the handshake has completed.
+//
+   if (!pImpl->ssl || !(pImpl->hsDone) || pImpl->fatal) return false;
+   return (wbio = SSL_get_wbio(pImpl->ssl)) && BIO_get_ktls_send(wbio);
+#else
+   return false;
+#endif
+}
+
 /******************************************************************************/
 /*                               C o n n e c t                                */
 /******************************************************************************/
@@ -302,6 +324,7 @@ do{int rc = SSL_connect( pImpl->ssl );
 //  Set the hsDone flag!
 //
    pImpl->hsDone = bool( SSL_is_init_finished( pImpl->ssl ) );
+   if (SSL_session_reused(pImpl->ssl)) DBG_SOK("Resumed previous session.");
 
 // Validate the host name if so desired. Note that cert verification is
 // checked by the notary since hostname validation requires it. We currently
@@ -321,6 +344,10 @@ do{int rc = SSL_connect( pImpl->ssl );
           }
       }
 
+// The peer has been verified, so the session may be saved for resumption.
+//
+   if (pImpl->sessKey.size()) SaveSession();
+
    DBG_SOK("Connect completed without error.");
    return XrdTls::TLS_AOK;
 }
@@ -505,6 +532,8 @@ const char *XrdTlsSocket::Init( XrdTlsContext &ctx, int sfd,
 //
    pImpl->hsDone = false;
    pImpl->fatal = 0;
+   pImpl->sessTry = 0;
+   pImpl->sessKey.clear();
 
 // The glories of OpenSSL require that we do some fancy footwork with the
 // handshake timeout. If there is one and this is a server and the server
@@ -531,6 +560,15 @@ const char *XrdTlsSocket::Init( XrdTlsContext &ctx, int sfd,
    return 0;
 }
 
+/******************************************************************************/
+/*                             i s R e s u m e d                              */
+/******************************************************************************/
+
+bool XrdTlsSocket::isResumed()
+{
+   return pImpl->ssl && SSL_session_reused(pImpl->ssl);
+}
+
 /******************************************************************************/
 /*                                  P e e k                                   */
 /******************************************************************************/
@@ -658,6 +696,7 @@ XrdTls::RC XrdTlsSocket::Read( char *buffer, size_t size, int &bytesRead )
     if( rc > 0 )
       {bytesRead = rc;
        DBG_SIO(rc <<" out of " <<size <<" bytes.");
+       if (pImpl->sessTry) SaveSession();
        return XrdTls::TLS_AOK;
       }
 
@@ -689,6 +728,124 @@ XrdTls::RC XrdTlsSocket::Read( char *buffer, size_t size, int &bytesRead )
     return XrdTls::TLS_SYS_Error;
   }
 
+/******************************************************************************/
+/* Private:                  S a v e S e s s i o n                            */
+/******************************************************************************/
+
+// With TLS 1.3 the server sends session tickets after the handshake and they
+// are only processed by a subsequent read. So, if the session is not yet
+// resumable, we try again for the next few reads.
+//
+void XrdTlsSocket::SaveSession()
+{
+   SSL_SESSION *sess = SSL_get0_session(pImpl->ssl);
+
+   if (sess && SSL_SESSION_is_resumable(sess)
+   &&  SSL_get_verify_result(pImpl->ssl) == X509_V_OK)
+      {pImpl->tlsctx->PutSession(pImpl->sessKey.c_str(), sess);
+       pImpl->sessTry = 0;
+      } else {
+       if (!pImpl->hsDone) pImpl->sessTry = 0;
+          else if (!pImpl->sessTry) pImpl->sessTry = 16;
+                  else pImpl->sessTry--;
+      }
+}
+
+/******************************************************************************/
+/*                              S e n d F i l e                               */
+/******************************************************************************/
+
+XrdTls::RC XrdTlsSocket::SendFile( int fd, off_t offset, size_t size,
+                                   int &bytesOut )
+{
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+    EPNAME("SendFile");
+    XrdSysMutexHelper mHelper;
+    int ssler;
+
+    //------------------------------------------------------------------------
+    // Serialize call if need be
+    //------------------------------------------------------------------------
+
+    if (pImpl->isSerial) mHelper.Lock(&(pImpl->sslMutex));
+
+    //------------------------------------------------------------------------
+    // Return an error if this socket received a fatal error as OpenSSL will
+    // SEGV when called after such an error.
+    //------------------------------------------------------------------------
+
+    if (pImpl->fatal)
+       {DBG_SIO("Failing due to previous error, fatal=" << (int)pImpl->fatal);
+        return (XrdTls::RC)pImpl->fatal;
+       }
+
+    //------------------------------------------------------------------------
+    // We report the amount sent as an int, so limit the size accordingly.
+    //------------------------------------------------------------------------
+
+    if (size > 0x7fffffff) size = 0x7fffffff;
+
+ do{ossl_ssize_t rc = SSL_sendfile( pImpl->ssl, fd, offset, size, 0 );
+
+    if (rc > 0)
+      {bytesOut = static_cast<int>(rc);
+       DBG_SIO(rc <<" out of " <<size <<" bytes.");
+       return XrdTls::TLS_AOK;
+      }
+
+    // We have a potential error. Get the SSL error code.
+    //
+    ssler = Diagnose("TLS_SendFile", static_cast<int>(rc), XrdTls::dbgSIO);
+    if (ssler == SSL_ERROR_NONE)
+       {bytesOut = 0;
+        DBG_SIO(rc <<" out of " <<size <<" bytes.");
+        return XrdTls::TLS_AOK;
+       }
+
+    // If the error isn't due to blocking issues, we are done.
+    //
+    if (ssler != SSL_ERROR_WANT_READ && ssler != SSL_ERROR_WANT_WRITE)
+       return XrdTls::ssl2RC(ssler);
+
+    // If the caller is non-blocking for writes, return the issue. Otherwise,
+    // block for the caller.
+    //
+    if (!(pImpl->cAttr & wBlocking)) return XrdTls::ssl2RC(ssler);
+
+    // Wait unil the write can get restarted
+
+   } while(Wait4OK(ssler == SSL_ERROR_WANT_READ));
+
+    return XrdTls::TLS_SYS_Error;
+#else
+    (void)fd; (void)offset; (void)size; bytesOut = 0;
+    return XrdTls::TLS_UNK_Error;
+#endif
+}
+
+/******************************************************************************/
+/*                         S e t S e s s i o n K e y                          */
+/******************************************************************************/
+
+bool XrdTlsSocket::SetSessionKey(const char *key)
+{
+   SSL_SESSION *sess;
+
+// This only makes sense for a client that has not yet started the handshake
+//
+   if (!pImpl->ssl || !pImpl->isClient || !SSL_in_before(pImpl->ssl))
+      return false;
+
+// Record the key and offer any saved session to the server
+//
+   pImpl->sessKey = key;
+   if ((sess = static_cast<SSL_SESSION *>(pImpl->tlsctx->GetSession(key))))
+      {SSL_set_session(pImpl->ssl, sess);
+       SSL_SESSION_free(sess);
+      }
+   return true;
+}
+
 /******************************************************************************/
 /*                            S e t T r a c e I D                             */
 /******************************************************************************/
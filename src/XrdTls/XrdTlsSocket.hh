@@ -19,6 +19,7 @@
 //------------------------------------------------------------------------------
 
 #include <string>
+#include <sys/types.h>
 
 #include "XrdTls/XrdTls.hh"
 
@@ -115,6 +116,15 @@ enum HS_Mode
 
   XrdTls::RC Connect(const char *thehost=0, std::string *eWhy=0);
 
+//------------------------------------------------------------------------
+//! Determine whether file data can be sent directly using SendFile(). This
+//! is only possible when kernel TLS is handling encryption of sent data.
+//!
+//! @return true if SendFile() may be used, false otherwise.
+//------------------------------------------------------------------------
+
+  bool CanSendFile();
+
 //------------------------------------------------------------------------
 //! Obtain context associated with this connection.
 //!
@@ -165,6 +175,14 @@ XrdTlsPeerCerts *getCerts(bool ver=true);
   const char *Init( XrdTlsContext &ctx, int sfd, RW_Mode rwm, HS_Mode hsm,
                     bool isClient, bool serial=true, const char *tid="" );
 
+//------------------------------------------------------------------------
+//! Indicate whether the handshake resumed a previously saved session.
+//!
+//! @return true if the session was resumed, false otherwise.
+//------------------------------------------------------------------------
+
+  bool isResumed();
+
 //------------------------------------------------------------------------
 //! Peek at the TLS connection data. If necessary, a handshake will be done.
 //!
@@ -205,6 +223,34 @@ XrdTlsPeerCerts *getCerts(bool ver=true);
 
   XrdTls::RC Read( char *buffer, size_t size, int &bytesRead );
 
+//------------------------------------------------------------------------
+//! Send file data over the TLS connection using kernel TLS. This must only
+//! be called when CanSendFile() returns true.
+//!
+//! @param  fd         - The file descriptor of the file holding the data.
+//! @param  offset     - The offset in the file where the data starts.
+//! @param  size       - The number of bytes to send.
+//! @param  bytesOut   - Number of bytes actually sent, if successful.
+//!
+//! @return TLS_AOK if the operation was successful; otherwise the appropraite
+//!                 return code indicating the problem.
+//------------------------------------------------------------------------
+
+  XrdTls::RC SendFile( int fd, off_t offset, size_t size, int &bytesOut );
+
+//------------------------------------------------------------------------
+//! Set the key under which a client session is saved and resumed. When the
+//! context has a client session cache, a saved session for the key is
+//! offered to the server and the new session is saved once the peer has
+//! been verified. Only effective for clients before the handshake starts.
+//!
+//! @param  key        - The key identifying the peer (host, port, creds).
+//!
+//! @return true if the key was set, false if it is too late to do so.
+//------------------------------------------------------------------------
+
+  bool       SetSessionKey(const char *key);
+
 //------------------------------------------------------------------------
 //! Set the trace identifier (used when it's updated).
 //!
@@ -258,6 +304,7 @@ void AcceptEMsg(std::string *eWhy, const char *reason);
 int  Diagnose(const char *what, int sslrc, int tcode);
 std::string Err2Text(int sslerr);
 bool NeedHS();
+void SaveSession();
 bool Wait4OK(bool wantRead);
 
 XrdTlsSocketImpl *pImpl;
@@ -78,6 +78,23 @@ XrdXrootdAioBuff *XrdXrootdAioBuff::Alloc(XrdXrootdAioTask* arp)
 //
    if (!(bP = BPool->Obtain(XrdXrootdProtocol::as_segsize))) return 0;
 
+// Get an aio object using this buffer
+//
+   aiobuff = Alloc(arp, bP->buff, bP->bsize);
+   aiobuff->buffP = bP;
+   return aiobuff;
+}
+
+/******************************************************************************/
+
+// This version is used when the data is to be read into the caller's buffer.
+// The buffer is not released when the object is recycled.
+
+XrdXrootdAioBuff *XrdXrootdAioBuff::Alloc(XrdXrootdAioTask* arp,
+                                          char *buff, int blen)
+{
+   XrdXrootdAioBuff *aiobuff;
+
 // Obtain a preallocated aio object
 //
    fqMutex.Lock();
@@ -89,13 +106,13 @@ XrdXrootdAioBuff *XrdXrootdAioBuff::Alloc(XrdXrootdAioTask* arp)
 
 // If we have no object, create a new one.
 //
-   if (!aiobuff) aiobuff = new XrdXrootdAioBuff(arp, bP);
+   if (!aiobuff) aiobuff = new XrdXrootdAioBuff(arp, 0);
       else {aiobuff->reqP   = arp;
-            aiobuff->buffP  = bP;
+            aiobuff->buffP  = 0;
            }
     aiobuff->cksVec = 0;
-    aiobuff->sfsAio.aio_buf = bP->buff;
-    aiobuff->sfsAio.aio_nbytes = bP->bsize;
+    aiobuff->sfsAio.aio_buf = buff;
+    aiobuff->sfsAio.aio_nbytes = blen;
 
 // Update aio counters
 //
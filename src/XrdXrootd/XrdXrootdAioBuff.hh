@@ -44,6 +44,9 @@ public:
 static
 XrdXrootdAioBuff*       Alloc(XrdXrootdAioTask *arp);
 
+static
+XrdXrootdAioBuff*       Alloc(XrdXrootdAioTask *arp, char *buff, int blen);
+
         void            doneRead() override;
 
         void            doneWrite() override;
@@ -67,6 +67,8 @@
 
 #include "XrdXrootd/XrdXrootdAdmin.hh"
 #include "XrdXrootd/XrdXrootdCallBack.hh"
+#include "XrdXrootd/XrdXrootdDirSnap.hh"
+#include "XrdXrootd/XrdXrootdDirStat.hh"
 #include "XrdXrootd/XrdXrootdFile.hh"
 #include "XrdXrootd/XrdXrootdFileLock.hh"
 #include "XrdXrootd/XrdXrootdFileLock1.hh"
@@ -163,6 +165,8 @@ char                    *gpfLib  = 0;// Normally zero for default
 char                    *gpfParm = 0;
 char                    *SecLib;
 int                      tlsCache= XrdTlsContext::scNone;
+int                      tlsTktRot = 0;
+char                    *tlsTktKeys = 0;
 int                      asyncFlags = 0;
 
 static const int asDebug   = 0x01;
@@ -201,6 +205,7 @@ int XrdXrootdProtocol::Configure(char *parms, XrdProtocol_Config *pi)
    SI           = new XrdXrootdStats(pi->Stats);
    XrdXrootd::SI= SI;
    Sched        = pi->Sched; XrdXrootd::Sched = pi->Sched;
+   XrdXrootdDirStat::Sched = pi->Sched;
    BPool        = pi->BPool; XrdXrootd::BPool = pi->BPool;
    hailWait     = pi->hailWait;
    readWait     = pi->readWait;
@@ -598,6 +603,7 @@ int XrdXrootdProtocol::Config(const char *ConfigFN)
              else if TS_Xeq("bindif",        xbif);
              else if TS_Xeq("chksum",        xcksum);
              else if TS_Xeq("diglib",        xdig);
+             else if TS_Xeq("dirlist",       xdirl);
              else if TS_Xeq("export",        xexp);
              else if TS_Xeq("fslib",         xfsl);
              else if TS_Xeq("fsoverload",    xfso);
@@ -638,7 +644,11 @@ int XrdXrootdProtocol::Config(const char *ConfigFN)
            NoGo = 1;
           } else {
            static const char *sessID = "xroots";
+           std::string eMsg;
            tlsCtx->SessionCache(tlsCache, sessID, 6);
+           if ((tlsTktRot || tlsTktKeys)
+           &&  !tlsCtx->SessionTickets(tlsTktRot, tlsTktKeys, &eMsg))
+              {eDest.Say("Config failure: ", eMsg.c_str()); NoGo = 1;}
           }
       }
 
@@ -862,8 +872,8 @@ int XrdXrootdProtocol::ConfigSecurity(XrdOucEnv &xEnv, const char *cfn)
                                        [maxtot <mtot>] [segsize <segsize>]
                                        [minsize <iosz>] [maxstalls <cnt>]
                                        [timeout <tos>]
-                                       [Debug] [force] [syncw] [off]
-                                       [nocache] [nosf]
+                                       [Debug] [force] [syncw] [syncrv]
+                                       [off] [nocache] [nosf]
 
              <aiopl>  maximum number of async req per link. Default 8.
              <msegs>  maximum number of async ops per request. Default 8.
@@ -883,6 +893,7 @@ int XrdXrootdProtocol::ConfigSecurity(XrdOucEnv &xEnv, const char *cfn)
              force    Uses async i/o for all requests, even when not explicitly
                       requested (this is compatible with synchronous clients).
              syncw    Use synchronous i/o for write requests.
+             syncrv   Use synchronous i/o for readv requests.
              off      Disables async i/o
              nocache  Disables async I/O is this is a caching proxy.
              nosf     Disables use of sendfile to send data to the client.
@@ -895,6 +906,7 @@ int XrdXrootdProtocol::xasync(XrdOucStream &Config)
     char *val;
     int  i, ppp;
     int  V_force=-1, V_syncw = -1, V_off = -1, V_mstall = -1, V_nosf = -1;
+    int  V_syncrv = -1;
     int  V_limit=-1, V_msegs=-1, V_mtot=-1, V_minsz=-1, V_segsz=-1;
     int  V_minsf=-1, V_debug=-1, V_noca=-1, V_tmo=-1;
     long long llp;
@@ -906,6 +918,7 @@ int XrdXrootdProtocol::xasync(XrdOucStream &Config)
         {"off",       -1, &V_off,   ""},
         {"nocache",   -1, &V_noca,  ""},
         {"nosf",      -1, &V_nosf,  ""},
+        {"syncrv",    -1, &V_syncrv,""},
         {"syncw",     -1, &V_syncw, ""},
         {"limit",      0, &V_limit, "async limit"},
         {"segsize", 4096, &V_segsz, "async segsize"},
@@ -991,6 +1004,7 @@ int XrdXrootdProtocol::xasync(XrdOucStream &Config)
    if (V_force > 0) as_force     = true;
    if (V_off   > 0) as_aioOK     = false;
    if (V_syncw > 0) as_syncw     = true;
+   if (V_syncrv> 0) as_syncrv    = true;
    if (V_noca  > 0) asyncFlags  |= asNoCache;
    if (V_nosf  > 0) as_nosf      = true;
    if (V_minsf > 0) as_minsfsz   = V_minsf;
@@ -1199,6 +1213,62 @@ int XrdXrootdProtocol::xdig(XrdOucStream &Config)
    return 0;
 }
 
+/******************************************************************************/
+/*                                 x d i r l                                  */
+/******************************************************************************/
+
+/* Function: xdirl
+
+   Purpose:  To parse the directive: dirlist [pagemax <n>] [snapshots <n>]
+                                             [statbatch <n>] [statjobs <n>]
+
+             pagemax   maximum number of entries returned in a single page
+                       when the client asks for a paged listing.
+             snapshots maximum number of paged listings per client whose
+                       sorted directory snapshot is kept in memory between
+                       pages (0 disables keeping them).
+             statbatch number of entries stat'ed at a time when the file
+                       system does not return stat information on its own.
+             statjobs  maximum number of parallel stat jobs for a batch.
+
+  Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdXrootdProtocol::xdirl(XrdOucStream &Config)
+{
+   static struct dlopts {const char *opname; int minv; int *oploc;
+                         const char *opmsg;} dlopts[] =
+       {
+        {"pagemax",   1, &dirPageMax,                "dirlist pagemax"},
+        {"snapshots", 0, &XrdXrootdDirSnapTab::maxSnaps,"dirlist snapshots"},
+        {"statbatch", 1, &dirStatBatch,              "dirlist statbatch"},
+        {"statjobs",  1, &XrdXrootdDirStat::maxPar,  "dirlist statjobs"}
+       };
+   int i, num, numopts = sizeof(dlopts)/sizeof(struct dlopts);
+   char *val;
+
+   if (!(val = Config.GetWord()))
+      {eDest.Emsg("Config", "dirlist option not specified"); return 1;}
+   while (val)
+         {for (i = 0; i < numopts; i++)
+              if (!strcmp(val, dlopts[i].opname))
+                 {if (!(val = Config.GetWord()))
+                     {eDest.Emsg("Config", "dirlist", dlopts[i].opname,
+                                 "value not specified");
+                      return 1;
+                     }
+                  if (XrdOuca2x::a2i(eDest, dlopts[i].opmsg, val, &num,
+                                     dlopts[i].minv)) return 1;
+                  *dlopts[i].oploc = num;
+                  break;
+                 }
+          if (i >= numopts)
+             eDest.Say("Config warning: ignoring invalid dirlist option '",val,"'.");
+          val = Config.GetWord();
+         }
+   return 0;
+}
+
 /******************************************************************************/
 /*                                  x e x p                                   */
 /******************************************************************************/
@@ -2073,11 +2143,18 @@ int XrdXrootdProtocol::xtls(XrdOucStream &Config)
 /* Function: xtlsr
 
    Purpose:  To parse the directive: tlsreuse off | on [flush <ft>[h|m|s]]
+                                                         [rotate <rt>[h|m|s]]
+                                                         [keyfile <path>]
 
              off       turns off the TLS session reuse cache.
              on        turns on  the TLS session reuse cache.
              <ft>      sets the cache flush frequency. the default is set
                        by the TLS libraries and is typically connection count.
+             <rt>      issues session tickets with keys that are rotated every
+                       <rt> time units (minimum 60 seconds).
+             <path>    issues session tickets with keys read from <path> which
+                       may be shared by all servers in a cluster. The file is
+                       re-read when it changes and rotate is then ignored.
 
   Output: 0 upon success or !0 upon failure.
 */
@@ -2097,6 +2174,8 @@ int XrdXrootdProtocol::xtlsr(XrdOucStream &Config)
 //
    if (!strcmp(val, "off"))
       {tlsCache = XrdTlsContext::scOff;
+       tlsTktRot = 0;
+       if (tlsTktKeys) {free(tlsTktKeys); tlsTktKeys = 0;}
        return 0;
       }
 
@@ -2108,18 +2187,39 @@ int XrdXrootdProtocol::xtlsr(XrdOucStream &Config)
                      return 0;
                     }
        tlsCache = XrdTlsContext::scSrvr;
-       if (!(val = Config.GetWord())) return 0;
-       if (!strcmp(val, "flush" ))
-            {if (!(val = Config.GetWord()))
-                {eDest.Emsg("Config", "tlsreuse flush value not specified");
-                 return 1;
+       while((val = Config.GetWord()))
+            {if (!strcmp(val, "flush" ))
+                {if (!(val = Config.GetWord()))
+                    {eDest.Emsg("Config","tlsreuse flush value not specified");
+                     return 1;
+                    }
+                 if (XrdOuca2x::a2tm(eDest,"tlsreuse flush",val,&num,1))
+                    return 1;
+                 if (num < 60) num = 60;
+                    else if (num > XrdTlsContext::scFMax)
+                             num = XrdTlsContext::scFMax;
+                 tlsCache |= num;
+                }
+             else if (!strcmp(val, "rotate"))
+                {if (!(val = Config.GetWord()))
+                    {eDest.Emsg("Config","tlsreuse rotate value not specified");
+                     return 1;
+                    }
+                 if (XrdOuca2x::a2tm(eDest,"tlsreuse rotate",val,&num,60))
+                    return 1;
+                 tlsTktRot = num;
+                }
+             else if (!strcmp(val, "keyfile"))
+                {if (!(val = Config.GetWord()) || *val != '/')
+                    {eDest.Emsg("Config","tlsreuse keyfile path not specified");
+                     return 1;
+                    }
+                 if (tlsTktKeys) free(tlsTktKeys);
+                 tlsTktKeys = strdup(val);
                 }
-             if (XrdOuca2x::a2tm(eDest,"tlsreuse flush",val,&num,1)) return 1;
-             if (num < 60) num = 60;
-                else if (num > XrdTlsContext::scFMax)
-                         num = XrdTlsContext::scFMax;
-             tlsCache |= num;
+             else break;
             }
+       if (!val) return 0;
       }
 
 // We have a bad keyword
@@ -0,0 +1,136 @@
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d X r o o t d D i r S n a p . c c                    */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+
+#include "XrdSfs/XrdSfsInterface.hh"
+#include "XrdXrootd/XrdXrootdDirSnap.hh"
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+int XrdXrootdDirSnapTab::maxSnaps = 8;
+
+/******************************************************************************/
+/*                                  F i n d                                   */
+/******************************************************************************/
+
+int XrdXrootdDirSnap::Find(const char *after)
+{
+   if (!after || !*after) return 0;
+   return std::upper_bound(Names.begin(), Names.end(), std::string(after))
+        - Names.begin();
+}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdXrootdDirSnapTab::~XrdXrootdDirSnapTab()
+{
+   for (auto &ent : snapTab) delete ent.second;
+}
+
+/******************************************************************************/
+/*                                   G e t                                    */
+/******************************************************************************/
+
+XrdXrootdDirSnap *XrdXrootdDirSnapTab::Get(const std::string &key,
+                                           const char *after,
+                                           XrdSfsDirectory *dp)
+{
+   XrdXrootdDirSnap *snap;
+   const char *dname;
+
+// A listing that continues where a previous page ended uses its snapshot
+//
+   if (after && *after)
+      {std::string sKey(key + '\n' + after);
+       tabMutex.Lock();
+       auto it = snapTab.find(sKey);
+       if (it != snapTab.end())
+          {snap = it->second;
+           snapTab.erase(it);
+           tabMutex.UnLock();
+           return snap;
+          }
+       tabMutex.UnLock();
+      }
+
+// Read the directory and sort the entries so that we can page through them
+//
+   snap = new XrdXrootdDirSnap(key);
+   while((dname = dp->nextEntry()))
+        {if (dname[0] == '.' && (!dname[1] || (dname[1] == '.' && !dname[2])))
+            continue;
+         snap->Names.emplace_back(dname);
+        }
+   std::sort(snap->Names.begin(), snap->Names.end());
+   return snap;
+}
+
+/******************************************************************************/
+/*                                   P u t                                    */
+/******************************************************************************/
+
+void XrdXrootdDirSnapTab::Put(XrdXrootdDirSnap *snap, const std::string &cursor)
+{
+   XrdSysMutexHelper mHelp(tabMutex);
+   std::string sKey(snap->sKey + '\n' + cursor);
+
+// Nothing is kept if so configured
+//
+   if (maxSnaps <= 0) {delete snap; return;}
+
+// Replace any snapshot left at the same place by an earlier listing
+//
+   auto it = snapTab.find(sKey);
+   if (it != snapTab.end())
+      {delete it->second;
+       snapTab.erase(it);
+      }
+
+// Make room by dropping the listing that has waited the longest
+//
+   if ((int)snapTab.size() >= maxSnaps)
+      {auto lru = snapTab.begin();
+       for (auto jt = snapTab.begin(); jt != snapTab.end(); ++jt)
+           if (jt->second->lastUse < lru->second->lastUse) lru = jt;
+       delete lru->second;
+       snapTab.erase(lru);
+      }
+
+// Keep the snapshot for the next page
+//
+   snap->lastUse = ++useCnt;
+   snapTab[sKey] = snap;
+}
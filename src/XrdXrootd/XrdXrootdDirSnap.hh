@@ -0,0 +1,113 @@
+#ifndef __XRDXROOTDDIRSNAP_HH__
+#define __XRDXROOTDDIRSNAP_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d X r o o t d D i r S n a p . h h                    */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+class XrdSfsDirectory;
+
+/******************************************************************************/
+/*                   C l a s s   X r d X r o o t d D i r S n a p              */
+/******************************************************************************/
+
+// A snapshot is the sorted list of the entries in a directory. It allows a
+// directory listing to be returned in pages, each page starting after the last
+// entry of the previous one. A snapshot belongs to a single listing; between
+// pages it is kept in the client's snapshot table (see below).
+//
+class XrdXrootdDirSnap
+{
+public:
+
+// Return the index of the first entry that sorts after the supplied name.
+//
+       int               Find(const char *after);
+
+std::vector<std::string> Names;     // Sorted entry names (excludes . and ..)
+
+private:
+friend class XrdXrootdDirSnapTab;
+
+       XrdXrootdDirSnap(const std::string &key) : sKey(key), lastUse(0) {}
+      ~XrdXrootdDirSnap() {}
+
+std::string sKey;
+long long   lastUse;
+};
+
+/******************************************************************************/
+/*                C l a s s   X r d X r o o t d D i r S n a p T a b           */
+/******************************************************************************/
+
+// Each client connection has one of these. A listing's snapshot is kept under
+// the listing's key (the path and CGI) and its cursor (the last entry sent),
+// so that the next page of that listing finds it no matter how many other
+// listings are in progress or whether the directory changed meanwhile. It is
+// released once the last page was sent, when the client disconnects or when
+// the client has more than maxSnaps listings in progress, in which case the
+// one that has waited the longest goes.
+//
+class XrdXrootdDirSnapTab
+{
+public:
+
+// Get the snapshot for the listing identified by key that continues after the
+// named entry. A new one is made from the open directory object if there is
+// none or the listing starts anew. The caller owns the snapshot until it is
+// handed back via Put() or deleted via Drop().
+//
+XrdXrootdDirSnap *Get(const std::string &key, const char *after,
+                      XrdSfsDirectory *dp);
+
+// Release a snapshot.
+//
+static void       Drop(XrdXrootdDirSnap *snap) {delete snap;}
+
+// Keep a snapshot for the page that follows the cursor entry.
+//
+void              Put(XrdXrootdDirSnap *snap, const std::string &cursor);
+
+static int        maxSnaps;  // Maximum number of listings kept per client
+
+                  XrdXrootdDirSnapTab() : useCnt(0) {}
+                 ~XrdXrootdDirSnapTab();
+
+private:
+
+XrdSysMutex                              tabMutex;
+std::map<std::string, XrdXrootdDirSnap*> snapTab;
+long long                                useCnt;
+};
+#endif
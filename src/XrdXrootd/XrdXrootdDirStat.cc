@@ -0,0 +1,200 @@
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d X r o o t d D i r S t a t . c c                    */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+
+#include "Xrd/XrdJob.hh"
+#include "Xrd/XrdScheduler.hh"
+#include "XrdOuc/XrdOucErrInfo.hh"
+#include "XrdSfs/XrdSfsInterface.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdXrootd/XrdXrootdDirStat.hh"
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+XrdScheduler *XrdXrootdDirStat::Sched   = 0;
+int           XrdXrootdDirStat::maxPar  = 8;
+int           XrdXrootdDirStat::minEnts = 16;
+
+/******************************************************************************/
+/*             C l a s s   X r d X r o o t d D i r S t a t W o r k            */
+/******************************************************************************/
+
+// The entries are split into slices that the caller and the scheduled jobs
+// take in turn. The caller keeps taking slices until none are left and then
+// waits only for slices that others are working on, never for a job that is
+// still queued as the scheduler may have no thread to give it. Jobs that run
+// after all slices were taken simply let go. The last one out deletes this.
+//
+class XrdXrootdDirStatWork
+{
+public:
+
+void Release() {workCV.Lock();
+                bool last = (--refs == 0);
+                workCV.UnLock();
+                if (last) delete this;
+               }
+
+void Wait() {workCV.Lock(); while(busy) workCV.Wait(); workCV.UnLock();}
+
+void Work();
+
+     XrdXrootdDirStatWork(XrdXrootdDirStat *dsp, XrdXrootdDirStat::Ent *ep,
+                          int n, int perjob, int nrefs)
+                         : workCV(0), dsP(dsp), ents(ep), num(n),
+                           perJob(perjob), next(0), busy(0), refs(nrefs) {}
+    ~XrdXrootdDirStatWork() {}
+
+private:
+XrdSysCondVar          workCV;
+XrdXrootdDirStat      *dsP;
+XrdXrootdDirStat::Ent *ents;
+int                    num;
+int                    perJob;
+int                    next;   // First entry not yet taken
+int                    busy;   // Slices being worked on
+int                    refs;
+};
+
+void XrdXrootdDirStatWork::Work()
+{
+   int at, n;
+
+   workCV.Lock();
+   while(next < num)
+        {at = next;
+         n = (num - at < perJob ? num - at : perJob);
+         next += n;
+         busy++;
+         workCV.UnLock();
+         dsP->Stat(ents+at, n);
+         workCV.Lock();
+         if (!--busy) workCV.Broadcast();
+        }
+   workCV.UnLock();
+}
+
+/******************************************************************************/
+/*              C l a s s   X r d X r o o t d D i r S t a t J o b             */
+/******************************************************************************/
+
+class XrdXrootdDirStatJob : public XrdJob
+{
+public:
+
+void DoIt() override {workP->Work(); workP->Release(); delete this;}
+
+     XrdXrootdDirStatJob(XrdXrootdDirStatWork *wp)
+                        : XrdJob("dirstat"), workP(wp) {}
+    ~XrdXrootdDirStatJob() {}
+
+private:
+XrdXrootdDirStatWork *workP;
+};
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdXrootdDirStat::XrdXrootdDirStat(XrdSfsFileSystem *fs, const char *dir,
+                                   const XrdSecEntity *cred, const char *tid,
+                                   int mid, int ucap, const char *cgi,
+                                   const char *cksT)
+                 : sfsP(fs), dPath(dir), client(cred), tident(tid),
+                   opaque(cgi), algT(cksT), monID(mid), uCap(ucap)
+{
+   if (dPath.empty() || dPath.back() != '/') dPath += '/';
+}
+
+/******************************************************************************/
+/*                                   R u n                                    */
+/******************************************************************************/
+
+void XrdXrootdDirStat::Run(std::vector<Ent> &ents)
+{
+   int num = ents.size(), numJobs, perJob, i;
+
+// Figure out how many jobs are worth running. Small batches are simply done
+// inline as it's not worth the scheduling overhead.
+//
+   numJobs = (Sched ? num / minEnts : 1);
+   if (numJobs > maxPar) numJobs = maxPar;
+   if (numJobs <= 1) {Stat(ents.data(), num); return;}
+
+// Hand off slices to the scheduler and work on them ourselves as well. Then
+// wait for whatever others are still working on.
+//
+   perJob = (num + numJobs - 1) / numJobs;
+   XrdXrootdDirStatWork *workP = new XrdXrootdDirStatWork(this, ents.data(),
+                                                          num, perJob, numJobs);
+   for (i = 1; i < numJobs; i++)
+       Sched->Schedule((XrdJob *)new XrdXrootdDirStatJob(workP));
+   workP->Work();
+   workP->Wait();
+   workP->Release();
+}
+
+/******************************************************************************/
+/* Private:                         S t a t                                   */
+/******************************************************************************/
+
+void XrdXrootdDirStat::Stat(Ent *ents, int num)
+{
+   XrdOucErrInfo myError(tident, monID, uCap);
+   std::string path;
+   const char *csData;
+   int rc;
+
+// Stat each entry (and get its checksum if so wanted) recording the outcome
+//
+   for (int i = 0; i < num; i++)
+       {Ent &ent = ents[i];
+        path = dPath + ent.name;
+        myError.Reset();
+        if (ent.needStat)
+           ent.sfsRC = sfsP->stat(path.c_str(), &ent.Stat, myError, client,
+                                  opaque);
+        if (ent.sfsRC != SFS_OK)
+           {ent.eCode = myError.getErrInfo();
+            ent.etext = myError.getErrText();
+            continue;
+           }
+        if (algT)
+           {rc = sfsP->chksum(XrdSfsFileSystem::csGet, algT, path.c_str(),
+                              myError, client, opaque);
+            csData = myError.getErrText();
+            if (rc != SFS_OK || !(*csData) || *csData == '!') csData = "none";
+            ent.cksum = csData;
+           }
+       }
+}
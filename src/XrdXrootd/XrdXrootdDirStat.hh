@@ -0,0 +1,93 @@
+#ifndef __XRDXROOTDDIRSTAT_HH__
+#define __XRDXROOTDDIRSTAT_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d X r o o t d D i r S t a t . h h                    */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+class XrdScheduler;
+class XrdSecEntity;
+class XrdSfsFileSystem;
+
+/******************************************************************************/
+/*                   C l a s s   X r d X r o o t d D i r S t a t              */
+/******************************************************************************/
+
+// This class obtains stat information (and optionally checksums) for a batch
+// of directory entries. Large batches are split and handed to the scheduler so
+// that the underlying file system is queried in parallel. The caller works on
+// the batch as well and returns once all of the entries have been processed.
+//
+class XrdXrootdDirStat
+{
+public:
+
+struct Ent
+      {std::string name;     // Entry name (input)
+       std::string cksum;    // Checksum value when requested
+       std::string etext;    // Error text if sfsRC is not SFS_OK
+       struct stat Stat;
+       int         sfsRC;    // SFS_OK or the stat() return code
+       int         eCode;    // Error code if sfsRC is not SFS_OK
+       bool        needStat; // False if Stat is already valid
+
+       Ent(const char *dname) : name(dname), sfsRC(0), eCode(0),
+                                needStat(true) {}
+      };
+
+void  Run(std::vector<Ent> &ents);
+
+      XrdXrootdDirStat(XrdSfsFileSystem *fs, const char *dir,
+                       const XrdSecEntity *cred, const char *tid, int mid,
+                       int ucap, const char *opaque, const char *cksT=0);
+
+     ~XrdXrootdDirStat() {}
+
+static XrdScheduler *Sched;
+static int           maxPar;  // Maximum number of parallel stat jobs
+static int           minEnts; // Minimum number of entries per job
+
+private:
+friend class XrdXrootdDirStatWork;
+
+void  Stat(Ent *ents, int num);
+
+XrdSfsFileSystem   *sfsP;
+std::string         dPath;
+const XrdSecEntity *client;
+const char         *tident;
+const char         *opaque;
+const char         *algT;
+int                 monID;
+int                 uCap;
+};
+#endif
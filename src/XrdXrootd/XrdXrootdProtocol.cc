@@ -47,6 +47,7 @@
 #include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysTimer.hh"
 #include "XrdTls/XrdTls.hh"
+#include "XrdXrootd/XrdXrootdDirSnap.hh"
 #include "XrdXrootd/XrdXrootdFile.hh"
 #include "XrdXrootd/XrdXrootdFileLock.hh"
 #include "XrdXrootd/XrdXrootdFileLock1.hh"
@@ -135,6 +136,7 @@ bool                  XrdXrootdProtocol::as_force     = false;
 bool                  XrdXrootdProtocol::as_aioOK     = true;
 bool                  XrdXrootdProtocol::as_nosf      = false;
 bool                  XrdXrootdProtocol::as_syncw     = false;
+bool                  XrdXrootdProtocol::as_syncrv    = false;
 
 const char           *XrdXrootdProtocol::myInst  = 0;
 const char           *XrdXrootdProtocol::TraceID = "Protocol";
@@ -156,6 +158,9 @@ int                   XrdXrootdProtocol::PrepareLimit = -1;
 bool                  XrdXrootdProtocol::PrepareAlt = false;
 bool                  XrdXrootdProtocol::LimitError = true;
 
+int                   XrdXrootdProtocol::dirPageMax   = 100000;
+int                   XrdXrootdProtocol::dirStatBatch = 512;
+
 struct XrdXrootdProtocol::RD_Table XrdXrootdProtocol::Route[RD_Num];
 struct XrdXrootdProtocol::RC_Table XrdXrootdProtocol::RouteClient;
 int                   XrdXrootdProtocol::OD_Stall = 33;
@@ -1103,6 +1108,10 @@ void XrdXrootdProtocol::Cleanup()
        FTab = 0;
       }
 
+// Release the snapshots of any unfinished paged listings
+//
+   if (DirSnaps) {delete DirSnaps; DirSnaps = 0;}
+
 // Handle statistics
 //
    SI->statsMutex.Lock();
@@ -1474,6 +1483,7 @@ void XrdXrootdProtocol::Reset()
    argp               = 0;
    Link               = 0;
    FTab               = 0;
+   DirSnaps           = 0;
    pmHandle           = 0;
    ResumePio          = 0;
    Resume             = 0;
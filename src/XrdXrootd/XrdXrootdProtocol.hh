@@ -30,6 +30,7 @@
 /******************************************************************************/
  
 #include <cstdlib>
+#include <string>
 #include <unistd.h>
 #include <sys/types.h>
 
@@ -81,6 +82,7 @@ class XrdSecProtocol;
 class XrdBuffer;
 class XrdLink;
 class XrdTlsContext;
+class XrdXrootdDirSnapTab;
 class XrdXrootdFile;
 class XrdXrootdFileLock;
 class XrdXrootdFileTable;
@@ -92,7 +94,9 @@ class XrdXrootdRedirPI;
 class XrdXrootdStats;
 class XrdXrootdXPath;
 
+struct XrdOucIOVec;
 struct XrdSfsFACtl;
+struct XrdXrootdDirBuff;
 struct XrdXrootdWVInfo;
 
 /******************************************************************************/
@@ -232,6 +236,7 @@ static bool          as_force;     // aio to be forced
 static bool          as_aioOK;     // aio is enabled
 static bool          as_nosf;      // sendfile is disabled
 static bool          as_syncw;     // writes to be synchronous
+static bool          as_syncrv;    // readv to be synchronous
 
 private:
 
@@ -253,7 +258,9 @@ enum RD_func {RD_chmod = 0, RD_chksum,  RD_dirlist, RD_locate, RD_mkdir,
        int   do_Clone();
        int   do_Close();
        int   do_Dirlist();
-       int   do_DirStat(XrdSfsDirectory *dp, char *pbuff, char *opaque);
+       int   do_DirPage(XrdSfsDirectory *dp, char *opaque, int pgSize,
+                        const char *after);
+       int   do_DirStat(XrdSfsDirectory *dp, char *opaque);
        int   do_Endsess();
        int   do_FAttr();
        int   do_gpFile();
@@ -279,12 +286,14 @@ enum RD_func {RD_chmod = 0, RD_chksum,  RD_dirlist, RD_locate, RD_mkdir,
        int   do_Qconf();
        int   do_QconfCX(XrdOucTokenizer &qcargs, char *val);
        int   do_Qfh();
+       int   do_Qfread();
        int   do_Qopaque(short);
        int   do_Qspace();
        int   do_Query();
        int   do_Qxattr();
        int   do_Read();
        int   do_ReadV();
+       bool  do_ReadVAio(XrdOucIOVec *rdVec, int rdVecNum, int Quantum);
        int   do_ReadAll();
        int   do_ReadNone(int &retc, int &pathID);
        int   do_Rm();
@@ -333,6 +342,12 @@ static int   rpCheck(char *fn, char **opaque);
        int   rpEmsg(const char *op, char *fn);
        int   vpEmsg(const char *op, char *fn);
 static int   CheckTLS(const char *tlsProt);
+       int   DirDone(XrdXrootdDirBuff &xb);
+       int   DirEmit(XrdXrootdDirBuff &xb, const char *dname,
+                     struct stat *Stat, const char *algT,
+                     const char *cksum, int statSz);
+std::string  DirSnapKey(const char *opaque);
+       void  QfreadAcct(const char *fn, long long fsize, int rlen);
 static bool  ConfigFS(XrdOucEnv &xEnv, const char *cfn);
 static bool  ConfigFS(const char *path, XrdOucEnv &xEnv, const char *cfn);
 static bool  ConfigGStream(XrdOucEnv &myEnv, XrdOucEnv *urEnv);
@@ -342,6 +357,7 @@ static int   Squash(char *);
 static int   xapath(XrdOucStream &Config);
 static int   xasync(XrdOucStream &Config);
 static int   xcksum(XrdOucStream &Config);
+static int   xdirl(XrdOucStream &Config);
 static int   xbif(XrdOucStream &Config);
 static int   xdig(XrdOucStream &Config);
 static int   xexp(XrdOucStream &Config);
@@ -514,6 +530,7 @@ long long                  totReadP;     // Bytes
 XrdLink                   *Link;
 XrdBuffer                 *argp;
 XrdXrootdFileTable        *FTab;
+XrdXrootdDirSnapTab       *DirSnaps;
 XrdXrootdMonitor::User     Monitor;
 XrdNetPMark::Handle       *pmHandle;
 int                        clientPV; // Protocol version + capabilities
@@ -632,6 +649,11 @@ static bool                LimitError;  // Indicates that hitting a limit should
 int                        PrepareCount;
 static int                 PrepareLimit;
 
+// Directory listing parameters
+//
+static int                 dirPageMax;   // Maximum entries in a dirlist page
+static int                 dirStatBatch; // Entries stat'ed in parallel
+
 // Buffers to handle client requests
 //
 XrdXrootdReqID             ReqID;
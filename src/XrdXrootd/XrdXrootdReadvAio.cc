@@ -0,0 +1,407 @@
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d X r o o t d R e a d v A i o . c c                   */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "Xrd/XrdBuffer.hh"
+#include "Xrd/XrdLink.hh"
+#include "Xrd/XrdScheduler.hh"
+#include "XProtocol/XProtocol.hh"
+#include "XrdSfs/XrdSfsInterface.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+#include "XrdXrootd/XrdXrootdAioBuff.hh"
+#include "XrdXrootd/XrdXrootdFile.hh"
+#include "XrdXrootd/XrdXrootdReadvAio.hh"
+#include "XrdXrootd/XrdXrootdTrace.hh"
+
+#define TRACELINK dataLink
+ 
+/******************************************************************************/
+/*                        G l o b a l   S t a t i c s                         */
+/******************************************************************************/
+
+extern XrdSysTrace  XrdXrootdTrace;
+
+namespace XrdXrootd
+{
+extern XrdBuffManager *BPool;
+extern XrdSysError     eLog;
+extern XrdScheduler   *Sched;
+}
+using namespace XrdXrootd;
+  
+/******************************************************************************/
+/*                       S t a t i c   M e m e b e r s                        */
+/******************************************************************************/
+
+const char *XrdXrootdReadvAio::TraceID = "ReadvAio";
+  
+/******************************************************************************/
+/*                         L o c a l   S t a t i c s                          */
+/******************************************************************************/
+
+namespace
+{
+XrdSysMutex        fqMutex;
+XrdXrootdReadvAio *fqFirst = 0;
+int                numFree = 0;
+
+static const int   maxKeep = 16; // Keep in reserve
+
+static const int   hdrSZ = sizeof(readahead_list);
+}
+
+/******************************************************************************/
+/*                                 A l l o c                                  */
+/******************************************************************************/
+  
+XrdXrootdReadvAio *XrdXrootdReadvAio::Alloc(XrdXrootdProtocol *protP,
+                                            XrdXrootdResponse &resp,
+                                            XrdXrootdFile     *fP)
+{
+   XrdXrootdReadvAio *reqP;
+
+// Obtain a preallocated aio request object
+//
+   fqMutex.Lock();
+   if ((reqP = fqFirst))
+      {fqFirst = reqP->nextRdvA;
+       numFree--;
+      }
+   fqMutex.UnLock();
+
+// If we have no object, create a new one
+//
+   if (!reqP) reqP = new XrdXrootdReadvAio;
+
+// Initialize the object and return it
+//
+   reqP->Init(protP, resp, fP);
+   reqP->nextRdvA = 0;
+   return reqP;
+}
+
+/******************************************************************************/
+/* Private:                     c a n I s s u e                               */
+/******************************************************************************/
+
+bool XrdXrootdReadvAio::canIssue()
+{
+// We can issue another read if there is one, we are not at our limit, and
+// there is space for it in a response buffer.
+//
+   if (isDone || nextSeg >= (int)rvSegs.size()
+   ||  inFlight >= XrdXrootdProtocol::as_maxperreq) return false;
+   if (numWins < maxWins) return true;
+
+   rvWin &lastWin = rvWins[(winBeg+numWins-1) % maxWins];
+   return !lastWin.closed
+       &&  lastWin.used + rvSegs[nextSeg].size + hdrSZ <= rvQuantum;
+}
+  
+/******************************************************************************/
+/* Private:                      C o p y F 2 L                                */
+/******************************************************************************/
+  
+void XrdXrootdReadvAio::CopyF2L()
+{
+   XrdXrootdAioBuff *aioP;
+
+// Keep issuing reads while we can; otherwise wait for one to complete. After
+// each step, send any response buffer that has all of its data.
+//
+   do {if ((aioP = getBuff(!canIssue()))) Place(aioP);
+          else {if (isDone) break;
+                if (!canIssue())
+                   {SendError(EIDRM, "aio readv encountered an impossible "
+                                     "condition");
+                    eLog.Emsg("ReadvAio", "read logic error for",
+                                          dataLink->ID, dataFile->FileKey);
+                    break;
+                   }
+                if (!Issue()) break;
+               }
+      } while(Flush() && !isDone);
+
+// If we encountered a fatal link error then there is nothing more to do.
+// Do a quick drain if something is still in flight for logging purposes.
+// If the quick drain wasn't successful, then draining will be done in
+// the background; which, of course, might never complete. Otherwise, recycle.
+//
+   if (!inFlight) Recycle(true);
+      else Recycle(Drain());
+}
+  
+/******************************************************************************/
+/*                                  D o I t                                   */
+/******************************************************************************/
+
+void XrdXrootdReadvAio::DoIt()
+{
+// Readv runs disconnected as it never reads from the link.
+//
+   CopyF2L();
+}
+
+/******************************************************************************/
+/* Private:                         F l u s h                                 */
+/******************************************************************************/
+
+bool XrdXrootdReadvAio::Flush()
+{
+   bool final;
+   int rc;
+
+// Send every completed response buffer in order. The last one carries the
+// final status. Should sending fail the link is dead.
+//
+   while(numWins && !isDone)
+        {rvWin &theWin = rvWins[winBeg];
+         if (!theWin.closed || theWin.pending) break;
+         final = theWin.endSeg >= (int)rvSegs.size();
+         rc = Response.Send((final ? kXR_ok : kXR_oksofar),
+                            theWin.bP->buff, theWin.used);
+         TRACEP(FSAIO, "aioV send " <<theWin.used <<" bytes ending segment "
+                       <<theWin.endSeg <<(final ? " final" : "") <<" rc=" <<rc);
+         BPool->Release(theWin.bP); theWin.bP = 0;
+         winBeg = (winBeg+1) % maxWins;
+         numWins--;
+         if (rc)
+            {isDone = true;
+             aioState |= aioDead;
+             return false;
+            }
+         if (final) isDone = true;
+        }
+   return true;
+}
+  
+/******************************************************************************/
+/* Private:                         I s s u e                                 */
+/******************************************************************************/
+
+bool XrdXrootdReadvAio::Issue()
+{
+   XrdXrootdAioBuff *aioP;
+   XrdOucIOVec      &seg = rvSegs[nextSeg];
+   rvWin            *wP  = (numWins ? &rvWins[(winBeg+numWins-1) % maxWins] : 0);
+   readahead_list    respHdr;
+   char             *bP;
+   int               rc;
+
+// Place this segment into the current response buffer unless it won't fit.
+// In that case, close it off and start a new one.
+//
+   if (!wP || wP->closed || wP->used + seg.size + hdrSZ > rvQuantum)
+      {if (wP) wP->closed = true;
+       wP = &rvWins[(winBeg+numWins) % maxWins];
+       if (!(wP->bP = BPool->Obtain(rvQuantum)))
+          {SendError(ENOMEM, "insufficient memory");
+           return false;
+          }
+       numWins++;
+       wP->used    = 0;
+       wP->pending = 0;
+       wP->closed  = false;
+      }
+
+// Construct the header for this segment
+//
+   bP = wP->bP->buff + wP->used;
+   memcpy(respHdr.fhandle, &seg.info, sizeof(respHdr.fhandle));
+   respHdr.rlen   = htonl(seg.size);
+   respHdr.offset = htonll(seg.offset);
+   memcpy(bP, &respHdr, hdrSZ);
+   wP->used  += hdrSZ + seg.size;
+   wP->endSeg = ++nextSeg;
+   if (nextSeg >= (int)rvSegs.size()) wP->closed = true;
+
+// Issue the read for this segment directly into the response buffer
+//
+   if (!seg.size) return true;
+   aioP = XrdXrootdAioBuff::Alloc(this, bP+hdrSZ, seg.size);
+   aioP->sfsAio.aio_offset = seg.offset;
+   dataFile = rvFile[nextSeg-1];
+   wP->pending++;
+   if ((rc = dataFile->XrdSfsp->read((XrdSfsAio *)aioP)) != SFS_OK)
+      {SendFSError(rc);
+       aioP->Recycle();
+       return false;
+      }
+   inFlight++;
+   TRACEP(FSAIO, "aioV beg " <<seg.size <<'@' <<seg.offset
+                 <<" fh=" <<seg.info <<" inF=" <<int(inFlight));
+   return true;
+}
+  
+/******************************************************************************/
+/* Private:                         P l a c e                                 */
+/******************************************************************************/
+
+void XrdXrootdReadvAio::Place(XrdXrootdAioBuff *aioP)
+{
+   char *aioBuff = (char *)aioP->sfsAio.aio_buf;
+
+// Do some tracing
+//
+   TRACEP(FSAIO,"aioV end "<<aioP->sfsAio.aio_nbytes
+              <<'@'<<aioP->sfsAio.aio_offset
+              <<" result="<<aioP->Result<<" D-S="<<isDone<<'-'<<int(Status)
+              <<" inF="<<int(inFlight));
+
+// Find the response buffer holding this data and account for it
+//
+   for (int i = 0; i < numWins; i++)
+       {rvWin &theWin = rvWins[(winBeg+i) % maxWins];
+        if (aioBuff >= theWin.bP->buff
+        &&  aioBuff <  theWin.bP->buff + theWin.used)
+           {theWin.pending--;
+            break;
+           }
+       }
+
+// Readv has no notion of a short read, we must get everything asked for
+//
+   if (!isDone && aioP->Result != (ssize_t)aioP->sfsAio.aio_nbytes)
+      {if (aioP->Result < 0) SendError(-aioP->Result, 0);
+          else SendError(ENODATA, "readv past EOF");
+      }
+   aioP->Recycle();
+}
+
+/******************************************************************************/
+/*                                  R e a d                                   */
+/******************************************************************************/
+
+void XrdXrootdReadvAio::Read(long long offs, int dlen)
+{
+// This object only handles vector reads
+//
+   Protocol->aioUpdReq(1);
+   SendError(ENOTSUP, "aio readv object used for read");
+   Recycle(true);
+}
+
+/******************************************************************************/
+/*                                 R e a d v                                  */
+/******************************************************************************/
+
+void XrdXrootdReadvAio::Readv(XrdOucIOVec *rdVec, XrdXrootdFile **fVec,
+                              int rdVnum, int quantum)
+{
+   int i, j;
+
+// Copy the read vector as the caller's copy is transient
+//
+   rvSegs.assign(rdVec, rdVec+rdVnum);
+   rvFile.assign(fVec,  fVec +rdVnum);
+   rvQuantum = quantum;
+   nextSeg   = 0;
+   winBeg    = numWins = 0;
+   aioState  = aioRead;
+
+// Reads run disconnected and are self-terminating, so we need to increase the
+// refcount for the link we will be using to prevent it from disapearing.
+// Each distinct file is also referenced so that it cannot go away on us.
+//
+   dataLink->setRef(1);
+   rvRefs.clear();
+   for (i = 0; i < rdVnum; i++)
+       {for (j = rvRefs.size()-1; j >= 0 && rvRefs[j] != fVec[i]; j--) {}
+        if (j < 0) {rvRefs.push_back(fVec[i]); fVec[i]->Ref(1);}
+       }
+   Protocol->aioUpdReq(1);
+
+// Schedule ourselves to run this asynchronously and return
+//
+   Sched->Schedule(this);
+}
+  
+/******************************************************************************/
+/*                               R e c y c l e                                */
+/******************************************************************************/
+
+void XrdXrootdReadvAio::Recycle(bool release)
+{
+// Update request count, file and link reference count
+//
+   if (!(aioState & aioHeld))
+      {Protocol->aioUpdReq(-1);
+       if (aioState & aioRead)
+          {for (int i = 0; i < (int)rvRefs.size(); i++) rvRefs[i]->Ref(-1);
+           rvRefs.clear();
+           dataLink->setRef(-1);
+          }
+       aioState |= aioHeld;
+      }
+
+// Do some tracing
+//
+   TRACEP(FSAIO,"aioV recycle"<<(release ? "" : " hold")
+                     <<" D-S="<<isDone<<'-'<<int(Status));
+
+// Place the object on the free queue if possible. Response buffers can only
+// be released once nothing is in flight as data may still arrive.
+//
+   if (release)
+      {while(numWins)
+            {BPool->Release(rvWins[winBeg].bP); rvWins[winBeg].bP = 0;
+             winBeg = (winBeg+1) % maxWins;
+             numWins--;
+            }
+       fqMutex.Lock();
+       if (numFree >= maxKeep)
+          {fqMutex.UnLock();
+           delete this;
+          } else {
+           nextRdvA = fqFirst;
+           fqFirst = this;
+           numFree++;
+           fqMutex.UnLock();
+          }
+      }
+}
+
+/******************************************************************************/
+/*                                 W r i t e                                  */
+/******************************************************************************/
+
+int XrdXrootdReadvAio::Write(long long offs, int dlen)
+{
+// This object only handles vector reads
+//
+   Protocol->aioUpdReq(1);
+   SendError(ENOTSUP, "aio readv object used for write");
+   Recycle(true);
+   return 0;
+}
@@ -0,0 +1,100 @@
+#ifndef __XRDXROOTDREADVAIO_HH__
+#define __XRDXROOTDREADVAIO_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d X r o o t d R e a d v A i o . h h                   */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <vector>
+
+#include "XrdOuc/XrdOucIOVec.hh"
+#include "XrdXrootd/XrdXrootdAioTask.hh"
+
+class XrdBuffer;
+class XrdXrootdAioBuff;
+class XrdXrootdFile;
+
+// A readv request is executed by placing each element into a response buffer
+// and reading its data via aio directly into the buffer. Buffers are sent, in
+// order, as soon as all of their reads complete. Up to as_maxperreq reads are
+// in flight at any one time, regardless of how many files are involved.
+  
+class XrdXrootdReadvAio : public XrdXrootdAioTask
+{
+public:
+
+static XrdXrootdReadvAio *Alloc(XrdXrootdProtocol *protP,
+                                XrdXrootdResponse &resp,
+                                XrdXrootdFile     *fP);
+
+       void               DoIt() override;
+
+       void               Read(long long offs, int dlen) override;
+
+       void               Readv(XrdOucIOVec *rdVec, XrdXrootdFile **fVec,
+                                int rdVnum, int quantum);
+
+       void               Recycle(bool release) override;
+
+       int                Write(long long offs, int dlen) override;
+
+private:
+
+         XrdXrootdReadvAio() : XrdXrootdAioTask("aio readv request"),
+                               winBeg(0), numWins(0) {}
+virtual ~XrdXrootdReadvAio() {}
+
+       bool               canIssue();
+       void               CopyF2L() override;
+       int                CopyL2F() override {return 0;}
+       bool               CopyL2F(XrdXrootdAioBuff *aioP) override
+                                 {return false;}
+       bool               Flush();
+       bool               Issue();
+       void               Place(XrdXrootdAioBuff *aioP);
+
+static const char        *TraceID;
+static const int          maxWins = 2;  // Response buffers in use at once
+
+struct rvWin {XrdBuffer *bP;
+              int        endSeg;        // Index of segment past the last
+              int        used;          // Bytes used in the buffer
+              int        pending;       // Reads not yet completed
+              bool       closed;        // No more segments will be added
+             };
+
+       std::vector<XrdOucIOVec>    rvSegs;
+       std::vector<XrdXrootdFile*> rvFile; // File for each segment
+       std::vector<XrdXrootdFile*> rvRefs; // Files we hold a reference to
+       rvWin              rvWins[maxWins];
+       int                winBeg;       // Index of oldest window
+       int                numWins;      // Number of windows in use
+       int                nextSeg;      // Next segment to be read
+       int                rvQuantum;    // Size of each response buffer
+};
+#endif
@@ -59,6 +59,8 @@
 #include "Xrd/XrdLinkCtl.hh"
 #include "XrdXrootd/XrdXrootdAioFob.hh"
 #include "XrdXrootd/XrdXrootdCallBack.hh"
+#include "XrdXrootd/XrdXrootdDirSnap.hh"
+#include "XrdXrootd/XrdXrootdDirStat.hh"
 #include "XrdXrootd/XrdXrootdFile.hh"
 #include "XrdXrootd/XrdXrootdFileLock.hh"
 #include "XrdXrootd/XrdXrootdJob.hh"
@@ -68,6 +70,7 @@
 #include "XrdXrootd/XrdXrootdPio.hh"
 #include "XrdXrootd/XrdXrootdPrepare.hh"
 #include "XrdXrootd/XrdXrootdProtocol.hh"
+#include "XrdXrootd/XrdXrootdReadvAio.hh"
 #include "XrdXrootd/XrdXrootdRedirHelper.hh"
 #include "XrdXrootd/XrdXrootdRedirPI.hh"
 #include "XrdXrootd/XrdXrootdStats.hh"
@@ -763,10 +766,27 @@ int XrdXrootdProtocol::do_Dirlist()
        return rc;
       }
 
+// Check if the caller wants a page of the listing
+//
+   if (opaque)
+      {XrdOucEnv dlEnv(opaque);
+       const char *pgVal = dlEnv.Get("xrd.dlpage");
+       if (pgVal)
+          {int pgSize = atoi(pgVal);
+           const char *after = dlEnv.Get("xrd.dlafter");
+           std::string last(after ? XrdOucUtils::UrlDecode(after) : "");
+           if (pgSize <= 0)
+              {dp->close(); delete dp;
+               return Response.Send(kXR_ArgInvalid, "Invalid dirlist page size");
+              }
+           return do_DirPage(dp, opaque, pgSize, last.c_str());
+          }
+      }
+
 // Check if the caller wants stat information as well
 //
    if (Request.dirlist.options[0] & (kXR_dstat | kXR_dcksm))
-      return do_DirStat(dp, ebuff, opaque);
+      return do_DirStat(dp, opaque);
 
 // Start retreiving each entry and place in a local buffer with a trailing new
 // line character (the last entry will have a null byte). If we cannot fit a
@@ -805,20 +825,141 @@ int XrdXrootdProtocol::do_Dirlist()
    return rc;
 }
 
+/******************************************************************************/
+/*                            d o _ D i r P a g e                             */
+/******************************************************************************/
+
+// A page of the listing is returned from a sorted snapshot of the directory
+// starting after the entry named by the client. The page may hold fewer entries
+// than requested (e.g. when limited by pagemax). The last page of the listing
+// ends with a "/" entry, a name no directory entry can have, so that the client
+// never has to infer the end of the listing from the size of a page.
+//
+int XrdXrootdProtocol::do_DirPage(XrdSfsDirectory *dp, char *opaque,
+                                  int pgSize, const char *after)
+{
+   XrdOucErrInfo myError(Link->ID, Monitor.Did, clientPV);
+   XrdXrootdDirBuff XB;
+   XrdXrootdDirSnap *snap;
+   std::string cursor;
+   char *algT = 0;
+   int i, beg, end, rc, statSz = 0;
+   bool doStat = (Request.dirlist.options[0] & (kXR_dstat | kXR_dcksm)) != 0;
+
+// Preprocess checksum request as in do_DirStat()
+//
+   if ((Request.dirlist.options[0] & kXR_dcksm) && JobLCL)
+      {char cksT[64];
+       algT = getCksType(opaque, cksT, sizeof(cksT));
+       if (!algT)
+          {char ebuf[1024];
+           snprintf(ebuf, sizeof(ebuf), "%s checksum not supported.", cksT);
+           dp->close(); delete dp;
+           return Response.Send(kXR_ServerError, ebuf);
+          }
+       statSz = XrdCksData::NameSize + (XrdCksData::ValuSize*2) + 8;
+      }
+   if (doStat) statSz += 160;
+
+// Continue the listing from its snapshot or take one if it starts anew
+//
+   if (!DirSnaps) DirSnaps = new XrdXrootdDirSnapTab;
+   snap = DirSnaps->Get(DirSnapKey(opaque), after, dp);
+   dp->close();
+   delete dp;
+
+// Indicate we support the dstat option, see do_DirStat()
+//
+   if (doStat)
+      {strcpy(XB.ebuff, ".\n0 0 0 0\n");
+       XB.buff += 10; XB.bleft -= 10;
+      }
+
+// Stat the entries on this page in parallel when so wanted and send them out.
+// Entries that vanished since the snapshot was taken are replaced by the ones
+// that follow so that only the last page of the listing is ever short.
+//
+   if (pgSize > dirPageMax) pgSize = dirPageMax;
+   XrdXrootdDirStat dirStat(osFS, argp->buff, CRED, Link->ID,
+                            Monitor.Did, clientPV, opaque, algT);
+   std::vector<XrdXrootdDirStat::Ent> ents;
+   int nNames = (int)snap->Names.size();
+   beg = snap->Find(after);
+   rc = 0;
+   while(!rc && XB.cnt < pgSize && beg < nNames)
+        {end = (nNames - beg > pgSize - XB.cnt ? beg + pgSize - XB.cnt : nNames);
+         ents.clear();
+         for (i = beg; i < end; i++) ents.emplace_back(snap->Names[i].c_str());
+         beg = end;
+         if (doStat) dirStat.Run(ents);
+         for (i = 0; i < (int)ents.size() && !rc; i++)
+             {XrdXrootdDirStat::Ent &ent = ents[i];
+              if (doStat && ent.sfsRC != SFS_OK)
+                 {if (ent.sfsRC == SFS_ERROR && ent.eCode == ENOENT) continue;
+                  XrdXrootdDirSnapTab::Drop(snap);
+                  myError.setErrInfo(ent.eCode, ent.etext.c_str());
+                  return fsError(ent.sfsRC, XROOTD_MON_STAT, myError,
+                                 argp->buff, opaque);
+                 }
+              rc = DirEmit(XB, ent.name.c_str(), (doStat ? &ent.Stat : 0),
+                           algT, ent.cksum.c_str(), statSz);
+              cursor = ent.name;
+             }
+        }
+
+// Keep the snapshot for the next page unless this one ends the listing, in
+// which case mark the end.
+//
+   if (rc || beg >= nNames) XrdXrootdDirSnapTab::Drop(snap);
+      else DirSnaps->Put(snap, (cursor.empty() ? after : cursor));
+   if (!rc && beg >= nNames)
+      {struct stat eStat;
+       memset(&eStat, 0, sizeof(eStat));
+       rc = DirEmit(XB, "/", (doStat ? &eStat : 0), 0, 0, statSz);
+      }
+   if (!rc) rc = DirDone(XB);
+
+   if (!rc) {TRACEP(FS, "dirpage entries=" <<XB.cnt <<" path=" <<argp->buff);}
+   return rc;
+}
+
+/******************************************************************************/
+/*                            D i r S n a p K e y                             */
+/******************************************************************************/
+
+// Snapshots are kept per client and only continue a listing of the same path
+// with the same CGI, as either may influence what the file system lists. The
+// paging CGI differs for each page and is therefore left out.
+//
+std::string XrdXrootdProtocol::DirSnapKey(const char *opaque)
+{
+   std::string key(argp->buff);
+   const char *cgi = opaque, *amp;
+   int n;
+
+   while(cgi && *cgi)
+        {if ((amp = index(cgi, '&'))) n = amp - cgi;
+            else n = strlen(cgi);
+         if (n && strncmp(cgi, "xrd.dlpage=", 11) && strncmp(cgi, "xrd.dlafter=", 12))
+            {key += '&'; key.append(cgi, n);}
+         cgi = (amp ? amp+1 : 0);
+        }
+   return key;
+}
+
 /******************************************************************************/
 /*                            d o _ D i r S t a t                             */
 /******************************************************************************/
 
-int XrdXrootdProtocol::do_DirStat(XrdSfsDirectory *dp, char *pbuff,
-                                                       char *opaque)
+int XrdXrootdProtocol::do_DirStat(XrdSfsDirectory *dp, char *opaque)
 {
    XrdOucErrInfo myError(Link->ID, Monitor.Did, clientPV);
+   XrdXrootdDirBuff XB;
    struct stat Stat;
-   char *buff, *dLoc, *algT = 0;
-   const char *csData, *dname;
-   int bleft, rc = 0, dlen, cnt = 0, statSz = 160;
+   char *algT = 0;
+   const char *dname;
+   int rc = 0, statSz = 160;
    bool manStat;
-   struct {char ebuff[8192]; char epad[512];} XB;
 
 // Preprocess checksum request. If we don't support checksums or if the
 // requested checksum type is not supported, ignore it.
@@ -829,6 +970,7 @@ int XrdXrootdProtocol::do_DirStat(XrdSfsDirectory *dp, char *pbuff,
        if (!algT)
           {char ebuf[1024];
            snprintf(ebuf, sizeof(ebuf), "%s checksum not supported.", cksT);
+           dp->close(); delete dp;
            return Response.Send(kXR_ServerError, ebuf);
           }
        statSz += XrdCksData::NameSize + (XrdCksData::ValuSize*2) + 8;
@@ -838,86 +980,115 @@ int XrdXrootdProtocol::do_DirStat(XrdSfsDirectory *dp, char *pbuff,
 //
    manStat = (dp->autoStat(&Stat) != SFS_OK);
 
-// Construct the path to the directory as we will be asking for stat calls
-// if the interface does not support autostat or returning checksums.
-//
-   if (manStat || algT)
-      {strcpy(pbuff, argp->buff);
-       dlen = strlen(pbuff);
-       if (pbuff[dlen-1] != '/') {pbuff[dlen] = '/'; dlen++;}
-       dLoc = pbuff+dlen;
-      } else dLoc = 0;
-
 // The initial leadin is a "dot" entry to indicate to the client that we
 // support the dstat option (older servers will not do that). It's up to the
 // client to issue individual stat requests in that case.
 //
    memset(&Stat, 0, sizeof(Stat));
    strcpy(XB.ebuff, ".\n0 0 0 0\n");
-   buff = XB.ebuff+10; bleft = sizeof(XB.ebuff)-10;
+   XB.buff += 10; XB.bleft -= 10;
 
 // Start retreiving each entry and place in a local buffer with a trailing new
 // line character (the last entry will have a null byte). If we cannot fit a
 // full entry in the buffer, send what we have with an OKSOFAR and continue.
-// This code depends on the fact that a directory entry will never be longer
-// than sizeof( ebuff)-1; otherwise, an infinite loop will result. No errors
-// are allowed to be reflected at this point.
+// When we need to stat or checksum the entries ourselves we do so for a batch
+// of entries at a time, in parallel. No errors are allowed to be reflected at
+// this point.
 //
-  dname = 0;
-  do {while(dname || (dname = dp->nextEntry()))
-           {dlen = strlen(dname);
-            if (dlen > 2 || dname[0] != '.' || (dlen == 2 && dname[1] != '.'))
-               {if ((bleft -= (dlen+1)) < 0 || bleft < statSz) break;
-                if (dLoc) strcpy(dLoc, dname);
-                if (manStat)
-                   {rc = osFS->stat(pbuff, &Stat, myError, CRED, opaque);
-                    if (rc == SFS_ERROR && myError.getErrInfo() == ENOENT)
-                       {dname = 0; continue;}
-                    if (rc != SFS_OK)
-                       return fsError(rc, XROOTD_MON_STAT, myError,
-                                          argp->buff, opaque);
-                   }
-                strcpy(buff, dname); buff += dlen; *buff = '\n'; buff++; cnt++;
-                dlen = StatGen(Stat, buff, sizeof(XB.epad));
-                bleft -= dlen; buff += (dlen-1);
-                if (algT)
-                   {int ec = osFS->chksum(XrdSfsFileSystem::csGet, algT,
-                                          pbuff, myError, CRED, opaque);
-                    csData = myError.getErrText();
-                    if (ec != SFS_OK || !(*csData) || *csData == '!')
-                       csData = "none";
-                    int n = snprintf(buff,sizeof(XB.epad)," [ %s:%s ]",
-                                     algT, csData);
-                    buff += n; bleft -= n;
+   if (manStat || algT)
+      {XrdXrootdDirStat dirStat(osFS, argp->buff, CRED, Link->ID,
+                                Monitor.Did, clientPV, opaque, algT);
+       std::vector<XrdXrootdDirStat::Ent> ents;
+       ents.reserve(dirStatBatch);
+       do {ents.clear();
+           while((int)ents.size() < dirStatBatch && (dname = dp->nextEntry()))
+                {if (dname[0] == '.'
+                 && (!dname[1] || (dname[1] == '.' && !dname[2]))) continue;
+                 ents.emplace_back(dname);
+                 if (!manStat)
+                    {ents.back().Stat = Stat;
+                     ents.back().needStat = false;
+                    }
+                }
+           dirStat.Run(ents);
+           for (auto &ent : ents)
+               {if (ent.sfsRC != SFS_OK)
+                   {if (ent.sfsRC == SFS_ERROR && ent.eCode == ENOENT) continue;
+                    dp->close(); delete dp;
+                    myError.setErrInfo(ent.eCode, ent.etext.c_str());
+                    return fsError(ent.sfsRC, XROOTD_MON_STAT, myError,
+                                   argp->buff, opaque);
                    }
-                *buff = '\n'; buff++;
+                if ((rc = DirEmit(XB, ent.name.c_str(), &ent.Stat, algT,
+                                  ent.cksum.c_str(), statSz))) break;
                }
-            dname = 0;
-           }
-       if (dname)
-          {rc = Response.Send(kXR_oksofar, XB.ebuff, buff-XB.ebuff);
-           buff = XB.ebuff; bleft = sizeof(XB.ebuff);
-           TRACEP(FS, "dirstat sofar n=" <<cnt <<" path=" <<argp->buff);
-          }
-     } while(!rc && dname);
+          } while(!rc && (int)ents.size() == dirStatBatch);
+      } else {
+       while(!rc && (dname = dp->nextEntry()))
+            {if (dname[0] == '.'
+             && (!dname[1] || (dname[1] == '.' && !dname[2]))) continue;
+             rc = DirEmit(XB, dname, &Stat, 0, 0, statSz);
+            }
+      }
 
 // Send the ending packet if we actually have one to send
 //
-   if (!rc)
-      {if (XB.ebuff == buff) rc = Response.Send();
-          else {*(buff-1) = '\0';
-                rc = Response.Send((void *)XB.ebuff, buff-XB.ebuff);
-               }
-      }
+   if (!rc) rc = DirDone(XB);
 
 // Close the directory
 //
    dp->close();
    delete dp;
-   if (!rc) {TRACEP(FS, "dirstat entries=" <<cnt <<" path=" <<argp->buff);}
+   if (!rc) {TRACEP(FS, "dirstat entries=" <<XB.cnt <<" path=" <<argp->buff);}
    return rc;
 }
 
+/******************************************************************************/
+/*                               D i r D o n e                                */
+/******************************************************************************/
+
+int XrdXrootdProtocol::DirDone(XrdXrootdDirBuff &xb)
+{
+   if (xb.ebuff == xb.buff) return Response.Send();
+   *(xb.buff-1) = '\0';
+   return Response.Send((void *)xb.ebuff, xb.buff-xb.ebuff);
+}
+
+/******************************************************************************/
+/*                               D i r E m i t                                */
+/******************************************************************************/
+
+// Add an entry, followed by its stat information when supplied, to the buffer.
+// If the entry does not fit, what we have is sent with an OKSOFAR first. This
+// depends on the fact that an entry is never longer than the buffer.
+//
+int XrdXrootdProtocol::DirEmit(XrdXrootdDirBuff &xb, const char *dname,
+                               struct stat *Stat, const char *algT,
+                               const char *cksum, int statSz)
+{
+   int rc, n, dlen = strlen(dname);
+
+   if (xb.bleft - (dlen+1) < statSz)
+      {rc = Response.Send(kXR_oksofar, xb.ebuff, xb.buff-xb.ebuff);
+       TRACEP(FS, "dirlist sofar n=" <<xb.cnt <<" path=" <<argp->buff);
+       xb.Reset();
+       if (rc) return rc;
+      }
+
+   strcpy(xb.buff, dname); xb.buff += dlen; *xb.buff = '\n'; xb.buff++;
+   xb.bleft -= (dlen+1); xb.cnt++;
+   if (Stat)
+      {n = StatGen(*Stat, xb.buff, sizeof(xb.epad));
+       xb.bleft -= n; xb.buff += (n-1);
+       if (algT)
+          {n = snprintf(xb.buff, sizeof(xb.epad), " [ %s:%s ]", algT, cksum);
+           xb.buff += n; xb.bleft -= n;
+          }
+       *xb.buff = '\n'; xb.buff++;
+      }
+   return 0;
+}
+
 /******************************************************************************/
 /*                            d o _ E n d s e s s                             */
 /******************************************************************************/
@@ -2484,6 +2655,7 @@ int XrdXrootdProtocol::do_Query()
           case kXR_Qconfig: return do_Qconf();
           case kXR_Qspace:  return do_Qspace();
           case kXR_Qxattr:  return do_Qxattr();
+          case kXR_QFread:  return do_Qfread();
           case kXR_QFSinfo:
           case kXR_Qopaque:
           case kXR_Qopaquf: return do_Qopaque(qopt);
@@ -2585,7 +2757,8 @@ int XrdXrootdProtocol::do_Read()
 // will use and if possible, do a fast dispatch.
 //
         if (IO.File->isMMapped) IO.Mode = XrdXrootd::IOParms::useMMap;
-   else if (IO.File->sfEnabled && !isTLS && IO.IOLen >= as_minsfsz
+   else if (IO.File->sfEnabled && (!isTLS || Link->sfTLS())
+        &&  IO.IOLen >= as_minsfsz
         &&  IO.Offset+IO.IOLen <= IO.File->Stats.fSize)
            IO.Mode = XrdXrootd::IOParms::useSF;
    else if (IO.File->AsyncMode && IO.IOLen >= as_miniosz
@@ -2815,6 +2988,12 @@ int XrdXrootdProtocol::do_ReadV()
 //
    Quantum = totSZ < maxTransz ? totSZ : maxTransz;
 
+// Run the request asynchronously if we can. If we can't, do it inline.
+//
+   if (as_aioOK && !as_syncrv && totSZ >= as_miniosz && FTab
+   &&  linkAioReq < as_maxperlnk && srvrAioOps < as_maxpersrv
+   &&  do_ReadVAio(rdVec, rdVBreak, Quantum)) return 0;
+
 // Now obtain the right size buffer
 //
    if ((Quantum < halfBSize && Quantum > 1024) || Quantum > argp->bsize)
@@ -2900,6 +3079,57 @@ int XrdXrootdProtocol::do_ReadV()
    return (Quantum != Qleft ? Response.Send(argp->buff, Quantum-Qleft) : 0);
 }
 
+/******************************************************************************/
+/*                           d o _ R e a d V A i o                            */
+/******************************************************************************/
+
+// Returns true if the readv was handed off to be run asynchronously.
+
+bool XrdXrootdProtocol::do_ReadVAio(XrdOucIOVec *rdVec, int rdVecNum,
+                                    int Quantum)
+{
+   XrdXrootdFile     *fVec[XrdProto::maxRvecsz];
+   XrdXrootdReadvAio *aioP;
+   XrdSfsXferSize rdVXfr = 0;
+   int i, k, rdVBeg = 0;
+   int rvMon = Monitor.InOut();
+   int ioMon = (rvMon > 1);
+   char vType = (ioMon ? XROOTD_MON_READU : XROOTD_MON_READV);
+
+// Resolve every file handle. All of the files must be open in async mode;
+// otherwise, the request is executed synchronously which reports any error.
+//
+   for (i = 0; i < rdVecNum; i++)
+       {if (i && rdVec[i].info == rdVec[i-1].info) fVec[i] = fVec[i-1];
+           else if (!(fVec[i] = FTab->Get(rdVec[i].info))
+                ||  !fVec[i]->AsyncMode || fVec[i]->isMMapped) return false;
+       }
+
+// Since the request runs disconnected, record statistics and monitoring
+// information for each run of segments against the same file up front.
+//
+   rvSeq++;
+   for (i = 0; i < rdVecNum; i++)
+       {rdVXfr += rdVec[i].size;
+        if (i+1 < rdVecNum && rdVec[i+1].info == rdVec[i].info) continue;
+        fVec[i]->Stats.rvOps(rdVXfr, i+1-rdVBeg);
+        if (rvMon)
+           {Monitor.Agent->Add_rv(fVec[i]->Stats.FileID, htonl(rdVXfr),
+                                  htons(i+1-rdVBeg), rvSeq, vType);
+            if (ioMon) for (k = rdVBeg; k <= i; k++)
+                Monitor.Agent->Add_rd(fVec[i]->Stats.FileID,
+                        htonl(rdVec[k].size), htonll(rdVec[k].offset));
+           }
+        rdVBeg = i+1; rdVXfr = 0;
+       }
+
+// Hand the request off
+//
+   aioP = XrdXrootdReadvAio::Alloc(this, Response, fVec[0]);
+   aioP->Readv(rdVec, fVec, rdVecNum, Quantum);
+   return true;
+}
+
 /******************************************************************************/
 /*                                 d o _ R m                                  */
 /******************************************************************************/
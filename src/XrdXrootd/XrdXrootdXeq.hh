@@ -53,3 +53,15 @@ struct XrdXrootdFHandle
         XrdXrootdFHandle(kXR_char *ch) {Set(ch);}
        ~XrdXrootdFHandle() {}
        };
+
+struct XrdXrootdDirBuff
+       {char *buff;
+        int   bleft;
+        int   cnt;
+        char  ebuff[8192];
+        char  epad[512];
+
+        void Reset() {buff = ebuff; bleft = sizeof(ebuff);}
+        XrdXrootdDirBuff() : cnt(0) {Reset();}
+       ~XrdXrootdDirBuff() {}
+       };
@@ -0,0 +1,332 @@
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d X r o o t d X e q B u l k . c c                    */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*   Produced by Andrew Hanushevsky for Stanford University under contract    */
+/*              DE-AC02-76-SFO0515 with the Department of Energy              */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <arpa/inet.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+#include "XProtocol/XProtocol.hh"
+#include "Xrd/XrdBuffer.hh"
+#include "Xrd/XrdJob.hh"
+#include "Xrd/XrdLink.hh"
+#include "Xrd/XrdScheduler.hh"
+#include "XrdOuc/XrdOucErrInfo.hh"
+#include "XrdSfs/XrdSfsInterface.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdXrootd/XrdXrootdFileLock.hh"
+#include "XrdXrootd/XrdXrootdFileStats.hh"
+#include "XrdXrootd/XrdXrootdMonFile.hh"
+#include "XrdXrootd/XrdXrootdMonitor.hh"
+#include "XrdXrootd/XrdXrootdProtocol.hh"
+#include "XrdXrootd/XrdXrootdStats.hh"
+#include "XrdXrootd/XrdXrootdTrace.hh"
+#include "XrdXrootd/XrdXrootdXPath.hh"
+#include "XrdXrootd/XrdXrootdXeq.hh"
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+extern XrdSysTrace  XrdXrootdTrace;
+
+/******************************************************************************/
+/*                 C l a s s   X r d X r o o t d B u l k J o b                */
+/******************************************************************************/
+
+// Each path in a kXR_QFread request is handled by one of these. The job opens,
+// stats, reads and closes the file on a scheduler thread so that the files are
+// processed in parallel while the protocol thread returns results in order.
+// The protocol thread never waits for a job that is still queued; it runs it
+// itself as the scheduler may have no thread to give it. Whichever of the two
+// lets go of the job last deletes it.
+//
+class XrdXrootdBulkJob : public XrdJob
+{
+public:
+
+void  DoIt() override
+          {if (!claimed.exchange(true)) {Run(); done.Post();}
+           Release();
+          }
+
+void  Fail(int ecode, const char *etext)
+          {data.assign(etext, etext+strlen(etext));
+           rsp.errnum = htonl(ecode);
+           rsp.dlen   = htonl(data.size());
+           rsp.fsize  = htonll(-1);
+          }
+
+void  Finish() {if (!claimed.exchange(true)) Run(); else done.Wait();}
+
+const char *Path() {return path;}
+
+void  Release() {if (--refs == 0) delete this;}
+
+void  Start(XrdScheduler *sP) {refs++; sP->Schedule(this);}
+
+      XrdXrootdBulkJob(XrdSfsFileSystem *fs, XrdXrootdFileLock *lk,
+                       char *tid, int mid, const XrdSecEntity *cred,
+                       char *fn, char *cgi, int mlen)
+                      : XrdJob("kXR_QFread"), sfsP(fs), lockP(lk), tident(tid),
+                        client(cred), path(fn), opaque(cgi), monID(mid),
+                        maxlen(mlen), done(0), refs(1), claimed(false)
+                      {rsp.errnum = 0; rsp.dlen = 0; rsp.fsize = 0;}
+     ~XrdXrootdBulkJob() {}
+
+ServerResponseBody_QFread rsp;
+std::vector<char>         data;
+bool                      opened = false; // Opened, so must be accounted for
+long long                 fSize  = 0;     // Size of the file when opened
+
+private:
+
+void                      Run();
+
+XrdSfsFileSystem         *sfsP;
+XrdXrootdFileLock        *lockP;   // Nil if the path need not be locked
+char                     *tident;
+const XrdSecEntity       *client;
+char                     *path;
+char                     *opaque;
+int                       monID;
+int                       maxlen;
+XrdSysSemaphore           done;
+std::atomic<int>          refs;
+std::atomic<bool>         claimed;
+};
+
+/******************************************************************************/
+/*                                   R u n                                    */
+/******************************************************************************/
+
+void XrdXrootdBulkJob::Run()
+{
+   XrdSfsFile *fp;
+   struct stat Stat;
+   int n, rc;
+
+// Jobs that failed before being run have nothing to do
+//
+   if (rsp.errnum) return;
+
+// Files being written may not be read in bulk (see do_Open)
+//
+   if (lockP && lockP->Lock(path, 'r', false))
+      {Fail(kXR_FileLocked, "file is already opened for writing");
+       return;
+      }
+
+// Open the file. If we can't do so right now the client needs to take the
+// long way around (e.g. the file needs to be staged or we should redirect).
+//
+   if (!(fp = sfsP->newFile(tident, monID)))
+      Fail(kXR_NoMemory, "insufficient memory to open file");
+   else if ((rc = fp->open(path, SFS_O_RDONLY, 0, client, opaque)) != SFS_OK)
+           {if (rc == SFS_ERROR)
+               Fail(XProtocol::mapError(fp->error.getErrInfo()),
+                    fp->error.getErrText());
+               else Fail(kXR_Cancelled, "file is not immediately available; "
+                                        "open it individually");
+            delete fp;
+           }
+   else    {opened = true;
+            if (fp->stat(&Stat) != SFS_OK)
+               Fail(XProtocol::mapError(fp->error.getErrInfo()),
+                    fp->error.getErrText());
+               else {fSize = Stat.st_size;
+                     data.resize(Stat.st_size < maxlen ? Stat.st_size : maxlen);
+                     for (n = 0, rc = 1; n < (int)data.size() && rc > 0; n += rc)
+                         rc = fp->read(n, data.data()+n, data.size()-n);
+                     if (rc < 0)
+                        Fail(XProtocol::mapError(fp->error.getErrInfo()),
+                             fp->error.getErrText());
+                        else {data.resize(n);
+                              rsp.dlen  = htonl(n);
+                              rsp.fsize = htonll(Stat.st_size);
+                             }
+                    }
+            fp->close();
+            delete fp;
+           }
+
+// All done
+//
+   if (lockP) lockP->Unlock(path, 'r');
+}
+
+/******************************************************************************/
+/*                            Q f r e a d A c c t                             */
+/******************************************************************************/
+
+// Files read in bulk are accounted for and monitored as if each one had been
+// opened, read in a single request and closed (see do_Open, do_Read and
+// XrdXrootdFileTable::Del). This must be called on the protocol thread.
+//
+void XrdXrootdProtocol::QfreadAcct(const char *fn, long long fsize, int rlen)
+{
+   XrdXrootdFileStats Stats;
+
+// Account for the open
+//
+   SI->Bump(SI->openCnt);
+   Stats.Init();
+   Stats.fSize = fsize;
+   if (Monitor.Files())
+      {Stats.FileID = Monitor.MapPath(fn);
+       Stats.monLvl = XrdXrootdFileStats::monOn;
+       Monitor.Agent->Open(Stats.FileID, fsize);
+      }
+   if (Monitor.Fstat()) XrdXrootdMonFile::Open(&Stats, fn, Monitor.Did, false);
+
+// Account for the read
+//
+   numReads++;
+   Stats.rdOps(rlen);
+
+// Account for the close
+//
+   if (Monitor.Files()) Monitor.Agent->Close(Stats.FileID, Stats.xfr.read, 0);
+   if (Stats.MonEnt != -1) XrdXrootdMonFile::Close(&Stats, false);
+}
+
+/******************************************************************************/
+/*                             d o _ Q f r e a d                              */
+/******************************************************************************/
+
+// The arguments are "<maxbytes>\n<path>[?<cgi>][\n<path>[?<cgi>]]...". Each
+// file is opened, read up to maxbytes and closed, so that many small files can
+// be fetched with a single round trip. The files are processed in parallel but
+// results are returned in request order as soon as each one is available. At
+// most maxTotal bytes of file data are returned; files that would exceed it
+// are reported as cancelled and must be read individually.
+//
+int XrdXrootdProtocol::do_Qfread()
+{
+   static const int maxFiles = 1024;
+   static const int maxPar   = 16;
+   static const long long maxTotal = 64*1024*1024;
+   std::vector<XrdXrootdBulkJob *> jobs;
+   XrdXrootdBulkJob *jP;
+   struct iovec iov[3];
+   char *fn, *opaque, *lp, *np;
+   long long maxlen, left = maxTotal;
+   int i, k, popt, rc = 0;
+
+// Keep statistics
+//
+   SI->Bump(SI->miscCnt);
+
+// Extract the maximum number of bytes to read from each file
+//
+   if (!Request.query.dlen)
+      return Response.Send(kXR_ArgMissing, "Required query argument not present");
+   maxlen = strtoll(argp->buff, &lp, 10);
+   if (lp == argp->buff || *lp != '\n' || maxlen < 0)
+      return Response.Send(kXR_ArgInvalid, "Invalid maximum read size");
+   if (maxlen > maxBuffsz) maxlen = maxBuffsz;
+
+// Construct a job for each path. Bad paths are reported for that path alone.
+//
+   for (fn = lp+1; *fn; fn = np)
+       {if ((np = index(fn, '\n'))) *np++ = '\0';
+           else np = fn + strlen(fn);
+        if (!*fn) continue;
+        if ((int)jobs.size() >= maxFiles)
+           {for (auto job : jobs) job->Release();
+            return Response.Send(kXR_ArgTooLong, "Too many files requested");
+           }
+        if (rpCheck(fn, &opaque))
+           {jP = new XrdXrootdBulkJob(osFS, 0, Link->ID, Monitor.Did, CRED,
+                                       fn, 0, maxlen);
+            jP->Fail(kXR_ArgInvalid, "relative paths are not allowed");
+           } else if (!(popt = Squash(fn)))
+                     {jP = new XrdXrootdBulkJob(osFS, 0, Link->ID, Monitor.Did,
+                                                CRED, fn, 0, maxlen);
+                      jP->Fail(kXR_ArgInvalid, "path is not allowed");
+                     } else {
+                      jP = new XrdXrootdBulkJob(osFS,
+                                    (popt & XROOTDXP_NOLK ? 0 : Locker),
+                                    Link->ID, Monitor.Did, CRED,
+                                    fn, opaque, maxlen);
+                      if (Route[RD_open1].Host[rdType]
+                      &&  RPList.Validate(fn) > 0)
+                         jP->Fail(kXR_Cancelled, "file must be opened "
+                                  "individually");
+                     }
+        jobs.push_back(jP);
+       }
+   if (jobs.empty())
+      return Response.Send(kXR_ArgMissing, "No files specified");
+   TRACEP(FS, "qfread " <<jobs.size() <<" files maxbytes=" <<maxlen);
+
+// Start the first batch of jobs. Jobs that failed up front need not be run.
+//
+   for (k = 0; k < (int)jobs.size() && k < maxPar; k++)
+       if (!jobs[k]->rsp.errnum) jobs[k]->Start(Sched);
+
+// Return the results in order, each one as soon as it is available, while
+// keeping at most maxPar files in progress.
+//
+   for (i = 0; i < (int)jobs.size(); i++)
+       {jP = jobs[i];
+        jP->Finish();
+        if (jP->opened) QfreadAcct(jP->Path(), jP->fSize, jP->data.size());
+        if (!jP->rsp.errnum)
+           {if ((long long)jP->data.size() > left)
+               jP->Fail(kXR_Cancelled, "response size limit reached; "
+                                       "read the file individually");
+               else left -= jP->data.size();
+           }
+        if (!rc)
+           {iov[1].iov_base = (caddr_t)&jP->rsp;
+            iov[1].iov_len  = sizeof(jP->rsp);
+            iov[2].iov_base = (caddr_t)jP->data.data();
+            iov[2].iov_len  = jP->data.size();
+            rc = Response.Send((i+1 < (int)jobs.size() ? kXR_oksofar : kXR_ok),
+                               iov, 3);
+           }
+        jP->Release();
+        if (k < (int)jobs.size())
+           {if (rc) jobs[k]->Fail(kXR_Cancelled, "request aborted");
+               else if (!left) jobs[k]->Fail(kXR_Cancelled,
+                                        "response size limit reached; "
+                                        "read the file individually");
+            if (!jobs[k]->rsp.errnum) jobs[k]->Start(Sched);
+            k++;
+           }
+       }
+   return rc;
+}
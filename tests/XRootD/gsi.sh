@@ -53,6 +53,21 @@ function test_gsi() {
 	# Check against original file
 	assert diff -u "${SOURCE_DIR}"/gsi.cfg gsi.cfg
 
+	# Chain verifications are cached for -vfyto seconds: let the outcomes of
+	# the handshakes above expire, then the first new handshake verifies the
+	# chain, the next one finds it in the cache and after the timeout the
+	# chain is verified again
+	sleep 4
+	HITS="$(grep -c "outcome found in cache" "${XROOTD_SERVER_LOGFILE}" || true)"
+	assert xrdfs "${HOST}" query config version
+	assert xrdfs "${HOST}" query config version
+	assert_eq "$((HITS + 1))" "$(grep -c "outcome found in cache" "${XROOTD_SERVER_LOGFILE}")" \
+		"chain verification cache hits"
+	sleep 4
+	assert xrdfs "${HOST}" query config version
+	assert_eq "$((HITS + 1))" "$(grep -c "outcome found in cache" "${XROOTD_SERVER_LOGFILE}")" \
+		"chain verification cache hits after expiration"
+
 	assert truncate -s 0 "${XRD_LOGFILE}"
 
 	# Check that authentication fails with a bad (invalid) proxy certificate
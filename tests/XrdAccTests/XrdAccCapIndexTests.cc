@@ -0,0 +1,114 @@
+#undef NDEBUG
+
+#include "XrdAcc/XrdAccCapIndex.hh"
+#include "XrdAcc/XrdAccCapability.hh"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+XrdAccPrivCaps Caps(int pos, int neg=0)
+{
+   XrdAccPrivCaps caps;
+   caps.pprivs = (XrdAccPrivs)pos;
+   caps.nprivs = (XrdAccPrivs)neg;
+   return caps;
+}
+
+// Builds a capability list from the paths, rule i getting privilege bit i.
+//
+XrdAccCapability *MakeList(const std::vector<std::string> &paths)
+{
+   XrdAccCapability *head = 0, *last = 0, *cP;
+
+   for (size_t i = 0; i < paths.size(); i++)
+       {XrdAccPrivCaps caps = Caps(1 << (i % 9), (i % 5 ? 0 : 1 << (i % 7)));
+        cP = new XrdAccCapability((char *)paths[i].c_str(), caps);
+        if (last) last->Add(cP);
+           else head = cP;
+        last = cP;
+       }
+   return head;
+}
+
+void Check(XrdAccCapability *linear, XrdAccCapability *compiled,
+           const char *path)
+{
+   XrdAccPrivCaps lCaps, cCaps;
+   int lRC = linear->Privs(lCaps, path);
+   int cRC = compiled->Privs(cCaps, path);
+
+   EXPECT_EQ(lRC, cRC) << path;
+   EXPECT_EQ(lCaps.pprivs, cCaps.pprivs) << path;
+   EXPECT_EQ(lCaps.nprivs, cCaps.nprivs) << path;
+}
+}
+
+TEST(XrdAccCapIndexTests, FirstMatchingPrefixApplies)
+{
+   XrdAccCapIndex ix;
+   XrdAccPrivCaps caps;
+
+   ix.Add("/data/",      6, Caps(XrdAccPriv_Read));
+   ix.Add("/data/vo1/", 10, Caps(XrdAccPriv_Write));
+   ix.Add("/dat",        4, Caps(XrdAccPriv_Lookup));
+   ix.Add("/data/",      6, Caps(XrdAccPriv_Delete));
+   ix.Ready();
+   EXPECT_EQ(ix.Rules(), 3);
+
+   EXPECT_TRUE(ix.Find(caps, "/data/vo1/f", 11));
+   EXPECT_EQ(caps.pprivs, XrdAccPriv_Read);
+
+   caps = Caps(0);
+   EXPECT_TRUE(ix.Find(caps, "/database", 9));
+   EXPECT_EQ(caps.pprivs, XrdAccPriv_Lookup);
+
+   caps = Caps(0);
+   EXPECT_FALSE(ix.Find(caps, "/da", 3));
+   EXPECT_FALSE(ix.Find(caps, "/store/x", 8));
+   EXPECT_EQ(caps.pprivs, XrdAccPriv_None);
+}
+
+TEST(XrdAccCapIndexTests, CompiledMatchesLinear)
+{
+   static const char *parts[] = {"/", "a", "ab", "b", "/x", "/y/", "vo"};
+   std::vector<std::string> paths, probes;
+
+   srand(42);
+   for (int i = 0; i < 400; i++)
+       {std::string p;
+        int n = rand() % 6;
+        while(n--) p += parts[rand() % 7];
+        paths.push_back(p);
+        probes.push_back(p);
+        probes.push_back(p + parts[rand() % 7]);
+        if (!p.empty()) probes.push_back(p.substr(0, p.size()-1));
+       }
+
+// A template is expanded where it is referenced
+//
+   XrdAccCapability *tmplt = MakeList({"/y/vo", "/xab", "/a"});
+   XrdAccCapability *linear = MakeList(paths);
+   XrdAccCapability *compiled = MakeList(paths);
+   XrdAccCapability *lRef = new XrdAccCapability(tmplt);
+   XrdAccCapability *cRef = new XrdAccCapability(tmplt);
+   lRef->Add(linear); linear = lRef;
+   cRef->Add(compiled); compiled = cRef;
+
+   compiled->Compile();
+   for (auto &p : probes) Check(linear, compiled, p.c_str());
+
+   delete linear; delete compiled; delete tmplt;
+}
+
+TEST(XrdAccCapIndexTests, ShortListsAreNotCompiled)
+{
+   XrdAccCapability *cP = MakeList({"/a", "/b"});
+
+   EXPECT_EQ(XrdAccCapIndex::Compile(cP), nullptr);
+   delete cP;
+}
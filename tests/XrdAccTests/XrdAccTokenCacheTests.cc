@@ -0,0 +1,72 @@
+#undef NDEBUG
+
+#include "XrdAcc/XrdAccTokenCache.hh"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(XrdAccTokenCacheTests, ItemsExpire)
+{
+   XrdAccTokenCache<std::string> cache;
+
+   cache.Add("tok1", std::make_shared<std::string>("one"), 100, 10);
+   cache.Add("tok2", std::make_shared<std::string>("two"), 200, 10);
+   cache.Add("tok3", std::make_shared<std::string>("old"),   5, 10);
+   EXPECT_EQ(cache.Size(), 2u);
+
+   auto item = cache.Find("tok1", 50);
+   ASSERT_TRUE(item);
+   EXPECT_EQ(*item, "one");
+   EXPECT_FALSE(cache.Find("tok1", 100));
+   EXPECT_FALSE(cache.Find("tok3", 10));
+
+   EXPECT_EQ(cache.Purge(300), 1);
+   EXPECT_EQ(cache.Size(), 0u);
+
+// A removed item stays valid for whoever holds it
+//
+   EXPECT_EQ(*item, "one");
+}
+
+TEST(XrdAccTokenCacheTests, SizeIsBounded)
+{
+   XrdAccTokenCache<int> cache(64, 4);
+
+   for (int i = 0; i < 1000; i++)
+       cache.Add("tok" + std::to_string(i), std::make_shared<int>(i),
+                 1000 + i, 0);
+   EXPECT_LE(cache.Size(), 64u);
+
+// The items furthest from expiring are the ones kept
+//
+   auto item = cache.Find("tok999", 0);
+   ASSERT_TRUE(item);
+   EXPECT_EQ(*item, 999);
+   EXPECT_FALSE(cache.Find("tok0", 0));
+}
+
+TEST(XrdAccTokenCacheTests, ConcurrentAccess)
+{
+   XrdAccTokenCache<int> cache(256, 8);
+   std::atomic<int> hits(0);
+   std::vector<std::thread> threads;
+
+   for (int t = 0; t < 4; t++)
+       threads.emplace_back([&cache, &hits, t]()
+          {for (int i = 0; i < 5000; i++)
+               {std::string key = "tok" + std::to_string((i * 7 + t) % 300);
+                auto item = cache.Find(key, i);
+                if (item) hits++;
+                   else cache.Add(key, std::make_shared<int>(i), i + 50, i);
+               }
+          });
+   for (auto &thr : threads) thr.join();
+
+   EXPECT_GT(hits.load(), 0);
+   EXPECT_LE(cache.Size(), 256u);
+}
@@ -0,0 +1,104 @@
+#undef NDEBUG
+
+#include "XProtocol/XProtocol.hh"
+#include "XrdCl/XrdClXRootDResponses.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+
+#include <string>
+#include <vector>
+
+using namespace XrdCl;
+
+//------------------------------------------------------------------------------
+// Append the entry for one file to a kXR_QFread response
+//------------------------------------------------------------------------------
+static void AddEntry( std::string &resp, int errnum, long long fsize,
+                      const std::string &data )
+{
+  ServerResponseBody_QFread rsp;
+  rsp.errnum = htonl( errnum );
+  rsp.dlen   = htonl( data.size() );
+  rsp.fsize  = htonll( fsize );
+  resp.append( (const char*)&rsp, sizeof( rsp ) );
+  resp += data;
+}
+
+TEST(ReadFilesInfoTest, NormalResponse)
+{
+  std::vector<std::string> paths = { "/a", "/b", "/c" };
+  std::string resp;
+  AddEntry( resp, 0, 5, "hello" );
+  AddEntry( resp, 0, 0, "" );
+  AddEntry( resp, 0, 100, "truncated" );
+
+  ReadFilesInfo info;
+  ASSERT_TRUE( info.ParseServerResponse( paths, resp.data(), resp.size() ) );
+  ASSERT_EQ( info.GetSize(), 3u );
+
+  EXPECT_EQ( info.At( 0 ).GetPath(), "/a" );
+  EXPECT_TRUE( info.At( 0 ).GetStatus().IsOK() );
+  EXPECT_EQ( info.At( 0 ).GetSize(), 5u );
+  EXPECT_EQ( info.At( 0 ).GetData(), "hello" );
+
+  EXPECT_TRUE( info.At( 1 ).GetStatus().IsOK() );
+  EXPECT_EQ( info.At( 1 ).GetSize(), 0u );
+  EXPECT_TRUE( info.At( 1 ).GetData().empty() );
+
+  // the file is bigger than what was read
+  EXPECT_EQ( info.At( 2 ).GetSize(), 100u );
+  EXPECT_EQ( info.At( 2 ).GetData(), "truncated" );
+}
+
+TEST(ReadFilesInfoTest, PerFileError)
+{
+  std::vector<std::string> paths = { "/ok", "/missing", "/ok2" };
+  std::string resp;
+  AddEntry( resp, 0, 2, "ok" );
+  AddEntry( resp, kXR_NotFound, -1, "no such file" );
+  AddEntry( resp, 0, 3, "ok2" );
+
+  ReadFilesInfo info;
+  ASSERT_TRUE( info.ParseServerResponse( paths, resp.data(), resp.size() ) );
+  ASSERT_EQ( info.GetSize(), 3u );
+
+  EXPECT_TRUE( info.At( 0 ).GetStatus().IsOK() );
+
+  const XRootDStatus &st = info.At( 1 ).GetStatus();
+  EXPECT_FALSE( st.IsOK() );
+  EXPECT_EQ( st.code, errErrorResponse );
+  EXPECT_EQ( st.errNo, (uint32_t)kXR_NotFound );
+  EXPECT_EQ( st.GetErrorMessage(), "no such file" );
+  EXPECT_TRUE( info.At( 1 ).GetData().empty() );
+
+  // an error does not affect the files that follow
+  EXPECT_TRUE( info.At( 2 ).GetStatus().IsOK() );
+  EXPECT_EQ( info.At( 2 ).GetData(), "ok2" );
+}
+
+TEST(ReadFilesInfoTest, TruncatedResponse)
+{
+  std::vector<std::string> paths = { "/a", "/b" };
+  std::string resp;
+  AddEntry( resp, 0, 5, "hello" );
+  AddEntry( resp, 0, 5, "world" );
+
+  ReadFilesInfo info;
+
+  // cut inside the data of the last file
+  EXPECT_FALSE( info.ParseServerResponse( paths, resp.data(), resp.size() - 1 ) );
+
+  // cut inside the header of the last file
+  size_t hdr = sizeof( ServerResponseBody_QFread );
+  EXPECT_FALSE( info.ParseServerResponse( paths, resp.data(), hdr + 5 + hdr / 2 ) );
+
+  // the entry for the last file is missing altogether
+  EXPECT_FALSE( info.ParseServerResponse( paths, resp.data(), hdr + 5 ) );
+
+  // more data than there are files
+  std::vector<std::string> one = { "/a" };
+  EXPECT_FALSE( info.ParseServerResponse( one, resp.data(), resp.size() ) );
+}
@@ -0,0 +1,280 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//
+// In applying this licence, CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include "GTestXrdHelpers.hh"
+#include "XrdCl/XrdClZipArchive.hh"
+#include "XrdCl/XrdClZipCache.hh"
+#include "XrdCl/XrdClParallelOperation.hh"
+#include "XrdCl/XrdClZipOperations.hh"
+#include "XrdZip/XrdZipEOCD.hh"
+
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <unistd.h>
+
+using namespace XrdCl;
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class ZipSeekIndexTest: public ::testing::Test
+{
+  public:
+    void SetUp() override;
+    void TearDown() override;
+
+    void Deflate( const std::string &in, std::string &out );
+    void MakeArchive( const std::string &path, const std::string &fn,
+                      const std::string &data );
+    void ReadArchive( const std::string &path, size_t size );
+
+    std::string data;
+    std::string compressed;
+    std::string dir;
+};
+
+//------------------------------------------------------------------------------
+// Some compressible, yet not trivial, data with plenty of deflate blocks
+//------------------------------------------------------------------------------
+void ZipSeekIndexTest::SetUp()
+{
+  std::mt19937 gen( 1234 );
+  static const char *words[] = { "alpha ", "beta ", "gamma ", "delta ", "epsilon ",
+                                 "zeta ", "eta ", "theta ", "iota ", "kappa\n" };
+  data.reserve( 20 * 1024 * 1024 );
+  while( data.size() < 20 * 1024 * 1024 )
+  {
+    data += words[gen() % 10];
+    data += std::to_string( gen() % 1000 );
+  }
+  Deflate( data, compressed );
+
+  char tmpl[] = "/tmp/xrdclzipseek.XXXXXX";
+  ASSERT_NE( mkdtemp( tmpl ), nullptr );
+  dir = tmpl;
+}
+
+void ZipSeekIndexTest::TearDown()
+{
+  std::string cmd = "rm -rf " + dir;
+  ASSERT_EQ( system( cmd.c_str() ), 0 );
+}
+
+void ZipSeekIndexTest::Deflate( const std::string &in, std::string &out )
+{
+  z_stream strm;
+  memset( &strm, 0, sizeof( strm ) );
+  ASSERT_EQ( deflateInit2( &strm, 1, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY ), Z_OK );
+  out.resize( deflateBound( &strm, in.size() ) );
+  strm.next_in   = (Bytef*)in.data();
+  strm.avail_in  = in.size();
+  strm.next_out  = (Bytef*)out.data();
+  strm.avail_out = out.size();
+  ASSERT_EQ( deflate( &strm, Z_FINISH ), Z_STREAM_END );
+  out.resize( strm.total_out );
+  deflateEnd( &strm );
+}
+
+//------------------------------------------------------------------------------
+// Write a ZIP archive with a single deflated file
+//------------------------------------------------------------------------------
+void ZipSeekIndexTest::MakeArchive( const std::string &path, const std::string &fn,
+                                    const std::string &content )
+{
+  std::string deflated;
+  Deflate( content, deflated );
+  uint32_t crc = crc32( 0, (const Bytef*)content.data(), content.size() );
+
+  XrdZip::LFH lfh( fn, crc, content.size(), time( 0 ) );
+  lfh.compressionMethod = Z_DEFLATED;
+  lfh.compressedSize    = deflated.size();
+  XrdZip::CDFH cdfh( &lfh, 0644, 0 );
+
+  XrdZip::buffer_t hdr, cd, eocd;
+  lfh.Serialize( hdr );
+  cdfh.Serialize( cd );
+  XrdZip::EOCD( hdr.size() + deflated.size(), 1, cd.size() ).Serialize( eocd );
+
+  std::ofstream out( path, std::ios::binary );
+  out.write( hdr.data(), hdr.size() );
+  out.write( deflated.data(), deflated.size() );
+  out.write( cd.data(), cd.size() );
+  out.write( eocd.data(), eocd.size() );
+  ASSERT_TRUE( out.good() );
+}
+
+//------------------------------------------------------------------------------
+// Read sequentially, then at random, and check against the original data
+//------------------------------------------------------------------------------
+void ZipSeekIndexTest::ReadArchive( const std::string &path, size_t size )
+{
+  std::string content = data.substr( 0, size );
+  ZipArchive zip;
+  EXPECT_XRDST_OK( WaitFor( OpenArchive( zip, "file://localhost" + path, OpenFlags::Read ) ) );
+
+  std::vector<char> buffer( 1024 * 1024 );
+  for( size_t off = 0; off < size; off += buffer.size() )
+  {
+    uint32_t len = std::min<size_t>( buffer.size(), size - off );
+    ChunkInfo info;
+    EXPECT_XRDST_OK( WaitFor( ReadFrom( zip, "data.txt", off, buffer.size(), buffer.data() )
+                              >> [&]( XRootDStatus&, ChunkInfo &c ){ info = c; } ) );
+    ASSERT_EQ( info.length, len );
+    ASSERT_EQ( memcmp( buffer.data(), content.data() + off, len ), 0 );
+  }
+
+  std::mt19937 gen( 4321 );
+  for( int i = 0; i < 20; ++i )
+  {
+    uint64_t off = gen() % size;
+    uint32_t len = std::min<uint64_t>( gen() % ( 6 * 1024 * 1024 ) + 1, size - off );
+    std::vector<char> buff( len );
+    ChunkInfo info;
+    EXPECT_XRDST_OK( WaitFor( ReadFrom( zip, "data.txt", off, len, buff.data() )
+                              >> [&]( XRootDStatus&, ChunkInfo &c ){ info = c; } ) );
+    ASSERT_EQ( info.length, len );
+    ASSERT_EQ( memcmp( buff.data(), content.data() + off, len ), 0 );
+  }
+
+  // reading past the end gives nothing
+  ChunkInfo info;
+  EXPECT_XRDST_OK( WaitFor( ReadFrom( zip, "data.txt", size + 10, 10, buffer.data() )
+                            >> [&]( XRootDStatus&, ChunkInfo &c ){ info = c; } ) );
+  EXPECT_EQ( info.length, 0u );
+
+  EXPECT_XRDST_OK( WaitFor( CloseArchive( zip ) ) );
+}
+
+//------------------------------------------------------------------------------
+// Tests
+//------------------------------------------------------------------------------
+TEST_F( ZipSeekIndexTest, InflaterCheckpoints )
+{
+  auto index = std::make_shared<ZipSeekIndex>();
+  std::vector<char> buffer( data.size() );
+  uint32_t filled = 0;
+
+  // a sequential pass populates the index
+  {
+    ZipInflater inflater( index );
+    EXPECT_XRDST_OK( inflater.Reset( nullptr ) );
+    size_t coff = 0;
+    XRootDStatus st;
+    while( ( st = inflater.Inflate( 0, data.size(), buffer.data(), filled ) ).code == suContinue )
+    {
+      size_t len = std::min<size_t>( 100000, compressed.size() - coff );
+      inflater.Input( ZipCache::buffer_t( compressed.begin() + coff, compressed.begin() + coff + len ) );
+      coff += len;
+    }
+    EXPECT_XRDST_OK( st );
+    ASSERT_EQ( filled, data.size() );
+    ASSERT_EQ( memcmp( buffer.data(), data.data(), data.size() ), 0 );
+  }
+  EXPECT_GE( index->Size(), data.size() / ZipSeekIndex::span - 1 );
+  EXPECT_EQ( index->Inside( 0, data.size() ).size(), index->Size() );
+
+  // random reads start from the nearest checkpoint
+  std::mt19937 gen( 42 );
+  for( int i = 0; i < 20; ++i )
+  {
+    uint64_t off = gen() % data.size();
+    uint32_t len = std::min<uint64_t>( gen() % 100000 + 1, data.size() - off );
+    ZipSeekIndex::Point pt;
+    bool found = index->Find( off, pt );
+    ZipInflater inflater( index );
+    EXPECT_XRDST_OK( inflater.Reset( found ? &pt : nullptr ) );
+    EXPECT_EQ( inflater.UncompressedOffset(), found ? pt.uoff : 0 );
+    EXPECT_LE( off - inflater.UncompressedOffset(), 2 * ZipSeekIndex::span );
+    size_t coff = inflater.CompressedOffset();
+    std::vector<char> buff( len );
+    filled = 0;
+    XRootDStatus st;
+    while( ( st = inflater.Inflate( off, len, buff.data(), filled ) ).code == suContinue )
+    {
+      size_t n = std::min<size_t>( 65536, compressed.size() - coff );
+      inflater.Input( ZipCache::buffer_t( compressed.begin() + coff, compressed.begin() + coff + n ) );
+      coff += n;
+    }
+    EXPECT_XRDST_OK( st );
+    ASSERT_EQ( filled, len );
+    ASSERT_EQ( memcmp( buff.data(), data.data() + off, len ), 0 );
+  }
+}
+
+TEST_F( ZipSeekIndexTest, RemoteArchive )
+{
+  // big enough not to be buffered as a whole when opening the archive
+  std::string path = dir + "/big.zip";
+  MakeArchive( path, "data.txt", data );
+  ReadArchive( path, data.size() );
+}
+
+TEST_F( ZipSeekIndexTest, BufferedArchive )
+{
+  // small enough to be read as a whole when opening the archive
+  std::string path = dir + "/small.zip";
+  MakeArchive( path, "data.txt", data.substr( 0, 100000 ) );
+  ReadArchive( path, 100000 );
+}
+
+TEST_F( ZipSeekIndexTest, ConcurrentReads )
+{
+  // more reads in flight than there are cursors, the excess is queued with
+  // the busy cursors
+  std::string path = dir + "/big.zip";
+  MakeArchive( path, "data.txt", data );
+  ZipArchive zip;
+  EXPECT_XRDST_OK( WaitFor( OpenArchive( zip, "file://localhost" + path, OpenFlags::Read ) ) );
+
+  // a sequential pass first so that the reads below can use checkpoints
+  std::vector<char> buffer( 4 * 1024 * 1024 );
+  for( size_t off = 0; off < data.size(); off += buffer.size() )
+    EXPECT_XRDST_OK( WaitFor( ReadFrom( zip, "data.txt", off, buffer.size(), buffer.data() ) ) );
+
+  const int nreads = 40;
+  std::mt19937 gen( 777 );
+  std::vector<uint64_t> offs( nreads );
+  std::vector<uint32_t> lens( nreads );
+  std::vector<std::vector<char>> buffs( nreads );
+  std::vector<ChunkInfo> infos( nreads );
+  std::vector<Pipeline> reads;
+  for( int i = 0; i < nreads; ++i )
+  {
+    offs[i] = gen() % data.size();
+    lens[i] = std::min<uint64_t>( gen() % ( 1024 * 1024 ) + 1, data.size() - offs[i] );
+    buffs[i].resize( lens[i] );
+    reads.emplace_back( ReadFrom( zip, "data.txt", offs[i], lens[i], buffs[i].data() )
+                        >> [&infos, i]( XRootDStatus&, ChunkInfo &c ){ infos[i] = c; } );
+  }
+  EXPECT_XRDST_OK( WaitFor( Parallel( reads ) ) );
+
+  for( int i = 0; i < nreads; ++i )
+  {
+    ASSERT_EQ( infos[i].length, lens[i] );
+    ASSERT_EQ( memcmp( buffs[i].data(), data.data() + offs[i], lens[i] ), 0 );
+  }
+
+  EXPECT_XRDST_OK( WaitFor( CloseArchive( zip ) ) );
+}
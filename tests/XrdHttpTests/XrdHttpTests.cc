@@ -6,11 +6,15 @@
 #include "XrdHttp/XrdHttpReadRangeHandler.hh"
 #include "XrdHttp/XrdHttpHeaderUtils.hh"
 #include "XrdHttpCors/XrdHttpCorsHandler.hh"
+#include "XrdOuc/XrdOucStream.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdTls/XrdTlsContext.hh"
 #include <exception>
 #include <gtest/gtest.h>
 #include <string>
 #include <sstream>
 #include <tuple>
+#include <unistd.h>
 
 
 using namespace testing;
@@ -856,3 +860,76 @@ TEST(XrdHttpTests, parseTransferEncoding) {
     ASSERT_EQ(expected, res) << "input was: \"" << input << "\"";
   }
 }
+
+namespace XrdHttpProtoInfo
+{
+extern int   tlsCache;
+extern int   tlsTktRot;
+extern char *tlsTktKeys;
+}
+
+class XrdHttpConfigTests : public Test {
+protected:
+  // Configuration errors are reported through the protocol's logger
+  static void SetUpTestSuite() {
+    static XrdSysLogger logger;
+    XrdHttpProtocol::eDest.logger(&logger);
+  }
+
+  // Process the arguments of an http.tlsreuse directive
+  int TlsReuse(const char *args) {
+    XrdOucStream config;
+    std::string line = std::string("tlsreuse ") + args + "\n";
+    int fd[2];
+    if (pipe(fd)) return -1;
+    bool ok = write(fd[1], line.data(), line.size()) == (ssize_t)line.size();
+    close(fd[1]);
+    if (!ok || config.Attach(fd[0])) { close(fd[0]); return -1; }
+    if (!config.GetLine() || !config.GetWord()) return -1;
+    return XrdHttpProtocol::xtlsreuse(config);
+  }
+
+  void TearDown() override { TlsReuse("off"); }
+
+  const char *keyFile() const { return XrdHttpProtoInfo::tlsTktKeys; }
+};
+
+TEST_F(XrdHttpConfigTests, tlsReuseOnOff) {
+  ASSERT_EQ(0, TlsReuse("on"));
+  EXPECT_EQ(+XrdTlsContext::scSrvr, XrdHttpProtoInfo::tlsCache);
+  EXPECT_EQ(0, XrdHttpProtoInfo::tlsTktRot);
+  EXPECT_EQ(nullptr, keyFile());
+
+  ASSERT_EQ(0, TlsReuse("off"));
+  EXPECT_EQ(+XrdTlsContext::scOff, XrdHttpProtoInfo::tlsCache);
+}
+
+TEST_F(XrdHttpConfigTests, tlsReuseTicketOptions) {
+  ASSERT_EQ(0, TlsReuse("on rotate 2h keyfile /etc/xrootd/tickets.key"));
+  EXPECT_EQ(+XrdTlsContext::scSrvr, XrdHttpProtoInfo::tlsCache);
+  EXPECT_EQ(7200, XrdHttpProtoInfo::tlsTktRot);
+  ASSERT_NE(nullptr, keyFile());
+  EXPECT_STREQ("/etc/xrootd/tickets.key", keyFile());
+
+  // Options may come in any order and the last one wins
+  ASSERT_EQ(0, TlsReuse("on keyfile /tmp/a.key rotate 90 keyfile /tmp/b.key"));
+  EXPECT_EQ(90, XrdHttpProtoInfo::tlsTktRot);
+  EXPECT_STREQ("/tmp/b.key", keyFile());
+
+  // Turning reuse off forgets the ticket settings
+  ASSERT_EQ(0, TlsReuse("off"));
+  EXPECT_EQ(0, XrdHttpProtoInfo::tlsTktRot);
+  EXPECT_EQ(nullptr, keyFile());
+}
+
+TEST_F(XrdHttpConfigTests, tlsReuseRejectsBadOptions) {
+  EXPECT_NE(0, TlsReuse(""));
+  EXPECT_NE(0, TlsReuse("maybe"));
+  EXPECT_NE(0, TlsReuse("on rotate"));
+  EXPECT_NE(0, TlsReuse("on rotate 30"));
+  EXPECT_NE(0, TlsReuse("on rotate soon"));
+  EXPECT_NE(0, TlsReuse("on keyfile"));
+  EXPECT_NE(0, TlsReuse("on keyfile tickets.key"));
+  EXPECT_NE(0, TlsReuse("on flush 60"));
+  EXPECT_EQ(nullptr, keyFile());
+}
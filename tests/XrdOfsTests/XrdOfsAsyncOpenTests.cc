@@ -0,0 +1,216 @@
+//------------------------------------------------------------------------------
+// Unit tests for XrdOfsAsyncOpen.
+//
+// The oss file and the client callback are fakes, so the tests drive the two
+// events an asynchronous open waits for (the client being told to wait and the
+// oss open completing) in either order and check that:
+//   - a successful open is reported with SFS_OK and can be claimed once;
+//   - a failed open is reported with SFS_ERROR and the errno and is not kept;
+//   - an oss that cannot open asynchronously leaves the open to the caller.
+//------------------------------------------------------------------------------
+
+#include "XrdOfs/XrdOfsAsyncOpen.hh"
+
+#include "XrdOss/XrdOss.hh"
+#include "XrdOuc/XrdOucCache.hh"
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdOuc/XrdOucErrInfo.hh"
+#include "XrdSfs/XrdSfsInterface.hh"
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <string>
+
+namespace {
+
+//------------------------------------------------------------------------------
+// An oss file that completes its asynchronous open only when told to
+//------------------------------------------------------------------------------
+class AsyncDF : public XrdOssDF
+{
+public:
+
+int  OpenAsync(const char *path, int Oflag, mode_t Mode, XrdOucEnv &env,
+               XrdOucCacheIOCB &cbP) override
+              {(void)path; (void)Oflag; (void)Mode; (void)env;
+               if (startRC) return startRC;
+               openCB = &cbP;
+               return 0;
+              }
+
+int  Close(long long *retsz=0) override {(void)retsz; closed = true; return 0;}
+
+     AsyncDF(bool *deleted=0, int rc=0) : startRC(rc), delP(deleted) {}
+    ~AsyncDF() {if (delP) *delP = true;}
+
+XrdOucCacheIOCB *openCB = 0;
+bool             closed = false;
+int              startRC;
+bool            *delP;
+};
+
+//------------------------------------------------------------------------------
+// An oss file without asynchronous open support
+//------------------------------------------------------------------------------
+class SyncDF : public XrdOssDF
+{
+public:
+
+int  Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &env) override
+         {(void)path; (void)Oflag; (void)Mode; (void)env;
+          opened = true;
+          return 0;
+         }
+
+int  Close(long long *retsz=0) override {(void)retsz; return 0;}
+
+bool opened = false;
+};
+
+//------------------------------------------------------------------------------
+// The client's callback, as supplied by the protocol
+//------------------------------------------------------------------------------
+class ClientCB : public XrdOucEICB
+{
+public:
+
+void Done(int &Result, XrdOucErrInfo *eInfo, const char *Path=0) override
+         {(void)Path;
+          calls++;
+          result = Result;
+          eCode  = eInfo->getErrInfo();
+          eText  = eInfo->getErrText();
+          delete eInfo;
+         }
+
+int  Same(unsigned long long arg1, unsigned long long arg2) override
+         {return arg1 == arg2;}
+
+int         calls  = 0;
+int         result = -1;
+int         eCode  = 0;
+std::string eText;
+};
+
+const char *tident = "user.1:2@host";
+
+// The protocol tells the client to wait and then calls the error callback
+//
+void ClientWaits(XrdOucErrInfo &einfo)
+{
+   unsigned long long arg;
+   XrdOucEICB *cb = einfo.getErrCB(arg);
+   int rc = SFS_STARTED;
+   cb->Done(rc, &einfo);
+}
+}
+
+TEST(XrdOfsAsyncOpen, CompletesAfterClientWaits)
+{
+   ClientCB client;
+   XrdOucErrInfo einfo("user", &client, 7);
+   XrdOucEnv env;
+   AsyncDF *df = new AsyncDF;
+
+   XrdOfsAsyncOpen::SetWait(42);
+   ASSERT_EQ(0, XrdOfsAsyncOpen::Start(df, "/a", O_RDONLY, 0, env, einfo, tident));
+   EXPECT_EQ(42, einfo.getErrInfo());
+   ASSERT_NE(nullptr, df->openCB);
+
+   ClientWaits(einfo);
+   EXPECT_EQ(0, client.calls);
+
+   df->openCB->Done(0);
+   EXPECT_EQ(1, client.calls);
+   EXPECT_EQ(SFS_OK, client.result);
+
+   // The retried open picks up the opened file, but only once
+   EXPECT_EQ(nullptr, XrdOfsAsyncOpen::Claim("other.1:2@host", "/a"));
+   EXPECT_EQ(nullptr, XrdOfsAsyncOpen::Claim(tident, "/b"));
+   EXPECT_EQ(df, XrdOfsAsyncOpen::Claim(tident, "/a"));
+   EXPECT_EQ(nullptr, XrdOfsAsyncOpen::Claim(tident, "/a"));
+   delete df;
+}
+
+TEST(XrdOfsAsyncOpen, CompletesBeforeClientWaits)
+{
+   ClientCB client;
+   XrdOucErrInfo einfo("user", &client, 7);
+   XrdOucEnv env;
+   AsyncDF *df = new AsyncDF;
+
+   ASSERT_EQ(0, XrdOfsAsyncOpen::Start(df, "/c", O_RDONLY, 0, env, einfo, tident));
+
+   // The result may only be sent once the client was told to wait
+   df->openCB->Done(0);
+   EXPECT_EQ(0, client.calls);
+
+   ClientWaits(einfo);
+   EXPECT_EQ(1, client.calls);
+   EXPECT_EQ(SFS_OK, client.result);
+   EXPECT_EQ(df, XrdOfsAsyncOpen::Claim(tident, "/c"));
+   delete df;
+}
+
+TEST(XrdOfsAsyncOpen, FailedOpenIsReported)
+{
+   ClientCB client;
+   XrdOucErrInfo einfo("user", &client, 7);
+   XrdOucEnv env;
+   bool deleted = false;
+   AsyncDF *df = new AsyncDF(&deleted);
+
+   ASSERT_EQ(0, XrdOfsAsyncOpen::Start(df, "/d", O_RDONLY, 0, env, einfo, tident));
+   ClientWaits(einfo);
+   df->openCB->Done(-ENOENT);
+
+   EXPECT_EQ(1, client.calls);
+   EXPECT_EQ(SFS_ERROR, client.result);
+   EXPECT_EQ(ENOENT, client.eCode);
+   EXPECT_NE(std::string::npos, client.eText.find("Unable to open /d"));
+
+   // The failed file object is disposed of and nothing can be claimed
+   EXPECT_TRUE(deleted);
+   EXPECT_EQ(nullptr, XrdOfsAsyncOpen::Claim(tident, "/d"));
+}
+
+TEST(XrdOfsAsyncOpen, FailedStartLeavesCallerInCharge)
+{
+   ClientCB client;
+   XrdOucErrInfo einfo("user", &client, 7);
+   XrdOucEnv env;
+   bool deleted = false;
+   AsyncDF df(&deleted, -EACCES);
+   unsigned long long arg;
+
+   EXPECT_EQ(-EACCES, XrdOfsAsyncOpen::Start(&df, "/e", O_RDONLY, 0, env, einfo, tident));
+
+   // The client's callback is restored and the file object is left alone
+   EXPECT_EQ(&client, einfo.getErrCB(arg));
+   EXPECT_EQ(7u, arg);
+   EXPECT_FALSE(deleted);
+   EXPECT_EQ(0, client.calls);
+}
+
+TEST(XrdOfsAsyncOpen, FallsBackWithoutOssSupport)
+{
+   ClientCB client;
+   XrdOucErrInfo einfo("user", &client, 7);
+   XrdOucEnv env;
+   SyncDF df;
+   unsigned long long arg;
+
+   // The default XrdOssDF::OpenAsync() asks for a synchronous open
+   int rc = XrdOfsAsyncOpen::Start(&df, "/f", O_RDONLY, 0, env, einfo, tident);
+   ASSERT_EQ(-ENOTSUP, rc);
+   EXPECT_EQ(&client, einfo.getErrCB(arg));
+
+   // which is what XrdOfsFile::open() then does
+   if (rc == -ENOTSUP) rc = df.Open("/f", O_RDONLY, 0, env);
+   EXPECT_EQ(0, rc);
+   EXPECT_TRUE(df.opened);
+   EXPECT_EQ(0, client.calls);
+   EXPECT_EQ(nullptr, XrdOfsAsyncOpen::Claim(tident, "/f"));
+}
@@ -0,0 +1,151 @@
+#undef NDEBUG
+
+#include "XrdOssArc/XrdOssArcZipFile.hh"
+#include "XrdOssArc/XrdOssArcZipIndex.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdSys/XrdSysTrace.hh"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <gtest/gtest.h>
+
+namespace XrdOssArcGlobals
+{
+XrdSysLogger Logger;
+XrdSysError  Elog(&Logger, "OssArc_");
+XrdSysTrace  ArcTrace("OssArc", &Logger);
+}
+
+class XrdOssArcZipFileTests : public ::testing::Test
+{
+protected:
+
+void SetUp() override
+{
+   if (system("zip -h >/dev/null 2>&1"))
+      GTEST_SKIP() << "zip command not available";
+
+   char tmpl[] = "/tmp/xrdossarczip.XXXXXX";
+   ASSERT_NE(mkdtemp(tmpl), nullptr);
+   root = tmpl;
+
+// A small stored member and a large deflated one spanning several seek points
+//
+   small = "stored member contents\n";
+   for (int i = 0; big.size() < 3*XrdOssArcZipIndex::pointSpan; i++)
+       big += "line " + std::to_string(i) + " of " + std::to_string(i*i%977)
+            + '\n';
+   MkFile("small.txt", small);
+   MkFile("big.txt", big);
+   std::string cmd = "cd " + root + " && zip -q -0 a.zip small.txt"
+                   + " && zip -q -1 a.zip big.txt";
+   ASSERT_EQ(system(cmd.c_str()), 0);
+   arc = root + "/a.zip";
+}
+
+void TearDown() override
+{
+   if (root.empty()) return;
+   std::string cmd = "rm -rf " + root;
+   ASSERT_EQ(system(cmd.c_str()), 0);
+}
+
+void MkFile(const char *fn, const std::string &data)
+{
+   int fd = open((root + "/" + fn).c_str(), O_CREAT|O_WRONLY, 0644);
+   ASSERT_GE(fd, 0);
+   ASSERT_EQ(write(fd, data.data(), data.size()), (ssize_t)data.size());
+   close(fd);
+}
+
+std::string ReadAt(XrdOssArcZipFile &zf, off_t off, size_t len)
+{
+   std::string buff(len, '\0');
+   ssize_t n = zf.Read(buff.data(), off, len);
+   EXPECT_GE(n, 0);
+   buff.resize(n < 0 ? 0 : n);
+   return buff;
+}
+
+std::string root, arc, small, big;
+};
+
+TEST_F(XrdOssArcZipFileTests, ReadMembers)
+{
+   int rc = -1;
+   XrdOssArcZipFile zf(arc.c_str(), rc);
+   struct stat st;
+
+   ASSERT_EQ(rc, 0);
+   EXPECT_EQ(zf.Open("missing.txt"), -ENOENT);
+
+   ASSERT_EQ(zf.Open("small.txt"), 0);
+   ASSERT_EQ(zf.Stat(st), 0);
+   EXPECT_EQ(st.st_size, (off_t)small.size());
+   EXPECT_EQ(ReadAt(zf, 0, 4096), small);
+   EXPECT_EQ(ReadAt(zf, 7, 6), "member");
+   EXPECT_EQ(ReadAt(zf, small.size(), 10), "");
+
+   ASSERT_EQ(zf.Stat("big.txt", st), 0);
+   EXPECT_EQ(st.st_size, (off_t)big.size());
+   ASSERT_EQ(zf.Open("big.txt"), 0);
+   std::string data;
+   for (off_t off = 0; off < (off_t)big.size(); off += 1000000)
+       data += ReadAt(zf, off, 1000000);
+   EXPECT_TRUE(data == big);
+}
+
+TEST_F(XrdOssArcZipFileTests, RandomAccessDeflated)
+{
+   int rc = -1;
+   XrdOssArcZipFile zf1(arc.c_str(), rc);
+   ASSERT_EQ(rc, 0);
+   ASSERT_EQ(zf1.Open("big.txt"), 0);
+
+// Reading backwards forces restarts; later ones come from seek points that
+// the first pass through the member left in the shared index.
+//
+   const off_t span = XrdOssArcZipIndex::pointSpan;
+   const off_t offs[] = {2*span + 12345, span + 1, 17, 3*span - 100, span - 5};
+   for (int pass = 0; pass < 2; pass++)
+       for (off_t off : offs)
+           EXPECT_TRUE(ReadAt(zf1, off, 300) == big.substr(off, 300)) << off;
+
+// A second open of the same archive shares the index
+//
+   XrdOssArcZipFile zf2(arc.c_str(), rc);
+   ASSERT_EQ(rc, 0);
+   ASSERT_EQ(zf2.Open("big.txt"), 0);
+   EXPECT_TRUE(ReadAt(zf2, 2*span + 7, 65536) == big.substr(2*span + 7, 65536));
+
+   struct stat st;
+   int fd = open(arc.c_str(), O_RDONLY);
+   ASSERT_GE(fd, 0);
+   ASSERT_EQ(fstat(fd, &st), 0);
+   XrdOssArcZipIndex *ix1 = XrdOssArcZipIndex::Get(arc.c_str(), fd, st, rc);
+   XrdOssArcZipIndex *ix2 = XrdOssArcZipIndex::Get(arc.c_str(), fd, st, rc);
+   close(fd);
+   ASSERT_NE(ix1, nullptr);
+   EXPECT_EQ(ix1, ix2);
+   EXPECT_EQ(ix1->Members(), 2);
+   XrdOssArcZipIndex::Point pnt;
+   EXPECT_TRUE(ix1->GetPoint(*ix1->Find("big.txt"), 2*span + 7, pnt));
+   EXPECT_GE(pnt.uOff, span);
+   ix1->Recycle();
+   ix2->Recycle();
+}
+
+TEST_F(XrdOssArcZipFileTests, NotAnArchive)
+{
+   int rc = 0;
+   XrdOssArcZipFile zf((root + "/small.txt").c_str(), rc);
+   EXPECT_EQ(rc, -ENOTBLK);
+   EXPECT_EQ(zf.Open("small.txt"), -EBADF);
+}
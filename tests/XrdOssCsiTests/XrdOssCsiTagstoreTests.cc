@@ -0,0 +1,329 @@
+//------------------------------------------------------------------------------
+// Unit tests for the memory mapped XrdOssCsi tag store.
+//
+// The tag file is a real file in a temporary directory accessed through a
+// minimal oss file that counts its reads and writes. The tests check that:
+//   - tags written through the mapping read back the same, also after the
+//     file is reopened, and the file is readable by the file based store;
+//   - tags within the mapped file are read and updated without oss calls;
+//   - growing and truncating the tag file keeps the tags consistent;
+//   - appending with interleaved reads extends the mapping only now and then,
+//     reading the tail with pread in between;
+//   - a tag file without a local descriptor falls back to read/write calls.
+//------------------------------------------------------------------------------
+
+#include "XrdOssCsi/XrdOssCsiTagstoreFile.hh"
+#include "XrdOssCsi/XrdOssCsiTagstoreMmap.hh"
+
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdOuc/XrdOucTrace.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysPageSize.hh"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+// The tag store traces through the plugin's trace object
+//
+XrdSysError OssCsiEroute(0, "osscsi_");
+XrdOucTrace OssCsiTrace(&OssCsiEroute);
+
+namespace {
+
+//------------------------------------------------------------------------------
+// An oss file backed by a local file that counts the I/O done through it
+//------------------------------------------------------------------------------
+class LocalDF : public XrdOssDF
+{
+public:
+
+int     Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &env) override
+            {if ((fd = open(path, Oflag|O_CREAT, Mode)) < 0) return -errno;
+             return 0;
+            }
+
+int     Close(long long *retsz=0) override
+            {if (fd < 0) return -EBADF;
+             close(fd); fd = -1;
+             return 0;
+            }
+
+int     Fstat(struct stat *buf) override
+            {nStats++;
+             return (fstat(fd, buf) ? -errno : 0);}
+
+int     Fsync() override {return (fsync(fd) ? -errno : 0);}
+
+int     Ftruncate(unsigned long long flen) override
+            {return (ftruncate(fd, flen) ? -errno : 0);}
+
+int     getFD() override {return (hideFD ? -1 : fd);}
+
+ssize_t Read(void *buffer, off_t offset, size_t size) override
+            {nReads++;
+             ssize_t n = pread(fd, buffer, size, offset);
+             return (n < 0 ? -errno : n);
+            }
+
+ssize_t Write(const void *buffer, off_t offset, size_t size) override
+            {nWrites++;
+             ssize_t n = pwrite(fd, buffer, size, offset);
+             return (n < 0 ? -errno : n);
+            }
+
+        LocalDF(int *rd, int *wr, int *st, bool nofd)
+               : nReads(*rd), nWrites(*wr), nStats(*st), hideFD(nofd) {}
+
+int    &nReads;
+int    &nWrites;
+int    &nStats;
+bool    hideFD;
+};
+
+const off_t pgSize = XrdSys::PageSize;
+
+std::vector<uint32_t> Tags(size_t n, uint32_t seed)
+{
+   std::vector<uint32_t> tags(n);
+   for (size_t i = 0; i < n; i++) tags[i] = seed * 2654435761U + i;
+   return tags;
+}
+}
+
+class XrdOssCsiTagstoreTests : public ::testing::Test
+{
+protected:
+
+void SetUp() override
+     {char tmpl[] = "/tmp/xrdosscsi-tests-XXXXXX";
+      ASSERT_NE(nullptr, mkdtemp(tmpl));
+      dir  = tmpl;
+      path = dir + "/file.xrdt";
+     }
+
+void TearDown() override
+     {unlink(path.c_str());
+      rmdir(dir.c_str());
+     }
+
+// Open the tag file for a data file of dsize bytes
+//
+template<class T>
+std::unique_ptr<XrdOssCsiTagstore> Open(off_t dsize, bool nofd = false,
+                                        int Oflag = O_RDWR)
+     {std::unique_ptr<XrdOssDF> df(new LocalDF(&nReads, &nWrites, &nStats, nofd));
+      std::unique_ptr<XrdOssCsiTagstore>
+            ts(new T(path, std::move(df), "test"));
+      EXPECT_EQ(0, ts->Open(path.c_str(), dsize, Oflag, env));
+      return ts;
+     }
+
+off_t FileSize()
+     {struct stat sb;
+      return (stat(path.c_str(), &sb) ? -1 : sb.st_size);
+     }
+
+XrdOucEnv   env;
+std::string dir;
+std::string path;
+int         nReads  = 0;
+int         nWrites = 0;
+int         nStats  = 0;
+};
+
+//------------------------------------------------------------------------------
+// Tags read back the same, after a reopen and through the file based store
+//------------------------------------------------------------------------------
+TEST_F(XrdOssCsiTagstoreTests, RoundTrip)
+{
+   const size_t n = 3000;
+   auto tags = Tags(n, 1);
+   std::vector<uint32_t> back(n);
+
+   {auto ts = Open<XrdOssCsiTagstoreMmap>(0);
+    ASSERT_EQ((ssize_t)n, ts->WriteTags(tags.data(), 0, n));
+    ASSERT_EQ(0, ts->SetTrackedSize(n * pgSize));
+    ASSERT_EQ((ssize_t)n, ts->ReadTags(back.data(), 0, n));
+    EXPECT_EQ(tags, back);
+    EXPECT_EQ(0, ts->Fsync());
+    EXPECT_EQ(0, ts->Close());
+   }
+   EXPECT_EQ(20 + 4 * (off_t)n, FileSize());
+
+   {auto ts = Open<XrdOssCsiTagstoreMmap>(n * pgSize, false, O_RDONLY);
+    EXPECT_EQ(n * pgSize, ts->GetTrackedTagSize());
+    std::fill(back.begin(), back.end(), 0);
+    ASSERT_EQ((ssize_t)n, ts->ReadTags(back.data(), 0, n));
+    EXPECT_EQ(tags, back);
+   }
+
+   {auto ts = Open<XrdOssCsiTagstoreFile>(n * pgSize);
+    std::fill(back.begin(), back.end(), 0);
+    ASSERT_EQ((ssize_t)n, ts->ReadTags(back.data(), 0, n));
+    EXPECT_EQ(tags, back);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Tags within the mapped file are accessed without going through the oss
+//------------------------------------------------------------------------------
+TEST_F(XrdOssCsiTagstoreTests, MappedAccessNeedsNoCalls)
+{
+   const size_t n = 1024;
+   auto tags = Tags(n, 2);
+   std::vector<uint32_t> back(n);
+
+   {auto ts = Open<XrdOssCsiTagstoreFile>(0);
+    ASSERT_EQ((ssize_t)n, ts->WriteTags(tags.data(), 0, n));
+    ASSERT_EQ(0, ts->SetTrackedSize(n * pgSize));
+   }
+
+   auto ts = Open<XrdOssCsiTagstoreMmap>(n * pgSize);
+   int rd = nReads, wr = nWrites;
+
+   auto upd = Tags(100, 3);
+   ASSERT_EQ(100, ts->WriteTags(upd.data(), 500, 100));
+   ASSERT_EQ((ssize_t)n, ts->ReadTags(back.data(), 0, n));
+   std::copy(upd.begin(), upd.end(), tags.begin() + 500);
+   EXPECT_EQ(tags, back);
+   EXPECT_EQ(rd, nReads);
+   EXPECT_EQ(wr, nWrites);
+
+// The update reaches the file once it has been synced
+//
+   ts->Flush();
+   EXPECT_EQ(0, ts->Fsync());
+   auto fs = Open<XrdOssCsiTagstoreFile>(n * pgSize);
+   std::fill(back.begin(), back.end(), 0);
+   ASSERT_EQ((ssize_t)n, fs->ReadTags(back.data(), 0, n));
+   EXPECT_EQ(tags, back);
+}
+
+//------------------------------------------------------------------------------
+// Growing and truncating the tag file keeps the tags consistent
+//------------------------------------------------------------------------------
+TEST_F(XrdOssCsiTagstoreTests, Resize)
+{
+   const size_t n = 512;
+   auto tags = Tags(4 * n, 4);
+   std::vector<uint32_t> back(4 * n);
+
+   auto ts = Open<XrdOssCsiTagstoreMmap>(0);
+   ASSERT_EQ((ssize_t)n, ts->WriteTags(tags.data(), 0, n));
+   ASSERT_EQ(0, ts->SetTrackedSize(n * pgSize));
+   ASSERT_EQ((ssize_t)n, ts->ReadTags(back.data(), 0, n));
+
+// Extending the file beyond the mapping is seen by later reads
+//
+   ASSERT_EQ((ssize_t)(3 * n), ts->WriteTags(&tags[n], n, 3 * n));
+   ASSERT_EQ(0, ts->SetTrackedSize(4 * n * pgSize));
+   ASSERT_EQ((ssize_t)(4 * n), ts->ReadTags(back.data(), 0, 4 * n));
+   EXPECT_EQ(tags, back);
+
+// and updates of the extended part go through the mapping once it has been
+// established again
+//
+   auto upd = Tags(10, 5);
+   ASSERT_EQ(0, ts->ResetSizes(4 * n * pgSize));
+   int wr = nWrites;
+   ASSERT_EQ(10, ts->WriteTags(upd.data(), 3 * n, 10));
+   EXPECT_EQ(wr, nWrites);
+   std::copy(upd.begin(), upd.end(), tags.begin() + 3 * n);
+
+// Truncate to fewer pages than there were tags
+//
+   ASSERT_EQ(0, ts->Truncate(n * pgSize + 1, true));
+   EXPECT_EQ(20 + 4 * (off_t)(n + 1), FileSize());
+   EXPECT_EQ(n * pgSize + 1, ts->GetTrackedTagSize());
+   ASSERT_EQ((ssize_t)(n + 1), ts->ReadTags(back.data(), 0, n + 1));
+   EXPECT_TRUE(std::equal(back.begin(), back.begin() + n + 1, tags.begin()));
+   EXPECT_EQ(-EDOM, ts->ReadTags(back.data(), n + 1, 1));
+
+// Truncate up again; the new tags are zero until written
+//
+   ASSERT_EQ(0, ts->Truncate(2 * n * pgSize, true));
+   ASSERT_EQ((ssize_t)(2 * n), ts->ReadTags(back.data(), 0, 2 * n));
+   EXPECT_TRUE(std::equal(back.begin(), back.begin() + n + 1, tags.begin()));
+   EXPECT_EQ(0u, back[2 * n - 1]);
+
+// ResetSizes trims a tag file longer than the tracked size
+//
+   ASSERT_EQ(0, ts->SetTrackedSize(n * pgSize));
+   ASSERT_EQ(0, ts->ResetSizes(n * pgSize));
+   EXPECT_EQ(20 + 4 * (off_t)n, FileSize());
+   ASSERT_EQ((ssize_t)n, ts->ReadTags(back.data(), 0, n));
+   EXPECT_TRUE(std::equal(back.begin(), back.begin() + n, tags.begin()));
+   EXPECT_EQ(0, ts->Close());
+
+   ts = Open<XrdOssCsiTagstoreMmap>(n * pgSize);
+   std::fill(back.begin(), back.end(), 0);
+   ASSERT_EQ((ssize_t)n, ts->ReadTags(back.data(), 0, n));
+   EXPECT_TRUE(std::equal(back.begin(), back.begin() + n, tags.begin()));
+}
+
+//------------------------------------------------------------------------------
+// Appending with a read after every write does not remap the file each time
+//------------------------------------------------------------------------------
+TEST_F(XrdOssCsiTagstoreTests, AppendWithReads)
+{
+   const size_t n = 200000;
+   auto tags = Tags(n, 7);
+   uint32_t back;
+
+   auto ts = Open<XrdOssCsiTagstoreMmap>(0);
+   int st = nStats, rd = nReads;
+   for (size_t i = 0; i < n; i++)
+       {ASSERT_EQ(1, ts->WriteTags(&tags[i], i, 1));
+        ASSERT_EQ(1, ts->ReadTags(&back, i, 1));
+        ASSERT_EQ(tags[i], back);
+       }
+
+// The mapping was extended a few times; the tail was read with pread
+//
+   EXPECT_LE(nStats - st, 4);
+   EXPECT_LT(rd, nReads);
+
+// Everything up to the last extension is read without oss calls
+//
+   rd = nReads;
+   std::vector<uint32_t> head(n / 2);
+   ASSERT_EQ((ssize_t)head.size(), ts->ReadTags(head.data(), 0, head.size()));
+   EXPECT_TRUE(std::equal(head.begin(), head.end(), tags.begin()));
+   EXPECT_EQ(rd, nReads);
+}
+
+//------------------------------------------------------------------------------
+// Without a local descriptor the store uses read and write calls
+//------------------------------------------------------------------------------
+TEST_F(XrdOssCsiTagstoreTests, FallbackWithoutDescriptor)
+{
+   const size_t n = 256;
+   auto tags = Tags(n, 6);
+   std::vector<uint32_t> back(n);
+
+   auto ts = Open<XrdOssCsiTagstoreMmap>(0, true);
+   ASSERT_EQ((ssize_t)n, ts->WriteTags(tags.data(), 0, n));
+   ASSERT_EQ(0, ts->SetTrackedSize(n * pgSize));
+
+   int rd = nReads, wr = nWrites;
+   ASSERT_EQ((ssize_t)n, ts->ReadTags(back.data(), 0, n));
+   ASSERT_EQ(1, ts->WriteTags(&tags[7], 7, 1));
+   EXPECT_EQ(tags, back);
+   EXPECT_LT(rd, nReads);
+   EXPECT_LT(wr, nWrites);
+   EXPECT_EQ(0, ts->Close());
+
+   ts = Open<XrdOssCsiTagstoreMmap>(n * pgSize);
+   std::fill(back.begin(), back.end(), 0);
+   ASSERT_EQ((ssize_t)n, ts->ReadTags(back.data(), 0, n));
+   EXPECT_EQ(tags, back);
+}
@@ -0,0 +1,161 @@
+#include "XrdOssMirageFixture.hh"
+#include "XrdOssMirage/XrdOssMiragePattern.hh"
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+class XrdOssMirageBenchFixture : public XrdOssMirageFixture
+{
+protected:
+    void SetUp() override
+    {
+        std::string error;
+        ASSERT_TRUE(oss.configure("content=bench", error)) << error;
+        XrdOssMirageFixture::SetUp();
+    }
+
+    std::vector<char> read_all(const char *path, std::size_t size)
+    {
+        XrdOssMirageFile reader(oss);
+        reader.Open(path, O_RDONLY, {}, env);
+
+        std::vector<char> buffer(size);
+        for (std::size_t offset = 0; offset < size;)
+        {
+            const ssize_t num_bytes = reader.Read(buffer.data() + offset, offset, 100003);
+            if (num_bytes <= 0)
+                break;
+            offset += num_bytes;
+        }
+        return buffer;
+    }
+};
+
+TEST(XrdOssMirageConfigTests, ConfigureParsesAllOptions)
+{
+    XrdOssMirage oss;
+    std::string error;
+
+    ASSERT_TRUE(oss.configure("content=bench latency.open=1 latency.read=20 latency.write=300 maxrate=2m", error));
+    EXPECT_TRUE(oss.get_config().bench_content);
+    EXPECT_EQ(std::chrono::microseconds(1), oss.get_config().open_latency);
+    EXPECT_EQ(std::chrono::microseconds(20), oss.get_config().read_latency);
+    EXPECT_EQ(std::chrono::microseconds(300), oss.get_config().write_latency);
+    EXPECT_EQ(2u << 20, oss.get_config().max_rate);
+}
+
+TEST(XrdOssMirageConfigTests, ConfigureWithoutParametersKeepsDefaults)
+{
+    XrdOssMirage oss;
+    std::string error;
+
+    ASSERT_TRUE(oss.configure(nullptr, error));
+    EXPECT_FALSE(oss.get_config().bench_content);
+    EXPECT_EQ(0u, oss.get_config().max_rate);
+}
+
+TEST(XrdOssMirageConfigTests, ConfigureRejectsInvalidOptions)
+{
+    XrdOssMirage oss;
+    std::string error;
+
+    EXPECT_FALSE(oss.configure("unknown=1", error));
+    EXPECT_FALSE(oss.configure("content=random", error));
+    EXPECT_FALSE(oss.configure("latency.read=abc", error));
+    EXPECT_FALSE(oss.configure("maxrate=10x", error));
+    EXPECT_FALSE(oss.configure("maxrate=", error));
+}
+
+TEST_F(XrdOssMirageBenchFixture, ContentIsDeterministic)
+{
+    oss.Create(nullptr, "/other", {}, env, XRDOSS_new);
+    oss.Truncate("/other", 9999);
+
+    const auto first = read_all("/dummy", 9999);
+    const auto second = read_all("/dummy", 9999);
+    const auto other = read_all("/other", 9999);
+
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, other);
+}
+
+TEST_F(XrdOssMirageBenchFixture, ContentDoesNotDependOnReadOffsets)
+{
+    const auto whole = read_all("/dummy", 9999);
+
+    file.Open("/dummy", O_RDONLY, {}, env);
+    char buffer[100];
+    ASSERT_EQ(100, file.Read(buffer, 1234, sizeof(buffer)));
+
+    EXPECT_TRUE(std::equal(buffer, buffer + sizeof(buffer), whole.begin() + 1234));
+}
+
+TEST_F(XrdOssMirageBenchFixture, ReadPastTheEndReturnsNothing)
+{
+    file.Open("/dummy", O_RDONLY, {}, env);
+    char buffer[100];
+
+    EXPECT_EQ(0, file.Read(buffer, 9999, sizeof(buffer)));
+    EXPECT_EQ(0, file.Read(buffer, 20000, sizeof(buffer)));
+}
+
+TEST_F(XrdOssMirageBenchFixture, PatternTakesPrecedenceOverBenchContent)
+{
+    xattr.Set("U.pattern", "x", 1, "/dummy", 0, 0);
+
+    file.Open("/dummy", O_RDONLY, {}, env);
+    char buffer[10];
+    file.Read(buffer, 0, sizeof(buffer));
+
+    EXPECT_EQ(std::string(10, 'x'), std::string(buffer, sizeof(buffer)));
+    EXPECT_EQ(-EINVAL, xattr.Get("U.adler32", buffer, sizeof(buffer), "/dummy", 0));
+}
+
+TEST_F(XrdOssMirageBenchFixture, Adler32MatchesContent)
+{
+    // sizes below, at and across several pattern periods
+    const std::size_t period = XrdOssMiragePattern::period;
+    for (const std::size_t size : {std::size_t{0}, std::size_t{1}, std::size_t{9999}, period,
+                                   period + 17, 3 * period, 5 * period + 12345})
+    {
+        oss.Truncate("/dummy", size);
+        const auto content = read_all("/dummy", size);
+
+        char expected[9];
+        std::snprintf(expected, sizeof(expected), "%08lx",
+                      ::adler32(::adler32(0L, Z_NULL, 0), reinterpret_cast<const Bytef *>(content.data()), size));
+
+        char value[16] = {};
+        ASSERT_EQ(8, xattr.Get("U.adler32", value, sizeof(value), "/dummy", 0));
+        EXPECT_STREQ(expected, value) << "size " << size;
+    }
+}
+
+TEST_F(XrdOssMirageFixture, Adler32IsOnlyAvailableInBenchMode)
+{
+    char value[16];
+    EXPECT_EQ(-EINVAL, xattr.Get("U.adler32", value, sizeof(value), "/dummy", 0));
+}
+
+TEST_F(XrdOssMirageFixture, ReadIsThrottledToMaxRate)
+{
+    std::string error;
+    ASSERT_TRUE(oss.configure("maxrate=1m", error));
+
+    file.Open("/dummy", O_RDONLY, {}, env);
+    std::vector<char> buffer(9999);
+
+    // 10 reads of ~10kB at 1MiB/s take roughly 95ms
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; ++i)
+        file.Read(buffer.data(), 0, buffer.size());
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(90));
+}
@@ -0,0 +1,76 @@
+#undef NDEBUG
+
+#include "XrdOuc/XrdOucCRC.hh"
+#include "XrdOuc/XrdOucCRC32C.hh"
+#include "XrdSys/XrdSysPageSize.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+class XrdOucCRCTests : public ::testing::Test {};
+
+static std::vector<uint8_t> randomData(size_t len)
+{
+  std::vector<uint8_t> buf(len);
+  srand(1234);
+  for (auto &c : buf) c = rand() & 0xff;
+  return buf;
+}
+
+// Page checksums must be identical to checksumming every page on its own,
+// whatever the buffer alignment and however many (partial) pages there are.
+TEST(XrdOucCRCTests, Calc32CPages)
+{
+  const size_t pgsz = XrdSys::PageSize;
+  auto buf = randomData(pgsz*16 + 8);
+  const size_t lens[] = {1, 7, pgsz-1, pgsz, pgsz+1, 2*pgsz, 3*pgsz,
+                         3*pgsz+13, 7*pgsz+5, 16*pgsz};
+
+  for (size_t off = 0; off < 8; off++)
+    for (size_t len : lens)
+    {
+      const size_t npg = (len + pgsz - 1) / pgsz;
+      std::vector<uint32_t> csvec(npg), swvec(npg);
+      XrdOucCRC::Calc32C(&buf[off], len, csvec.data());
+      crc32c_pages_sw(&buf[off], len, pgsz, swvec.data());
+      for (size_t i = 0; i < npg; i++)
+      {
+        const size_t plen = std::min(pgsz, len - i*pgsz);
+        EXPECT_EQ(csvec[i], XrdOucCRC::Calc32C(&buf[off + i*pgsz], plen))
+          << "off=" << off << " len=" << len << " page=" << i;
+        EXPECT_EQ(csvec[i], swvec[i]);
+      }
+    }
+}
+
+// Page verification reports the first mismatching page, also when it lies
+// beyond the first batch of pages checked.
+TEST(XrdOucCRCTests, Ver32CPages)
+{
+  const size_t pgsz = XrdSys::PageSize;
+  const size_t len = 100*pgsz + 100;
+  const size_t npg = (len + pgsz - 1) / pgsz;
+  auto buf = randomData(len);
+  std::vector<uint32_t> csvec(npg), valcs(npg);
+  std::vector<char> valok(npg);
+  uint32_t badcs;
+
+  XrdOucCRC::Calc32C(buf.data(), len, csvec.data());
+  EXPECT_EQ(XrdOucCRC::Ver32C(buf.data(), len, csvec.data(), badcs), -1);
+  EXPECT_TRUE(XrdOucCRC::Ver32C(buf.data(), len, csvec.data(), valcs.data()));
+
+  for (size_t bad : {size_t(0), size_t(47), size_t(48), size_t(99), npg-1})
+  {
+    const uint32_t good = csvec[bad];
+    csvec[bad] ^= 1;
+    EXPECT_EQ(XrdOucCRC::Ver32C(buf.data(), len, csvec.data(), badcs), (int)bad);
+    EXPECT_EQ(badcs, good);
+    EXPECT_FALSE(XrdOucCRC::Ver32C(buf.data(), len, csvec.data(),
+                                   (bool *)valok.data()));
+    for (size_t i = 0; i < npg; i++) EXPECT_EQ((bool)valok[i], i != bad);
+    csvec[bad] = good;
+  }
+}
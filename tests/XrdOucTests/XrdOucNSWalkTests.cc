@@ -0,0 +1,119 @@
+#undef NDEBUG
+
+#include "XrdOuc/XrdOucNSWalk.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <gtest/gtest.h>
+
+class XrdOucNSWalkTests : public ::testing::Test
+{
+protected:
+
+void SetUp() override
+{
+   char tmpl[] = "/tmp/xrdoucnswalk.XXXXXX";
+   ASSERT_NE(mkdtemp(tmpl), nullptr);
+   root = tmpl;
+   MkDir("a"); MkDir("b"); MkDir("b/c"); MkDir("b/c/d"); MkDir("e");
+   MkFile("a/f1"); MkFile("a/f2"); MkFile("b/f3");
+   MkFile("b/c/d/f4"); MkFile("b/c/d/f5"); MkFile("f6");
+}
+
+void TearDown() override
+{
+   std::string cmd = "rm -rf " + root;
+   ASSERT_EQ(system(cmd.c_str()), 0);
+}
+
+void MkDir(const char *dn)
+{
+   ASSERT_EQ(mkdir((root + "/" + dn).c_str(), 0755), 0);
+}
+
+void MkFile(const char *fn)
+{
+   int fd = open((root + "/" + fn).c_str(), O_CREAT|O_WRONLY, 0644);
+   ASSERT_GE(fd, 0);
+   ASSERT_EQ(write(fd, "data", 4), 4);
+   close(fd);
+}
+
+std::set<std::string> Walk(int nThreads, XrdOucNSIndex *ixP=0)
+{
+   static const int opts = XrdOucNSWalk::retFile | XrdOucNSWalk::retStat
+                         | XrdOucNSWalk::Recurse;
+   XrdOucNSWalk nsWalk(0, root.c_str(), 0, opts);
+   XrdOucNSWalk::NSEnt *nP, *eP;
+   std::set<std::string> files;
+   int rc;
+
+   nsWalk.setThreads(nThreads);
+   nsWalk.setIndex(ixP);
+   while((nP = nsWalk.Index(rc)))
+        {while((eP = nP))
+              {files.insert(eP->Path + root.size() + 1);
+               nP = eP->Next;
+               delete eP;
+              }
+        }
+   EXPECT_EQ(rc, 0);
+   return files;
+}
+
+std::string root;
+};
+
+TEST_F(XrdOucNSWalkTests, ParallelMatchesSequential)
+{
+   std::set<std::string> seq = Walk(0);
+
+   EXPECT_EQ(seq.size(), 6u);
+   EXPECT_TRUE(seq.count("b/c/d/f5"));
+   EXPECT_EQ(Walk(4), seq);
+   EXPECT_EQ(Walk(2), seq);
+}
+
+TEST_F(XrdOucNSWalkTests, IndexSkipsUnchangedDirectories)
+{
+   std::string ixPath = root + ".index";
+   XrdOucNSIndex ixObj, ixNew;
+   XrdOucNSIndex::Totals tots;
+
+// Recently changed directories are never recorded, so let the tree settle
+//
+   sleep(2);
+   EXPECT_EQ(Walk(0, &ixObj).size(), 6u);
+   ixObj.Stats(tots);
+   EXPECT_EQ(tots.Dirs, 0);
+   EXPECT_EQ(tots.Ents, 6);
+
+// Nothing changed so nothing is returned, yet everything is accounted for
+//
+   EXPECT_TRUE(Walk(3, &ixObj).empty());
+   ixObj.Stats(tots);
+   EXPECT_EQ(tots.Dirs, 6);
+   EXPECT_EQ(tots.Files, 6);
+   EXPECT_EQ(tots.Bytes, 24);
+
+// The index must survive a save and load
+//
+   ASSERT_EQ(ixObj.Save(ixPath.c_str()), 0);
+   ASSERT_EQ(ixNew.Load(ixPath.c_str()), 0);
+   unlink(ixPath.c_str());
+
+// Only the changed directory is listed again
+//
+   MkFile("b/c/d/f7");
+   std::set<std::string> files = Walk(0, &ixNew);
+   EXPECT_EQ(files.size(), 3u);
+   EXPECT_TRUE(files.count("b/c/d/f7"));
+   ixNew.Stats(tots);
+   EXPECT_EQ(tots.Dirs, 5);
+}
@@ -0,0 +1,248 @@
+//------------------------------------------------------------------------------
+// Unit tests for the XrdPosixObject file descriptor table.
+//
+// The table is set up with virtual file descriptors so that the tests do not
+// depend on which real descriptors the process happens to have open. They
+// check that:
+//   - descriptors are handed out from the bottom of the table and a released
+//     descriptor is the next one to be reused;
+//   - lookups only find objects of the requested kind and fail once the
+//     object has been released;
+//   - a thread closing descriptors while other threads look them up never
+//     lets a lookup return an object that has already been deleted.
+//------------------------------------------------------------------------------
+
+#include "XrdPosix/XrdPosixObject.hh"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <sched.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+//------------------------------------------------------------------------------
+// A file object that poisons itself when it is deleted
+//------------------------------------------------------------------------------
+class TestFile : public XrdPosixObject
+{
+public:
+
+static const unsigned int aliveMark = 0x600dF11e;
+
+bool Who(XrdPosixFile **fileP) override
+        {*fileP = reinterpret_cast<XrdPosixFile *>(this); return true;}
+
+bool Alive() const {return mark == aliveMark;}
+
+     TestFile() : mark(aliveMark) {}
+    ~TestFile() {mark = 0;}
+
+private:
+volatile unsigned int mark;
+};
+
+TestFile *AsTest(XrdPosixFile *fP) {return reinterpret_cast<TestFile *>(fP);}
+
+const int tableSize = 8;
+
+class XrdPosixObjectTest : public ::testing::Test
+{
+protected:
+// The table can only be set up once per process, so every test starts from
+// an empty table by closing whatever the previous test left behind.
+//
+   static void SetUpTestSuite() {baseFD = XrdPosixObject::Init(-tableSize);}
+
+   static void TearDownTestSuite() {XrdPosixObject::Shutdown();}
+
+   void SetUp() override {ASSERT_GT(baseFD, 0);}
+
+   void TearDown() override
+        {XrdPosixFile *fP;
+         for (int fd = baseFD; fd < baseFD + tableSize; fd++)
+             if ((fP = XrdPosixObject::ReleaseFile(fd)))
+                delete reinterpret_cast<TestFile *>(fP);
+        }
+
+   static int baseFD;
+};
+
+int XrdPosixObjectTest::baseFD = 0;
+}
+
+//------------------------------------------------------------------------------
+// Descriptors are assigned from the bottom of the table
+//------------------------------------------------------------------------------
+TEST_F(XrdPosixObjectTest, AssignsConsecutiveDescriptors)
+{
+   std::vector<TestFile *> files;
+
+   for (int i = 0; i < tableSize; i++)
+       {files.push_back(new TestFile);
+        ASSERT_TRUE(files.back()->AssignFD());
+        EXPECT_EQ(baseFD + i, files.back()->FDNum());
+        EXPECT_TRUE(XrdPosixObject::Valid(baseFD + i));
+       }
+
+// The table is full now and virtual descriptors can never be streams
+//
+   TestFile extra;
+   EXPECT_FALSE(extra.AssignFD());
+   EXPECT_FALSE(extra.AssignFD(true));
+   EXPECT_EQ(-1, extra.FDNum());
+}
+
+//------------------------------------------------------------------------------
+// A released descriptor is the next one handed out
+//------------------------------------------------------------------------------
+TEST_F(XrdPosixObjectTest, ReusesReleasedDescriptor)
+{
+   TestFile *f0 = new TestFile, *f1 = new TestFile, *f2 = new TestFile;
+
+   ASSERT_TRUE(f0->AssignFD());
+   ASSERT_TRUE(f1->AssignFD());
+   ASSERT_TRUE(f2->AssignFD());
+
+   int fd = f1->FDNum();
+   ASSERT_EQ(f1, AsTest(XrdPosixObject::ReleaseFile(fd)));
+   EXPECT_EQ(-1, f1->FDNum());
+   EXPECT_FALSE(XrdPosixObject::Valid(fd));
+   delete f1;
+
+   TestFile *f3 = new TestFile;
+   ASSERT_TRUE(f3->AssignFD());
+   EXPECT_EQ(fd, f3->FDNum());
+
+   TestFile *f4 = new TestFile;
+   ASSERT_TRUE(f4->AssignFD());
+   EXPECT_EQ(f2->FDNum() + 1, f4->FDNum());
+}
+
+//------------------------------------------------------------------------------
+// Deleting an object that still owns a descriptor releases the descriptor
+//------------------------------------------------------------------------------
+TEST_F(XrdPosixObjectTest, DeleteReleasesDescriptor)
+{
+   TestFile *fP = new TestFile;
+
+   ASSERT_TRUE(fP->AssignFD());
+   int fd = fP->FDNum();
+   delete fP;
+
+   EXPECT_FALSE(XrdPosixObject::Valid(fd));
+   errno = 0;
+   EXPECT_EQ(nullptr, XrdPosixObject::File(fd));
+   EXPECT_EQ(EBADF, errno);
+}
+
+//------------------------------------------------------------------------------
+// Lookups only find live objects of the right kind
+//------------------------------------------------------------------------------
+TEST_F(XrdPosixObjectTest, LookupFindsAssignedObject)
+{
+   TestFile *fP = new TestFile;
+
+   ASSERT_TRUE(fP->AssignFD());
+   int fd = fP->FDNum();
+
+   XrdPosixFile *found = XrdPosixObject::File(fd);
+   ASSERT_EQ(fP, AsTest(found));
+   fP->UnLock();
+
+   errno = 0;
+   EXPECT_EQ(nullptr, XrdPosixObject::Dir(fd));
+   EXPECT_EQ(EBADF, errno);
+
+   errno = 0;
+   EXPECT_EQ(nullptr, XrdPosixObject::File(baseFD - 1));
+   EXPECT_EQ(EBADF, errno);
+
+   errno = 0;
+   EXPECT_EQ(nullptr, XrdPosixObject::File(baseFD + tableSize));
+   EXPECT_EQ(EBADF, errno);
+
+   ASSERT_EQ(fP, AsTest(XrdPosixObject::ReleaseFile(fd)));
+   EXPECT_EQ(nullptr, XrdPosixObject::File(fd));
+   EXPECT_EQ(nullptr, XrdPosixObject::ReleaseFile(fd));
+   delete fP;
+}
+
+//------------------------------------------------------------------------------
+// Lookups hold the object read lock, so a close has to wait for them
+//------------------------------------------------------------------------------
+TEST_F(XrdPosixObjectTest, LookupHoldsReadLock)
+{
+   TestFile *fP = new TestFile;
+
+   ASSERT_TRUE(fP->AssignFD());
+   int fd = fP->FDNum();
+
+   ASSERT_NE(nullptr, XrdPosixObject::File(fd));
+   ASSERT_NE(nullptr, XrdPosixObject::File(fd));
+   fP->UnLock();
+   fP->UnLock();
+
+   ASSERT_EQ(fP, AsTest(XrdPosixObject::ReleaseFile(fd)));
+   delete fP;
+}
+
+//------------------------------------------------------------------------------
+// One thread closes and reopens descriptors while others keep looking them up.
+// Every object a lookup returns must still be alive while it is held.
+//------------------------------------------------------------------------------
+TEST_F(XrdPosixObjectTest, ConcurrentCloseAndLookup)
+{
+   const int numReaders = 4, numFiles = tableSize/2, numCycles = 500;
+   std::atomic<bool> done(false);
+   std::atomic<long> hits(0), stale(0);
+   std::vector<int> fds;
+
+   for (int i = 0; i < numFiles; i++)
+       {TestFile *fP = new TestFile;
+        ASSERT_TRUE(fP->AssignFD());
+        fds.push_back(fP->FDNum());
+       }
+
+   auto reader = [&](int first)
+        {int n = first;
+         while(!done.load())
+              {XrdPosixFile *fP = XrdPosixObject::File(fds[n++ % numFiles]);
+               if (fP)
+                  {if (!AsTest(fP)->Alive()) stale++;
+                   hits++;
+                   AsTest(fP)->UnLock();
+                  }
+               std::this_thread::sleep_for(std::chrono::microseconds(20));
+              }
+        };
+
+   std::vector<std::thread> readers;
+   for (int i = 0; i < numReaders; i++) readers.emplace_back(reader, i);
+
+// Do not start closing before the readers are running and keep closing until
+// the readers have had a fair chance to race with it.
+//
+   while(hits.load() < numReaders) sched_yield();
+
+   for (int i = 0; i < numCycles || hits.load() < numCycles; i++)
+       {int fd = fds[i % numFiles];
+        XrdPosixFile *fP = XrdPosixObject::ReleaseFile(fd);
+        if (!fP) {ADD_FAILURE() << "fd " <<fd <<" vanished"; break;}
+        delete AsTest(fP);
+
+        TestFile *nP = new TestFile;
+        if (!nP->AssignFD() || nP->FDNum() != fd)
+           {ADD_FAILURE() << "fd " <<fd <<" was not reused"; delete nP; break;}
+       }
+
+   done = true;
+   for (auto &t : readers) t.join();
+
+   EXPECT_EQ(0, stale.load());
+   EXPECT_GT(hits.load(), 0);
+}
@@ -0,0 +1,500 @@
+//------------------------------------------------------------------------------
+// Unit tests for XrdPssStream read-ahead and write-behind.
+//
+// The proxied file is an in-memory file behind a stand-in for the XrdPosix
+// calls the stream makes. Asynchronous requests either complete at once or
+// are held until the test completes them. The tests check that:
+//   - sequential reads start read-ahead past the data asked for and are then
+//     served from the window without further synchronous reads;
+//   - a read that breaks the sequence is read directly and starts no
+//     read-ahead, while reads waiting for a block in flight get its data;
+//   - a short read-ahead marks the end of file and stops the window;
+//   - a failed read-ahead block is read again directly;
+//   - contiguous writes are aggregated into full blocks, a write elsewhere
+//     flushes the partial block and Drain() writes out the remainder;
+//   - overlapping blocks are written in the order they were written;
+//   - the first write error is returned by every later Write() and Drain();
+//   - a writer reading back the file sees its buffered data;
+//   - once all streams together hold maxMem bytes, writes bypass the buffers
+//     until some stream releases its blocks.
+//------------------------------------------------------------------------------
+
+#include "XrdPosix/XrdPosixXrootd.hh"
+#include "XrdPss/XrdPssStream.hh"
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// The remote file and the requests made against it
+//------------------------------------------------------------------------------
+class RemoteFile
+{
+public:
+
+struct Request
+      {XrdPosixCallBackIO *cbp;
+       char               *rbuf;
+       std::string         wdata;
+       off_t               offset;
+       size_t              len;
+      };
+
+using Span = std::pair<off_t, size_t>;
+
+// Complete the oldest held request
+//
+void Complete()
+    {Request req;
+     {std::unique_lock<std::mutex> lck(mtx);
+      if (!cv.wait_for(lck, std::chrono::seconds(10),
+                       [this]() {return !held.empty();})) return;
+      req = std::move(held.front());
+      held.pop_front();
+     }
+     Finish(req);
+    }
+
+// Wait until n requests are held
+//
+bool Held(size_t n)
+    {std::unique_lock<std::mutex> lck(mtx);
+     return cv.wait_for(lck, std::chrono::seconds(10),
+                        [&]() {return held.size() >= n;});
+    }
+
+size_t HeldNow() {std::lock_guard<std::mutex> lck(mtx); return held.size();}
+
+ssize_t Read(char *buff, off_t offset, size_t len)
+       {std::lock_guard<std::mutex> lck(mtx);
+        if (offset >= (off_t)data.size()) return 0;
+        if (len > data.size() - offset) len = data.size() - offset;
+        data.copy(buff, len, offset);
+        return len;
+       }
+
+ssize_t Write(const std::string &wdata, off_t offset)
+       {std::lock_guard<std::mutex> lck(mtx);
+        if (data.size() < offset + wdata.size())
+           data.resize(offset + wdata.size(), 0);
+        data.replace(offset, wdata.size(), wdata);
+        return wdata.size();
+       }
+
+void Submit(Request &&req, bool isWrite)
+    {{std::lock_guard<std::mutex> lck(mtx);
+      (isWrite ? asyncWrites : asyncReads).push_back({req.offset, req.len});
+      if (hold)
+         {held.push_back(std::move(req));
+          cv.notify_all();
+          return;
+         }
+     }
+     Finish(req);
+    }
+
+std::mutex              mtx;
+std::condition_variable cv;
+std::string             data;
+std::deque<Request>     held;
+std::vector<Span>       asyncReads;
+std::vector<Span>       asyncWrites;
+std::vector<Span>       syncReads;
+std::vector<Span>       syncWrites;
+int                     failRead  = 0;   // Fail asynchronous reads
+int                     failWrite = 0;   // Fail asynchronous writes
+bool                    hold      = false;
+
+private:
+
+void Finish(Request &req)
+    {ssize_t rc;
+     if (req.rbuf) rc = (failRead  ? -failRead  : Read(req.rbuf, req.offset,
+                                                        req.len));
+        else       rc = (failWrite ? -failWrite : Write(req.wdata, req.offset));
+     req.cbp->Complete(rc);
+    }
+};
+
+RemoteFile *theFile = 0;
+
+const int testFD = 7;
+const int bsz    = 4096;
+
+std::string Pattern(size_t size, int seed)
+{
+   std::string data(size, 0);
+   for (size_t i = 0; i < size; i++) data[i] = static_cast<char>(i * 31 + seed);
+   return data;
+}
+}
+
+/******************************************************************************/
+/*                X r d P o s i x   S t a n d - I n s   (I/O)                 */
+/******************************************************************************/
+
+void XrdPosixCallBackIO::Done(int result) {Complete(result);}
+
+ssize_t XrdPosixXrootd::Pread(int fildes, void *buf, size_t nbyte, off_t offset)
+{
+   EXPECT_EQ(testFD, fildes);
+   {std::lock_guard<std::mutex> lck(theFile->mtx);
+    theFile->syncReads.push_back({offset, nbyte});
+   }
+   ssize_t rc = theFile->Read((char *)buf, offset, nbyte);
+   if (rc < 0) {errno = -rc; return -1;}
+   return rc;
+}
+
+void XrdPosixXrootd::Pread(int fildes, void *buf, size_t nbyte, off_t offset,
+                           XrdPosixCallBackIO *cbp)
+{
+   EXPECT_EQ(testFD, fildes);
+   theFile->Submit({cbp, (char *)buf, std::string(), offset, nbyte}, false);
+}
+
+ssize_t XrdPosixXrootd::Pwrite(int fildes, const void *buf, size_t nbyte,
+                               off_t offset)
+{
+   EXPECT_EQ(testFD, fildes);
+   {std::lock_guard<std::mutex> lck(theFile->mtx);
+    theFile->syncWrites.push_back({offset, nbyte});
+   }
+   ssize_t rc = theFile->Write(std::string((const char *)buf, nbyte), offset);
+   if (rc < 0) {errno = -rc; return -1;}
+   return rc;
+}
+
+void XrdPosixXrootd::Pwrite(int fildes, const void *buf, size_t nbyte,
+                            off_t offset, XrdPosixCallBackIO *cbp)
+{
+   EXPECT_EQ(testFD, fildes);
+   theFile->Submit({cbp, 0, std::string((const char *)buf, nbyte), offset,
+                    nbyte}, true);
+}
+
+/******************************************************************************/
+/*                              F i x t u r e                                 */
+/******************************************************************************/
+
+class XrdPssStreamTests : public ::testing::Test
+{
+protected:
+
+void SetUp() override
+     {saved[0] = XrdPssStream::rdBlocks;
+      saved[1] = XrdPssStream::wrBlocks;
+      saved[2] = XrdPssStream::blkSize;
+      savedMax = XrdPssStream::maxMem;
+      XrdPssStream::rdBlocks = 2;
+      XrdPssStream::wrBlocks = 2;
+      XrdPssStream::blkSize  = bsz;
+      theFile = &file;
+     }
+
+void TearDown() override
+     {XrdPssStream::rdBlocks = saved[0];
+      XrdPssStream::wrBlocks = saved[1];
+      XrdPssStream::blkSize  = saved[2];
+      XrdPssStream::maxMem   = savedMax;
+      theFile = 0;
+     }
+
+// Read through the stream and check the data against the file
+//
+void ReadAndCheck(XrdPssStream &strm, off_t offset, size_t len,
+                  ssize_t expect = -1)
+     {std::string buff(len, 0);
+      if (expect < 0) expect = len;
+      ASSERT_EQ(expect, strm.Read(&buff[0], offset, len));
+      EXPECT_TRUE(file.data.compare(offset, expect, buff, 0, expect) == 0)
+                 << "data mismatch at offset " << offset;
+     }
+
+RemoteFile file;
+int        saved[3];
+long long  savedMax;
+};
+
+//------------------------------------------------------------------------------
+// Streams are only used when configured for the kind of open
+//------------------------------------------------------------------------------
+TEST_F(XrdPssStreamTests, Enabled)
+{
+   EXPECT_TRUE(XrdPssStream::Enabled(false));
+   EXPECT_TRUE(XrdPssStream::Enabled(true));
+
+   XrdPssStream::rdBlocks = 0;
+   EXPECT_FALSE(XrdPssStream::Enabled(false));
+   EXPECT_TRUE(XrdPssStream::Enabled(true));
+}
+
+//------------------------------------------------------------------------------
+// Sequential reads fill the window and are then served from it
+//------------------------------------------------------------------------------
+TEST_F(XrdPssStreamTests, SequentialReadAhead)
+{
+   file.data = Pattern(20000, 1);
+   file.hold = true;
+   XrdPssStream strm(testFD, false);
+
+   ReadAndCheck(strm, 0, 1000);
+   ASSERT_EQ(1u, file.syncReads.size());
+   ASSERT_EQ(2u, file.asyncReads.size());
+   EXPECT_EQ(RemoteFile::Span(1000, bsz), file.asyncReads[0]);
+   EXPECT_EQ(RemoteFile::Span(1000 + bsz, bsz), file.asyncReads[1]);
+
+   file.Complete();
+   file.Complete();
+   file.hold = false;
+
+// Both blocks are consumed without synchronous reads. The first one is then
+// reused for the next block of the window.
+//
+   ReadAndCheck(strm, 1000, 2 * bsz);
+   EXPECT_EQ(1u, file.syncReads.size());
+   ASSERT_EQ(4u, file.asyncReads.size());
+   EXPECT_EQ(RemoteFile::Span(1000 + 2*bsz, bsz), file.asyncReads[2]);
+
+   ReadAndCheck(strm, 1000 + 2*bsz, 100);
+   EXPECT_EQ(1u, file.syncReads.size());
+}
+
+//------------------------------------------------------------------------------
+// A read that breaks the sequence is read directly and reads waiting on a
+// block in flight get its data once it arrives.
+//------------------------------------------------------------------------------
+TEST_F(XrdPssStreamTests, RandomReadAndWaitForBlock)
+{
+   file.data = Pattern(50000, 2);
+   file.hold = true;
+   XrdPssStream strm(testFD, false);
+
+   ReadAndCheck(strm, 0, 100);
+   ASSERT_EQ(2u, file.asyncReads.size());
+
+// Random reads do not touch the window and start no read-ahead
+//
+   ReadAndCheck(strm, 30000, 500);
+   EXPECT_EQ(2u, file.syncReads.size());
+   EXPECT_EQ(2u, file.asyncReads.size());
+
+// Reading where the window is waits for the block in flight. The pattern is
+// not sequential so the read-ahead is not extended.
+//
+   std::thread reader([&]() {ReadAndCheck(strm, 100, 200);});
+   std::this_thread::sleep_for(std::chrono::milliseconds(50));
+   file.Complete();
+   reader.join();
+   EXPECT_EQ(2u, file.syncReads.size());
+   EXPECT_EQ(2u, file.asyncReads.size());
+   file.Complete();
+}
+
+//------------------------------------------------------------------------------
+// A short read-ahead tells the stream where the file ends
+//------------------------------------------------------------------------------
+TEST_F(XrdPssStreamTests, ShortReadMarksEOF)
+{
+   XrdPssStream::rdBlocks = 4;
+   file.data = Pattern(6000, 3);
+   XrdPssStream strm(testFD, false);
+
+   ReadAndCheck(strm, 0, 100);
+   size_t nAsync = file.asyncReads.size();
+   EXPECT_EQ(4u, nAsync);
+
+// The rest of the file comes from the window, the read stopping at the end
+// of file without a synchronous read and without more read-ahead.
+//
+   ReadAndCheck(strm, 100, 8000, 5900);
+   EXPECT_EQ(1u, file.syncReads.size());
+   EXPECT_EQ(nAsync, file.asyncReads.size());
+
+   ReadAndCheck(strm, 6000, 100, 0);
+   EXPECT_EQ(nAsync, file.asyncReads.size());
+}
+
+//------------------------------------------------------------------------------
+// A failed read-ahead block is read again directly
+//------------------------------------------------------------------------------
+TEST_F(XrdPssStreamTests, FailedReadAhead)
+{
+   file.data = Pattern(20000, 4);
+   XrdPssStream strm(testFD, false);
+
+   file.failRead = EIO;
+   ReadAndCheck(strm, 0, 100);
+   EXPECT_EQ(1u, file.syncReads.size());
+   EXPECT_EQ(2u, file.asyncReads.size());
+
+   file.failRead = 0;
+   ReadAndCheck(strm, 100, 1000);
+   EXPECT_EQ(2u, file.syncReads.size());
+   EXPECT_EQ(RemoteFile::Span(100, 1000), file.syncReads[1]);
+}
+
+//------------------------------------------------------------------------------
+// Contiguous writes are aggregated into full blocks
+//------------------------------------------------------------------------------
+TEST_F(XrdPssStreamTests, WritesAreAggregated)
+{
+   std::string data = Pattern(10000, 5);
+   XrdPssStream strm(testFD, true);
+
+   for (size_t off = 0; off < data.size(); off += 1000)
+       ASSERT_EQ(1000, strm.Write(&data[off], off, 1000));
+
+   ASSERT_EQ(2u, file.asyncWrites.size());
+   EXPECT_EQ(RemoteFile::Span(0, bsz), file.asyncWrites[0]);
+   EXPECT_EQ(RemoteFile::Span(bsz, bsz), file.asyncWrites[1]);
+
+   EXPECT_EQ(0, strm.Drain());
+   ASSERT_EQ(3u, file.asyncWrites.size());
+   EXPECT_EQ(RemoteFile::Span(2*bsz, 10000 - 2*bsz), file.asyncWrites[2]);
+   EXPECT_EQ(0u, file.syncWrites.size());
+   EXPECT_EQ(data, file.data);
+
+// Nothing is left to write
+//
+   EXPECT_EQ(0, strm.Drain());
+   EXPECT_EQ(3u, file.asyncWrites.size());
+}
+
+//------------------------------------------------------------------------------
+// A write elsewhere flushes the block being filled
+//------------------------------------------------------------------------------
+TEST_F(XrdPssStreamTests, NonContiguousWriteFlushes)
+{
+   std::string a = Pattern(100, 6), b = Pattern(200, 7);
+   XrdPssStream strm(testFD, true);
+
+   ASSERT_EQ(100, strm.Write(a.data(), 0, 100));
+   EXPECT_EQ(0u, file.asyncWrites.size());
+   ASSERT_EQ(200, strm.Write(b.data(), 10000, 200));
+   ASSERT_EQ(1u, file.asyncWrites.size());
+   EXPECT_EQ(RemoteFile::Span(0, 100), file.asyncWrites[0]);
+
+   EXPECT_EQ(0, strm.Drain());
+   ASSERT_EQ(2u, file.asyncWrites.size());
+   EXPECT_EQ(RemoteFile::Span(10000, 200), file.asyncWrites[1]);
+   EXPECT_EQ(0, file.data.compare(0, 100, a));
+   EXPECT_EQ(0, file.data.compare(10000, 200, b));
+}
+
+//------------------------------------------------------------------------------
+// Overlapping blocks reach the file in the order they were written
+//------------------------------------------------------------------------------
+TEST_F(XrdPssStreamTests, OverlappingWritesInOrder)
+{
+   std::string a = Pattern(bsz, 8), b = Pattern(bsz, 9);
+   XrdPssStream strm(testFD, true);
+
+   file.hold = true;
+   ASSERT_EQ(bsz, strm.Write(a.data(), 0, bsz));
+   ASSERT_TRUE(file.Held(1));
+
+// The rewrite must not be sent while the first write is in flight
+//
+   std::thread writer([&]() {EXPECT_EQ(bsz, strm.Write(b.data(), 0, bsz));});
+   std::this_thread::sleep_for(std::chrono::milliseconds(50));
+   EXPECT_EQ(1u, file.HeldNow());
+   EXPECT_EQ(1u, file.asyncWrites.size());
+
+   file.Complete();
+   ASSERT_TRUE(file.Held(1));
+   file.Complete();
+   writer.join();
+
+   file.hold = false;
+   EXPECT_EQ(0, strm.Drain());
+   EXPECT_EQ(2u, file.asyncWrites.size());
+   EXPECT_EQ(b, file.data);
+}
+
+//------------------------------------------------------------------------------
+// The first write error sticks
+//------------------------------------------------------------------------------
+TEST_F(XrdPssStreamTests, WriteErrorIsSticky)
+{
+   std::string data = Pattern(2 * bsz, 10);
+   XrdPssStream strm(testFD, true);
+
+   file.failWrite = ENOSPC;
+   file.hold = true;
+   ASSERT_EQ(bsz, strm.Write(data.data(), 0, bsz));
+   EXPECT_EQ(1u, file.asyncWrites.size());
+   file.Complete();
+
+   file.hold = false;
+   file.failWrite = 0;
+   EXPECT_EQ(-ENOSPC, strm.Write(&data[bsz], bsz, 100));
+   EXPECT_EQ(-ENOSPC, strm.Drain());
+   EXPECT_EQ(-ENOSPC, strm.Write(&data[bsz], bsz, 100));
+   EXPECT_EQ(-ENOSPC, strm.Drain());
+   EXPECT_EQ(1u, file.asyncWrites.size());
+   EXPECT_EQ(0u, file.syncWrites.size());
+}
+
+//------------------------------------------------------------------------------
+// A writer reading the file sees what it has written so far
+//------------------------------------------------------------------------------
+TEST_F(XrdPssStreamTests, WriterReadsBack)
+{
+   std::string data = Pattern(bsz + 500, 11);
+   XrdPssStream strm(testFD, true);
+
+   ASSERT_EQ((ssize_t)data.size(), strm.Write(data.data(), 0, data.size()));
+   EXPECT_EQ(1u, file.asyncWrites.size());
+
+   ReadAndCheck(strm, 0, data.size());
+   EXPECT_EQ(2u, file.asyncWrites.size());
+   EXPECT_EQ(data, file.data);
+   EXPECT_EQ(0u, file.asyncReads.size());
+   EXPECT_EQ(0, strm.Drain());
+}
+
+//------------------------------------------------------------------------------
+// All streams together stay within the global memory limit
+//------------------------------------------------------------------------------
+TEST_F(XrdPssStreamTests, GlobalMemoryLimit)
+{
+   std::string data = Pattern(300, 12);
+
+   XrdPssStream::maxMem = 2 * bsz;
+   {XrdPssStream strmA(testFD, true), strmB(testFD, true);
+    ASSERT_EQ(100, strmA.Write(data.data(), 0, 100));
+    ASSERT_EQ(100, strmB.Write(&data[100], 100, 100));
+    EXPECT_EQ(0u, file.syncWrites.size());
+
+// A third stream finds no memory left and writes directly
+//
+    {XrdPssStream strmC(testFD, true);
+     ASSERT_EQ(100, strmC.Write(&data[200], 200, 100));
+     ASSERT_EQ(1u, file.syncWrites.size());
+     EXPECT_EQ(RemoteFile::Span(200, 100), file.syncWrites[0]);
+     EXPECT_EQ(0, strmC.Drain());
+    }
+    EXPECT_EQ(0, strmA.Drain());
+    EXPECT_EQ(0, strmB.Drain());
+   }
+   EXPECT_EQ(data, file.data);
+
+// The memory is returned once the streams are gone
+//
+   XrdPssStream strmD(testFD, true);
+   ASSERT_EQ(100, strmD.Write(data.data(), 0, 100));
+   EXPECT_EQ(1u, file.syncWrites.size());
+   EXPECT_EQ(0, strmD.Drain());
+}
@@ -0,0 +1,332 @@
+//------------------------------------------------------------------------------
+// Unit tests for the partitioned XrdRmc memory cache.
+//
+// The cached file is a fake kept in memory. The tests look at where pages end
+// up in the cache and check that:
+//   - the slots are split into the configured number of partitions, each with
+//     enough pages and with its own LRU list;
+//   - every page is cached in a slot of the partition its address hashes to;
+//   - filling one partition only evicts pages from that partition;
+//   - reads and writes spanning pages of different partitions always return
+//     the file contents, also while the cache keeps evicting pages.
+//------------------------------------------------------------------------------
+
+#include "XrdRmc/XrdRmc.hh"
+#include "XrdRmc/XrdRmcReal.hh"
+#include "XrdOuc/XrdOucCache.hh"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int pgSize  = 4096;
+const int pgCount = 256;
+
+//------------------------------------------------------------------------------
+// A file kept in memory that counts how often it is read
+//------------------------------------------------------------------------------
+class MemIO : public XrdOucCacheIO
+{
+public:
+
+bool        Detach(XrdOucCacheIOCD &iocd) override {return true;}
+
+long long   FSize() override {return data.size();}
+
+const char *Path() override {return "/mem";}
+
+int         Read(char *buff, long long offs, int rlen) override
+                {nReads++;
+                 if (offs >= (long long)data.size()) return 0;
+                 if (offs + rlen > (long long)data.size())
+                    rlen = data.size() - offs;
+                 memcpy(buff, data.data() + offs, rlen);
+                 return rlen;
+                }
+
+int         Sync() override {return 0;}
+
+int         Trunc(long long offs) override {data.resize(offs); return 0;}
+
+int         Write(char *buff, long long offs, int wlen) override
+                {if (offs + wlen > (long long)data.size())
+                    data.resize(offs + wlen);
+                 memcpy(data.data() + offs, buff, wlen);
+                 return wlen;
+                }
+
+            MemIO(size_t size) : data(size), nReads(0)
+                {for (size_t i = 0; i < size; i++)
+                     data[i] = static_cast<char>((i * 7 + i / pgSize) & 0xff);
+                }
+
+std::vector<char> data;
+std::atomic<int>  nReads;
+};
+
+class DetachCB : public XrdOucCacheIOCD
+{
+public:
+void DetachDone() override {}
+};
+
+//------------------------------------------------------------------------------
+// Small deterministic generator so that failures can be reproduced
+//------------------------------------------------------------------------------
+struct Rnd
+{
+unsigned int seed;
+unsigned int Next(unsigned int n)
+             {seed = seed * 1103515245 + 12345; return (seed >> 8) % n;}
+};
+}
+
+//------------------------------------------------------------------------------
+// The fixture is a friend of XrdRmcReal so it can look at the partitions
+//------------------------------------------------------------------------------
+class XrdRmcTests : public ::testing::Test
+{
+protected:
+
+XrdRmcReal *NewCache(int parts, int opts = 0)
+               {XrdRmc::Parms parms;
+                int rc = 0;
+                parms.CacheSize  = static_cast<long long>(pgCount) * pgSize;
+                parms.PageSize   = pgSize;
+                parms.Max2Cache  = 16 * pgSize;
+                parms.MaxFiles   = 16;
+                parms.Options    = opts;
+                parms.Partitions = parts;
+                XrdRmcReal *cP = new XrdRmcReal(rc, parms);
+                EXPECT_EQ(0, rc);
+                return cP;
+               }
+
+int  NParts(XrdRmcReal *cP) {return cP->nParts;}
+
+int  Anchor(XrdRmcReal *cP, int i) {return cP->Parts[i].Anchor;}
+
+int  PartEnd(XrdRmcReal *cP, int i)
+               {return (i == cP->nParts-1 ? cP->SegCnt : Anchor(cP, i+1));}
+
+int  PartOfAddr(XrdRmcReal *cP, long long lAddr)
+               {return &cP->pAddr(lAddr) - cP->Parts;}
+
+int  PartOfSlot(XrdRmcReal *cP, int slot)
+               {return &cP->pSlot(slot) - cP->Parts;}
+
+// Return the slot holding page 'page' of the only attached file, if any
+//
+int  SlotOf(XrdRmcReal *cP, long long page)
+               {for (int s = 0; s < cP->SegCnt; s++)
+                    if (cP->Slots[s].Contents >= 0
+                    &&  (cP->Slots[s].Contents & XrdRmcReal::Strip) == page)
+                       return s;
+                return -1;
+               }
+
+long long Contents(XrdRmcReal *cP, int slot)
+               {return cP->Slots[slot].Contents;}
+
+long long FileBits(XrdRmcReal *cP, int slot)
+               {return Contents(cP, slot) & ~XrdRmcReal::Strip;}
+
+int  LRULen(XrdRmcReal *cP, int i)
+               {int n = 0, a = Anchor(cP, i), s = cP->Slots[a].Status.LRU.Next;
+                while(s != a && n <= cP->SegCnt)
+                     {n++; s = cP->Slots[s].Status.LRU.Next;}
+                return n;
+               }
+
+void Release(XrdRmcReal *cP, XrdOucCacheIO *ioP)
+               {DetachCB cb;
+                if (ioP) {EXPECT_TRUE(ioP->Detach(cb));}
+                for (int i = 0; i < NParts(cP); i++)
+                    EXPECT_EQ(PartEnd(cP, i) - Anchor(cP, i) - 1, LRULen(cP, i))
+                              << "partition " << i;
+                delete cP;
+               }
+};
+
+//------------------------------------------------------------------------------
+// The slots are split in contiguous partitions of at least 64 pages
+//------------------------------------------------------------------------------
+TEST_F(XrdRmcTests, PartitionLayout)
+{
+   XrdRmcReal *cP = NewCache(4);
+   ASSERT_EQ(4, NParts(cP));
+   for (int i = 0; i < 4; i++)
+       {EXPECT_EQ(i * pgCount/4, Anchor(cP, i));
+        EXPECT_EQ(pgCount/4 - 1, LRULen(cP, i));
+        EXPECT_EQ(i, PartOfSlot(cP, Anchor(cP, i)));
+        EXPECT_EQ(i, PartOfSlot(cP, PartEnd(cP, i) - 1));
+       }
+   Release(cP, 0);
+
+// Too many partitions are cut down so that each has enough pages
+//
+   cP = NewCache(64);
+   EXPECT_EQ(pgCount/64, NParts(cP));
+   Release(cP, 0);
+
+// Clients get four partitions unless told otherwise
+//
+   cP = NewCache(0);
+   EXPECT_EQ(4, NParts(cP));
+   Release(cP, 0);
+
+   cP = NewCache(1);
+   EXPECT_EQ(1, NParts(cP));
+   EXPECT_EQ(pgCount - 1, LRULen(cP, 0));
+   Release(cP, 0);
+}
+
+//------------------------------------------------------------------------------
+// Every page lands in the partition its address hashes to
+//------------------------------------------------------------------------------
+TEST_F(XrdRmcTests, PagesMapToTheirPartition)
+{
+   XrdRmcReal *cP = NewCache(4);
+   MemIO file(64 * pgSize);
+   XrdOucCacheIO *ioP = cP->Attach(&file);
+   ASSERT_NE(&file, ioP);
+
+   std::vector<char> buff(pgSize);
+   std::set<int> used;
+   for (int page = 0; page < 32; page++)
+       {ASSERT_EQ(pgSize, ioP->Read(buff.data(), page * pgSize, pgSize));
+        int slot = SlotOf(cP, page);
+        ASSERT_GE(slot, 0) << "page " << page;
+        int part = PartOfAddr(cP, Contents(cP, slot));
+        EXPECT_EQ(part, PartOfSlot(cP, slot)) << "page " << page;
+        EXPECT_GT(slot, Anchor(cP, part));
+        EXPECT_LT(slot, PartEnd(cP, part));
+        used.insert(part);
+       }
+
+// Consecutive pages are spread over all of the partitions
+//
+   EXPECT_EQ(4u, used.size());
+   Release(cP, ioP);
+}
+
+//------------------------------------------------------------------------------
+// Filling one partition only evicts pages of that partition
+//------------------------------------------------------------------------------
+TEST_F(XrdRmcTests, EvictionStaysInPartition)
+{
+   XrdRmcReal *cP = NewCache(4);
+   MemIO file(2048 * pgSize);
+   XrdOucCacheIO *ioP = cP->Attach(&file);
+   ASSERT_NE(&file, ioP);
+   std::vector<char> buff(pgSize);
+
+// Find out which partition each page of the file goes to
+//
+   ASSERT_EQ(pgSize, ioP->Read(buff.data(), 0, pgSize));
+   long long vNum = FileBits(cP, SlotOf(cP, 0));
+   std::vector<int> inPart[4];
+   for (int page = 0; page < 2048; page++)
+       inPart[PartOfAddr(cP, vNum | page)].push_back(page);
+
+// Cache a few pages of partition 1 and then read more pages of partition 0
+// than it can hold
+//
+   int p0 = PartOfAddr(cP, vNum), p1 = (p0 + 1) % 4;
+   for (int i = 0; i < 8; i++)
+       ASSERT_EQ(pgSize, ioP->Read(buff.data(), inPart[p1][i] * pgSize, pgSize));
+   ASSERT_GE(inPart[p0].size(), static_cast<size_t>(2 * pgCount / 4));
+   for (int i = 0; i < 2 * pgCount / 4; i++)
+       ASSERT_EQ(pgSize, ioP->Read(buff.data(), inPart[p0][i] * pgSize, pgSize));
+
+// The pages of partition 1 are still there and the first ones of partition 0
+// were evicted
+//
+   int nReads = file.nReads;
+   for (int i = 0; i < 8; i++)
+       {ASSERT_EQ(pgSize, ioP->Read(buff.data(), inPart[p1][i] * pgSize, pgSize));
+        EXPECT_EQ(0, memcmp(buff.data(), file.data.data() + inPart[p1][i] * pgSize,
+                            pgSize));
+       }
+   EXPECT_EQ(nReads, file.nReads);
+   EXPECT_EQ(-1, SlotOf(cP, inPart[p0][0]));
+
+   Release(cP, ioP);
+}
+
+//------------------------------------------------------------------------------
+// Reads and writes spanning partitions always see the file contents
+//------------------------------------------------------------------------------
+TEST_F(XrdRmcTests, ReadWriteAcrossPartitions)
+{
+   XrdRmcReal *cP = NewCache(4);
+   const int fSize = 4 * pgCount * pgSize;
+   MemIO file(fSize);
+   XrdOucCacheIO *ioP = cP->Attach(&file, XrdOucCache::optRW);
+   ASSERT_NE(&file, ioP);
+
+   std::vector<char> buff(8 * pgSize), wbuff(8 * pgSize);
+   Rnd rnd = {12345};
+
+   for (int i = 0; i < 4000; i++)
+       {int len  = 1 + rnd.Next(6 * pgSize);
+        int offs = rnd.Next(fSize - len);
+        if (rnd.Next(3) == 0)
+           {for (int j = 0; j < len; j++) wbuff[j] = static_cast<char>(rnd.Next(256));
+            ASSERT_EQ(len, ioP->Write(wbuff.data(), offs, len));
+           } else {
+            ASSERT_EQ(len, ioP->Read(buff.data(), offs, len));
+            ASSERT_EQ(0, memcmp(buff.data(), file.data.data() + offs, len))
+                      << "read " << len << '@' << offs << " iteration " << i;
+           }
+       }
+
+// A write spanning cached pages updates them in every partition
+//
+   ASSERT_EQ(4 * pgSize, ioP->Read(buff.data(), pgSize, 4 * pgSize));
+   int nReads = file.nReads;
+   memset(wbuff.data(), 'x', 3 * pgSize);
+   ASSERT_EQ(3 * pgSize, ioP->Write(wbuff.data(), pgSize + pgSize/2, 3 * pgSize));
+   ASSERT_EQ(4 * pgSize, ioP->Read(buff.data(), pgSize, 4 * pgSize));
+   EXPECT_EQ(nReads, file.nReads);
+   EXPECT_EQ(0, memcmp(buff.data(), file.data.data() + pgSize, 4 * pgSize));
+
+   Release(cP, ioP);
+}
+
+//------------------------------------------------------------------------------
+// Concurrent readers of pages in different partitions see the file contents
+//------------------------------------------------------------------------------
+TEST_F(XrdRmcTests, ConcurrentReadsAcrossPartitions)
+{
+   XrdRmcReal *cP = NewCache(4, XrdRmc::ioMTSafe);
+   const int fSize = 4 * pgCount * pgSize;
+   MemIO file(fSize);
+   XrdOucCacheIO *ioP = cP->Attach(&file);
+   ASSERT_NE(&file, ioP);
+   std::atomic<int> bad(0);
+
+   auto reader = [&](unsigned int seed)
+        {std::vector<char> buff(8 * pgSize);
+         Rnd rnd = {seed};
+         for (int i = 0; i < 2000; i++)
+             {int len  = 1 + rnd.Next(6 * pgSize);
+              int offs = rnd.Next(fSize - len);
+              if (ioP->Read(buff.data(), offs, len) != len
+              ||  memcmp(buff.data(), file.data.data() + offs, len)) bad++;
+             }
+        };
+
+   std::vector<std::thread> readers;
+   for (unsigned int i = 0; i < 4; i++) readers.emplace_back(reader, i + 1);
+   for (auto &t : readers) t.join();
+
+   EXPECT_EQ(0, bad.load());
+   Release(cP, ioP);
+}
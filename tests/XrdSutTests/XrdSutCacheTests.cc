@@ -0,0 +1,213 @@
+//------------------------------------------------------------------------------
+// Unit tests for XrdSutCache.
+//
+// The cache spreads its entries over shards, so the tests use enough tags to
+// land in all of them and check that:
+//   - new entries are created write-locked and found again read-locked;
+//   - entries failing the lookup condition come back write-locked so that the
+//     caller can validate them again;
+//   - Trim() removes matching entries from every shard but leaves alone the
+//     ones somebody still holds;
+//   - entries carrying an expiration time are only good until that time.
+//------------------------------------------------------------------------------
+
+#include "XrdSut/XrdSutCache.hh"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Good while enabled and not past the expiration time passed in arg1
+//------------------------------------------------------------------------------
+bool NotExpired(XrdSutCacheEntry *e, void *a)
+{
+   long long now = ((XrdSutCacheArg_t *)a)->arg1;
+
+   if (e && e->status == kCE_ok) {
+      if (e->mtime > now) return true;
+      e->status = kCE_expired;
+   }
+   return false;
+}
+
+//------------------------------------------------------------------------------
+// Disabled or past the expiration time passed in arg1
+//------------------------------------------------------------------------------
+bool Outdated(XrdSutCacheEntry *e, void *a)
+{
+   long long now = ((XrdSutCacheArg_t *)a)->arg1;
+
+   return (e->status != kCE_ok || e->mtime <= now);
+}
+
+std::string Tag(int i) { return "tag" + std::to_string(i); }
+
+//------------------------------------------------------------------------------
+// Add an entry that is valid until 'expire' and release it
+//------------------------------------------------------------------------------
+void Add(XrdSutCache &cache, const std::string &tag, int expire)
+{
+   bool rdlock = true;
+   XrdSutCacheEntry *cent = cache.Get(tag.c_str(), rdlock);
+   ASSERT_NE(nullptr, cent);
+   ASSERT_FALSE(rdlock);
+   cent->status = kCE_ok;
+   cent->mtime = expire;
+   cent->rwmtx.UnLock();
+}
+}
+
+//------------------------------------------------------------------------------
+// A new entry is created write-locked and found again afterwards
+//------------------------------------------------------------------------------
+TEST(XrdSutCacheTests, AddAndLookup)
+{
+   XrdSutCache cache;
+   bool rdlock = true;
+
+   EXPECT_EQ(nullptr, cache.Get("missing"));
+
+   XrdSutCacheEntry *cent = cache.Get("one", rdlock);
+   ASSERT_NE(nullptr, cent);
+   EXPECT_FALSE(rdlock);
+   EXPECT_STREQ("one", cent->name);
+   EXPECT_FALSE(cent->rwmtx.CondReadLock());
+   cent->status = kCE_ok;
+   cent->rwmtx.UnLock();
+
+   XrdSutCacheEntry *found = cache.Get("one");
+   ASSERT_EQ(cent, found);
+   found->rwmtx.UnLock();
+
+   found = cache.Get("one", rdlock);
+   ASSERT_EQ(cent, found);
+   EXPECT_TRUE(rdlock);
+   found->rwmtx.UnLock();
+
+   EXPECT_EQ(1, cache.Num());
+}
+
+//------------------------------------------------------------------------------
+// Every tag is found again however the tags are spread over the shards
+//------------------------------------------------------------------------------
+TEST(XrdSutCacheTests, LookupAcrossShards)
+{
+   XrdSutCache cache(8, 13);
+   const int n = 500;
+
+   for (int i = 0; i < n; i++) Add(cache, Tag(i), i);
+   EXPECT_EQ(n, cache.Num());
+
+   for (int i = 0; i < n; i++) {
+      XrdSutCacheEntry *cent = cache.Get(Tag(i).c_str());
+      ASSERT_NE(nullptr, cent) << Tag(i);
+      EXPECT_EQ(Tag(i), cent->name);
+      EXPECT_EQ(i, cent->mtime);
+      cent->rwmtx.UnLock();
+   }
+
+// Adding an existing tag again does not create a second entry
+//
+   bool rdlock = false;
+   XrdSutCacheEntry *cent = cache.Get(Tag(7).c_str(), rdlock);
+   ASSERT_NE(nullptr, cent);
+   EXPECT_TRUE(rdlock);
+   cent->rwmtx.UnLock();
+   EXPECT_EQ(n, cache.Num());
+
+   cache.Reset();
+   EXPECT_EQ(0, cache.Num());
+   EXPECT_EQ(nullptr, cache.Get(Tag(7).c_str()));
+}
+
+//------------------------------------------------------------------------------
+// Trim removes the matching entries from all shards and nothing else
+//------------------------------------------------------------------------------
+TEST(XrdSutCacheTests, TrimRemovesMatchingEntries)
+{
+   XrdSutCache cache;
+   const int n = 200;
+
+   for (int i = 0; i < n; i++) Add(cache, Tag(i), (i % 2) ? 2000 : 1000);
+
+   XrdSutCacheArg_t arg = {1500, 0, 0, 0};
+   EXPECT_EQ(n/2, cache.Trim(Outdated, &arg));
+   EXPECT_EQ(n/2, cache.Num());
+
+   for (int i = 0; i < n; i++) {
+      XrdSutCacheEntry *cent = cache.Get(Tag(i).c_str());
+      if (i % 2) {
+         ASSERT_NE(nullptr, cent) << Tag(i);
+         cent->rwmtx.UnLock();
+      } else {
+         EXPECT_EQ(nullptr, cent) << Tag(i);
+      }
+   }
+
+   EXPECT_EQ(0, cache.Trim(Outdated, &arg));
+}
+
+//------------------------------------------------------------------------------
+// Trim leaves alone entries that are still referenced
+//------------------------------------------------------------------------------
+TEST(XrdSutCacheTests, TrimSkipsReferencedEntries)
+{
+   XrdSutCache cache;
+
+   Add(cache, "held", 1000);
+   Add(cache, "free", 1000);
+
+   XrdSutCacheEntry *held = cache.Get("held");
+   ASSERT_NE(nullptr, held);
+
+   XrdSutCacheArg_t arg = {1500, 0, 0, 0};
+   EXPECT_EQ(1, cache.Trim(Outdated, &arg));
+   EXPECT_EQ(1, cache.Num());
+   held->rwmtx.UnLock();
+
+   EXPECT_EQ(1, cache.Trim(Outdated, &arg));
+   EXPECT_EQ(0, cache.Num());
+}
+
+//------------------------------------------------------------------------------
+// An entry is good until its expiration time and must be validated again after
+//------------------------------------------------------------------------------
+TEST(XrdSutCacheTests, EntriesExpire)
+{
+   XrdSutCache cache;
+   bool rdlock;
+
+   Add(cache, "chain", 1300);
+
+   XrdSutCacheArg_t arg = {1000, 0, 0, 0};
+   XrdSutCacheEntry *cent = cache.Get("chain", rdlock, NotExpired, &arg);
+   ASSERT_NE(nullptr, cent);
+   EXPECT_TRUE(rdlock);
+   cent->rwmtx.UnLock();
+
+// Past the expiration the entry is handed out write-locked for validation
+//
+   arg.arg1 = 1300;
+   cent = cache.Get("chain", rdlock, NotExpired, &arg);
+   ASSERT_NE(nullptr, cent);
+   EXPECT_FALSE(rdlock);
+   EXPECT_EQ(kCE_expired, cent->status);
+   cent->status = kCE_ok;
+   cent->mtime = 1600;
+   cent->rwmtx.UnLock();
+
+   cent = cache.Get("chain", rdlock, NotExpired, &arg);
+   ASSERT_NE(nullptr, cent);
+   EXPECT_TRUE(rdlock);
+   cent->rwmtx.UnLock();
+
+// Once expired it is also eligible for trimming
+//
+   arg.arg1 = 1600;
+   EXPECT_EQ(1, cache.Trim(Outdated, &arg));
+   EXPECT_EQ(nullptr, cache.Get("chain"));
+}
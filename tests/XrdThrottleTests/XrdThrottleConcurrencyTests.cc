@@ -0,0 +1,55 @@
+#include "XrdThrottle/XrdThrottleConcurrency.hh"
+
+#include <gtest/gtest.h>
+
+using XrdThrottle::ConcurrencyController;
+
+// With constant latency and the server busy up to the limit, the limit grows.
+TEST(XrdThrottleConcurrencyTests, GrowsWhileLatencyStable) {
+    ConcurrencyController ctrl(1, 1000, 10);
+    int limit = ctrl.GetLimit();
+    for (int idx = 0; idx < 20; idx++) {
+        int new_limit = ctrl.Update(1000, 10.0, limit);
+        EXPECT_GE(new_limit, limit);
+        limit = new_limit;
+    }
+    EXPECT_GT(limit, 10);
+    EXPECT_DOUBLE_EQ(0.01, ctrl.GetLatency());
+}
+
+// When the latency increases well beyond the long-term average, the limit
+// is reduced, but never below the minimum.
+TEST(XrdThrottleConcurrencyTests, ShrinksWhenLatencyInflates) {
+    ConcurrencyController ctrl(5, 1000, 100);
+    for (int idx = 0; idx < 10; idx++) {
+        ctrl.Update(1000, 10.0, ctrl.GetLimit());
+    }
+    int limit = ctrl.GetLimit();
+    for (int idx = 0; idx < 5; idx++) {
+        int new_limit = ctrl.Update(1000, 50.0, ctrl.GetLimit());
+        EXPECT_LT(new_limit, limit);
+        limit = new_limit;
+    }
+    double io_time = 50.0;
+    for (int idx = 0; idx < 100; idx++) {
+        io_time *= 1.2;
+        ctrl.Update(1000, io_time, ctrl.GetLimit());
+    }
+    EXPECT_EQ(5, ctrl.GetLimit());
+}
+
+// The limit does not change when there is too little or too light activity,
+// and stays within the configured bounds.
+TEST(XrdThrottleConcurrencyTests, IdleAndBounds) {
+    ConcurrencyController ctrl(2, 20, 50);
+    EXPECT_EQ(20, ctrl.GetLimit());
+
+    EXPECT_EQ(20, ctrl.Update(ConcurrencyController::m_min_samples - 1, 1.0, 20));
+    EXPECT_EQ(20, ctrl.Update(1000, 0.0, 20));
+    EXPECT_EQ(20, ctrl.Update(1000, 1.0, 5));
+
+    for (int idx = 0; idx < 100; idx++) {
+        ctrl.Update(1000, 1.0, ctrl.GetLimit());
+    }
+    EXPECT_EQ(20, ctrl.GetLimit());
+}
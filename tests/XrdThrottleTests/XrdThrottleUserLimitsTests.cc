@@ -2,6 +2,7 @@
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysLogger.hh"
 #include "XrdOuc/XrdOucTrace.hh"
+#include "XrdSec/XrdSecEntity.hh"
 
 #include <gtest/gtest.h>
 #include <fstream>
@@ -50,6 +51,26 @@ protected:
         }
     }
 
+    // Map a client with the given name to its slot, as done at open time
+    void MapUser(const char *name) {
+        XrdSecEntity client;
+        client.name = const_cast<char *>(name);
+        m_manager->GetUserInfo(&client);
+        client.name = nullptr;
+    }
+
+    // Return the weight and group currently held by the user's slot
+    float SlotWeight(const char *name, int &group) {
+        uint16_t uid = m_manager->GetUid(name);
+        group = m_manager->m_user_group[uid];
+        return m_manager->m_user_weight[uid];
+    }
+
+    float SlotWeight(const char *name) {
+        int group;
+        return SlotWeight(name, group);
+    }
+
     XrdSysLogger* m_logger;
     XrdSysError* m_log;
     XrdOucTrace* m_trace;
@@ -233,3 +254,101 @@ maxconn = 50
     RemoveTempFile(config_file);
 }
 
+
+TEST_F(XrdThrottleUserLimitsTests, GetUserWeight) {
+    std::string config_content = R"(
+[default]
+name = *
+maxconn = 200
+
+[cms]
+name = cms:*
+weight = 4
+
+[production]
+name = cms:production
+weight = 10
+maxconn = 100
+
+[analysis]
+name = atlas:*
+maxconn = 20
+
+[badweight]
+name = badweight
+weight = -1
+)";
+
+    std::string config_file = CreateTempConfig(config_content);
+    ASSERT_FALSE(config_file.empty());
+
+    int result = m_manager->LoadUserLimits(config_file);
+    EXPECT_EQ(0, result);
+
+    int group, cms_group;
+    // Exact match uses its own weight and is not part of a group
+    EXPECT_FLOAT_EQ(10.0, m_manager->GetUserWeight("cms:production", group));
+    EXPECT_EQ(-1, group);
+
+    // Wildcard match shares the weight of the group
+    EXPECT_FLOAT_EQ(4.0, m_manager->GetUserWeight("cms:user1", cms_group));
+    EXPECT_GE(cms_group, 0);
+    EXPECT_FLOAT_EQ(4.0, m_manager->GetUserWeight("cms:user2", group));
+    EXPECT_EQ(cms_group, group);
+
+    // Sections without a weight do not affect the weight lookup
+    EXPECT_FLOAT_EQ(1.0, m_manager->GetUserWeight("atlas:user1", group));
+    EXPECT_EQ(-1, group);
+    EXPECT_FLOAT_EQ(1.0, m_manager->GetUserWeight("otheruser", group));
+    EXPECT_FLOAT_EQ(1.0, m_manager->GetUserWeight("badweight", group));
+
+    // Sections with only a weight do not affect the connection limits
+    EXPECT_EQ(200UL, m_manager->GetUserMaxConn("cms:user1"));
+    EXPECT_EQ(100UL, m_manager->GetUserMaxConn("cms:production"));
+    EXPECT_EQ(20UL, m_manager->GetUserMaxConn("atlas:user1"));
+
+    RemoveTempFile(config_file);
+}
+
+TEST_F(XrdThrottleUserLimitsTests, ReloadUpdatesSlotWeights) {
+    std::string config_file = CreateTempConfig(R"(
+[cms]
+name = cms:*
+weight = 4
+
+[alice]
+name = alice
+weight = 2
+)");
+    ASSERT_FALSE(config_file.empty());
+    ASSERT_EQ(0, m_manager->LoadUserLimits(config_file));
+
+    for (auto name : {"cms:user1", "alice", "bob"}) MapUser(name);
+    int group;
+    EXPECT_FLOAT_EQ(4.0, SlotWeight("cms:user1", group));
+    EXPECT_GE(group, 0);
+    EXPECT_FLOAT_EQ(2.0, SlotWeight("alice"));
+    EXPECT_FLOAT_EQ(1.0, SlotWeight("bob"));
+
+    // Users already mapped to a slot get the new weights on reload without
+    // opening another file.
+    std::ofstream file(config_file);
+    file << R"(
+[alice]
+name = alice
+weight = 8
+
+[bob]
+name = bob
+weight = 3
+)";
+    file.close();
+    ASSERT_EQ(0, m_manager->LoadUserLimits(config_file));
+
+    EXPECT_FLOAT_EQ(1.0, SlotWeight("cms:user1", group));
+    EXPECT_EQ(-1, group);
+    EXPECT_FLOAT_EQ(8.0, SlotWeight("alice"));
+    EXPECT_FLOAT_EQ(3.0, SlotWeight("bob"));
+
+    RemoveTempFile(config_file);
+}
@@ -0,0 +1,220 @@
+#ifndef __XRD_TLS_FIXTURE_HH__
+#define __XRD_TLS_FIXTURE_HH__
+//------------------------------------------------------------------------------
+// Common setup for the XrdTls unit tests.
+//
+// A self-signed certificate and key are generated once per test suite so that
+// the tests do not depend on any grid setup. Connections are made either over
+// a local socket pair or over a loopback TCP connection, the latter being the
+// only kind of socket the kernel can take over TLS for.
+//------------------------------------------------------------------------------
+
+#include "XrdTls/XrdTlsContext.hh"
+#include "XrdTls/XrdTlsSocket.hh"
+
+#include <gtest/gtest.h>
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509v3.h>
+
+#include <arpa/inet.h>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+class XrdTlsFixture : public ::testing::Test
+{
+protected:
+
+// A connected pair of TLS sockets and the descriptors they use
+//
+struct Conn
+      {std::unique_ptr<XrdTlsSocket> srv;
+       std::unique_ptr<XrdTlsSocket> cli;
+       int                           fd[2] = {-1, -1};
+
+      ~Conn() {srv.reset(); cli.reset();
+               if (fd[0] >= 0) close(fd[0]);
+               if (fd[1] >= 0) close(fd[1]);
+              }
+      };
+
+static void SetUpTestSuite()
+     {char tmpl[] = "/tmp/xrdtls-tests-XXXXXX";
+      ASSERT_NE(nullptr, mkdtemp(tmpl));
+      dir    = tmpl;
+      certFN = dir + "/cert.pem";
+      keyFN  = dir + "/key.pem";
+      ASSERT_TRUE(MakeCert());
+     }
+
+static void TearDownTestSuite()
+     {unlink(certFN.c_str());
+      unlink(keyFN.c_str());
+      rmdir(dir.c_str());
+     }
+
+// Contexts for either side of a connection
+//
+std::unique_ptr<XrdTlsContext> Server(uint64_t opts = 0)
+     {std::string eMsg;
+      std::unique_ptr<XrdTlsContext> ctx(new XrdTlsContext(certFN.c_str(),
+                      keyFN.c_str(), 0, 0, opts | XrdTlsContext::servr, &eMsg));
+      EXPECT_TRUE(ctx->isOK()) << eMsg;
+      return ctx;
+     }
+
+std::unique_ptr<XrdTlsContext> Client(uint64_t opts = 0)
+     {std::string eMsg;
+      std::unique_ptr<XrdTlsContext> ctx(new XrdTlsContext(0, 0, 0,
+                      certFN.c_str(), opts, &eMsg));
+      EXPECT_TRUE(ctx->isOK()) << eMsg;
+      return ctx;
+     }
+
+// Connect a client and a server over a socket pair or a loopback TCP
+// connection and complete the handshake. A client session key is set when
+// one is given so that sessions are saved and resumed.
+//
+bool Connect(Conn &conn, XrdTlsContext &srvCtx, XrdTlsContext &cliCtx,
+             bool useTCP, const char *sessKey = 0)
+     {std::string sMsg, cMsg;
+      XrdTls::RC src = XrdTls::TLS_AOK, crc;
+
+      if (!(useTCP ? TcpPair(conn.fd) : !socketpair(AF_UNIX, SOCK_STREAM,
+                                                    0, conn.fd)))
+         return false;
+
+      conn.srv.reset(new XrdTlsSocket);
+      conn.cli.reset(new XrdTlsSocket);
+      if (conn.srv->Init(srvCtx, conn.fd[0], XrdTlsSocket::TLS_RBL_WBL,
+                         XrdTlsSocket::TLS_HS_BLOCK, false)
+      ||  conn.cli->Init(cliCtx, conn.fd[1], XrdTlsSocket::TLS_RBL_WBL,
+                         XrdTlsSocket::TLS_HS_BLOCK, true)) return false;
+      if (sessKey && !conn.cli->SetSessionKey(sessKey)) return false;
+
+      std::thread acceptor([&]() {src = conn.srv->Accept(&sMsg);});
+      crc = conn.cli->Connect(0, &cMsg);
+      acceptor.join();
+
+      EXPECT_EQ(XrdTls::TLS_AOK, src) << sMsg;
+      EXPECT_EQ(XrdTls::TLS_AOK, crc) << cMsg;
+      return src == XrdTls::TLS_AOK && crc == XrdTls::TLS_AOK;
+     }
+
+// Send size bytes from one socket and read them on the other
+//
+static bool Transfer(XrdTlsSocket &from, XrdTlsSocket &to, size_t size)
+     {std::string data(size, 0), back(size, 0);
+      bool ok = true;
+      int n;
+
+      for (size_t i = 0; i < size; i++) data[i] = static_cast<char>(i * 7);
+
+      std::thread writer([&]()
+           {for (size_t off = 0; off < size && ok; off += n)
+                if (from.Write(&data[off], size - off, n) != XrdTls::TLS_AOK)
+                   ok = false;
+           });
+      for (size_t off = 0; off < size && ok; off += n)
+          if (to.Read(&back[off], size - off, n) != XrdTls::TLS_AOK || !n)
+             ok = false;
+      writer.join();
+      return ok && data == back;
+     }
+
+static std::string dir;
+static std::string certFN;
+static std::string keyFN;
+
+private:
+
+// Create a listening loopback socket, connect to it and accept the connection
+//
+static bool TcpPair(int fd[2])
+     {struct sockaddr_in addr = {};
+      socklen_t alen = sizeof(addr);
+      int lfd;
+      bool ok;
+
+      addr.sin_family      = AF_INET;
+      addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      if ((lfd = socket(AF_INET, SOCK_STREAM, 0)) < 0) return false;
+      ok = !bind(lfd, (struct sockaddr *)&addr, sizeof(addr))
+        && !listen(lfd, 1)
+        && !getsockname(lfd, (struct sockaddr *)&addr, &alen)
+        && (fd[1] = socket(AF_INET, SOCK_STREAM, 0)) >= 0
+        && !connect(fd[1], (struct sockaddr *)&addr, sizeof(addr))
+        && (fd[0] = accept(lfd, 0, 0)) >= 0;
+      close(lfd);
+      return ok;
+     }
+
+// Generate a self-signed certificate for localhost. It is also used as the
+// CA certificate by clients.
+//
+static bool MakeCert()
+     {EVP_PKEY *pkey = 0;
+      EVP_PKEY_CTX *kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, 0);
+      X509 *x509 = X509_new();
+      X509V3_CTX v3ctx;
+      X509_EXTENSION *ext;
+      FILE *fp;
+      bool ok;
+
+      ok = kctx && x509 && EVP_PKEY_keygen_init(kctx) > 0
+        && EVP_PKEY_CTX_set_ec_paramgen_curve_nid(kctx, NID_X9_62_prime256v1) > 0
+        && EVP_PKEY_keygen(kctx, &pkey) > 0;
+
+      if (ok)
+         {X509_NAME *name = X509_get_subject_name(x509);
+          X509_set_version(x509, 2);
+          ASN1_INTEGER_set(X509_get_serialNumber(x509), 1);
+          X509_gmtime_adj(X509_getm_notBefore(x509), -3600);
+          X509_gmtime_adj(X509_getm_notAfter(x509), 86400);
+          X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                                     (const unsigned char *)"localhost",
+                                     -1, -1, 0);
+          X509_set_issuer_name(x509, name);
+          X509_set_pubkey(x509, pkey);
+          X509V3_set_ctx(&v3ctx, x509, x509, 0, 0, 0);
+          for (const char *val : {"critical,CA:TRUE", "DNS:localhost"})
+              {int nid = (*val == 'D' ? NID_subject_alt_name
+                                      : NID_basic_constraints);
+               if (!(ext = X509V3_EXT_conf_nid(0, &v3ctx, nid, val))) ok = false;
+                  else {X509_add_ext(x509, ext, -1);
+                        X509_EXTENSION_free(ext);
+                       }
+              }
+          ok = ok && X509_sign(x509, pkey, EVP_sha256()) > 0;
+         }
+
+      if (ok && (ok = (fp = fopen(keyFN.c_str(), "w")) != 0))
+         {fchmod(fileno(fp), 0600);
+          ok = PEM_write_PrivateKey(fp, pkey, 0, 0, 0, 0, 0) > 0;
+          fclose(fp);
+         }
+      if (ok && (ok = (fp = fopen(certFN.c_str(), "w")) != 0))
+         {ok = PEM_write_X509(fp, x509) > 0;
+          fclose(fp);
+         }
+
+      X509_free(x509);
+      EVP_PKEY_free(pkey);
+      EVP_PKEY_CTX_free(kctx);
+      return ok;
+     }
+};
+
+inline std::string XrdTlsFixture::dir;
+inline std::string XrdTlsFixture::certFN;
+inline std::string XrdTlsFixture::keyFN;
+
+#endif
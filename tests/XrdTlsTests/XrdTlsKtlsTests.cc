@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+// Unit tests for kernel TLS support.
+//
+// The tests check that:
+//   - the xrd.tls directive turns kernel TLS on and off and rejects unknown
+//     options;
+//   - a context asks OpenSSL for kernel TLS only when told to;
+//   - when the kernel cannot take over the connection (socket pairs, ciphers
+//     the kernel does not implement, kTLS not asked for) CanSendFile() is
+//     false and data still flows through the regular TLS path;
+//   - when the kernel does take over, SendFile() delivers the file contents.
+//     This is skipped when the kernel has no TLS support.
+//------------------------------------------------------------------------------
+
+#include "XrdTlsFixture.hh"
+
+#include "Xrd/XrdConfig.hh"
+#include "XrdOuc/XrdOucStream.hh"
+
+#include <openssl/ssl.h>
+
+#include <cstring>
+#include <fcntl.h>
+
+//------------------------------------------------------------------------------
+// Parsing of the xrd.tls directive
+//------------------------------------------------------------------------------
+class XrdConfigTests : public ::testing::Test
+{
+protected:
+
+// Process a single xrd directive as it would appear in the config file
+//
+int Parse(const char *line)
+   {XrdOucStream Config;
+    std::string text = std::string(line) + '\n';
+    int fd[2];
+    char *var;
+    bool ok;
+
+    if (pipe(fd)) return -1;
+    ok = write(fd[1], text.data(), text.size()) == (ssize_t)text.size();
+    close(fd[1]);
+    if (!ok || Config.Attach(fd[0])) {close(fd[0]); return -1;}
+    if (!Config.GetLine() || !(var = Config.GetWord())) return -1;
+    return config.ConfigXeq(var, Config);
+   }
+
+bool KtlsOn() {return (config.tlsOpts & XrdTlsContext::ktlsOn) != 0;}
+
+int  HsTo() {return static_cast<int>(config.tlsOpts & XrdTlsContext::hsto);}
+
+XrdConfig config;
+};
+
+TEST_F(XrdConfigTests, KtlsIsOffByDefault)
+{
+   EXPECT_FALSE(KtlsOn());
+   ASSERT_EQ(0, Parse("tls /tmp/cert.pem /tmp/key.pem"));
+   EXPECT_FALSE(KtlsOn());
+}
+
+TEST_F(XrdConfigTests, KtlsOption)
+{
+   ASSERT_EQ(0, Parse("tls /tmp/cert.pem ktls"));
+   EXPECT_TRUE(KtlsOn());
+
+   ASSERT_EQ(0, Parse("tls /tmp/cert.pem /tmp/key.pem ktls noktls"));
+   EXPECT_FALSE(KtlsOn());
+
+   ASSERT_EQ(0, Parse("tls /tmp/cert.pem nodetail ktls hsto 5"));
+   EXPECT_TRUE(KtlsOn());
+   EXPECT_EQ(5, HsTo());
+}
+
+TEST_F(XrdConfigTests, KtlsRejectsUnknownOptions)
+{
+   EXPECT_NE(0, Parse("tls /tmp/cert.pem kTLSx"));
+   EXPECT_NE(0, Parse("tls /tmp/cert.pem hsto"));
+   EXPECT_FALSE(KtlsOn());
+}
+
+//------------------------------------------------------------------------------
+// Kernel TLS on actual connections
+//------------------------------------------------------------------------------
+class XrdTlsKtlsTests : public XrdTlsFixture {};
+
+namespace
+{
+bool KtlsCompiled()
+{
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+   return true;
+#else
+   return false;
+#endif
+}
+
+// Restrict a context to TLS 1.2 with a cipher the kernel does not implement
+//
+void UseCBC(XrdTlsContext &ctx)
+{
+   SSL_CTX *sslCtx = static_cast<SSL_CTX *>(ctx.Context());
+   SSL_CTX_set_max_proto_version(sslCtx, TLS1_2_VERSION);
+   ASSERT_TRUE(ctx.SetContextCiphers("ECDHE-ECDSA-AES128-SHA"));
+}
+}
+
+TEST_F(XrdTlsKtlsTests, ContextEnablesKtlsOnlyWhenAsked)
+{
+   if (!KtlsCompiled()) GTEST_SKIP() << "OpenSSL built without kTLS";
+#ifdef SSL_OP_ENABLE_KTLS
+   auto with    = Server(XrdTlsContext::ktlsOn);
+   auto without = Server();
+
+   EXPECT_TRUE(SSL_CTX_get_options(static_cast<SSL_CTX *>(with->Context()))
+               & SSL_OP_ENABLE_KTLS);
+   EXPECT_FALSE(SSL_CTX_get_options(static_cast<SSL_CTX *>(without->Context()))
+                & SSL_OP_ENABLE_KTLS);
+   EXPECT_TRUE(with->GetParams()->opts & XrdTlsContext::ktlsOn);
+#endif
+}
+
+TEST_F(XrdTlsKtlsTests, FallbackOnSocketPair)
+{
+   auto srvCtx = Server(XrdTlsContext::ktlsOn);
+   auto cliCtx = Client(XrdTlsContext::ktlsOn);
+   Conn conn;
+
+   ASSERT_TRUE(Connect(conn, *srvCtx, *cliCtx, false));
+   EXPECT_FALSE(conn.srv->CanSendFile());
+   EXPECT_FALSE(conn.cli->CanSendFile());
+   EXPECT_TRUE(Transfer(*conn.srv, *conn.cli, 1024*1024));
+   EXPECT_TRUE(Transfer(*conn.cli, *conn.srv, 1000));
+}
+
+TEST_F(XrdTlsKtlsTests, FallbackWithUnsupportedCipher)
+{
+   auto srvCtx = Server(XrdTlsContext::ktlsOn);
+   auto cliCtx = Client(XrdTlsContext::ktlsOn);
+   Conn conn;
+
+   UseCBC(*srvCtx);
+   UseCBC(*cliCtx);
+   ASSERT_TRUE(Connect(conn, *srvCtx, *cliCtx, true));
+   EXPECT_STREQ("TLSv1.2", conn.srv->Version());
+   EXPECT_FALSE(conn.srv->CanSendFile());
+   EXPECT_TRUE(Transfer(*conn.srv, *conn.cli, 1024*1024));
+}
+
+TEST_F(XrdTlsKtlsTests, NoKtlsUnlessAsked)
+{
+   auto srvCtx = Server();
+   auto cliCtx = Client();
+   Conn conn;
+
+   ASSERT_TRUE(Connect(conn, *srvCtx, *cliCtx, true));
+   EXPECT_FALSE(conn.srv->CanSendFile());
+   EXPECT_TRUE(Transfer(*conn.srv, *conn.cli, 1024*1024));
+}
+
+TEST_F(XrdTlsKtlsTests, SendFileWithKernelTLS)
+{
+   auto srvCtx = Server(XrdTlsContext::ktlsOn);
+   auto cliCtx = Client(XrdTlsContext::ktlsOn);
+   Conn conn;
+
+   ASSERT_TRUE(Connect(conn, *srvCtx, *cliCtx, true));
+   if (!conn.srv->CanSendFile())
+      GTEST_SKIP() << "kernel TLS is not available on this host";
+
+// Send the middle of a file and read it back through the client
+//
+   const size_t fsize = 3*1024*1024 + 17, off = 4097, len = fsize - 2*off;
+   std::string data(fsize, 0), back(len, 0);
+   for (size_t i = 0; i < fsize; i++) data[i] = static_cast<char>(i * 13);
+
+   std::string fn = dir + "/data";
+   int fd = open(fn.c_str(), O_RDWR|O_CREAT|O_TRUNC, 0600);
+   ASSERT_GE(fd, 0);
+   unlink(fn.c_str());
+   ASSERT_EQ((ssize_t)fsize, write(fd, data.data(), fsize));
+
+   bool ok = true;
+   std::thread sender([&]()
+        {off_t pos = off;
+         int n;
+         while(ok && pos < (off_t)(off + len))
+              {if (conn.srv->SendFile(fd, pos, off + len - pos, n)
+                   != XrdTls::TLS_AOK || !n)
+                  {ok = false;
+                   shutdown(conn.fd[0], SHUT_RDWR);
+                  }
+               pos += n;
+              }
+        });
+
+   int n;
+   for (size_t got = 0; got < len; got += n)
+       if (conn.cli->Read(&back[got], len - got, n) != XrdTls::TLS_AOK || !n)
+          {ok = false; break;}
+   sender.join();
+   close(fd);
+
+   EXPECT_TRUE(ok);
+   EXPECT_TRUE(data.compare(off, len, back) == 0);
+}
@@ -0,0 +1,229 @@
+//------------------------------------------------------------------------------
+// Unit tests for TLS session resumption.
+//
+// The tests check that:
+//   - a client context with a session cache saves the session negotiated for
+//     a key, offers it again for the same key only, and resumes it;
+//   - sessions are not saved without a client cache and expired sessions are
+//     dropped from the cache;
+//   - servers sharing a ticket key file resume each other's sessions while a
+//     server with its own generated keys does not, and that cloned contexts
+//     keep accepting the tickets of the original;
+//   - unusable ticket key files are rejected.
+//------------------------------------------------------------------------------
+
+#include "XrdTlsFixture.hh"
+
+#include <openssl/rand.h>
+#include <openssl/ssl.h>
+
+#include <ctime>
+#include <fcntl.h>
+
+class XrdTlsSessionTests : public XrdTlsFixture
+{
+protected:
+
+void TearDown() override {unlink(KeyFN().c_str());}
+
+// Connect with the given session key and read some data so that tickets sent
+// after a TLS 1.3 handshake are processed. Returns whether the session was
+// resumed.
+//
+bool Resumed(XrdTlsContext &srvCtx, XrdTlsContext &cliCtx, const char *key)
+     {Conn conn;
+      if (!Connect(conn, srvCtx, cliCtx, false, key)
+      ||  !Transfer(*conn.srv, *conn.cli, 100))
+         {ADD_FAILURE() << "connection failed";
+          return false;
+         }
+      EXPECT_EQ(conn.cli->isResumed(), conn.srv->isResumed());
+      return conn.cli->isResumed();
+     }
+
+// Write a ticket key file holding size random bytes
+//
+static std::string KeyFile(size_t size, mode_t mode = 0600)
+     {std::string fn = KeyFN(), keys(size, 0);
+      int fd;
+
+      unlink(fn.c_str());
+      RAND_bytes((unsigned char *)keys.data(), size);
+      if ((fd = open(fn.c_str(), O_WRONLY|O_CREAT|O_TRUNC, mode)) < 0
+      ||  fchmod(fd, mode)
+      ||  write(fd, keys.data(), size) != (ssize_t)size)
+         ADD_FAILURE() << "unable to create " << fn;
+      if (fd >= 0) close(fd);
+      return fn;
+     }
+
+static std::string KeyFN() {return dir + "/tickets.key";}
+
+static bool Cached(XrdTlsContext &ctx, const char *key)
+     {SSL_SESSION *sess = static_cast<SSL_SESSION *>(ctx.GetSession(key));
+      if (sess) SSL_SESSION_free(sess);
+      return sess != 0;
+     }
+};
+
+//------------------------------------------------------------------------------
+// A saved session is only offered for its own key
+//------------------------------------------------------------------------------
+TEST_F(XrdTlsSessionTests, ClientCacheResumesByKey)
+{
+   auto srvCtx = Server();
+   auto cliCtx = Client();
+
+   cliCtx->SessionCache(XrdTlsContext::scClnt);
+   EXPECT_FALSE(Cached(*cliCtx, "server1:1094"));
+
+   EXPECT_FALSE(Resumed(*srvCtx, *cliCtx, "server1:1094"));
+   EXPECT_TRUE(Cached(*cliCtx, "server1:1094"));
+   EXPECT_FALSE(Cached(*cliCtx, "server2:1094"));
+
+   EXPECT_TRUE(Resumed(*srvCtx, *cliCtx, "server1:1094"));
+   EXPECT_TRUE(Resumed(*srvCtx, *cliCtx, "server1:1094"));
+   EXPECT_FALSE(Resumed(*srvCtx, *cliCtx, "server2:1094"));
+   EXPECT_TRUE(Cached(*cliCtx, "server2:1094"));
+}
+
+//------------------------------------------------------------------------------
+// Without a client cache nothing is saved or resumed
+//------------------------------------------------------------------------------
+TEST_F(XrdTlsSessionTests, NoClientCache)
+{
+   auto srvCtx = Server();
+   auto cliCtx = Client();
+
+   EXPECT_FALSE(Resumed(*srvCtx, *cliCtx, "server1:1094"));
+   EXPECT_FALSE(Cached(*cliCtx, "server1:1094"));
+   EXPECT_FALSE(Resumed(*srvCtx, *cliCtx, "server1:1094"));
+
+// Turning the cache off again discards nothing but stops lookups
+//
+   cliCtx->SessionCache(XrdTlsContext::scClnt);
+   EXPECT_FALSE(Resumed(*srvCtx, *cliCtx, "server1:1094"));
+   cliCtx->SessionCache(XrdTlsContext::scOff);
+   EXPECT_FALSE(Cached(*cliCtx, "server1:1094"));
+   EXPECT_FALSE(Resumed(*srvCtx, *cliCtx, "server1:1094"));
+}
+
+//------------------------------------------------------------------------------
+// Saved sessions are replaced by newer ones and dropped once expired
+//------------------------------------------------------------------------------
+TEST_F(XrdTlsSessionTests, CacheInsertLookupAndTimeout)
+{
+   auto cliCtx = Client();
+   cliCtx->SessionCache(XrdTlsContext::scClnt);
+
+   SSL_SESSION *old = SSL_SESSION_new(), *cur = SSL_SESSION_new();
+   time_t now = time(0);
+   SSL_SESSION_set_time(old, now);
+   SSL_SESSION_set_timeout(old, 300);
+   SSL_SESSION_set_time(cur, now);
+   SSL_SESSION_set_timeout(cur, 300);
+
+   cliCtx->PutSession("host:1", old);
+   SSL_SESSION *found = static_cast<SSL_SESSION *>(cliCtx->GetSession("host:1"));
+   EXPECT_EQ(old, found);
+   SSL_SESSION_free(found);
+
+   cliCtx->PutSession("host:1", cur);
+   found = static_cast<SSL_SESSION *>(cliCtx->GetSession("host:1"));
+   EXPECT_EQ(cur, found);
+   SSL_SESSION_free(found);
+
+// The cache holds its own references
+//
+   SSL_SESSION_free(old);
+   SSL_SESSION_free(cur);
+   EXPECT_TRUE(Cached(*cliCtx, "host:1"));
+
+// An expired session is not handed out
+//
+   SSL_SESSION *stale = SSL_SESSION_new();
+   SSL_SESSION_set_time(stale, now - 100);
+   SSL_SESSION_set_timeout(stale, 10);
+   cliCtx->PutSession("host:2", stale);
+   SSL_SESSION_free(stale);
+   EXPECT_FALSE(Cached(*cliCtx, "host:2"));
+   EXPECT_TRUE(Cached(*cliCtx, "host:1"));
+}
+
+//------------------------------------------------------------------------------
+// A server with its session cache off issues no tickets
+//------------------------------------------------------------------------------
+TEST_F(XrdTlsSessionTests, ServerCacheOff)
+{
+   auto srvCtx = Server();
+   auto cliCtx = Client();
+
+   srvCtx->SessionCache(XrdTlsContext::scOff);
+   cliCtx->SessionCache(XrdTlsContext::scClnt);
+
+   EXPECT_FALSE(Resumed(*srvCtx, *cliCtx, "server1:1094"));
+   EXPECT_FALSE(Resumed(*srvCtx, *cliCtx, "server1:1094"));
+}
+
+//------------------------------------------------------------------------------
+// Servers sharing a key file accept each other's tickets. As TLS 1.3 tickets
+// are used only once, this also checks that every resumption hands out a new
+// ticket.
+//------------------------------------------------------------------------------
+TEST_F(XrdTlsSessionTests, SharedTicketKeys)
+{
+   auto srvA = Server(), srvB = Server(), srvC = Server();
+   auto cliCtx = Client();
+   std::string eMsg, keys = KeyFile(2*80);
+
+   cliCtx->SessionCache(XrdTlsContext::scClnt);
+   ASSERT_TRUE(srvA->SessionTickets(0, keys.c_str(), &eMsg)) << eMsg;
+   ASSERT_TRUE(srvB->SessionTickets(0, keys.c_str(), &eMsg)) << eMsg;
+   ASSERT_TRUE(srvC->SessionTickets(60, 0, &eMsg)) << eMsg;
+
+   EXPECT_FALSE(Resumed(*srvA, *cliCtx, "cluster:1094"));
+   EXPECT_TRUE (Resumed(*srvB, *cliCtx, "cluster:1094"));
+   EXPECT_TRUE (Resumed(*srvA, *cliCtx, "cluster:1094"));
+   EXPECT_TRUE (Resumed(*srvA, *cliCtx, "cluster:1094"));
+   EXPECT_FALSE(Resumed(*srvC, *cliCtx, "cluster:1094"));
+   EXPECT_TRUE (Resumed(*srvC, *cliCtx, "cluster:1094"));
+}
+
+//------------------------------------------------------------------------------
+// A cloned context, as made for a CRL refresh, keeps the ticket keys
+//------------------------------------------------------------------------------
+TEST_F(XrdTlsSessionTests, TicketsSurviveClone)
+{
+   auto srvCtx = Server();
+   auto cliCtx = Client();
+   std::string eMsg;
+
+   cliCtx->SessionCache(XrdTlsContext::scClnt);
+   ASSERT_TRUE(srvCtx->SessionTickets(60, 0, &eMsg)) << eMsg;
+   EXPECT_FALSE(Resumed(*srvCtx, *cliCtx, "server1:1094"));
+
+   std::unique_ptr<XrdTlsContext> clone(srvCtx->Clone());
+   ASSERT_TRUE(clone && clone->isOK());
+   EXPECT_TRUE(Resumed(*clone, *cliCtx, "server1:1094"));
+}
+
+//------------------------------------------------------------------------------
+// Key files must be private and hold whole keys
+//------------------------------------------------------------------------------
+TEST_F(XrdTlsSessionTests, BadKeyFiles)
+{
+   auto srvCtx = Server();
+   std::string eMsg;
+
+   EXPECT_FALSE(srvCtx->SessionTickets(0, KeyFN().c_str(), &eMsg));
+   EXPECT_NE(std::string::npos, eMsg.find(KeyFN())) << eMsg;
+
+   EXPECT_FALSE(srvCtx->SessionTickets(0, KeyFile(80, 0644).c_str(), &eMsg));
+   EXPECT_NE(std::string::npos, eMsg.find("owner")) << eMsg;
+
+   EXPECT_FALSE(srvCtx->SessionTickets(0, KeyFile(79).c_str(), &eMsg));
+   EXPECT_FALSE(srvCtx->SessionTickets(0, KeyFile(9*80).c_str(), &eMsg));
+   EXPECT_FALSE(srvCtx->SessionTickets(0, KeyFile(0).c_str(), &eMsg));
+
+   EXPECT_TRUE(srvCtx->SessionTickets(0, KeyFile(8*80).c_str(), &eMsg)) << eMsg;
+}
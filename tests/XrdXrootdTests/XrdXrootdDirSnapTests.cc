@@ -0,0 +1,239 @@
+//------------------------------------------------------------------------------
+// Unit tests for XrdXrootdDirSnapTab, the per-client table of the snapshots
+// that paged directory listings are served from. The tests check that:
+//   - a listing is paged through reading the directory only once, even while
+//     more than maxSnaps other paged listings are open by other clients;
+//   - a client's own listings keep their snapshots up to maxSnaps, after which
+//     the one that has waited the longest is released;
+//   - a listing starting anew reads the directory again and a snapshot is
+//     only found by the listing and cursor it was kept for;
+//   - nothing is kept when maxSnaps is zero.
+//------------------------------------------------------------------------------
+
+#include "XrdXrootd/XrdXrootdDirSnap.hh"
+#include "XrdSfs/XrdSfsInterface.hh"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A directory that counts how many times it was read
+//------------------------------------------------------------------------------
+class FakeDir : public XrdSfsDirectory
+{
+public:
+
+int         open(const char *, const XrdSecEntity *, const char *) override
+                {return SFS_OK;}
+
+const char *nextEntry() override
+                {if (pos == 0) nReads++;
+                 if (pos < names.size()) return names[pos++].c_str();
+                 return 0;
+                }
+
+int         close() override {return SFS_OK;}
+
+const char *FName() override {return "/dir";}
+
+void        Rewind() {pos = 0;}
+
+            FakeDir(int n) : XrdSfsDirectory("test", 0)
+                {names.push_back(".");
+                 names.push_back("..");
+                 for (int i = n; i > 0; i--) names.push_back(Name(i));
+                }
+
+static std::string Name(int i)
+                {char buff[16];
+                 snprintf(buff, sizeof(buff), "f%05d", i);
+                 return buff;
+                }
+
+std::vector<std::string> names;
+size_t                   pos    = 0;
+int                      nReads = 0;
+};
+
+//------------------------------------------------------------------------------
+// Page through a listing and return the number of entries seen
+//------------------------------------------------------------------------------
+int PageAll(XrdXrootdDirSnapTab &tab, const std::string &key, FakeDir &dir,
+            int pgSize)
+{
+   std::string after;
+   int seen = 0;
+
+   while(true)
+        {dir.Rewind();
+         XrdXrootdDirSnap *snap = tab.Get(key, after.c_str(), &dir);
+         int beg = snap->Find(after.c_str());
+         int end = beg + pgSize;
+         if (end >= (int)snap->Names.size())
+            {seen += snap->Names.size() - beg;
+             XrdXrootdDirSnapTab::Drop(snap);
+             return seen;
+            }
+         seen += pgSize;
+         after = snap->Names[end-1];
+         tab.Put(snap, after);
+        }
+}
+}
+
+/******************************************************************************/
+/*                              F i x t u r e                                 */
+/******************************************************************************/
+
+class XrdXrootdDirSnapTests : public ::testing::Test
+{
+protected:
+
+void SetUp()    override {saved = XrdXrootdDirSnapTab::maxSnaps;}
+void TearDown() override {XrdXrootdDirSnapTab::maxSnaps = saved;}
+
+// Open a listing and leave it after its first page
+//
+void StartListing(XrdXrootdDirSnapTab &tab, const std::string &key,
+                  FakeDir &dir, int pgSize)
+     {XrdXrootdDirSnap *snap = tab.Get(key, "", &dir);
+      tab.Put(snap, snap->Names[pgSize-1]);
+     }
+
+int saved;
+};
+
+//------------------------------------------------------------------------------
+// Other clients' listings do not affect the snapshot of this one
+//------------------------------------------------------------------------------
+TEST_F(XrdXrootdDirSnapTests, PagingWhileOthersListing)
+{
+   std::vector<std::unique_ptr<XrdXrootdDirSnapTab>> others;
+   FakeDir dir(1000), odir(100);
+   XrdXrootdDirSnapTab tab;
+
+   XrdXrootdDirSnapTab::maxSnaps = 8;
+   for (int i = 0; i < 3 * XrdXrootdDirSnapTab::maxSnaps; i++)
+       {others.emplace_back(new XrdXrootdDirSnapTab);
+        odir.Rewind();
+        StartListing(*others.back(), "/other", odir, 10);
+       }
+
+   std::string after;
+   int seen = 0, pages = 0;
+   while(true)
+        {XrdXrootdDirSnap *snap = tab.Get("/dir", after.c_str(), &dir);
+         int beg = snap->Find(after.c_str());
+         if (beg + 100 >= (int)snap->Names.size())
+            {seen += snap->Names.size() - beg;
+             XrdXrootdDirSnapTab::Drop(snap);
+             break;
+            }
+         seen += 100;
+         after = snap->Names[beg + 99];
+         tab.Put(snap, after);
+         pages++;
+
+// Keep the other clients busy starting listings between our pages
+//
+         for (auto &oTab : others)
+             {odir.Rewind();
+              StartListing(*oTab, "/other" + std::to_string(pages), odir, 10);
+             }
+        }
+   EXPECT_EQ(1000, seen);
+   EXPECT_EQ(1, dir.nReads);
+}
+
+//------------------------------------------------------------------------------
+// A client's own listings are kept up to maxSnaps
+//------------------------------------------------------------------------------
+TEST_F(XrdXrootdDirSnapTests, OwnListingsUpToLimit)
+{
+   FakeDir dir(50), odir(20);
+   XrdXrootdDirSnapTab tab;
+
+   XrdXrootdDirSnapTab::maxSnaps = 9;
+   StartListing(tab, "/dir", dir, 10);
+   for (int i = 0; i < 8; i++)
+       {odir.Rewind();
+        StartListing(tab, "/other" + std::to_string(i), odir, 10);
+       }
+
+// All nine fit, so our listing continues from its snapshot
+//
+   XrdXrootdDirSnap *snap = tab.Get("/dir", FakeDir::Name(10).c_str(), &dir);
+   EXPECT_EQ(1, dir.nReads);
+   EXPECT_EQ(10, snap->Find(FakeDir::Name(10).c_str()));
+   tab.Put(snap, FakeDir::Name(20));
+
+// One more listing pushes out the one that has waited the longest
+//
+   odir.Rewind();
+   StartListing(tab, "/another", odir, 10);
+   dir.Rewind();
+   snap = tab.Get("/dir", FakeDir::Name(20).c_str(), &dir);
+   EXPECT_EQ(1, dir.nReads);
+   XrdXrootdDirSnapTab::Drop(snap);
+
+   odir.Rewind();
+   snap = tab.Get("/other0", FakeDir::Name(10).c_str(), &odir);
+   EXPECT_EQ(10, odir.nReads);
+   XrdXrootdDirSnapTab::Drop(snap);
+}
+
+//------------------------------------------------------------------------------
+// Snapshots are found only by their listing and cursor
+//------------------------------------------------------------------------------
+TEST_F(XrdXrootdDirSnapTests, KeyedByListingAndCursor)
+{
+   FakeDir dir(30);
+   XrdXrootdDirSnapTab tab;
+
+   EXPECT_EQ(30, PageAll(tab, "/dir", dir, 7));
+   EXPECT_EQ(1, dir.nReads);
+
+// A listing that starts anew reads the directory again
+//
+   dir.Rewind();
+   StartListing(tab, "/dir", dir, 10);
+   dir.Rewind();
+   XrdXrootdDirSnapTab::Drop(tab.Get("/dir", "", &dir));
+   EXPECT_EQ(3, dir.nReads);
+
+// Another cursor or another listing does not find the snapshot
+//
+   dir.Rewind();
+   XrdXrootdDirSnapTab::Drop(tab.Get("/dir", FakeDir::Name(5).c_str(), &dir));
+   EXPECT_EQ(4, dir.nReads);
+   dir.Rewind();
+   XrdXrootdDirSnapTab::Drop(tab.Get("/dir?x=1", FakeDir::Name(10).c_str(),
+                                     &dir));
+   EXPECT_EQ(5, dir.nReads);
+
+// The snapshot is gone once its listing continued
+//
+   dir.Rewind();
+   XrdXrootdDirSnapTab::Drop(tab.Get("/dir", FakeDir::Name(10).c_str(), &dir));
+   EXPECT_EQ(5, dir.nReads);
+   dir.Rewind();
+   XrdXrootdDirSnapTab::Drop(tab.Get("/dir", FakeDir::Name(10).c_str(), &dir));
+   EXPECT_EQ(6, dir.nReads);
+}
+
+//------------------------------------------------------------------------------
+// Nothing is kept when so configured
+//------------------------------------------------------------------------------
+TEST_F(XrdXrootdDirSnapTests, KeepNothing)
+{
+   FakeDir dir(30);
+   XrdXrootdDirSnapTab tab;
+
+   XrdXrootdDirSnapTab::maxSnaps = 0;
+   EXPECT_EQ(30, PageAll(tab, "/dir", dir, 10));
+   EXPECT_EQ(3, dir.nReads);
+}
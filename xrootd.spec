@@ -38,7 +38,6 @@ BuildRequires:	fuse-devel
 BuildRequires:	krb5-devel
 BuildRequires:	libcurl-devel
 BuildRequires:	libxml2-devel
-BuildRequires:	libzip-devel
 BuildRequires:	ncurses-devel
 BuildRequires:	openssl-devel
 BuildRequires:	perl-generators